@@ -154,6 +154,10 @@ struct Settings {
   bool start_paused = false;
   bool trace_skia = false;
   std::vector<std::string> trace_allowlist;
+  // Record trace events into the in-memory ring buffers of
+  // fml/trace_buffer.h, which are served by the _flutter.getTraceBuffer
+  // service extension.
+  bool trace_to_buffer = false;
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
@@ -221,6 +225,20 @@ struct Settings {
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
+  // Choose the depth of the frame pipeline and the start of the UI work of
+  // each frame from the timings of recent frames, to lower the latency of
+  // frames that build and rasterize within one vsync interval.
+  bool enable_adaptive_frame_pacing = false;
+
+  // Dispatch the moves of touches and styluses once per frame, at the
+  // position they are predicted to have when the frame is presented.
+  bool enable_pointer_resampling = false;
+
+  // Dispatch the pointer events that the platform sends while the dispatch of
+  // earlier events is pending on the UI thread together with those, merging
+  // the consecutive moves and hovers of a device within a vsync interval.
+  bool coalesce_pointer_events = false;
+
   // Enable the Impeller renderer on supported platforms. Ignored if Impeller is
   // not supported on the platform.
 #if FML_OS_ANDROID || FML_OS_IOS || FML_OS_IOS_SIMULATOR
@@ -354,6 +372,18 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // The number of threads that rasterize frames of software surfaces in
+  // tiles, including the raster thread. Frames are rasterized on the raster
+  // thread only if this is 1 or less.
+  size_t software_raster_worker_count = 0;
+
+  // If not empty, the directory into which the rasterizer writes the
+  // DisplayLists of the next |frame_capture_count| frames it draws, in the
+  // format of |SerializeDisplayList|. Only honored in debug and profile
+  // builds.
+  std::string frame_capture_path;
+  size_t frame_capture_count = 0;
+
   /// Enable embedder api on the embedder.
   ///
   /// This is currently only used by iOS.
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 
@@ -205,6 +206,17 @@ class DlOpReceiverIgnore : public IgnoreAttributeDispatchHelper,
                            public IgnoreClipDispatchHelper,
                            public IgnoreDrawDispatchHelper {};
 
+// The same receiver declared final so that |DisplayList::DispatchInlined|
+// can call it without going through the vtable.
+class DlOpReceiverIgnoreFinal final : public IgnoreAttributeDispatchHelper,
+                                      public IgnoreTransformDispatchHelper,
+                                      public IgnoreClipDispatchHelper,
+                                      public IgnoreDrawDispatchHelper {
+ public:
+  using DlOpReceiver::save;
+  using DlOpReceiver::saveLayer;
+};
+
 static void BM_DisplayListDispatchDefault(
     benchmark::State& state,
     DisplayListDispatchBenchmarkType type) {
@@ -220,6 +232,37 @@ static void BM_DisplayListDispatchDefault(
   }
 }
 
+static void BM_DisplayListDispatchVirtual(
+    benchmark::State& state,
+    DisplayListDispatchBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  DisplayListBuilder builder(prepare_rtree);
+  for (int i = 0; i < 5; i++) {
+    InvokeAllOps(builder);
+  }
+  auto display_list = builder.Build();
+  DlOpReceiverIgnoreFinal receiver;
+  DlOpReceiver& virtual_receiver = receiver;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(virtual_receiver);
+  }
+}
+
+static void BM_DisplayListDispatchInlined(
+    benchmark::State& state,
+    DisplayListDispatchBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  DisplayListBuilder builder(prepare_rtree);
+  for (int i = 0; i < 5; i++) {
+    InvokeAllOps(builder);
+  }
+  auto display_list = builder.Build();
+  DlOpReceiverIgnoreFinal receiver;
+  while (state.KeepRunning()) {
+    display_list->DispatchInlined(receiver);
+  }
+}
+
 static void BM_DisplayListDispatchByIndexDefault(
     benchmark::State& state,
     DisplayListDispatchBenchmarkType type) {
@@ -290,6 +333,23 @@ static void BM_DisplayListDispatchCull(benchmark::State& state,
   }
 }
 
+static void BM_DisplayListDispatchInlinedCull(
+    benchmark::State& state,
+    DisplayListDispatchBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  DisplayListBuilder builder(prepare_rtree);
+  for (int i = 0; i < 5; i++) {
+    InvokeAllOps(builder);
+  }
+  auto display_list = builder.Build();
+  DlRect rect = DlRect::MakeLTRB(0, 0, 100, 100);
+  EXPECT_FALSE(rect.Contains(display_list->GetBounds()));
+  DlOpReceiverIgnoreFinal receiver;
+  while (state.KeepRunning()) {
+    display_list->DispatchInlined(receiver, rect);
+  }
+}
+
 static void BM_DisplayListDispatchByVectorCull(
     benchmark::State& state,
     DisplayListDispatchBenchmarkType type) {
@@ -444,6 +504,21 @@ BENCHMARK_CAPTURE(BM_DisplayListDispatchCull,
                   DisplayListDispatchBenchmarkType::kCulledWithRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListDispatchVirtual,
+                  kDefaultNoRtree,
+                  DisplayListDispatchBenchmarkType::kDefaultNoRtree)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchInlined,
+                  kDefaultNoRtree,
+                  DisplayListDispatchBenchmarkType::kDefaultNoRtree)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchInlinedCull,
+                  kCulledWithRtree,
+                  DisplayListDispatchBenchmarkType::kCulledWithRtree)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListDispatchByIndexDefault,
                   kDefaultNoRtree,
                   DisplayListDispatchBenchmarkType::kDefaultNoRtree)
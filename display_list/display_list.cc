@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/display_list/dl_op_records.h"
 #include "flutter/fml/trace_event.h"
 
@@ -179,10 +180,7 @@ void DisplayList::RTreeResultsToIndexVector(
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
-  const uint8_t* base = storage_.base();
-  for (size_t offset : offsets_) {
-    DispatchOneOp(receiver, base + offset);
-  }
+  DispatchInlined(receiver);
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
@@ -192,38 +190,7 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            const DlRect& cull_rect) const {
-  if (cull_rect.IsEmpty()) {
-    return;
-  }
-  if (!has_rtree() || cull_rect.Contains(GetBounds())) {
-    Dispatch(receiver);
-  } else {
-    auto op_indices = GetCulledIndices(cull_rect);
-    const uint8_t* base = storage_.base();
-    for (DlIndex index : op_indices) {
-      DispatchOneOp(receiver, base + offsets_[index]);
-    }
-  }
-}
-
-void DisplayList::DispatchOneOp(DlOpReceiver& receiver,
-                                const uint8_t* ptr) const {
-  auto op = reinterpret_cast<const DLOp*>(ptr);
-  switch (op->type) {
-#define DL_OP_DISPATCH(name)                              \
-  case DisplayListOpType::k##name:                        \
-    static_cast<const name##Op*>(op)->dispatch(receiver); \
-    break;
-
-    FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
-
-#undef DL_OP_DISPATCH
-
-    case DisplayListOpType::kInvalidOp:
-    default:
-      FML_DCHECK(false) << "Unrecognized op type: "
-                        << static_cast<int>(op->type);
-  }
+  DispatchInlined(receiver, cull_rect);
 }
 
 void DisplayList::DisposeOps(const DisplayListStorage& storage,
@@ -280,6 +280,29 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx, const DlRect& cull_rect) const;
   void Dispatch(DlOpReceiver& ctx, const DlIRect& cull_rect) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief   Dispatches the operations to a receiver of a known concrete
+  ///          type. The records call the methods of |Receiver| directly
+  ///          rather than through the |DlOpReceiver| vtable, which lets the
+  ///          compiler inline them when |Receiver| is declared final.
+  ///
+  ///          The receiver must make all of the |DlOpReceiver| overloads of
+  ///          |save| and |saveLayer| visible, typically with using
+  ///          declarations, and its receiver methods must be public.
+  ///
+  ///          These methods are defined in dl_op_dispatch.h, which must be
+  ///          included by their callers.
+  ///
+  /// @see |Dispatch(DlOpReceiver&)|
+  template <typename Receiver>
+  void DispatchInlined(Receiver& receiver) const;
+  template <typename Receiver>
+  void DispatchInlined(Receiver& receiver, const DlRect& cull_rect) const;
+  template <typename Receiver>
+  void DispatchInlined(Receiver& receiver, const DlIRect& cull_rect) const {
+    DispatchInlined(receiver, DlRect::Make(cull_rect));
+  }
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -550,7 +573,8 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
-  void DispatchOneOp(DlOpReceiver& receiver, const uint8_t* ptr) const;
+  template <typename Receiver>
+  void DispatchOneOp(Receiver& receiver, const uint8_t* ptr) const;
 
   void RTreeResultsToIndexVector(std::vector<DlIndex>& indices,
                                  const std::vector<int>& rtree_results) const;
@@ -11,6 +11,7 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/display_list/dl_paint.h"
 #include "flutter/display_list/effects/dl_image_filters.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
@@ -25,6 +26,7 @@
 #include "flutter/testing/testing.h"
 
 #include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkRSXform.h"
@@ -1203,6 +1205,39 @@ TEST_F(DisplayListTest, DisplayListTransformResetHandling) {
   ASSERT_TRUE(canvas->getTotalMatrix().isIdentity());
 }
 
+TEST_F(DisplayListTest, DispatchInlinedMatchesVirtualDispatch) {
+  auto render = [](const sk_sp<DisplayList>& display_list, bool inlined) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(150, 150);
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bitmap);
+    DlSkCanvasDispatcher dispatcher(&canvas);
+    if (inlined) {
+      display_list->DispatchInlined(dispatcher);
+    } else {
+      display_list->Dispatch(static_cast<DlOpReceiver&>(dispatcher));
+    }
+    return bitmap;
+  };
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListBuilder builder;
+      group.variants[i].Invoke(ToReceiver(builder));
+      builder.DrawRect(DlRect::MakeLTRB(20, 20, 80, 80), DlPaint());
+      auto display_list = builder.Build();
+
+      SkBitmap expected = render(display_list, false);
+      SkBitmap actual = render(display_list, true);
+      for (int y = 0; y < 150; y++) {
+        ASSERT_EQ(memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                         150 * sizeof(uint32_t)),
+                  0)
+            << group.op_name << " variant " << i << " row " << y;
+      }
+    }
+  }
+}
+
 TEST_F(DisplayListTest, SingleOpsMightSupportGroupOpacityBlendMode) {
   auto run_tests = [](const std::string& name,
                       void build(DlCanvas & canvas, const DlPaint& paint),
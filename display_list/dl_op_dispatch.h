@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OP_DISPATCH_H_
+#define FLUTTER_DISPLAY_LIST_DL_OP_DISPATCH_H_
+
+#include <type_traits>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/logging.h"
+
+// The definitions of the |DisplayList::DispatchInlined| templates. They are
+// kept out of display_list.h so that only the translation units that
+// dispatch to a concrete receiver depend on the layout of the op records.
+
+namespace flutter {
+
+template <typename Receiver>
+void DisplayList::DispatchOneOp(Receiver& receiver, const uint8_t* ptr) const {
+  static_assert(std::is_base_of_v<DlOpReceiver, Receiver>);
+  auto op = reinterpret_cast<const DLOp*>(ptr);
+  switch (op->type) {
+#define DL_OP_DISPATCH(name)                              \
+  case DisplayListOpType::k##name:                        \
+    static_cast<const name##Op*>(op)->dispatch(receiver); \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+
+#undef DL_OP_DISPATCH
+
+    case DisplayListOpType::kInvalidOp:
+    default:
+      FML_DCHECK(false) << "Unrecognized op type: "
+                        << static_cast<int>(op->type);
+  }
+}
+
+template <typename Receiver>
+void DisplayList::DispatchInlined(Receiver& receiver) const {
+  const uint8_t* base = storage_.base();
+  for (size_t offset : offsets_) {
+    DispatchOneOp(receiver, base + offset);
+  }
+}
+
+template <typename Receiver>
+void DisplayList::DispatchInlined(Receiver& receiver,
+                                  const DlRect& cull_rect) const {
+  if (cull_rect.IsEmpty()) {
+    return;
+  }
+  if (!has_rtree() || cull_rect.Contains(GetBounds())) {
+    DispatchInlined(receiver);
+  } else {
+    auto op_indices = GetCulledIndices(cull_rect);
+    const uint8_t* base = storage_.base();
+    for (DlIndex index : op_indices) {
+      DispatchOneOp(receiver, base + offsets_[index]);
+    }
+  }
+}
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OP_DISPATCH_H_
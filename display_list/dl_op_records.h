@@ -77,7 +77,8 @@ struct DLOp {
                                                                       \
     const bool value;                                                 \
                                                                       \
-    void dispatch(DlOpReceiver& receiver) const {                     \
+    template <typename Receiver>                                      \
+    void dispatch(Receiver& receiver) const {                         \
       receiver.set##name(value);                                      \
     }                                                                 \
   };
@@ -95,7 +96,8 @@ DEFINE_SET_BOOL_OP(InvertColors)
                                                                        \
     const DlStroke##name value;                                        \
                                                                        \
-    void dispatch(DlOpReceiver& receiver) const {                      \
+    template <typename Receiver>                                       \
+    void dispatch(Receiver& receiver) const {                          \
       receiver.setStroke##name(value);                                 \
     }                                                                  \
   };
@@ -111,7 +113,8 @@ struct SetStyleOp final : DLOp {
 
   const DlDrawStyle style;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.setDrawStyle(style);
   }
 };
@@ -123,7 +126,8 @@ struct SetStrokeWidthOp final : DLOp {
 
   const float width;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.setStrokeWidth(width);
   }
 };
@@ -135,7 +139,8 @@ struct SetStrokeMiterOp final : DLOp {
 
   const float limit;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.setStrokeMiter(limit);
   }
 };
@@ -148,7 +153,8 @@ struct SetColorOp final : DLOp {
 
   const DlColor color;
 
-  void dispatch(DlOpReceiver& receiver) const { receiver.setColor(color); }
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const { receiver.setColor(color); }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SetBlendModeOp final : DLOp {
@@ -158,7 +164,8 @@ struct SetBlendModeOp final : DLOp {
 
   const DlBlendMode mode;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.setBlendMode(mode);
   }
 };
@@ -175,7 +182,8 @@ struct SetBlendModeOp final : DLOp {
                                                                             \
     Clear##name##Op() : DLOp(kType) {}                                      \
                                                                             \
-    void dispatch(DlOpReceiver& receiver) const {                           \
+    template <typename Receiver>                                            \
+    void dispatch(Receiver& receiver) const {                               \
       receiver.set##name(nullptr);                                          \
     }                                                                       \
   };                                                                        \
@@ -184,7 +192,8 @@ struct SetBlendModeOp final : DLOp {
                                                                             \
     SetPod##name##Op() : DLOp(kType) {}                                     \
                                                                             \
-    void dispatch(DlOpReceiver& receiver) const {                           \
+    template <typename Receiver>                                            \
+    void dispatch(Receiver& receiver) const {                               \
       const Dl##name* filter = reinterpret_cast<const Dl##name*>(this + 1); \
       receiver.set##name(filter);                                           \
     }                                                                       \
@@ -210,7 +219,8 @@ struct SetImageColorSourceOp : DLOp {
 
   const DlImageColorSource source;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.setColorSource(&source);
   }
 };
@@ -229,7 +239,8 @@ struct SetRuntimeEffectColorSourceOp : DLOp {
 
   const DlRuntimeEffectColorSource source;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.setColorSource(&source);
   }
 
@@ -248,7 +259,8 @@ struct SetSharedImageFilterOp : DLOp {
 
   const std::shared_ptr<DlImageFilter> filter;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.setImageFilter(filter.get());
   }
 
@@ -287,7 +299,8 @@ struct SaveOp final : SaveOpBase {
 
   SaveOp() : SaveOpBase(kType) {}
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.save(total_content_depth);
   }
 };
@@ -310,8 +323,10 @@ struct SaveLayerOp final : SaveLayerOpBase {
   SaveLayerOp(const SaveLayerOptions& options, const DlRect& rect)
       : SaveLayerOpBase(kType, options, rect) {}
 
-  void dispatch(DlOpReceiver& receiver) const {
-    receiver.saveLayer(rect, options, total_content_depth, max_blend_mode);
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
+    receiver.saveLayer(rect, options, total_content_depth, max_blend_mode,
+                       nullptr, std::nullopt);
   }
 };
 // 36 byte SaveLayerOpBase + 4 bytes for alignment + 16 byte payload packs
@@ -330,7 +345,8 @@ struct SaveLayerBackdropOp final : SaveLayerOpBase {
   const std::shared_ptr<DlImageFilter> backdrop;
   std::optional<int64_t> backdrop_id_;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.saveLayer(rect, options, total_content_depth, max_blend_mode,
                        backdrop.get(), backdrop_id_);
   }
@@ -351,7 +367,8 @@ struct RestoreOp final : DLOp {
 
   RestoreOp() : DLOp(kType) {}
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.restore();
   }
 };
@@ -373,7 +390,8 @@ struct TranslateOp final : TransformClipOpBase {
   const DlScalar tx;
   const DlScalar ty;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.translate(tx, ty);
   }
 };
@@ -388,7 +406,8 @@ struct ScaleOp final : TransformClipOpBase {
   const DlScalar sx;
   const DlScalar sy;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.scale(sx, sy);
   }
 };
@@ -401,7 +420,8 @@ struct RotateOp final : TransformClipOpBase {
 
   const DlScalar degrees;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.rotate(degrees);
   }
 };
@@ -416,7 +436,8 @@ struct SkewOp final : TransformClipOpBase {
   const DlScalar sx;
   const DlScalar sy;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.skew(sx, sy);
   }
 };
@@ -436,7 +457,8 @@ struct Transform2DAffineOp final : TransformClipOpBase {
   const DlScalar mxx, mxy, mxt;
   const DlScalar myx, myy, myt;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.transform2DAffine(mxx, mxy, mxt,  //
                                myx, myy, myt);
   }
@@ -464,7 +486,8 @@ struct TransformFullPerspectiveOp final : TransformClipOpBase {
   const DlScalar mzx, mzy, mzz, mzt;
   const DlScalar mwx, mwy, mwz, mwt;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.transformFullPerspective(mxx, mxy, mxz, mxt,  //
                                       myx, myy, myz, myt,  //
                                       mzx, mzy, mzz, mzt,  //
@@ -478,7 +501,8 @@ struct TransformResetOp final : TransformClipOpBase {
 
   TransformResetOp() : TransformClipOpBase(kType) {}
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.transformReset();
   }
 };
@@ -503,7 +527,8 @@ struct TransformResetOp final : TransformClipOpBase {
     const bool is_aa;                                                          \
     const shapetype shape;                                                     \
                                                                                \
-    void dispatch(DlOpReceiver& receiver) const {                              \
+    template <typename Receiver>                                               \
+    void dispatch(Receiver& receiver) const {                                  \
       receiver.clip##shapename(shape, DlCanvas::ClipOp::k##clipop, is_aa);     \
     }                                                                          \
   };
@@ -526,7 +551,8 @@ DEFINE_CLIP_SHAPE_OP(RoundRect, DlRoundRect, Difference)
     const bool is_aa;                                                     \
     const DlPath path;                                                    \
                                                                           \
-    void dispatch(DlOpReceiver& receiver) const {                         \
+    template <typename Receiver>                                          \
+    void dispatch(Receiver& receiver) const {                             \
       receiver.clipPath(path, DlCanvas::ClipOp::k##clipop, is_aa);        \
     }                                                                     \
                                                                           \
@@ -553,7 +579,8 @@ struct DrawPaintOp final : DrawOpBase {
 
   DrawPaintOp() : DrawOpBase(kType) {}
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.drawPaint();
   }
 };
@@ -568,7 +595,8 @@ struct DrawColorOp final : DrawOpBase {
   const DlColor color;
   const DlBlendMode mode;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawColor(color, mode);
   }
 };
@@ -588,7 +616,8 @@ struct DrawColorOp final : DrawOpBase {
                                                                      \
     const arg_type arg_name;                                         \
                                                                      \
-    void dispatch(DlOpReceiver& receiver) const {                    \
+    template <typename Receiver>                                     \
+    void dispatch(Receiver& receiver) const {                        \
       receiver.draw##op_name(arg_name);                              \
     }                                                                \
   };
@@ -606,7 +635,8 @@ struct DrawPathOp final : DrawOpBase {
 
   const DlPath path;
 
-  void dispatch(DlOpReceiver& receiver) const {  //
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {  //
     receiver.drawPath(path);
   }
 
@@ -632,7 +662,8 @@ struct DrawPathOp final : DrawOpBase {
     const type1 name1;                                               \
     const type2 name2;                                               \
                                                                      \
-    void dispatch(DlOpReceiver& receiver) const {                    \
+    template <typename Receiver>                                     \
+    void dispatch(Receiver& receiver) const {                        \
       receiver.draw##op_name(name1, name2);                          \
     }                                                                \
   };
@@ -660,7 +691,8 @@ struct DrawDashedLineOp final : DrawOpBase {
   const DlScalar on_length;
   const DlScalar off_length;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawDashedLine(p0, p1, on_length, off_length);
   }
 };
@@ -681,7 +713,8 @@ struct DrawArcOp final : DrawOpBase {
   const DlScalar sweep;
   const bool center;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawArc(bounds, start, sweep, center);
   }
 };
@@ -701,7 +734,8 @@ struct DrawArcOp final : DrawOpBase {
                                                                        \
     const uint32_t count;                                              \
                                                                        \
-    void dispatch(DlOpReceiver& receiver) const {                      \
+    template <typename Receiver>                                       \
+    void dispatch(Receiver& receiver) const {                          \
       const DlPoint* pts = reinterpret_cast<const DlPoint*>(this + 1); \
       receiver.drawPoints(DlCanvas::PointMode::mode, count, pts);      \
     }                                                                  \
@@ -722,7 +756,8 @@ struct DrawVerticesOp final : DrawOpBase {
   const DlBlendMode mode;
   const std::shared_ptr<DlVertices> vertices;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawVertices(vertices, mode);
   }
 };
@@ -745,7 +780,8 @@ struct DrawVerticesOp final : DrawOpBase {
     const DlImageSampling sampling;                                   \
     const sk_sp<DlImage> image;                                       \
                                                                       \
-    void dispatch(DlOpReceiver& receiver) const {                     \
+    template <typename Receiver>                                      \
+    void dispatch(Receiver& receiver) const {                         \
       receiver.drawImage(image, point, sampling, with_attributes);    \
     }                                                                 \
                                                                       \
@@ -786,7 +822,8 @@ struct DrawImageRectOp final : DrawOpBase {
   const DlCanvas::SrcRectConstraint constraint;
   const sk_sp<DlImage> image;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawImageRect(image, src, dst, sampling, render_with_attributes,
                            constraint);
   }
@@ -822,7 +859,8 @@ struct DrawImageRectOp final : DrawOpBase {
     const DlFilterMode mode;                                      \
     const sk_sp<DlImage> image;                                   \
                                                                   \
-    void dispatch(DlOpReceiver& receiver) const {                 \
+    template <typename Receiver>                                  \
+    void dispatch(Receiver& receiver) const {                     \
       receiver.drawImageNine(image, center, dst, mode,            \
                              render_with_attributes);             \
     }                                                             \
@@ -905,7 +943,8 @@ struct DrawAtlasOp final : DrawAtlasBaseOp {
                         has_colors,
                         render_with_attributes) {}
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
     const DlRect* tex = reinterpret_cast<const DlRect*>(xform + count);
     const DlColor* colors =
@@ -949,7 +988,8 @@ struct DrawAtlasCulledOp final : DrawAtlasBaseOp {
 
   const DlRect cull_rect;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
     const DlRect* tex = reinterpret_cast<const DlRect*>(xform + count);
     const DlColor* colors =
@@ -981,7 +1021,8 @@ struct DrawDisplayListOp final : DrawOpBase {
   DlScalar opacity;
   const sk_sp<DisplayList> display_list;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawDisplayList(display_list, opacity);
   }
 
@@ -1005,7 +1046,8 @@ struct DrawTextBlobOp final : DrawOpBase {
   const DlScalar y;
   const sk_sp<SkTextBlob> blob;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawTextBlob(blob, x, y);
   }
 };
@@ -1022,7 +1064,8 @@ struct DrawTextFrameOp final : DrawOpBase {
   const DlScalar y;
   const std::shared_ptr<impeller::TextFrame> text_frame;
 
-  void dispatch(DlOpReceiver& receiver) const {
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) const {
     receiver.drawTextFrame(text_frame, x, y);
   }
 };
@@ -1047,7 +1090,8 @@ struct DrawTextFrameOp final : DrawOpBase {
     const DlScalar dpr;                                                       \
     const DlPath path;                                                        \
                                                                               \
-    void dispatch(DlOpReceiver& receiver) const {                             \
+    template <typename Receiver>                                              \
+    void dispatch(Receiver& receiver) const {                                 \
       receiver.drawShadow(path, color, elevation, transparent_occluder, dpr); \
     }                                                                         \
                                                                               \
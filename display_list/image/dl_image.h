@@ -56,6 +56,21 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      If a copy of this image was also packed into an atlas texture
+  ///             of the Impeller backend, that texture. Null otherwise.
+  ///
+  ///             Draws of images that share an atlas texture can be merged.
+  ///
+  /// @param[out] bounds  The bounds of the image in the atlas texture.
+  ///
+  /// @return     An Impeller texture instance or null.
+  ///
+  virtual std::shared_ptr<impeller::Texture> impeller_atlas_texture(
+      DlIRect* bounds) const {
+    return nullptr;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
@@ -6,6 +6,7 @@
 
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/display_list/effects/image_filters/dl_blur_image_filter.h"
 #include "flutter/display_list/skia/dl_sk_conversions.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
@@ -332,9 +333,10 @@ void DlSkCanvasAdapter::DrawDisplayList(const sk_sp<DisplayList> display_list,
 
   DlSkCanvasDispatcher dispatcher(delegate_, opacity);
   if (display_list->has_rtree()) {
-    display_list->Dispatch(dispatcher, delegate_->getLocalClipBounds());
+    display_list->DispatchInlined(dispatcher,
+                                  ToDlRect(delegate_->getLocalClipBounds()));
   } else {
-    display_list->Dispatch(dispatcher);
+    display_list->DispatchInlined(dispatcher);
   }
 
   delegate_->restoreToCount(restore_count);
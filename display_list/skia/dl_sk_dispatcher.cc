@@ -7,6 +7,7 @@
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 
 #include "flutter/display_list/dl_blend_mode.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/display_list/effects/image_filters/dl_blur_image_filter.h"
 #include "flutter/display_list/skia/dl_sk_conversions.h"
 #include "flutter/display_list/skia/dl_sk_types.h"
@@ -293,9 +294,10 @@ void DlSkCanvasDispatcher::drawDisplayList(
   // display_list from the current environment.
   DlSkCanvasDispatcher dispatcher(canvas_, combined_opacity);
   if (display_list->rtree()) {
-    display_list->Dispatch(dispatcher, canvas_->getLocalClipBounds());
+    display_list->DispatchInlined(dispatcher,
+                                  ToDlRect(canvas_->getLocalClipBounds()));
   } else {
-    display_list->Dispatch(dispatcher);
+    display_list->DispatchInlined(dispatcher);
   }
 
   // Restore canvas state to what it was before dispatching.
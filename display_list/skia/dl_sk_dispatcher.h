@@ -17,8 +17,8 @@ namespace flutter {
 /// @brief      Backend implementation of |DlOpReceiver| for |SkCanvas|.
 ///
 /// @see       DlOpReceiver
-class DlSkCanvasDispatcher : public virtual DlOpReceiver,
-                             public DlSkPaintDispatchHelper {
+class DlSkCanvasDispatcher final : public virtual DlOpReceiver,
+                                   public DlSkPaintDispatchHelper {
  public:
   explicit DlSkCanvasDispatcher(SkCanvas* canvas, DlScalar opacity = SK_Scalar1)
       : DlSkPaintDispatchHelper(opacity),
@@ -27,6 +27,9 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
 
   const SkPaint* safe_paint(bool use_attributes);
 
+  using DlOpReceiver::save;
+  using DlOpReceiver::saveLayer;
+
   void save() override;
   void restore() override;
   void saveLayer(const DlRect& bounds,
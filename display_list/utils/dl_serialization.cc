@@ -0,0 +1,2025 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_serialization.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/effects/dl_color_filters.h"
+#include "flutter/display_list/effects/dl_color_sources.h"
+#include "flutter/display_list/effects/dl_image_filters.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/effects/dl_runtime_effect.h"
+#include "flutter/fml/logging.h"
+#include "flutter/impeller/runtime_stage/runtime_stage.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/effects/SkRuntimeEffect.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kByteOrderMarker = 0x01020304;
+constexpr uint32_t kHasRTreeFlag = 1 << 0;
+constexpr int kMaxImageFilterDepth = 64;
+// Runtime effects take color sources, which may be runtime effects, as their
+// samplers.
+constexpr int kMaxColorSourceDepth = 64;
+
+// The values of all of the enums below are part of the format.
+enum class ImageEntryType : uint32_t {
+  kEmbedded,
+  kReference,
+};
+
+enum class SerializedOp : uint32_t {
+  kEnd = 0,
+
+  kSetAntiAlias = 1,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave = 32,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate = 48,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect = 64,
+  kClipOval,
+  kClipRoundRect,
+  kClipPath,
+
+  kDrawColor = 80,
+  kDrawPaint,
+  kDrawLine,
+  kDrawDashedLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRoundRect,
+  kDrawDiffRoundRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawShadow,
+  kDrawTextBlob,
+};
+
+enum class ColorSourceTag : uint32_t {
+  kNone,
+  kImage,
+  kLinearGradient,
+  kRadialGradient,
+  kConicalGradient,
+  kSweepGradient,
+  kRuntimeEffect,
+};
+
+enum class ColorFilterTag : uint32_t {
+  kNone,
+  kBlend,
+  kMatrix,
+  kSrgbToLinearGamma,
+  kLinearToSrgbGamma,
+};
+
+enum class ImageFilterTag : uint32_t {
+  kNone,
+  kBlur,
+  kDilate,
+  kErode,
+  kMatrix,
+  kCompose,
+  kColorFilter,
+  kLocalMatrix,
+  kRuntimeEffect,
+};
+
+enum class RuntimeEffectTag : uint32_t {
+  // The SkSL source of a Skia runtime effect.
+  kSkSL,
+  // The runtime stages an Impeller runtime effect was decoded from, and the
+  // backend of the decoded stage.
+  kRuntimeStage,
+};
+
+enum class MaskFilterTag : uint32_t {
+  kNone,
+  kBlur,
+};
+
+constexpr size_t Align(size_t size) {
+  return (size + 3) & ~static_cast<size_t>(3);
+}
+
+class SerialWriter {
+ public:
+  size_t size() const { return data_.size(); }
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+  void WriteUint32(uint32_t value) { WriteRaw(&value, sizeof(value)); }
+  void WriteInt32(int32_t value) { WriteRaw(&value, sizeof(value)); }
+  void WriteScalar(DlScalar value) { WriteRaw(&value, sizeof(value)); }
+  void WriteBool(bool value) { WriteUint32(value ? 1u : 0u); }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    WriteUint32(static_cast<uint32_t>(value));
+  }
+
+  void WritePoint(const DlPoint& point) {
+    WriteScalar(point.x);
+    WriteScalar(point.y);
+  }
+
+  void WriteRect(const DlRect& rect) {
+    WriteScalar(rect.GetLeft());
+    WriteScalar(rect.GetTop());
+    WriteScalar(rect.GetRight());
+    WriteScalar(rect.GetBottom());
+  }
+
+  void WriteRoundRect(const DlRoundRect& rrect) {
+    WriteRect(rrect.GetBounds());
+    const auto& radii = rrect.GetRadii();
+    for (const auto& radius : {radii.top_left, radii.top_right,
+                               radii.bottom_left, radii.bottom_right}) {
+      WriteScalar(radius.width);
+      WriteScalar(radius.height);
+    }
+  }
+
+  void WriteColor(const DlColor& color) {
+    WriteScalar(color.getAlphaF());
+    WriteScalar(color.getRedF());
+    WriteScalar(color.getGreenF());
+    WriteScalar(color.getBlueF());
+    WriteEnum(color.getColorSpace());
+  }
+
+  void WriteMatrix(const DlMatrix& matrix) {
+    for (DlScalar value : matrix.m) {
+      WriteScalar(value);
+    }
+  }
+
+  void WritePath(const DlPath& path) {
+    const SkPath& sk_path = path.GetSkPath();
+    std::vector<uint8_t> bytes(sk_path.writeToMemory(nullptr));
+    sk_path.writeToMemory(bytes.data());
+    WriteBytes(bytes.data(), bytes.size());
+  }
+
+  // Writes the length of the data followed by the data, padded to the
+  // alignment of the format.
+  void WriteBytes(const void* bytes, size_t length) {
+    WriteUint32(static_cast<uint32_t>(length));
+    WriteRaw(bytes, length);
+    data_.resize(Align(data_.size()));
+  }
+
+  void PatchUint32(size_t offset, uint32_t value) {
+    FML_DCHECK(offset + sizeof(value) <= data_.size());
+    memcpy(data_.data() + offset, &value, sizeof(value));
+  }
+
+ private:
+  void WriteRaw(const void* bytes, size_t length) {
+    auto begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + length);
+  }
+
+  std::vector<uint8_t> data_;
+};
+
+// Reads the values written by a |SerialWriter|. Reading past the end of the
+// data sets the reader into a failed state in which all reads return zero
+// values, so callers only need to check |ok| once they are done.
+class SerialReader {
+ public:
+  SerialReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool ok() const { return ok_; }
+  void Fail() { ok_ = false; }
+
+  uint32_t ReadUint32() {
+    uint32_t value = 0;
+    ReadRaw(&value, sizeof(value));
+    return value;
+  }
+
+  int32_t ReadInt32() {
+    int32_t value = 0;
+    ReadRaw(&value, sizeof(value));
+    return value;
+  }
+
+  DlScalar ReadScalar() {
+    DlScalar value = 0;
+    ReadRaw(&value, sizeof(value));
+    return value;
+  }
+
+  bool ReadBool() { return ReadUint32() != 0; }
+
+  template <typename T>
+  T ReadEnum(T last) {
+    uint32_t value = ReadUint32();
+    if (value > static_cast<uint32_t>(last)) {
+      Fail();
+      return T();
+    }
+    return static_cast<T>(value);
+  }
+
+  DlPoint ReadPoint() {
+    DlScalar x = ReadScalar();
+    DlScalar y = ReadScalar();
+    return DlPoint(x, y);
+  }
+
+  DlRect ReadRect() {
+    DlScalar left = ReadScalar();
+    DlScalar top = ReadScalar();
+    DlScalar right = ReadScalar();
+    DlScalar bottom = ReadScalar();
+    return DlRect::MakeLTRB(left, top, right, bottom);
+  }
+
+  DlRoundRect ReadRoundRect() {
+    DlRect bounds = ReadRect();
+    impeller::RoundingRadii radii;
+    for (auto* radius : {&radii.top_left, &radii.top_right,
+                         &radii.bottom_left, &radii.bottom_right}) {
+      radius->width = ReadScalar();
+      radius->height = ReadScalar();
+    }
+    return DlRoundRect::MakeRectRadii(bounds, radii);
+  }
+
+  DlColor ReadColor() {
+    DlScalar alpha = ReadScalar();
+    DlScalar red = ReadScalar();
+    DlScalar green = ReadScalar();
+    DlScalar blue = ReadScalar();
+    DlColorSpace color_space = ReadEnum(DlColorSpace::kDisplayP3);
+    return DlColor(alpha, red, green, blue, color_space);
+  }
+
+  DlMatrix ReadMatrix() {
+    DlMatrix matrix;
+    for (DlScalar& value : matrix.m) {
+      value = ReadScalar();
+    }
+    return matrix;
+  }
+
+  DlPath ReadPath() {
+    size_t length;
+    const uint8_t* bytes = ReadBytes(&length);
+    SkPath path;
+    if (bytes && path.readFromMemory(bytes, length) == 0) {
+      Fail();
+    }
+    return DlPath(path);
+  }
+
+  const uint8_t* ReadBytes(size_t* length) {
+    *length = ReadUint32();
+    return Skip(*length);
+  }
+
+  // Returns the next |length| bytes and moves past them and their padding.
+  const uint8_t* Skip(size_t length) {
+    if (!ok_ || length > size_ - offset_ ||
+        Align(length) > size_ - offset_) {
+      Fail();
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + offset_;
+    offset_ += Align(length);
+    return bytes;
+  }
+
+ private:
+  void ReadRaw(void* value, size_t length) {
+    if (const uint8_t* bytes = Skip(length)) {
+      memcpy(value, bytes, length);
+    }
+  }
+
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0;
+  bool ok_ = true;
+};
+
+// Collects the distinct images drawn by a DisplayList and its nested
+// DisplayLists.
+class ImageTable {
+ public:
+  uint32_t Add(const sk_sp<const DlImage>& image) {
+    auto [it, inserted] =
+        indices_.emplace(image.get(), static_cast<uint32_t>(images_.size()));
+    if (inserted) {
+      images_.push_back(image);
+    }
+    return it->second;
+  }
+
+  const std::vector<sk_sp<const DlImage>>& images() const { return images_; }
+
+ private:
+  std::unordered_map<const DlImage*, uint32_t> indices_;
+  std::vector<sk_sp<const DlImage>> images_;
+};
+
+// Collects the distinct typefaces of the text drawn by a DisplayList and its
+// nested DisplayLists.
+class TypefaceTable {
+ public:
+  uint32_t Add(sk_sp<SkTypeface> typeface) {
+    auto [it, inserted] = indices_.emplace(
+        typeface.get(), static_cast<uint32_t>(typefaces_.size()));
+    if (inserted) {
+      typefaces_.push_back(std::move(typeface));
+    }
+    return it->second;
+  }
+
+  const std::vector<sk_sp<SkTypeface>>& typefaces() const {
+    return typefaces_;
+  }
+
+ private:
+  std::unordered_map<const SkTypeface*, uint32_t> indices_;
+  std::vector<sk_sp<SkTypeface>> typefaces_;
+};
+
+void WriteImage(SerialWriter& writer,
+                const DlImage& image,
+                const DlSerializationOptions& options,
+                DlSerializationStats& stats) {
+  SkISize size = image.dimensions();
+  std::vector<uint8_t> pixels;
+  if (sk_sp<SkImage> sk_image =
+          options.embed_images ? image.skia_image() : nullptr) {
+    SkImageInfo info = SkImageInfo::Make(size, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    pixels.resize(info.computeMinByteSize());
+    if (!sk_image->readPixels(options.gr_context, info, pixels.data(),
+                              info.minRowBytes(), 0, 0)) {
+      pixels.clear();
+    }
+  }
+
+  writer.WriteEnum(pixels.empty() ? ImageEntryType::kReference
+                                  : ImageEntryType::kEmbedded);
+  writer.WriteInt32(size.width());
+  writer.WriteInt32(size.height());
+  writer.WriteBool(image.isOpaque());
+  if (pixels.empty()) {
+    stats.referenced_image_count++;
+  } else {
+    writer.WriteBytes(pixels.data(), pixels.size());
+    stats.embedded_image_count++;
+  }
+}
+
+void WriteTypeface(SerialWriter& writer, SkTypeface* typeface) {
+  sk_sp<SkData> data =
+      typeface
+          ? typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData)
+          : nullptr;
+  writer.WriteBytes(data ? data->data() : nullptr, data ? data->size() : 0u);
+}
+
+// Finds the backend of a runtime stage among the stages decoded from the same
+// payload.
+std::optional<impeller::RuntimeStageBackend> FindRuntimeStageBackend(
+    const impeller::RuntimeStage& stage) {
+  if (!stage.GetPayload() || !stage.GetCodeMapping()) {
+    return std::nullopt;
+  }
+  for (const auto& [backend, decoded] :
+       impeller::RuntimeStage::DecodeRuntimeStages(stage.GetPayload())) {
+    if (decoded && decoded->GetCodeMapping() &&
+        decoded->GetCodeMapping()->GetMapping() ==
+            stage.GetCodeMapping()->GetMapping()) {
+      return backend;
+    }
+  }
+  return std::nullopt;
+}
+
+// Writes the records of the operations dispatched to it. Images are only
+// written as indices into the image table, which is written once all records
+// are known.
+class SerializingReceiver final : public virtual DlOpReceiver {
+ public:
+  SerializingReceiver(SerialWriter& writer,
+                      ImageTable& images,
+                      TypefaceTable& typefaces,
+                      const DlSerializationOptions& options,
+                      DlSerializationStats& stats)
+      : writer_(writer),
+        images_(images),
+        typefaces_(typefaces),
+        options_(options),
+        stats_(stats) {}
+
+  void WriteOps(const DisplayList& display_list) {
+    display_list.Dispatch(*this);
+    BeginRecord(SerializedOp::kEnd);
+    EndRecord();
+  }
+
+  void setAntiAlias(bool aa) override {
+    BeginRecord(SerializedOp::kSetAntiAlias);
+    writer_.WriteBool(aa);
+    EndRecord();
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    BeginRecord(SerializedOp::kSetDrawStyle);
+    writer_.WriteEnum(style);
+    EndRecord();
+  }
+  void setColor(DlColor color) override {
+    BeginRecord(SerializedOp::kSetColor);
+    writer_.WriteColor(color);
+    EndRecord();
+  }
+  void setStrokeWidth(float width) override {
+    BeginRecord(SerializedOp::kSetStrokeWidth);
+    writer_.WriteScalar(width);
+    EndRecord();
+  }
+  void setStrokeMiter(float limit) override {
+    BeginRecord(SerializedOp::kSetStrokeMiter);
+    writer_.WriteScalar(limit);
+    EndRecord();
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    BeginRecord(SerializedOp::kSetStrokeCap);
+    writer_.WriteEnum(cap);
+    EndRecord();
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    BeginRecord(SerializedOp::kSetStrokeJoin);
+    writer_.WriteEnum(join);
+    EndRecord();
+  }
+  void setColorSource(const DlColorSource* source) override {
+    BeginRecord(SerializedOp::kSetColorSource);
+    WriteColorSource(source);
+    EndRecord();
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    BeginRecord(SerializedOp::kSetColorFilter);
+    WriteColorFilter(filter);
+    EndRecord();
+  }
+  void setInvertColors(bool invert) override {
+    BeginRecord(SerializedOp::kSetInvertColors);
+    writer_.WriteBool(invert);
+    EndRecord();
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    BeginRecord(SerializedOp::kSetBlendMode);
+    writer_.WriteEnum(mode);
+    EndRecord();
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    BeginRecord(SerializedOp::kSetMaskFilter);
+    const DlBlurMaskFilter* blur = filter ? filter->asBlur() : nullptr;
+    if (blur) {
+      writer_.WriteEnum(MaskFilterTag::kBlur);
+      writer_.WriteEnum(blur->style());
+      writer_.WriteScalar(blur->sigma());
+      writer_.WriteBool(blur->respectCTM());
+    } else {
+      writer_.WriteEnum(MaskFilterTag::kNone);
+    }
+    EndRecord();
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    BeginRecord(SerializedOp::kSetImageFilter);
+    WriteImageFilter(filter);
+    EndRecord();
+  }
+
+  void save() override {
+    BeginRecord(SerializedOp::kSave);
+    EndRecord();
+  }
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    BeginRecord(SerializedOp::kSaveLayer);
+    writer_.WriteRect(bounds);
+    writer_.WriteBool(options.bounds_from_caller());
+    writer_.WriteBool(options.renders_with_attributes());
+    WriteImageFilter(backdrop);
+    writer_.WriteBool(backdrop_id.has_value());
+    uint64_t id = static_cast<uint64_t>(backdrop_id.value_or(0));
+    writer_.WriteUint32(static_cast<uint32_t>(id));
+    writer_.WriteUint32(static_cast<uint32_t>(id >> 32));
+    EndRecord();
+  }
+  void restore() override {
+    BeginRecord(SerializedOp::kRestore);
+    EndRecord();
+  }
+
+  void translate(DlScalar tx, DlScalar ty) override {
+    BeginRecord(SerializedOp::kTranslate);
+    writer_.WriteScalar(tx);
+    writer_.WriteScalar(ty);
+    EndRecord();
+  }
+  void scale(DlScalar sx, DlScalar sy) override {
+    BeginRecord(SerializedOp::kScale);
+    writer_.WriteScalar(sx);
+    writer_.WriteScalar(sy);
+    EndRecord();
+  }
+  void rotate(DlScalar degrees) override {
+    BeginRecord(SerializedOp::kRotate);
+    writer_.WriteScalar(degrees);
+    EndRecord();
+  }
+  void skew(DlScalar sx, DlScalar sy) override {
+    BeginRecord(SerializedOp::kSkew);
+    writer_.WriteScalar(sx);
+    writer_.WriteScalar(sy);
+    EndRecord();
+  }
+  // clang-format off
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override {
+    BeginRecord(SerializedOp::kTransform2DAffine);
+    for (DlScalar value : {mxx, mxy, mxt, myx, myy, myt}) {
+      writer_.WriteScalar(value);
+    }
+    EndRecord();
+  }
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override {
+    BeginRecord(SerializedOp::kTransformFullPerspective);
+    for (DlScalar value : {mxx, mxy, mxz, mxt,
+                           myx, myy, myz, myt,
+                           mzx, mzy, mzz, mzt,
+                           mwx, mwy, mwz, mwt}) {
+      writer_.WriteScalar(value);
+    }
+    EndRecord();
+  }
+  // clang-format on
+  void transformReset() override {
+    BeginRecord(SerializedOp::kTransformReset);
+    EndRecord();
+  }
+
+  void clipRect(const DlRect& rect, ClipOp clip_op, bool is_aa) override {
+    BeginRecord(SerializedOp::kClipRect);
+    writer_.WriteRect(rect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+    EndRecord();
+  }
+  void clipOval(const DlRect& bounds, ClipOp clip_op, bool is_aa) override {
+    BeginRecord(SerializedOp::kClipOval);
+    writer_.WriteRect(bounds);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+    EndRecord();
+  }
+  void clipRoundRect(const DlRoundRect& rrect,
+                     ClipOp clip_op,
+                     bool is_aa) override {
+    BeginRecord(SerializedOp::kClipRoundRect);
+    writer_.WriteRoundRect(rrect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+    EndRecord();
+  }
+  void clipPath(const DlPath& path, ClipOp clip_op, bool is_aa) override {
+    BeginRecord(SerializedOp::kClipPath);
+    writer_.WritePath(path);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+    EndRecord();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    BeginRecord(SerializedOp::kDrawColor);
+    writer_.WriteColor(color);
+    writer_.WriteEnum(mode);
+    EndRecord();
+  }
+  void drawPaint() override {
+    BeginRecord(SerializedOp::kDrawPaint);
+    EndRecord();
+  }
+  void drawLine(const DlPoint& p0, const DlPoint& p1) override {
+    BeginRecord(SerializedOp::kDrawLine);
+    writer_.WritePoint(p0);
+    writer_.WritePoint(p1);
+    EndRecord();
+  }
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    BeginRecord(SerializedOp::kDrawDashedLine);
+    writer_.WritePoint(p0);
+    writer_.WritePoint(p1);
+    writer_.WriteScalar(on_length);
+    writer_.WriteScalar(off_length);
+    EndRecord();
+  }
+  void drawRect(const DlRect& rect) override {
+    BeginRecord(SerializedOp::kDrawRect);
+    writer_.WriteRect(rect);
+    EndRecord();
+  }
+  void drawOval(const DlRect& bounds) override {
+    BeginRecord(SerializedOp::kDrawOval);
+    writer_.WriteRect(bounds);
+    EndRecord();
+  }
+  void drawCircle(const DlPoint& center, DlScalar radius) override {
+    BeginRecord(SerializedOp::kDrawCircle);
+    writer_.WritePoint(center);
+    writer_.WriteScalar(radius);
+    EndRecord();
+  }
+  void drawRoundRect(const DlRoundRect& rrect) override {
+    BeginRecord(SerializedOp::kDrawRoundRect);
+    writer_.WriteRoundRect(rrect);
+    EndRecord();
+  }
+  void drawDiffRoundRect(const DlRoundRect& outer,
+                         const DlRoundRect& inner) override {
+    BeginRecord(SerializedOp::kDrawDiffRoundRect);
+    writer_.WriteRoundRect(outer);
+    writer_.WriteRoundRect(inner);
+    EndRecord();
+  }
+  void drawPath(const DlPath& path) override {
+    BeginRecord(SerializedOp::kDrawPath);
+    writer_.WritePath(path);
+    EndRecord();
+  }
+  void drawArc(const DlRect& oval_bounds,
+               DlScalar start_degrees,
+               DlScalar sweep_degrees,
+               bool use_center) override {
+    BeginRecord(SerializedOp::kDrawArc);
+    writer_.WriteRect(oval_bounds);
+    writer_.WriteScalar(start_degrees);
+    writer_.WriteScalar(sweep_degrees);
+    writer_.WriteBool(use_center);
+    EndRecord();
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const DlPoint points[]) override {
+    BeginRecord(SerializedOp::kDrawPoints);
+    writer_.WriteEnum(mode);
+    writer_.WriteUint32(count);
+    for (uint32_t i = 0; i < count; i++) {
+      writer_.WritePoint(points[i]);
+    }
+    EndRecord();
+  }
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    BeginRecord(SerializedOp::kDrawVertices);
+    writer_.WriteEnum(mode);
+    writer_.WriteEnum(vertices->mode());
+    const int count = vertices->vertex_count();
+    writer_.WriteInt32(count);
+    for (int i = 0; i < count; i++) {
+      writer_.WritePoint(ToDlPoint(vertices->vertices()[i]));
+    }
+    const SkPoint* texture_coordinates = vertices->texture_coordinates();
+    writer_.WriteBool(texture_coordinates != nullptr);
+    for (int i = 0; texture_coordinates && i < count; i++) {
+      writer_.WritePoint(ToDlPoint(texture_coordinates[i]));
+    }
+    const DlColor* colors = vertices->colors();
+    writer_.WriteBool(colors != nullptr);
+    for (int i = 0; colors && i < count; i++) {
+      writer_.WriteColor(colors[i]);
+    }
+    const int index_count = vertices->indices() ? vertices->index_count() : 0;
+    writer_.WriteBytes(vertices->indices(), index_count * sizeof(uint16_t));
+    EndRecord();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const DlPoint& point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    BeginRecord(SerializedOp::kDrawImage);
+    writer_.WriteUint32(images_.Add(image));
+    writer_.WritePoint(point);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+    EndRecord();
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    BeginRecord(SerializedOp::kDrawImageRect);
+    writer_.WriteUint32(images_.Add(image));
+    writer_.WriteRect(src);
+    writer_.WriteRect(dst);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+    writer_.WriteEnum(constraint);
+    EndRecord();
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    BeginRecord(SerializedOp::kDrawImageNine);
+    writer_.WriteUint32(images_.Add(image));
+    writer_.WriteInt32(center.GetLeft());
+    writer_.WriteInt32(center.GetTop());
+    writer_.WriteInt32(center.GetRight());
+    writer_.WriteInt32(center.GetBottom());
+    writer_.WriteRect(dst);
+    writer_.WriteEnum(filter);
+    writer_.WriteBool(render_with_attributes);
+    EndRecord();
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const DlRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override {
+    BeginRecord(SerializedOp::kDrawAtlas);
+    writer_.WriteUint32(images_.Add(atlas));
+    writer_.WriteInt32(count);
+    for (int i = 0; i < count; i++) {
+      writer_.WriteScalar(xform[i].fSCos);
+      writer_.WriteScalar(xform[i].fSSin);
+      writer_.WriteScalar(xform[i].fTx);
+      writer_.WriteScalar(xform[i].fTy);
+      writer_.WriteRect(tex[i]);
+    }
+    writer_.WriteBool(colors != nullptr);
+    for (int i = 0; colors && i < count; i++) {
+      writer_.WriteColor(colors[i]);
+    }
+    writer_.WriteEnum(mode);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(cull_rect != nullptr);
+    writer_.WriteRect(cull_rect ? *cull_rect : DlRect());
+    writer_.WriteBool(render_with_attributes);
+    EndRecord();
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    BeginRecord(SerializedOp::kDrawDisplayList);
+    writer_.WriteScalar(opacity);
+    writer_.WriteRect(display_list->GetBounds());
+    writer_.WriteBool(display_list->has_rtree());
+    // The nested DisplayList starts out with default attributes of its own,
+    // so its records are written with a receiver of their own.
+    SerializingReceiver nested(writer_, images_, typefaces_, options_, stats_);
+    nested.WriteOps(*display_list);
+    EndRecord();
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    DlScalar x,
+                    DlScalar y) override {
+    WriteTextBlob(blob, x, y);
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     DlScalar x,
+                     DlScalar y) override {
+    if (text_frame->GetRunCount() == 0u) {
+      return;
+    }
+    WriteTextBlob(MakeTextBlob(*text_frame), x, y);
+  }
+  void drawShadow(const DlPath& path,
+                  const DlColor color,
+                  const DlScalar elevation,
+                  bool transparent_occluder,
+                  DlScalar dpr) override {
+    BeginRecord(SerializedOp::kDrawShadow);
+    writer_.WritePath(path);
+    writer_.WriteColor(color);
+    writer_.WriteScalar(elevation);
+    writer_.WriteBool(transparent_occluder);
+    writer_.WriteScalar(dpr);
+    EndRecord();
+  }
+
+ private:
+  void BeginRecord(SerializedOp op) {
+    FML_DCHECK(record_size_offset_ == 0u);
+    writer_.WriteEnum(op);
+    record_size_offset_ = writer_.size();
+    writer_.WriteUint32(0);
+    stats_.op_count++;
+  }
+
+  void EndRecord() {
+    size_t payload_start = record_size_offset_ + sizeof(uint32_t);
+    writer_.PatchUint32(record_size_offset_,
+                        static_cast<uint32_t>(writer_.size() - payload_start));
+    record_size_offset_ = 0;
+  }
+
+  // Text blobs refer to their typefaces by their index in the typeface
+  // table, so that the font data is only stored once.
+  void WriteTextBlob(const sk_sp<SkTextBlob>& blob, DlScalar x, DlScalar y) {
+    SkSerialProcs procs;
+    procs.fTypefaceProc = [](SkTypeface* typeface, void* ctx) {
+      uint32_t index =
+          static_cast<TypefaceTable*>(ctx)->Add(sk_ref_sp(typeface));
+      return SkData::MakeWithCopy(&index, sizeof(index));
+    };
+    procs.fTypefaceCtx = &typefaces_;
+    sk_sp<SkData> data = blob ? blob->serialize(procs) : nullptr;
+    if (!data) {
+      stats_.unsupported_count++;
+      return;
+    }
+    BeginRecord(SerializedOp::kDrawTextBlob);
+    writer_.WriteScalar(x);
+    writer_.WriteScalar(y);
+    writer_.WriteBytes(data->data(), data->size());
+    EndRecord();
+  }
+
+  // The inverse of |MakeTextFrameFromTextBlobSkia|.
+  sk_sp<SkTextBlob> MakeTextBlob(const impeller::TextFrame& text_frame) {
+    if (!options_.skia_typeface_resolver) {
+      return nullptr;
+    }
+    SkTextBlobBuilder builder;
+    // The bounds of every run are those of the frame, so that the blob has
+    // the bounds of the frame.
+    const DlRect frame_bounds = text_frame.GetBounds();
+    const SkRect& bounds = ToSkRect(frame_bounds);
+    for (const impeller::TextRun& run : text_frame.GetRuns()) {
+      const impeller::Font& font = run.GetFont();
+      sk_sp<SkTypeface> typeface =
+          font.GetTypeface()
+              ? options_.skia_typeface_resolver(*font.GetTypeface())
+              : nullptr;
+      if (!typeface) {
+        return nullptr;
+      }
+      const impeller::Font::Metrics& metrics = font.GetMetrics();
+      SkFont sk_font(std::move(typeface), metrics.point_size, metrics.scaleX,
+                     metrics.skewX);
+      sk_font.setEmbolden(metrics.embolden);
+      sk_font.setSubpixel(font.GetAxisAlignment() !=
+                          impeller::AxisAlignment::kNone);
+
+      const auto& positions = run.GetGlyphPositions();
+      const SkTextBlobBuilder::RunBuffer& buffer =
+          builder.allocRunPos(sk_font, positions.size(), &bounds);
+      for (size_t i = 0; i < positions.size(); i++) {
+        buffer.glyphs[i] = positions[i].glyph.index;
+        buffer.points()[i] =
+            SkPoint::Make(positions[i].position.x, positions[i].position.y);
+      }
+    }
+    return builder.make();
+  }
+
+  bool CanWriteRuntimeEffect(const DlRuntimeEffect* effect) {
+    if (!effect) {
+      return false;
+    }
+    if (std::shared_ptr<impeller::RuntimeStage> stage =
+            effect->runtime_stage()) {
+      return FindRuntimeStageBackend(*stage).has_value();
+    }
+    return effect->skia_runtime_effect() != nullptr;
+  }
+
+  void WriteRuntimeEffect(
+      const DlRuntimeEffect& effect,
+      const std::vector<std::shared_ptr<DlColorSource>>& samplers,
+      const std::vector<uint8_t>* uniform_data) {
+    if (std::shared_ptr<impeller::RuntimeStage> stage =
+            effect.runtime_stage()) {
+      writer_.WriteEnum(RuntimeEffectTag::kRuntimeStage);
+      writer_.WriteEnum(FindRuntimeStageBackend(*stage).value());
+      writer_.WriteBytes(stage->GetPayload()->GetMapping(),
+                         stage->GetPayload()->GetSize());
+    } else {
+      writer_.WriteEnum(RuntimeEffectTag::kSkSL);
+      const std::string& source = effect.skia_runtime_effect()->source();
+      writer_.WriteBytes(source.data(), source.size());
+    }
+    writer_.WriteUint32(static_cast<uint32_t>(samplers.size()));
+    for (const auto& sampler : samplers) {
+      WriteColorSource(sampler.get());
+    }
+    writer_.WriteBytes(uniform_data ? uniform_data->data() : nullptr,
+                       uniform_data ? uniform_data->size() : 0u);
+  }
+
+  void WriteGradient(const DlGradientColorSourceBase* gradient) {
+    writer_.WriteUint32(gradient->stop_count());
+    for (int i = 0; i < gradient->stop_count(); i++) {
+      writer_.WriteColor(gradient->colors()[i]);
+      writer_.WriteScalar(gradient->stops()[i]);
+    }
+    writer_.WriteEnum(gradient->tile_mode());
+    writer_.WriteMatrix(gradient->matrix());
+  }
+
+  void WriteColorSource(const DlColorSource* source) {
+    if (!source) {
+      writer_.WriteEnum(ColorSourceTag::kNone);
+    } else if (auto image = source->asImage()) {
+      writer_.WriteEnum(ColorSourceTag::kImage);
+      writer_.WriteUint32(images_.Add(image->image()));
+      writer_.WriteEnum(image->horizontal_tile_mode());
+      writer_.WriteEnum(image->vertical_tile_mode());
+      writer_.WriteEnum(image->sampling());
+      writer_.WriteMatrix(image->matrix());
+    } else if (auto linear = source->asLinearGradient()) {
+      writer_.WriteEnum(ColorSourceTag::kLinearGradient);
+      writer_.WritePoint(linear->start_point());
+      writer_.WritePoint(linear->end_point());
+      WriteGradient(linear);
+    } else if (auto radial = source->asRadialGradient()) {
+      writer_.WriteEnum(ColorSourceTag::kRadialGradient);
+      writer_.WritePoint(radial->center());
+      writer_.WriteScalar(radial->radius());
+      WriteGradient(radial);
+    } else if (auto conical = source->asConicalGradient()) {
+      writer_.WriteEnum(ColorSourceTag::kConicalGradient);
+      writer_.WritePoint(conical->start_center());
+      writer_.WriteScalar(conical->start_radius());
+      writer_.WritePoint(conical->end_center());
+      writer_.WriteScalar(conical->end_radius());
+      WriteGradient(conical);
+    } else if (auto sweep = source->asSweepGradient()) {
+      writer_.WriteEnum(ColorSourceTag::kSweepGradient);
+      writer_.WritePoint(sweep->center());
+      writer_.WriteScalar(sweep->start());
+      writer_.WriteScalar(sweep->end());
+      WriteGradient(sweep);
+    } else if (auto runtime_effect = source->asRuntimeEffect();
+               runtime_effect &&
+               CanWriteRuntimeEffect(runtime_effect->runtime_effect().get())) {
+      writer_.WriteEnum(ColorSourceTag::kRuntimeEffect);
+      WriteRuntimeEffect(*runtime_effect->runtime_effect(),
+                         runtime_effect->samplers(),
+                         runtime_effect->uniform_data().get());
+    } else {
+      writer_.WriteEnum(ColorSourceTag::kNone);
+      stats_.unsupported_count++;
+    }
+  }
+
+  void WriteColorFilter(const DlColorFilter* filter) {
+    if (!filter) {
+      writer_.WriteEnum(ColorFilterTag::kNone);
+    } else if (auto blend = filter->asBlend()) {
+      writer_.WriteEnum(ColorFilterTag::kBlend);
+      writer_.WriteColor(blend->color());
+      writer_.WriteEnum(blend->mode());
+    } else if (auto matrix = filter->asMatrix()) {
+      writer_.WriteEnum(ColorFilterTag::kMatrix);
+      float values[20];
+      matrix->get_matrix(values);
+      for (float value : values) {
+        writer_.WriteScalar(value);
+      }
+    } else if (filter->type() == DlColorFilterType::kSrgbToLinearGamma) {
+      writer_.WriteEnum(ColorFilterTag::kSrgbToLinearGamma);
+    } else if (filter->type() == DlColorFilterType::kLinearToSrgbGamma) {
+      writer_.WriteEnum(ColorFilterTag::kLinearToSrgbGamma);
+    } else {
+      writer_.WriteEnum(ColorFilterTag::kNone);
+      stats_.unsupported_count++;
+    }
+  }
+
+  void WriteImageFilter(const DlImageFilter* filter) {
+    if (!filter) {
+      writer_.WriteEnum(ImageFilterTag::kNone);
+    } else if (auto blur = filter->asBlur()) {
+      writer_.WriteEnum(ImageFilterTag::kBlur);
+      writer_.WriteScalar(blur->sigma_x());
+      writer_.WriteScalar(blur->sigma_y());
+      writer_.WriteEnum(blur->tile_mode());
+    } else if (auto dilate = filter->asDilate()) {
+      writer_.WriteEnum(ImageFilterTag::kDilate);
+      writer_.WriteScalar(dilate->radius_x());
+      writer_.WriteScalar(dilate->radius_y());
+    } else if (auto erode = filter->asErode()) {
+      writer_.WriteEnum(ImageFilterTag::kErode);
+      writer_.WriteScalar(erode->radius_x());
+      writer_.WriteScalar(erode->radius_y());
+    } else if (auto matrix = filter->asMatrix()) {
+      writer_.WriteEnum(ImageFilterTag::kMatrix);
+      writer_.WriteMatrix(matrix->matrix());
+      writer_.WriteEnum(matrix->sampling());
+    } else if (auto compose = filter->asCompose()) {
+      writer_.WriteEnum(ImageFilterTag::kCompose);
+      WriteImageFilter(compose->outer().get());
+      WriteImageFilter(compose->inner().get());
+    } else if (auto color_filter = filter->asColorFilter()) {
+      writer_.WriteEnum(ImageFilterTag::kColorFilter);
+      WriteColorFilter(color_filter->color_filter().get());
+    } else if (auto local_matrix = filter->asLocalMatrix()) {
+      writer_.WriteEnum(ImageFilterTag::kLocalMatrix);
+      writer_.WriteMatrix(local_matrix->matrix());
+      WriteImageFilter(local_matrix->image_filter().get());
+    } else if (auto runtime_effect = filter->asRuntimeEffectFilter();
+               runtime_effect &&
+               CanWriteRuntimeEffect(runtime_effect->runtime_effect().get())) {
+      writer_.WriteEnum(ImageFilterTag::kRuntimeEffect);
+      WriteRuntimeEffect(*runtime_effect->runtime_effect(),
+                         runtime_effect->samplers(),
+                         runtime_effect->uniform_data().get());
+    } else {
+      writer_.WriteEnum(ImageFilterTag::kNone);
+      stats_.unsupported_count++;
+    }
+  }
+
+  SerialWriter& writer_;
+  ImageTable& images_;
+  TypefaceTable& typefaces_;
+  const DlSerializationOptions& options_;
+  DlSerializationStats& stats_;
+  size_t record_size_offset_ = 0;
+};
+
+// Replays the records of a serialized op stream onto a |DlCanvas|, tracking
+// the attributes they set in a |DlPaint|.
+class Deserializer {
+ public:
+  explicit Deserializer(const DlDeserializationOptions& options)
+      : options_(options) {}
+
+  bool ReadImageTable(SerialReader& reader, uint32_t count) {
+    for (uint32_t i = 0; i < count && reader.ok(); i++) {
+      ImageEntryType type = reader.ReadEnum(ImageEntryType::kReference);
+      int32_t width = reader.ReadInt32();
+      int32_t height = reader.ReadInt32();
+      bool opaque = reader.ReadBool();
+      if (!reader.ok() || width <= 0 || height <= 0) {
+        return false;
+      }
+      SkImageInfo info = SkImageInfo::Make(
+          width, height, kRGBA_8888_SkColorType,
+          opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+
+      sk_sp<SkImage> pixels;
+      if (type == ImageEntryType::kEmbedded) {
+        size_t length;
+        const uint8_t* bytes = reader.ReadBytes(&length);
+        if (!bytes || length != info.computeMinByteSize()) {
+          return false;
+        }
+        pixels = SkImages::RasterFromPixmapCopy(
+            SkPixmap(info, bytes, info.minRowBytes()));
+      } else {
+        // Only the size of the image was captured.
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(info)) {
+          return false;
+        }
+        bitmap.eraseColor(DlColor::kMidGrey().argb());
+        bitmap.setImmutable();
+        pixels = SkImages::RasterFromBitmap(bitmap);
+      }
+      if (!pixels) {
+        return false;
+      }
+      images_.push_back(options_.image_factory ? options_.image_factory(pixels)
+                                               : DlImage::Make(pixels));
+    }
+    return reader.ok();
+  }
+
+  bool ReadTypefaceTable(SerialReader& reader, uint32_t count) {
+    for (uint32_t i = 0; i < count && reader.ok(); i++) {
+      size_t length;
+      const uint8_t* bytes = reader.ReadBytes(&length);
+      if (!bytes) {
+        return false;
+      }
+      // A typeface that cannot be recreated leaves the text that uses it to
+      // the default typeface.
+      SkMemoryStream stream(bytes, length, /*copyData=*/false);
+      typefaces_.push_back(
+          SkTypeface::MakeDeserialize(&stream, options_.font_manager));
+    }
+    return reader.ok();
+  }
+
+  // Reads records up to and including the end record.
+  bool ReadOps(SerialReader& reader, DlCanvas& canvas) {
+    DlPaint paint;
+    while (reader.ok()) {
+      uint32_t op = reader.ReadUint32();
+      size_t size = reader.ReadUint32();
+      const uint8_t* payload = reader.Skip(size);
+      if (!payload) {
+        return false;
+      }
+      if (op == static_cast<uint32_t>(SerializedOp::kEnd)) {
+        return true;
+      }
+      SerialReader record(payload, size);
+      ReadOp(static_cast<SerializedOp>(op), record, canvas, paint);
+      if (!record.ok()) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+ private:
+  const DlPaint* AttributesIf(bool render_with_attributes,
+                              const DlPaint& paint) {
+    return render_with_attributes ? &paint : nullptr;
+  }
+
+  void ReadOp(SerializedOp op,
+              SerialReader& reader,
+              DlCanvas& canvas,
+              DlPaint& paint) {
+    switch (op) {
+      case SerializedOp::kEnd:
+        break;
+
+      case SerializedOp::kSetAntiAlias:
+        paint.setAntiAlias(reader.ReadBool());
+        break;
+      case SerializedOp::kSetDrawStyle:
+        paint.setDrawStyle(reader.ReadEnum(DlDrawStyle::kLastStyle));
+        break;
+      case SerializedOp::kSetColor:
+        paint.setColor(reader.ReadColor());
+        break;
+      case SerializedOp::kSetStrokeWidth:
+        paint.setStrokeWidth(reader.ReadScalar());
+        break;
+      case SerializedOp::kSetStrokeMiter:
+        paint.setStrokeMiter(reader.ReadScalar());
+        break;
+      case SerializedOp::kSetStrokeCap:
+        paint.setStrokeCap(reader.ReadEnum(DlStrokeCap::kLastCap));
+        break;
+      case SerializedOp::kSetStrokeJoin:
+        paint.setStrokeJoin(reader.ReadEnum(DlStrokeJoin::kLastJoin));
+        break;
+      case SerializedOp::kSetColorSource:
+        paint.setColorSource(ReadColorSource(reader, 0));
+        break;
+      case SerializedOp::kSetColorFilter:
+        paint.setColorFilter(ReadColorFilter(reader));
+        break;
+      case SerializedOp::kSetInvertColors:
+        paint.setInvertColors(reader.ReadBool());
+        break;
+      case SerializedOp::kSetBlendMode:
+        paint.setBlendMode(reader.ReadEnum(DlBlendMode::kLastMode));
+        break;
+      case SerializedOp::kSetMaskFilter:
+        paint.setMaskFilter(ReadMaskFilter(reader));
+        break;
+      case SerializedOp::kSetImageFilter:
+        paint.setImageFilter(ReadImageFilter(reader, 0));
+        break;
+
+      case SerializedOp::kSave:
+        canvas.Save();
+        break;
+      case SerializedOp::kSaveLayer: {
+        DlRect bounds = reader.ReadRect();
+        bool bounds_from_caller = reader.ReadBool();
+        bool renders_with_attributes = reader.ReadBool();
+        auto backdrop = ReadImageFilter(reader, 0);
+        bool has_backdrop_id = reader.ReadBool();
+        uint64_t id = reader.ReadUint32();
+        id |= static_cast<uint64_t>(reader.ReadUint32()) << 32;
+        std::optional<int64_t> backdrop_id;
+        if (has_backdrop_id) {
+          backdrop_id = static_cast<int64_t>(id);
+        }
+        std::optional<DlRect> layer_bounds;
+        if (bounds_from_caller) {
+          layer_bounds = bounds;
+        }
+        canvas.SaveLayer(layer_bounds,
+                         AttributesIf(renders_with_attributes, paint),
+                         backdrop.get(), backdrop_id);
+        break;
+      }
+      case SerializedOp::kRestore:
+        canvas.Restore();
+        break;
+
+      case SerializedOp::kTranslate: {
+        DlScalar tx = reader.ReadScalar();
+        DlScalar ty = reader.ReadScalar();
+        canvas.Translate(tx, ty);
+        break;
+      }
+      case SerializedOp::kScale: {
+        DlScalar sx = reader.ReadScalar();
+        DlScalar sy = reader.ReadScalar();
+        canvas.Scale(sx, sy);
+        break;
+      }
+      case SerializedOp::kRotate:
+        canvas.Rotate(reader.ReadScalar());
+        break;
+      case SerializedOp::kSkew: {
+        DlScalar sx = reader.ReadScalar();
+        DlScalar sy = reader.ReadScalar();
+        canvas.Skew(sx, sy);
+        break;
+      }
+      case SerializedOp::kTransform2DAffine: {
+        DlScalar m[6];
+        for (DlScalar& value : m) {
+          value = reader.ReadScalar();
+        }
+        canvas.Transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        break;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        DlScalar m[16];
+        for (DlScalar& value : m) {
+          value = reader.ReadScalar();
+        }
+        // clang-format off
+        canvas.TransformFullPerspective(m[0],  m[1],  m[2],  m[3],
+                                        m[4],  m[5],  m[6],  m[7],
+                                        m[8],  m[9],  m[10], m[11],
+                                        m[12], m[13], m[14], m[15]);
+        // clang-format on
+        break;
+      }
+      case SerializedOp::kTransformReset:
+        canvas.TransformReset();
+        break;
+
+      case SerializedOp::kClipRect: {
+        DlRect rect = reader.ReadRect();
+        auto clip_op = reader.ReadEnum(DlCanvas::ClipOp::kIntersect);
+        canvas.ClipRect(rect, clip_op, reader.ReadBool());
+        break;
+      }
+      case SerializedOp::kClipOval: {
+        DlRect bounds = reader.ReadRect();
+        auto clip_op = reader.ReadEnum(DlCanvas::ClipOp::kIntersect);
+        canvas.ClipOval(bounds, clip_op, reader.ReadBool());
+        break;
+      }
+      case SerializedOp::kClipRoundRect: {
+        DlRoundRect rrect = reader.ReadRoundRect();
+        auto clip_op = reader.ReadEnum(DlCanvas::ClipOp::kIntersect);
+        canvas.ClipRoundRect(rrect, clip_op, reader.ReadBool());
+        break;
+      }
+      case SerializedOp::kClipPath: {
+        DlPath path = reader.ReadPath();
+        auto clip_op = reader.ReadEnum(DlCanvas::ClipOp::kIntersect);
+        canvas.ClipPath(path, clip_op, reader.ReadBool());
+        break;
+      }
+
+      case SerializedOp::kDrawColor: {
+        DlColor color = reader.ReadColor();
+        canvas.DrawColor(color, reader.ReadEnum(DlBlendMode::kLastMode));
+        break;
+      }
+      case SerializedOp::kDrawPaint:
+        canvas.DrawPaint(paint);
+        break;
+      case SerializedOp::kDrawLine: {
+        DlPoint p0 = reader.ReadPoint();
+        DlPoint p1 = reader.ReadPoint();
+        canvas.DrawLine(p0, p1, paint);
+        break;
+      }
+      case SerializedOp::kDrawDashedLine: {
+        DlPoint p0 = reader.ReadPoint();
+        DlPoint p1 = reader.ReadPoint();
+        DlScalar on_length = reader.ReadScalar();
+        DlScalar off_length = reader.ReadScalar();
+        canvas.DrawDashedLine(p0, p1, on_length, off_length, paint);
+        break;
+      }
+      case SerializedOp::kDrawRect:
+        canvas.DrawRect(reader.ReadRect(), paint);
+        break;
+      case SerializedOp::kDrawOval:
+        canvas.DrawOval(reader.ReadRect(), paint);
+        break;
+      case SerializedOp::kDrawCircle: {
+        DlPoint center = reader.ReadPoint();
+        canvas.DrawCircle(center, reader.ReadScalar(), paint);
+        break;
+      }
+      case SerializedOp::kDrawRoundRect:
+        canvas.DrawRoundRect(reader.ReadRoundRect(), paint);
+        break;
+      case SerializedOp::kDrawDiffRoundRect: {
+        DlRoundRect outer = reader.ReadRoundRect();
+        DlRoundRect inner = reader.ReadRoundRect();
+        canvas.DrawDiffRoundRect(outer, inner, paint);
+        break;
+      }
+      case SerializedOp::kDrawPath: {
+        DlPath path = reader.ReadPath();
+        if (reader.ok()) {
+          canvas.DrawPath(path, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawArc: {
+        DlRect bounds = reader.ReadRect();
+        DlScalar start = reader.ReadScalar();
+        DlScalar sweep = reader.ReadScalar();
+        canvas.DrawArc(bounds, start, sweep, reader.ReadBool(), paint);
+        break;
+      }
+      case SerializedOp::kDrawPoints: {
+        auto mode = reader.ReadEnum(DlCanvas::PointMode::kPolygon);
+        uint32_t count = reader.ReadUint32();
+        if (count > DlOpReceiver::kMaxDrawPointsCount) {
+          reader.Fail();
+          break;
+        }
+        std::vector<DlPoint> points;
+        for (uint32_t i = 0; i < count && reader.ok(); i++) {
+          points.push_back(reader.ReadPoint());
+        }
+        if (reader.ok()) {
+          canvas.DrawPoints(mode, count, points.data(), paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawVertices: {
+        auto vertices = ReadVertices(reader);
+        if (vertices) {
+          canvas.DrawVertices(vertices, vertices_blend_mode_, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawImage: {
+        auto image = ReadImage(reader);
+        DlPoint point = reader.ReadPoint();
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool render_with_attributes = reader.ReadBool();
+        if (image) {
+          canvas.DrawImage(image, point, sampling,
+                           AttributesIf(render_with_attributes, paint));
+        }
+        break;
+      }
+      case SerializedOp::kDrawImageRect: {
+        auto image = ReadImage(reader);
+        DlRect src = reader.ReadRect();
+        DlRect dst = reader.ReadRect();
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool render_with_attributes = reader.ReadBool();
+        auto constraint =
+            reader.ReadEnum(DlCanvas::SrcRectConstraint::kFast);
+        if (image) {
+          canvas.DrawImageRect(image, src, dst, sampling,
+                               AttributesIf(render_with_attributes, paint),
+                               constraint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawImageNine: {
+        auto image = ReadImage(reader);
+        int32_t left = reader.ReadInt32();
+        int32_t top = reader.ReadInt32();
+        int32_t right = reader.ReadInt32();
+        int32_t bottom = reader.ReadInt32();
+        DlRect dst = reader.ReadRect();
+        auto filter = reader.ReadEnum(DlFilterMode::kLast);
+        bool render_with_attributes = reader.ReadBool();
+        if (image) {
+          canvas.DrawImageNine(image,
+                               DlIRect::MakeLTRB(left, top, right, bottom),
+                               dst, filter,
+                               AttributesIf(render_with_attributes, paint));
+        }
+        break;
+      }
+      case SerializedOp::kDrawAtlas: {
+        auto atlas = ReadImage(reader);
+        int32_t count = reader.ReadInt32();
+        if (count < 0) {
+          reader.Fail();
+          break;
+        }
+        std::vector<SkRSXform> xforms;
+        std::vector<DlRect> tex;
+        for (int32_t i = 0; i < count && reader.ok(); i++) {
+          DlScalar scos = reader.ReadScalar();
+          DlScalar ssin = reader.ReadScalar();
+          DlScalar tx = reader.ReadScalar();
+          DlScalar ty = reader.ReadScalar();
+          xforms.push_back(SkRSXform::Make(scos, ssin, tx, ty));
+          tex.push_back(reader.ReadRect());
+        }
+        std::vector<DlColor> colors;
+        if (reader.ReadBool()) {
+          for (int32_t i = 0; i < count && reader.ok(); i++) {
+            colors.push_back(reader.ReadColor());
+          }
+        }
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        bool has_cull_rect = reader.ReadBool();
+        DlRect cull_rect = reader.ReadRect();
+        bool render_with_attributes = reader.ReadBool();
+        if (atlas && reader.ok()) {
+          canvas.DrawAtlas(atlas, xforms.data(), tex.data(),
+                           colors.empty() ? nullptr : colors.data(), count,
+                           mode, sampling,
+                           has_cull_rect ? &cull_rect : nullptr,
+                           AttributesIf(render_with_attributes, paint));
+        }
+        break;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        DlScalar opacity = reader.ReadScalar();
+        DlRect bounds = reader.ReadRect();
+        bool has_rtree = reader.ReadBool();
+        DisplayListBuilder builder(bounds, has_rtree);
+        if (ReadOps(reader, builder)) {
+          canvas.DrawDisplayList(builder.Build(), opacity);
+        } else {
+          reader.Fail();
+        }
+        break;
+      }
+      case SerializedOp::kDrawShadow: {
+        DlPath path = reader.ReadPath();
+        DlColor color = reader.ReadColor();
+        DlScalar elevation = reader.ReadScalar();
+        bool transparent_occluder = reader.ReadBool();
+        DlScalar dpr = reader.ReadScalar();
+        if (reader.ok()) {
+          canvas.DrawShadow(path, color, elevation, transparent_occluder, dpr);
+        }
+        break;
+      }
+
+      case SerializedOp::kDrawTextBlob: {
+        DlScalar x = reader.ReadScalar();
+        DlScalar y = reader.ReadScalar();
+        sk_sp<SkTextBlob> blob = ReadTextBlob(reader);
+        if (!blob) {
+          break;
+        }
+        if (options_.text_frame_factory) {
+          if (auto text_frame = options_.text_frame_factory(blob)) {
+            canvas.DrawTextFrame(text_frame, x, y, paint);
+          }
+        } else {
+          canvas.DrawTextBlob(blob, x, y, paint);
+        }
+        break;
+      }
+
+      default:
+        // Records written by newer versions of the serializer are skipped.
+        break;
+    }
+  }
+
+  sk_sp<DlImage> ReadImage(SerialReader& reader) {
+    uint32_t index = reader.ReadUint32();
+    if (index >= images_.size()) {
+      reader.Fail();
+      return nullptr;
+    }
+    return images_[index];
+  }
+
+  sk_sp<SkTextBlob> ReadTextBlob(SerialReader& reader) {
+    size_t length;
+    const uint8_t* bytes = reader.ReadBytes(&length);
+    if (!bytes) {
+      return nullptr;
+    }
+    SkDeserialProcs procs;
+    procs.fTypefaceProc = [](const void* data, size_t length,
+                             void* ctx) -> sk_sp<SkTypeface> {
+      auto typefaces = static_cast<std::vector<sk_sp<SkTypeface>>*>(ctx);
+      uint32_t index;
+      if (length != sizeof(index)) {
+        return nullptr;
+      }
+      memcpy(&index, data, sizeof(index));
+      return index < typefaces->size() ? (*typefaces)[index] : nullptr;
+    };
+    procs.fTypefaceCtx = &typefaces_;
+    sk_sp<SkTextBlob> blob = SkTextBlob::Deserialize(bytes, length, procs);
+    if (!blob) {
+      reader.Fail();
+    }
+    return blob;
+  }
+
+  std::shared_ptr<DlVertices> ReadVertices(SerialReader& reader) {
+    vertices_blend_mode_ = reader.ReadEnum(DlBlendMode::kLastMode);
+    auto mode = reader.ReadEnum(DlVertexMode::kTriangleFan);
+    int32_t count = reader.ReadInt32();
+    if (count < 0) {
+      reader.Fail();
+      return nullptr;
+    }
+    std::vector<SkPoint> vertices;
+    for (int32_t i = 0; i < count && reader.ok(); i++) {
+      vertices.push_back(ToSkPoint(reader.ReadPoint()));
+    }
+    std::vector<SkPoint> texture_coordinates;
+    if (reader.ReadBool()) {
+      for (int32_t i = 0; i < count && reader.ok(); i++) {
+        texture_coordinates.push_back(ToSkPoint(reader.ReadPoint()));
+      }
+    }
+    std::vector<DlColor> colors;
+    if (reader.ReadBool()) {
+      for (int32_t i = 0; i < count && reader.ok(); i++) {
+        colors.push_back(reader.ReadColor());
+      }
+    }
+    size_t index_bytes;
+    const uint8_t* index_data = reader.ReadBytes(&index_bytes);
+    if (!reader.ok()) {
+      return nullptr;
+    }
+    std::vector<uint16_t> indices(index_bytes / sizeof(uint16_t));
+    memcpy(indices.data(), index_data, indices.size() * sizeof(uint16_t));
+    return DlVertices::Make(
+        mode, count, vertices.data(),
+        texture_coordinates.empty() ? nullptr : texture_coordinates.data(),
+        colors.empty() ? nullptr : colors.data(), indices.size(),
+        indices.empty() ? nullptr : indices.data());
+  }
+
+  std::shared_ptr<const DlColorSource> ReadColorSource(SerialReader& reader,
+                                                       int depth) {
+    if (depth > kMaxColorSourceDepth) {
+      reader.Fail();
+      return nullptr;
+    }
+    switch (reader.ReadEnum(ColorSourceTag::kRuntimeEffect)) {
+      case ColorSourceTag::kNone:
+        return nullptr;
+      case ColorSourceTag::kImage: {
+        auto image = ReadImage(reader);
+        auto horizontal_tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+        auto vertical_tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+        auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        DlMatrix matrix = reader.ReadMatrix();
+        if (!image) {
+          return nullptr;
+        }
+        return DlColorSource::MakeImage(image, horizontal_tile_mode,
+                                        vertical_tile_mode, sampling, &matrix);
+      }
+      case ColorSourceTag::kLinearGradient: {
+        DlPoint start = reader.ReadPoint();
+        DlPoint end = reader.ReadPoint();
+        Gradient gradient = ReadGradient(reader);
+        if (!reader.ok()) {
+          return nullptr;
+        }
+        return DlColorSource::MakeLinear(
+            start, end, gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      }
+      case ColorSourceTag::kRadialGradient: {
+        DlPoint center = reader.ReadPoint();
+        DlScalar radius = reader.ReadScalar();
+        Gradient gradient = ReadGradient(reader);
+        if (!reader.ok()) {
+          return nullptr;
+        }
+        return DlColorSource::MakeRadial(
+            center, radius, gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      }
+      case ColorSourceTag::kConicalGradient: {
+        DlPoint start_center = reader.ReadPoint();
+        DlScalar start_radius = reader.ReadScalar();
+        DlPoint end_center = reader.ReadPoint();
+        DlScalar end_radius = reader.ReadScalar();
+        Gradient gradient = ReadGradient(reader);
+        if (!reader.ok()) {
+          return nullptr;
+        }
+        return DlColorSource::MakeConical(
+            start_center, start_radius, end_center, end_radius,
+            gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      }
+      case ColorSourceTag::kSweepGradient: {
+        DlPoint center = reader.ReadPoint();
+        DlScalar start = reader.ReadScalar();
+        DlScalar end = reader.ReadScalar();
+        Gradient gradient = ReadGradient(reader);
+        if (!reader.ok()) {
+          return nullptr;
+        }
+        return DlColorSource::MakeSweep(
+            center, start, end, gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      }
+      case ColorSourceTag::kRuntimeEffect: {
+        RuntimeEffect effect = ReadRuntimeEffect(reader, depth);
+        if (!effect.effect) {
+          return nullptr;
+        }
+        return DlColorSource::MakeRuntimeEffect(
+            effect.effect, std::move(effect.samplers),
+            std::move(effect.uniform_data));
+      }
+    }
+    return nullptr;
+  }
+
+  struct RuntimeEffect {
+    sk_sp<DlRuntimeEffect> effect;
+    std::vector<std::shared_ptr<DlColorSource>> samplers;
+    std::shared_ptr<std::vector<uint8_t>> uniform_data;
+  };
+
+  // Reads a runtime effect along with its samplers and uniforms. The effect
+  // is null if its shader cannot be created for the requested backend.
+  RuntimeEffect ReadRuntimeEffect(SerialReader& reader, int depth) {
+    RuntimeEffect result;
+    switch (reader.ReadEnum(RuntimeEffectTag::kRuntimeStage)) {
+      case RuntimeEffectTag::kSkSL: {
+        size_t length;
+        const uint8_t* bytes = reader.ReadBytes(&length);
+        if (bytes) {
+          result.effect = MakeSkSLRuntimeEffect(
+              std::string(reinterpret_cast<const char*>(bytes), length));
+        }
+        break;
+      }
+      case RuntimeEffectTag::kRuntimeStage: {
+        auto backend =
+            reader.ReadEnum(impeller::RuntimeStageBackend::kVulkan);
+        size_t length;
+        const uint8_t* bytes = reader.ReadBytes(&length);
+        if (bytes) {
+          result.effect = MakeRuntimeStageEffect(
+              std::make_shared<fml::DataMapping>(
+                  std::vector<uint8_t>(bytes, bytes + length)),
+              options_.runtime_stage_backend.value_or(backend));
+        }
+        break;
+      }
+    }
+    uint32_t sampler_count = reader.ReadUint32();
+    for (uint32_t i = 0; i < sampler_count && reader.ok(); i++) {
+      std::shared_ptr<const DlColorSource> sampler =
+          ReadColorSource(reader, depth + 1);
+      result.samplers.push_back(
+          sampler ? std::const_pointer_cast<DlColorSource>(sampler)
+                  : nullptr);
+    }
+    size_t uniform_length;
+    const uint8_t* uniform_bytes = reader.ReadBytes(&uniform_length);
+    if (uniform_bytes) {
+      result.uniform_data = std::make_shared<std::vector<uint8_t>>(
+          uniform_bytes, uniform_bytes + uniform_length);
+    }
+    if (!reader.ok()) {
+      result.effect = nullptr;
+    }
+    return result;
+  }
+
+  static sk_sp<DlRuntimeEffect> MakeSkSLRuntimeEffect(
+      const std::string& source) {
+    SkRuntimeEffect::Result result =
+        SkRuntimeEffect::MakeForShader(SkString(source));
+    if (!result.effect) {
+      FML_LOG(ERROR) << "Could not create a serialized runtime effect: "
+                     << result.errorText.c_str();
+      return nullptr;
+    }
+    return DlRuntimeEffect::MakeSkia(result.effect);
+  }
+
+  static sk_sp<DlRuntimeEffect> MakeRuntimeStageEffect(
+      const std::shared_ptr<fml::Mapping>& payload,
+      impeller::RuntimeStageBackend backend) {
+    impeller::RuntimeStage::Map stages =
+        impeller::RuntimeStage::DecodeRuntimeStages(payload);
+    auto stage = stages.find(backend);
+    if (stage == stages.end() || !stage->second ||
+        !stage->second->IsValid()) {
+      return nullptr;
+    }
+    if (backend == impeller::RuntimeStageBackend::kSkSL) {
+      const std::shared_ptr<fml::Mapping>& code =
+          stage->second->GetCodeMapping();
+      return MakeSkSLRuntimeEffect(
+          std::string(reinterpret_cast<const char*>(code->GetMapping()),
+                      code->GetSize()));
+    }
+    return DlRuntimeEffect::MakeImpeller(stage->second);
+  }
+
+  struct Gradient {
+    std::vector<DlColor> colors;
+    std::vector<float> stops;
+    DlTileMode tile_mode = DlTileMode::kClamp;
+    DlMatrix matrix;
+  };
+
+  Gradient ReadGradient(SerialReader& reader) {
+    Gradient gradient;
+    uint32_t stop_count = reader.ReadUint32();
+    for (uint32_t i = 0; i < stop_count && reader.ok(); i++) {
+      gradient.colors.push_back(reader.ReadColor());
+      gradient.stops.push_back(reader.ReadScalar());
+    }
+    gradient.tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+    gradient.matrix = reader.ReadMatrix();
+    return gradient;
+  }
+
+  std::shared_ptr<const DlColorFilter> ReadColorFilter(SerialReader& reader) {
+    switch (reader.ReadEnum(ColorFilterTag::kLinearToSrgbGamma)) {
+      case ColorFilterTag::kNone:
+        return nullptr;
+      case ColorFilterTag::kBlend: {
+        DlColor color = reader.ReadColor();
+        auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        return DlColorFilter::MakeBlend(color, mode);
+      }
+      case ColorFilterTag::kMatrix: {
+        float matrix[20];
+        for (float& value : matrix) {
+          value = reader.ReadScalar();
+        }
+        return DlColorFilter::MakeMatrix(matrix);
+      }
+      case ColorFilterTag::kSrgbToLinearGamma:
+        return DlColorFilter::MakeSrgbToLinearGamma();
+      case ColorFilterTag::kLinearToSrgbGamma:
+        return DlColorFilter::MakeLinearToSrgbGamma();
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<DlImageFilter> ReadImageFilter(SerialReader& reader,
+                                                 int depth) {
+    if (depth > kMaxImageFilterDepth) {
+      reader.Fail();
+      return nullptr;
+    }
+    switch (reader.ReadEnum(ImageFilterTag::kRuntimeEffect)) {
+      case ImageFilterTag::kNone:
+        return nullptr;
+      case ImageFilterTag::kBlur: {
+        DlScalar sigma_x = reader.ReadScalar();
+        DlScalar sigma_y = reader.ReadScalar();
+        return DlImageFilter::MakeBlur(sigma_x, sigma_y,
+                                       reader.ReadEnum(DlTileMode::kDecal));
+      }
+      case ImageFilterTag::kDilate: {
+        DlScalar radius_x = reader.ReadScalar();
+        return DlImageFilter::MakeDilate(radius_x, reader.ReadScalar());
+      }
+      case ImageFilterTag::kErode: {
+        DlScalar radius_x = reader.ReadScalar();
+        return DlImageFilter::MakeErode(radius_x, reader.ReadScalar());
+      }
+      case ImageFilterTag::kMatrix: {
+        DlMatrix matrix = reader.ReadMatrix();
+        return DlImageFilter::MakeMatrix(
+            matrix, reader.ReadEnum(DlImageSampling::kCubic));
+      }
+      case ImageFilterTag::kCompose: {
+        auto outer = ReadImageFilter(reader, depth + 1);
+        auto inner = ReadImageFilter(reader, depth + 1);
+        return DlImageFilter::MakeCompose(outer, inner);
+      }
+      case ImageFilterTag::kColorFilter:
+        return DlImageFilter::MakeColorFilter(ReadColorFilter(reader));
+      case ImageFilterTag::kLocalMatrix: {
+        DlMatrix matrix = reader.ReadMatrix();
+        auto filter = ReadImageFilter(reader, depth + 1);
+        if (!filter) {
+          return nullptr;
+        }
+        return filter->makeWithLocalMatrix(matrix);
+      }
+      case ImageFilterTag::kRuntimeEffect: {
+        RuntimeEffect effect = ReadRuntimeEffect(reader, 0);
+        if (!effect.effect) {
+          return nullptr;
+        }
+        return DlImageFilter::MakeRuntimeEffect(effect.effect,
+                                                std::move(effect.samplers),
+                                                std::move(effect.uniform_data));
+      }
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<DlMaskFilter> ReadMaskFilter(SerialReader& reader) {
+    switch (reader.ReadEnum(MaskFilterTag::kBlur)) {
+      case MaskFilterTag::kNone:
+        return nullptr;
+      case MaskFilterTag::kBlur: {
+        auto style = reader.ReadEnum(DlBlurStyle::kInner);
+        DlScalar sigma = reader.ReadScalar();
+        return DlBlurMaskFilter::Make(style, sigma, reader.ReadBool());
+      }
+    }
+    return nullptr;
+  }
+
+  const DlDeserializationOptions& options_;
+  std::vector<sk_sp<DlImage>> images_;
+  std::vector<sk_sp<SkTypeface>> typefaces_;
+  DlBlendMode vertices_blend_mode_ = DlBlendMode::kModulate;
+};
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> SerializeDisplayList(
+    const sk_sp<DisplayList>& display_list,
+    const DlSerializationOptions& options,
+    DlSerializationStats* stats) {
+  if (!display_list) {
+    return nullptr;
+  }
+  DlSerializationStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+  *stats = {};
+
+  SerialWriter ops;
+  ImageTable images;
+  TypefaceTable typefaces;
+  SerializingReceiver(ops, images, typefaces, options, *stats)
+      .WriteOps(*display_list);
+
+  SerialWriter image_table;
+  for (const auto& image : images.images()) {
+    WriteImage(image_table, *image, options, *stats);
+  }
+  SerialWriter typeface_table;
+  for (const auto& typeface : typefaces.typefaces()) {
+    WriteTypeface(typeface_table, typeface.get());
+  }
+  stats->typeface_count = typefaces.typefaces().size();
+
+  SerialWriter header;
+  header.WriteUint32(kDlSerializationMagic);
+  header.WriteUint32(kDlSerializationVersion);
+  header.WriteUint32(kByteOrderMarker);
+  header.WriteUint32(display_list->has_rtree() ? kHasRTreeFlag : 0u);
+  header.WriteRect(display_list->GetBounds());
+  header.WriteUint32(static_cast<uint32_t>(images.images().size()));
+  header.WriteUint32(static_cast<uint32_t>(typefaces.typefaces().size()));
+  // The offsets of the image table, the typeface table and the op stream,
+  // which directly follow the header.
+  const size_t header_size = header.size() + 3 * sizeof(uint32_t);
+  const size_t typeface_table_offset = header_size + image_table.size();
+  header.WriteUint32(static_cast<uint32_t>(header_size));
+  header.WriteUint32(static_cast<uint32_t>(typeface_table_offset));
+  header.WriteUint32(
+      static_cast<uint32_t>(typeface_table_offset + typeface_table.size()));
+
+  std::vector<uint8_t> data = header.TakeData();
+  std::vector<uint8_t> image_data = image_table.TakeData();
+  std::vector<uint8_t> typeface_data = typeface_table.TakeData();
+  std::vector<uint8_t> op_data = ops.TakeData();
+  data.reserve(data.size() + image_data.size() + typeface_data.size() +
+               op_data.size());
+  data.insert(data.end(), image_data.begin(), image_data.end());
+  data.insert(data.end(), typeface_data.begin(), typeface_data.end());
+  data.insert(data.end(), op_data.begin(), op_data.end());
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+sk_sp<DisplayList> DeserializeDisplayList(
+    const uint8_t* data,
+    size_t size,
+    const DlDeserializationOptions& options) {
+  if (!data) {
+    return nullptr;
+  }
+  SerialReader header(data, size);
+  uint32_t magic = header.ReadUint32();
+  uint32_t version = header.ReadUint32();
+  uint32_t byte_order = header.ReadUint32();
+  uint32_t flags = header.ReadUint32();
+  DlRect bounds = header.ReadRect();
+  uint32_t image_count = header.ReadUint32();
+  uint32_t typeface_count = header.ReadUint32();
+  uint32_t image_table_offset = header.ReadUint32();
+  uint32_t typeface_table_offset = header.ReadUint32();
+  uint32_t op_stream_offset = header.ReadUint32();
+  if (!header.ok() || magic != kDlSerializationMagic) {
+    FML_LOG(ERROR) << "Data is not a serialized DisplayList.";
+    return nullptr;
+  }
+  if (version != kDlSerializationVersion || byte_order != kByteOrderMarker) {
+    FML_LOG(ERROR) << "Unsupported serialized DisplayList version " << version
+                   << ".";
+    return nullptr;
+  }
+  if (image_table_offset > typeface_table_offset ||
+      typeface_table_offset > op_stream_offset || op_stream_offset > size) {
+    FML_LOG(ERROR) << "Serialized DisplayList is truncated.";
+    return nullptr;
+  }
+
+  Deserializer deserializer(options);
+  SerialReader image_table(data + image_table_offset,
+                           typeface_table_offset - image_table_offset);
+  SerialReader typeface_table(data + typeface_table_offset,
+                              op_stream_offset - typeface_table_offset);
+  SerialReader ops(data + op_stream_offset, size - op_stream_offset);
+  DisplayListBuilder builder(bounds, (flags & kHasRTreeFlag) != 0);
+  if (!deserializer.ReadImageTable(image_table, image_count) ||
+      !deserializer.ReadTypefaceTable(typeface_table, typeface_count) ||
+      !deserializer.ReadOps(ops, builder)) {
+    FML_LOG(ERROR) << "Serialized DisplayList is malformed.";
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
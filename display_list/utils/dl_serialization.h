@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/impeller/core/runtime_types.h"
+#include "flutter/impeller/typographer/text_frame.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+class GrDirectContext;
+class SkImage;
+
+// This file contains a versioned binary format for DisplayLists that is used
+// to capture the frames of a running application and replay them offline,
+// for instance to compare the CPU cost of the rendering backends on the
+// exact same content.
+//
+// The format is designed to be read in place from a memory mapped file:
+//
+//   header:         magic, version, byte order marker, flags, bounds and the
+//                   offsets of the sections below, all 32-bit values.
+//   image table:    one entry per distinct image. Entries either embed the
+//                   premultiplied RGBA pixels of the image or only describe
+//                   its size, in which case a placeholder is used on replay.
+//   typeface table: one entry per distinct typeface drawn by text, with the
+//                   font data embedded.
+//   op stream:      a sequence of 4-byte aligned records, each consisting of
+//                   an op code, the size of its payload and the payload,
+//                   terminated by an end record. Nested DisplayLists are
+//                   stored inline as an op stream of their own.
+//
+// Text is stored as serialized SkTextBlobs that refer to the typeface table,
+// whether it was drawn as a text blob or as an Impeller text frame. Runtime
+// effects are stored with their shader source or the runtime stages they
+// were loaded from.
+//
+// Readers skip records with unknown op codes so that new operations can be
+// added without bumping the version. Changes to the layout of existing
+// records must bump |kDlSerializationVersion|.
+
+namespace flutter {
+
+static constexpr uint32_t kDlSerializationMagic = 0x4C444C46;  // "FLDL"
+static constexpr uint32_t kDlSerializationVersion = 2;
+
+struct DlSerializationOptions {
+  // Whether the pixels of images are stored in the serialized data. If false,
+  // or if the pixels of an image cannot be read, only the size of the image
+  // is stored.
+  bool embed_images = true;
+
+  // The context used to read back the pixels of texture backed images, may
+  // be null.
+  GrDirectContext* gr_context = nullptr;
+
+  // Returns the Skia typeface of a typeface that text frames are drawn with,
+  // which is needed to store their glyphs. Text frames are dropped if this
+  // is not specified or returns null.
+  std::function<sk_sp<SkTypeface>(const impeller::Typeface& typeface)>
+      skia_typeface_resolver;
+};
+
+struct DlSerializationStats {
+  // The number of records written, including those of nested DisplayLists.
+  size_t op_count = 0;
+  size_t embedded_image_count = 0;
+  size_t referenced_image_count = 0;
+  size_t typeface_count = 0;
+  // The number of operations and attributes that could not be serialized and
+  // were dropped, such as text frames whose typeface could not be resolved
+  // and runtime effects without a shader source.
+  size_t unsupported_count = 0;
+};
+
+struct DlDeserializationOptions {
+  // Creates the images drawn by the deserialized DisplayList from the pixels
+  // of the image table, for instance to upload them for a specific rendering
+  // backend. Images are wrapped with |DlImage::Make| if not specified.
+  std::function<sk_sp<DlImage>(const sk_sp<SkImage>& pixels)> image_factory;
+
+  // Recreates the typefaces of the text from their embedded font data. Text
+  // is drawn with a default typeface if not specified.
+  sk_sp<SkFontMgr> font_manager;
+
+  // Creates the text frames that text is drawn with, for instance for
+  // Impeller. Text is drawn as text blobs if not specified.
+  std::function<std::shared_ptr<impeller::TextFrame>(
+      const sk_sp<SkTextBlob>& blob)>
+      text_frame_factory;
+
+  // The backend whose runtime stage is used by the runtime effects that were
+  // loaded from runtime stages. |kSkSL| creates Skia runtime effects.
+  // Defaults to the backend the effects were captured with.
+  std::optional<impeller::RuntimeStageBackend> runtime_stage_backend;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes the DisplayList into the binary capture format
+///             described above.
+///
+/// @param[in]  display_list  The DisplayList to serialize.
+/// @param[in]  options       The options that control how images are stored.
+/// @param[out] stats         If not null, filled in with the statistics of
+///                           the serialization.
+///
+/// @return     The serialized data or null if the DisplayList is null.
+///
+std::unique_ptr<fml::Mapping> SerializeDisplayList(
+    const sk_sp<DisplayList>& display_list,
+    const DlSerializationOptions& options = {},
+    DlSerializationStats* stats = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      Recreates a DisplayList from the data written by
+///             |SerializeDisplayList|. The data is only read during the call
+///             and may be a memory mapped file.
+///
+/// @return     The DisplayList or null if the data is malformed or was
+///             written by an incompatible version.
+///
+sk_sp<DisplayList> DeserializeDisplayList(
+    const uint8_t* data,
+    size_t size,
+    const DlDeserializationOptions& options = {});
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
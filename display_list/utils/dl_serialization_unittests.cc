@@ -0,0 +1,337 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_serialization.h"
+
+#include <cstring>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/impeller/typographer/backends/skia/text_frame_skia.h"
+#include "flutter/impeller/typographer/backends/skia/typeface_skia.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/effects/SkRuntimeEffect.h"
+#include "txt/platform.h"
+
+namespace flutter {
+
+// Defined in display_list_unittests.cc.
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+namespace {
+
+constexpr int kRenderSize = 150;
+
+SkBitmap Render(const sk_sp<DisplayList>& display_list) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kRenderSize, kRenderSize);
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+  SkCanvas canvas(bitmap);
+  DlSkCanvasAdapter(&canvas).DrawDisplayList(display_list);
+  return bitmap;
+}
+
+bool RendersIdentically(const sk_sp<DisplayList>& a,
+                        const sk_sp<DisplayList>& b) {
+  SkBitmap bitmap_a = Render(a);
+  SkBitmap bitmap_b = Render(b);
+  for (int y = 0; y < kRenderSize; y++) {
+    if (memcmp(bitmap_a.getAddr32(0, y), bitmap_b.getAddr32(0, y),
+               kRenderSize * sizeof(uint32_t)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+sk_sp<DisplayList> RoundTrip(const sk_sp<DisplayList>& display_list,
+                             const DlSerializationOptions& options = {},
+                             DlSerializationStats* stats = nullptr) {
+  auto data = SerializeDisplayList(display_list, options, stats);
+  if (!data) {
+    return nullptr;
+  }
+  DlDeserializationOptions deserialization_options;
+  deserialization_options.font_manager = txt::GetDefaultFontManager();
+  return DeserializeDisplayList(data->GetMapping(), data->GetSize(),
+                                deserialization_options);
+}
+
+// Collects the ops that the Skia backend cannot render for comparison.
+class OpCollector : public virtual DlOpReceiver,
+                    public IgnoreAttributeDispatchHelper,
+                    public IgnoreClipDispatchHelper,
+                    public IgnoreTransformDispatchHelper,
+                    public IgnoreDrawDispatchHelper {
+ public:
+  void setImageFilter(const DlImageFilter* filter) override {
+    image_filters.push_back(filter ? filter->shared() : nullptr);
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     DlScalar x,
+                     DlScalar y) override {
+    text_frames.push_back(text_frame);
+  }
+
+  std::vector<std::shared_ptr<DlImageFilter>> image_filters;
+  std::vector<std::shared_ptr<impeller::TextFrame>> text_frames;
+};
+
+sk_sp<DlRuntimeEffect> MakeTestRuntimeEffect() {
+  auto result = SkRuntimeEffect::MakeForShader(SkString(R"(
+    uniform half4 color;
+    half4 main(float2 coord) { return color; }
+  )"));
+  FML_CHECK(result.effect) << result.errorText.c_str();
+  return DlRuntimeEffect::MakeSkia(result.effect);
+}
+
+std::shared_ptr<std::vector<uint8_t>> MakeTestUniforms() {
+  const float color[] = {0.0f, 0.5f, 1.0f, 1.0f};
+  return std::make_shared<std::vector<uint8_t>>(
+      reinterpret_cast<const uint8_t*>(color),
+      reinterpret_cast<const uint8_t*>(color) + sizeof(color));
+}
+
+}  // namespace
+
+TEST(DisplayListSerialization, AllOpsRoundTrip) {
+  for (auto& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListBuilder builder;
+      group.variants[i].Invoke(DisplayListBuilderTestingAccessor(builder));
+      // Draw something so that attribute changes affect the result.
+      builder.DrawRect(DlRect::MakeLTRB(20, 20, 80, 80), DlPaint());
+      auto display_list = builder.Build();
+
+      DlSerializationStats stats;
+      auto result = RoundTrip(display_list, {}, &stats);
+      ASSERT_NE(result, nullptr) << group.op_name << " variant " << i;
+      if (stats.unsupported_count > 0) {
+        // Text frames without a typeface resolver and runtime effects whose
+        // shaders cannot be recovered are dropped.
+        continue;
+      }
+      EXPECT_TRUE(RendersIdentically(display_list, result))
+          << group.op_name << " variant " << i;
+    }
+  }
+}
+
+TEST(DisplayListSerialization, KeepsBoundsAndRTree) {
+  DisplayListBuilder builder(DlRect::MakeWH(100, 100), /*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  builder.DrawOval(DlRect::MakeLTRB(50, 50, 90, 70), DlPaint());
+  auto display_list = builder.Build();
+
+  auto result = RoundTrip(display_list);
+  ASSERT_NE(result, nullptr);
+  EXPECT_TRUE(result->has_rtree());
+  EXPECT_EQ(result->GetBounds(), display_list->GetBounds());
+  EXPECT_EQ(result->op_count(), display_list->op_count());
+}
+
+TEST(DisplayListSerialization, NestedDisplayListsRoundTrip) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawCircle(DlPoint(30, 30), 20,
+                            DlPaint(DlColor::kBlue()).setAntiAlias(true));
+  auto nested = nested_builder.Build();
+
+  DisplayListBuilder builder;
+  builder.DrawPaint(DlPaint(DlColor::kYellow()));
+  builder.Translate(40, 40);
+  builder.DrawDisplayList(nested, 0.5f);
+  builder.Translate(20, 20);
+  builder.DrawDisplayList(nested);
+  auto display_list = builder.Build();
+
+  DlSerializationStats stats;
+  auto result = RoundTrip(display_list, {}, &stats);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(result->op_count(/*nested=*/true),
+            display_list->op_count(/*nested=*/true));
+  EXPECT_TRUE(RendersIdentically(display_list, result));
+}
+
+TEST(DisplayListSerialization, ImagesAreStoredOnce) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(16, 8);
+  bitmap.eraseColor(SK_ColorGREEN);
+  auto image = DlImage::Make(SkImages::RasterFromBitmap(bitmap));
+
+  DisplayListBuilder builder;
+  builder.DrawImage(image, DlPoint(0, 0), DlImageSampling::kNearestNeighbor);
+  builder.DrawImage(image, DlPoint(50, 0), DlImageSampling::kLinear);
+  auto display_list = builder.Build();
+
+  DlSerializationStats stats;
+  auto result = RoundTrip(display_list, {}, &stats);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(stats.embedded_image_count, 1u);
+  EXPECT_EQ(stats.referenced_image_count, 0u);
+  EXPECT_TRUE(RendersIdentically(display_list, result));
+}
+
+TEST(DisplayListSerialization, ReferencedImagesArePlaceholders) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(16, 8);
+  bitmap.eraseColor(SK_ColorGREEN);
+  auto image = DlImage::Make(SkImages::RasterFromBitmap(bitmap));
+
+  DisplayListBuilder builder;
+  builder.DrawImage(image, DlPoint(0, 0), DlImageSampling::kNearestNeighbor);
+  auto display_list = builder.Build();
+
+  DlSerializationOptions options;
+  options.embed_images = false;
+  DlSerializationStats stats;
+  auto data = SerializeDisplayList(display_list, options, &stats);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(stats.embedded_image_count, 0u);
+  EXPECT_EQ(stats.referenced_image_count, 1u);
+
+  std::vector<SkISize> image_sizes;
+  DlDeserializationOptions deserialization_options;
+  deserialization_options.image_factory =
+      [&image_sizes](const sk_sp<SkImage>& pixels) {
+        image_sizes.push_back(pixels->dimensions());
+        return DlImage::Make(pixels);
+      };
+  auto result = DeserializeDisplayList(data->GetMapping(), data->GetSize(),
+                                       deserialization_options);
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(image_sizes.size(), 1u);
+  EXPECT_EQ(image_sizes[0], SkISize::Make(16, 8));
+}
+
+TEST(DisplayListSerialization, TextBlobsStoreTypefacesOnce) {
+  DisplayListBuilder builder;
+  builder.DrawTextBlob(GetTestTextBlob(1), 10, 40, DlPaint(DlColor::kBlue()));
+  builder.DrawTextBlob(GetTestTextBlob(2), 10, 90, DlPaint(DlColor::kRed()));
+  auto display_list = builder.Build();
+
+  DlSerializationStats stats;
+  auto result = RoundTrip(display_list, {}, &stats);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(stats.typeface_count, 1u);
+  EXPECT_EQ(stats.unsupported_count, 0u);
+  EXPECT_EQ(result->op_count(), display_list->op_count());
+  EXPECT_TRUE(RendersIdentically(display_list, result));
+}
+
+TEST(DisplayListSerialization, TextFramesRoundTrip) {
+  auto blob = GetTestTextBlob(1);
+  DisplayListBuilder builder;
+  builder.DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob), 10, 40,
+                        DlPaint());
+  auto display_list = builder.Build();
+
+  // Without a resolver the typefaces of the frame cannot be recorded.
+  DlSerializationStats stats;
+  ASSERT_NE(SerializeDisplayList(display_list, {}, &stats), nullptr);
+  EXPECT_EQ(stats.unsupported_count, 1u);
+
+  DlSerializationOptions options;
+  options.skia_typeface_resolver = [](const impeller::Typeface& typeface) {
+    return impeller::TypefaceSkia::Cast(typeface).GetSkiaTypeface();
+  };
+  stats = {};
+  auto data = SerializeDisplayList(display_list, options, &stats);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(stats.unsupported_count, 0u);
+  EXPECT_EQ(stats.typeface_count, 1u);
+
+  DlDeserializationOptions deserialization_options;
+  deserialization_options.font_manager = txt::GetDefaultFontManager();
+  deserialization_options.text_frame_factory =
+      impeller::MakeTextFrameFromTextBlobSkia;
+  auto result = DeserializeDisplayList(data->GetMapping(), data->GetSize(),
+                                       deserialization_options);
+  ASSERT_NE(result, nullptr);
+
+  OpCollector collector;
+  result->Dispatch(collector);
+  ASSERT_EQ(collector.text_frames.size(), 1u);
+  auto expected = impeller::MakeTextFrameFromTextBlobSkia(blob);
+  const auto& frame = collector.text_frames[0];
+  ASSERT_EQ(frame->GetRunCount(), expected->GetRunCount());
+  const auto& run = frame->GetRuns()[0];
+  const auto& expected_run = expected->GetRuns()[0];
+  EXPECT_EQ(run.GetFont().GetMetrics(), expected_run.GetFont().GetMetrics());
+  ASSERT_EQ(run.GetGlyphCount(), expected_run.GetGlyphCount());
+  for (size_t i = 0; i < run.GetGlyphCount(); i++) {
+    EXPECT_EQ(run.GetGlyphPositions()[i].glyph.index,
+              expected_run.GetGlyphPositions()[i].glyph.index);
+    EXPECT_EQ(run.GetGlyphPositions()[i].position,
+              expected_run.GetGlyphPositions()[i].position);
+  }
+}
+
+TEST(DisplayListSerialization, RuntimeEffectsRoundTrip) {
+  auto effect = MakeTestRuntimeEffect();
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 60, 60),
+                   DlPaint().setColorSource(DlColorSource::MakeRuntimeEffect(
+                       effect, {}, MakeTestUniforms())));
+  DlPaint layer_paint;
+  layer_paint.setImageFilter(
+      DlImageFilter::MakeRuntimeEffect(effect, {nullptr}, MakeTestUniforms()));
+  builder.SaveLayer(std::nullopt, &layer_paint);
+  builder.DrawRect(DlRect::MakeLTRB(70, 70, 120, 120), DlPaint());
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DlSerializationStats stats;
+  auto result = RoundTrip(display_list, {}, &stats);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(stats.unsupported_count, 0u);
+  EXPECT_TRUE(RendersIdentically(display_list, result));
+
+  // Skia does not render runtime effect image filters, so compare the
+  // recovered filter instead.
+  OpCollector collector;
+  result->Dispatch(collector);
+  ASSERT_EQ(collector.image_filters.size(), 1u);
+  auto filter = collector.image_filters[0]->asRuntimeEffectFilter();
+  ASSERT_NE(filter, nullptr);
+  EXPECT_EQ(filter->runtime_effect()->skia_runtime_effect()->source(),
+            effect->skia_runtime_effect()->source());
+  EXPECT_EQ(filter->samplers().size(), 1u);
+  EXPECT_EQ(*filter->uniform_data(), *MakeTestUniforms());
+}
+
+TEST(DisplayListSerialization, RejectsMalformedData) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto data = SerializeDisplayList(builder.Build());
+  ASSERT_NE(data, nullptr);
+  std::vector<uint8_t> bytes(data->GetMapping(),
+                             data->GetMapping() + data->GetSize());
+  ASSERT_NE(DeserializeDisplayList(bytes.data(), bytes.size()), nullptr);
+
+  // Truncated.
+  EXPECT_EQ(DeserializeDisplayList(bytes.data(), bytes.size() - 4), nullptr);
+  EXPECT_EQ(DeserializeDisplayList(bytes.data(), 8), nullptr);
+
+  // Written by a different version.
+  std::vector<uint8_t> other_version = bytes;
+  uint32_t version = kDlSerializationVersion + 1;
+  memcpy(other_version.data() + sizeof(uint32_t), &version, sizeof(version));
+  EXPECT_EQ(DeserializeDisplayList(other_version.data(), other_version.size()),
+            nullptr);
+
+  // Not a serialized DisplayList.
+  std::vector<uint8_t> garbage(bytes.size(), 0xAB);
+  EXPECT_EQ(DeserializeDisplayList(garbage.data(), garbage.size()), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
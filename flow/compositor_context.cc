@@ -9,6 +9,10 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
+#ifdef IMPELLER_SUPPORTS_RENDERING
+#include "impeller/display_list/aiks_context.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 std::optional<DlRect> FrameDamage::ComputeClipRect(
@@ -20,7 +24,10 @@ std::optional<DlRect> FrameDamage::ComputeClipRect(
     DiffContext context(layer_tree.frame_size(), layer_tree.paint_region_map(),
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
-                        has_raster_cache, impeller_enabled);
+                        has_raster_cache, impeller_enabled,
+                        prev_layer_tree_
+                            ? &prev_layer_tree_->original_layer_id_map()
+                            : nullptr);
     context.PushCullRect(DlRect::MakeSize(layer_tree.frame_size()));
     {
       DiffContext::AutoSubtreeRestore subtree(&context);
@@ -39,6 +46,9 @@ std::optional<DlRect> FrameDamage::ComputeClipRect(
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
                               vertical_clip_alignment_);
+    if (partial_repaint_disabled_) {
+      return std::nullopt;
+    }
     return DlRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
@@ -68,6 +78,13 @@ void CompositorContext::EndFrame(ScopedFrame& frame,
   if (enable_instrumentation) {
     raster_time_.Stop();
   }
+#ifdef IMPELLER_SUPPORTS_RENDERING
+  // The backdrops marked unchanged while painting the layer tree only apply
+  // to the frame rendered from it, which has been submitted by now.
+  if (frame.aiks_context()) {
+    frame.aiks_context()->GetContentContext().GetBackdropFilterCache().End();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 std::unique_ptr<CompositorContext::ScopedFrame> CompositorContext::AcquireFrame(
@@ -12,6 +12,7 @@
 #include "flutter/common/macros.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layer_cost_recorder.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/macros.h"
@@ -61,6 +62,15 @@ class FrameDamage {
     additional_damage_ = additional_damage_.Union(damage);
   }
 
+  // Computes the damage only to find the content that did not change since
+  // the previous layer tree, like the backdrops of backdrop filters. The clip
+  // rect is never applied and no buffer damage is reported. Used for surfaces
+  // that do not support partial repaint.
+  void DisablePartialRepaint() {
+    partial_repaint_disabled_ = true;
+    ignore_damage_ = true;
+  }
+
   // Specifies clip rect alignment.
   void SetClipAlignment(int horizontal, int vertical) {
     horizontal_clip_alignment_ = horizontal;
@@ -101,6 +111,7 @@ class FrameDamage {
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
   bool ignore_damage_ = false;
+  bool partial_repaint_disabled_ = false;
 };
 
 class CompositorContext {
@@ -194,8 +205,11 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  LayerCostRecorder& layer_cost_recorder() { return layer_cost_recorder_; }
+
  private:
   NOT_SLIMPELLER(RasterCache raster_cache_);
+  LayerCostRecorder layer_cost_recorder_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
@@ -9,15 +9,18 @@
 
 namespace flutter {
 
-DiffContext::DiffContext(DlISize frame_size,
-                         PaintRegionMap& this_frame_paint_region_map,
-                         const PaintRegionMap& last_frame_paint_region_map,
-                         bool has_raster_cache,
-                         bool impeller_enabled)
+DiffContext::DiffContext(
+    DlISize frame_size,
+    PaintRegionMap& this_frame_paint_region_map,
+    const PaintRegionMap& last_frame_paint_region_map,
+    bool has_raster_cache,
+    bool impeller_enabled,
+    const OriginalLayerIdMap* last_frame_original_layer_ids)
     : rects_(std::make_shared<std::vector<DlRect>>()),
       frame_size_(frame_size),
       this_frame_paint_region_map_(this_frame_paint_region_map),
       last_frame_paint_region_map_(last_frame_paint_region_map),
+      last_frame_original_layer_ids_(last_frame_original_layer_ids),
       has_raster_cache_(has_raster_cache),
       impeller_enabled_(impeller_enabled) {}
 
@@ -219,6 +222,19 @@ void DiffContext::AddReadbackRegion(const DlIRect& paint_rect,
   readbacks_.push_back(readback);
 }
 
+bool DiffContext::IsDamaged(const DlIRect& rect) const {
+  DlRect damage(damage_);
+  for (const auto& r : readbacks_) {
+    DlRect paint_rect = DlRect::Make(r.paint_rect);
+    DlRect readback_rect = DlRect::Make(r.readback_rect);
+    if (paint_rect.IntersectsWithRect(damage) ||
+        readback_rect.IntersectsWithRect(damage)) {
+      damage = damage.Union(readback_rect).Union(paint_rect);
+    }
+  }
+  return DlRect::Make(rect).IntersectsWithRect(damage);
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -254,6 +270,16 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   }
 }
 
+uint64_t DiffContext::GetOldLayerOriginalId(const Layer* layer) const {
+  if (last_frame_original_layer_ids_) {
+    auto i = last_frame_original_layer_ids_->find(layer->unique_id());
+    if (i != last_frame_original_layer_ids_->end()) {
+      return i->second;
+    }
+  }
+  return layer->original_layer_id();
+}
+
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
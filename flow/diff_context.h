@@ -37,6 +37,9 @@ struct Damage {
 // Layer Unique Id to PaintRegion
 using PaintRegionMap = std::map<uint64_t, PaintRegion>;
 
+// Layer Unique Id to the original layer id of the layer it stands in for
+using OriginalLayerIdMap = std::map<uint64_t, uint64_t>;
+
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
  public:
@@ -44,7 +47,9 @@ class DiffContext {
                        PaintRegionMap& this_frame_paint_region_map,
                        const PaintRegionMap& last_frame_paint_region_map,
                        bool has_raster_cache,
-                       bool impeller_enabled);
+                       bool impeller_enabled,
+                       const OriginalLayerIdMap* last_frame_original_layer_ids =
+                           nullptr);
 
   // Starts a new subtree.
   void BeginSubtree();
@@ -126,6 +131,12 @@ class DiffContext {
   void AddReadbackRegion(const DlIRect& paint_rect,
                          const DlIRect& readback_rect);
 
+  // Returns whether the damage accumulated so far intersects the rect (in
+  // screen coordinates). Layers are diffed in paint order, so this is the
+  // damage of the content painted below the current layer. Readback regions
+  // registered so far extend the damage the same way as in ComputeDamage.
+  bool IsDamaged(const DlIRect& rect) const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -157,6 +168,12 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Retrieves the original layer id that the specified layer of the previous
+  // frame layer tree stood in for. This differs from the layer's own id when
+  // the layer was substituted for an identical rebuilt one, see
+  // LayerTree::ReuseIdenticalSubtrees.
+  uint64_t GetOldLayerOriginalId(const Layer* layer) const;
+
   // Whether or not a raster cache is being used. If so, we must snap
   // all transformations to physical pixels if the layer may be raster
   // cached.
@@ -246,6 +263,7 @@ class DiffContext {
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
+  const OriginalLayerIdMap* last_frame_original_layer_ids_;
   bool has_raster_cache_;
   bool impeller_enabled_;
 
@@ -30,10 +30,6 @@ void DisplayListEmbedderViewSlice::render_into(DlCanvas* canvas) {
   canvas->DrawDisplayList(display_list_);
 }
 
-void DisplayListEmbedderViewSlice::dispatch(DlOpReceiver& receiver) {
-  display_list_->Dispatch(receiver);
-}
-
 bool DisplayListEmbedderViewSlice::is_empty() {
   return display_list_->bounds().isEmpty();
 }
@@ -56,6 +52,10 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::UsesFrameDamage() {
+  return false;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
 void MutatorsStack::PushClipRect(const SkRect& rect) {
@@ -365,7 +365,14 @@ class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
   const DlRegion& getRegion() const override;
 
   void render_into(DlCanvas* canvas) override;
-  void dispatch(DlOpReceiver& receiver);
+
+  // Dispatches the recording to |receiver| with
+  // |DisplayList::DispatchInlined|, so callers must include dl_op_dispatch.h.
+  template <typename Receiver>
+  void dispatch(Receiver& receiver) {
+    display_list_->DispatchInlined(receiver);
+  }
+
   bool is_empty();
   bool recording_ended();
 
@@ -492,6 +499,14 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether |SubmitFlutterView| uses the frame damage in the submit info of
+  // the frame to only repaint the regions of its render targets that changed.
+  //
+  // Returning `true` makes the rasterizer diff every frame against the
+  // previous one. Painting is not restricted to the damage, as the render
+  // targets may lag behind by different regions.
+  virtual bool UsesFrameDamage();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace flutter {
+
+namespace {
+
+// Each group is a transform over an opacity over a clip over a picture, so
+// the tree has 1,000 layers below its root.
+constexpr int kGroupCount = 250;
+constexpr int kLayersPerGroup = 4;
+// The pictures of 10 groups, 1% of the layers, change every frame.
+constexpr int kChangedGroupsPerFrame = 10;
+constexpr int kFrameCount = kGroupCount / kChangedGroupsPerFrame;
+
+const DlISize kFrameSize(1000, 1000);
+
+sk_sp<DisplayList> MakePicture(int group, int frame) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeWH(10.0f + frame % 2, 10.0f),
+                   DlPaint(DlColor(0xFF000000 | group)));
+  return builder.Build();
+}
+
+// Rebuilds the whole tree, as the framework does for a scene without
+// retained layers, with new pictures for the groups that changed.
+std::unique_ptr<LayerTree> BuildFrame(
+    std::vector<sk_sp<DisplayList>>& pictures,
+    int frame) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int group = 0; group < kGroupCount; group++) {
+    if (group % kFrameCount == frame % kFrameCount) {
+      pictures[group] = MakePicture(group, frame);
+    }
+    DlPoint origin((group % 25) * 40.0f, (group / 25) * 40.0f);
+    auto picture = std::make_shared<DisplayListLayer>(
+        DlPoint(), pictures[group], false, false);
+    auto clip = std::make_shared<ClipRectLayer>(DlRect::MakeWH(30, 30),
+                                                Clip::kHardEdge);
+    clip->Add(picture);
+    auto opacity = std::make_shared<OpacityLayer>(200, DlPoint());
+    opacity->Add(clip);
+    auto transform =
+        std::make_shared<TransformLayer>(DlMatrix::MakeTranslation(origin));
+    transform->Add(opacity);
+    root->Add(transform);
+  }
+  return std::make_unique<LayerTree>(root, kFrameSize);
+}
+
+// Measures the diff and preroll of each frame, with or without substituting
+// the unchanged subtrees of the previous frame first. The raster cache is
+// not used, as with Impeller.
+void BM_LayerTreeFrame(benchmark::State& state, bool reuse_subtrees) {
+  CompositorContext compositor_context;
+  DisplayListBuilder builder;
+  auto scoped_frame = compositor_context.AcquireFrame(
+      nullptr, &builder, nullptr, SkMatrix::I(), false, true, nullptr,
+      nullptr);
+
+  std::vector<sk_sp<DisplayList>> pictures(kGroupCount);
+  for (int group = 0; group < kGroupCount; group++) {
+    pictures[group] = MakePicture(group, 0);
+  }
+  std::unique_ptr<LayerTree> previous = BuildFrame(pictures, 0);
+  FrameDamage().ComputeClipRect(*previous, false, true);
+  previous->Preroll(*scoped_frame, true);
+
+  int frame = 1;
+  size_t reused_subtrees = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<LayerTree> layer_tree = BuildFrame(pictures, frame++);
+    state.ResumeTiming();
+
+    if (reuse_subtrees) {
+      reused_subtrees += layer_tree->ReuseIdenticalSubtrees(previous.get());
+    }
+    FrameDamage frame_damage;
+    frame_damage.SetPreviousLayerTree(previous.get());
+    frame_damage.ComputeClipRect(*layer_tree, false, true);
+    layer_tree->Preroll(*scoped_frame, true);
+
+    state.PauseTiming();
+    previous = std::move(layer_tree);
+    state.ResumeTiming();
+  }
+  state.counters["Layers"] = kGroupCount * kLayersPerGroup;
+  state.counters["ReusedSubtrees"] = benchmark::Counter(
+      reused_subtrees, benchmark::Counter::kAvgIterations);
+}
+
+// A static page of 1,000 rectangles below a blurred app bar, whose title
+// moves on every frame.
+sk_sp<DisplayList> MakePage() {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 1000; i++) {
+    builder.DrawRect(
+        DlRect::MakeXYWH((i % 25) * 40.0f, (i / 25) * 25.0f, 30.0f, 20.0f),
+        DlPaint(DlColor(0xFF000000 | i)));
+  }
+  return builder.Build();
+}
+
+sk_sp<DisplayList> MakeTitle() {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeWH(200, 40), DlPaint(DlColor::kWhite()));
+  return builder.Build();
+}
+
+// Measures the diff and preroll of each frame, and reports how many frames
+// can reuse the blurred backdrop of the previous frame.
+void BM_BackdropFilterFrame(benchmark::State& state) {
+  CompositorContext compositor_context;
+  DisplayListBuilder builder;
+  auto scoped_frame = compositor_context.AcquireFrame(
+      nullptr, &builder, nullptr, SkMatrix::I(), false, true, nullptr,
+      nullptr);
+
+  sk_sp<DisplayList> page = MakePage();
+  sk_sp<DisplayList> title = MakeTitle();
+  auto blur = DlImageFilter::MakeBlur(20, 20, DlTileMode::kClamp);
+  std::shared_ptr<ClipRectLayer> app_bar;
+  std::shared_ptr<BackdropFilterLayer> backdrop;
+  auto build_frame = [&](int frame) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(
+        std::make_shared<DisplayListLayer>(DlPoint(), page, false, false));
+    auto new_app_bar = std::make_shared<ClipRectLayer>(
+        DlRect::MakeWH(1000, 100), Clip::kHardEdge);
+    auto new_backdrop =
+        std::make_shared<BackdropFilterLayer>(blur, DlBlendMode::kSrcOver);
+    if (app_bar) {
+      new_app_bar->AssignOldLayer(app_bar.get());
+      new_backdrop->AssignOldLayer(backdrop.get());
+    }
+    new_backdrop->Add(std::make_shared<DisplayListLayer>(
+        DlPoint(20.0f + frame % 100, 30.0f), title, false, false));
+    new_app_bar->Add(new_backdrop);
+    root->Add(new_app_bar);
+    app_bar = std::move(new_app_bar);
+    backdrop = std::move(new_backdrop);
+    return std::make_unique<LayerTree>(root, kFrameSize);
+  };
+
+  std::unique_ptr<LayerTree> previous = build_frame(0);
+  FrameDamage().ComputeClipRect(*previous, false, true);
+  previous->Preroll(*scoped_frame, true);
+
+  int frame = 1;
+  size_t backdrop_reuses = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<LayerTree> layer_tree = build_frame(frame++);
+    state.ResumeTiming();
+
+    FrameDamage frame_damage;
+    frame_damage.SetPreviousLayerTree(previous.get());
+    frame_damage.ComputeClipRect(*layer_tree, false, true);
+    layer_tree->Preroll(*scoped_frame, true);
+    backdrop_reuses += backdrop->backdrop_unchanged() ? 1 : 0;
+
+    state.PauseTiming();
+    previous = std::move(layer_tree);
+    state.ResumeTiming();
+  }
+  state.counters["BackdropReuses"] = benchmark::Counter(
+      backdrop_reuses, benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_LayerTreeFrame, Rebuilt, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_LayerTreeFrame, ReuseIdenticalSubtrees, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BackdropFilterFrame)->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
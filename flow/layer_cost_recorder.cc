@@ -0,0 +1,257 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_recorder.h"
+
+#include <algorithm>
+
+#include "flutter/display_list/benchmarking/dl_complexity.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "third_party/skia/include/gpu/ganesh/GrDirectContext.h"
+
+#ifdef IMPELLER_SUPPORTS_RENDERING
+#include "impeller/display_list/aiks_context.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace flutter {
+
+LayerCostRecorder::ScopedLayer::ScopedLayer(const PaintContext& context,
+                                            const Layer& layer)
+    : recorder_(context.layer_cost_recorder &&
+                        context.layer_cost_recorder->enabled()
+                    ? context.layer_cost_recorder
+                    : nullptr),
+      layer_(layer),
+      context_(context) {
+  if (recorder_) {
+    recorder_->BeginLayer();
+  }
+}
+
+LayerCostRecorder::ScopedLayer::~ScopedLayer() {
+  if (recorder_) {
+    recorder_->EndLayer(layer_, context_);
+  }
+}
+
+LayerCostRecorder::LayerCostRecorder(size_t window_size,
+                                     fml::TimePoint::ClockSource clock)
+    : window_size_(std::max<size_t>(window_size, 1)),
+      clock_(clock),
+      render_costs_(std::make_shared<RenderCosts>()) {}
+
+LayerCostRecorder::~LayerCostRecorder() = default;
+
+void LayerCostRecorder::set_enabled(bool enabled) {
+  if (enabled_ == enabled) {
+    return;
+  }
+  enabled_ = enabled;
+  window_frame_count_ = 0;
+  entries_.clear();
+  completed_frame_count_ = 0;
+  completed_entries_.clear();
+  open_layers_.clear();
+  frame_display_lists_.clear();
+  *render_costs_ = {};
+}
+
+void LayerCostRecorder::AttachToRenderer(impeller::AiksContext* aiks_context) {
+#ifdef IMPELLER_SUPPORTS_RENDERING
+  if (!aiks_context) {
+    return;
+  }
+  impeller::ContentContext& content_context =
+      aiks_context->GetContentContext();
+  if (!enabled_) {
+    if (content_context.GetDisplayListCostCallback()) {
+      content_context.SetDisplayListCostCallback(nullptr);
+    }
+    return;
+  }
+  if (!content_context.GetDisplayListCostCallback()) {
+    content_context.SetDisplayListCostCallback(
+        [render_costs = render_costs_](uint32_t display_list_id,
+                                       fml::TimeDelta time) {
+          render_costs->display_list_times.emplace_back(display_list_id, time);
+        });
+  }
+  std::optional<fml::TimeDelta> gpu_frame_time =
+      aiks_context->GetContext()->TakeGPUFrameTime();
+  if (gpu_frame_time.has_value()) {
+    AddGPUFrameTime(gpu_frame_time.value());
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void LayerCostRecorder::BeginFrame() {
+  FML_DCHECK(open_layers_.empty());
+  // The renderer reports the costs of the previous frame after it ended, so
+  // they are attributed before its window can complete.
+  AttributeRenderCosts();
+  frame_number_++;
+  if (window_frame_count_ < window_size_) {
+    return;
+  }
+  completed_entries_ = std::move(entries_);
+  completed_frame_count_ = window_frame_count_;
+  entries_.clear();
+  window_frame_count_ = 0;
+}
+
+void LayerCostRecorder::EndFrame() {
+  if (!enabled_) {
+    return;
+  }
+  window_frame_count_++;
+}
+
+void LayerCostRecorder::AddDisplayListRenderTime(uint32_t display_list_id,
+                                                 fml::TimeDelta time) {
+  render_costs_->display_list_times.emplace_back(display_list_id, time);
+}
+
+void LayerCostRecorder::AddGPUFrameTime(fml::TimeDelta time) {
+  render_costs_->gpu_frame_time = time;
+}
+
+void LayerCostRecorder::AttributeRenderCosts() {
+  std::unordered_map<uint64_t, fml::TimeDelta> layer_times;
+  fml::TimeDelta total_time;
+  for (const auto& [display_list_id, time] :
+       render_costs_->display_list_times) {
+    auto it = frame_display_lists_.find(display_list_id);
+    if (it == frame_display_lists_.end()) {
+      continue;
+    }
+    layer_times[it->second] = layer_times[it->second] + time;
+    total_time = total_time + time;
+  }
+  std::optional<fml::TimeDelta> gpu_frame_time = render_costs_->gpu_frame_time;
+  *render_costs_ = {};
+  frame_display_lists_.clear();
+
+  for (const auto& [layer_id, time] : layer_times) {
+    auto it = entries_.find(layer_id);
+    if (it == entries_.end()) {
+      continue;
+    }
+    LayerCost& cost = it->second.cost;
+    cost.render_time = cost.render_time + time;
+    if (gpu_frame_time.has_value() && total_time > fml::TimeDelta::Zero()) {
+      cost.gpu_time =
+          cost.gpu_time +
+          fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(
+              static_cast<double>(gpu_frame_time->ToNanoseconds()) *
+              time.ToNanoseconds() / total_time.ToNanoseconds()));
+    }
+  }
+}
+
+void LayerCostRecorder::BeginLayer() {
+  open_layers_.push_back({.start = clock_()});
+}
+
+void LayerCostRecorder::EndLayer(const Layer& layer,
+                                 const PaintContext& context) {
+  FML_DCHECK(!open_layers_.empty());
+  fml::TimeDelta total_time = clock_() - open_layers_.back().start;
+  fml::TimeDelta self_time = total_time - open_layers_.back().children_time;
+  open_layers_.pop_back();
+  if (!open_layers_.empty()) {
+    open_layers_.back().children_time = open_layers_.back().children_time +
+                                        total_time;
+  }
+
+  Entry& entry = entries_[layer.original_layer_id()];
+  LayerCost& cost = entry.cost;
+  cost.layer_id = layer.original_layer_id();
+  if (entry.last_frame != frame_number_) {
+    entry.last_frame = frame_number_;
+    cost.frame_count++;
+  }
+  cost.total_time = cost.total_time + total_time;
+  cost.self_time = cost.self_time + self_time;
+  cost.max_self_time = std::max(cost.max_self_time, self_time);
+  cost.device_bounds =
+      layer.paint_bounds().TransformBounds(context.state_stack.matrix());
+
+  auto* display_list_layer = layer.as_display_list_layer();
+  cost.is_display_list = display_list_layer != nullptr;
+  if (display_list_layer && display_list_layer->display_list()) {
+    frame_display_lists_[display_list_layer->display_list()->unique_id()] =
+        layer.original_layer_id();
+  }
+  if (display_list_layer && display_list_layer->display_list() &&
+      display_list_layer->display_list()->unique_id() !=
+          entry.display_list_id) {
+    // Computing the complexity walks the whole DisplayList, so it is only
+    // done when the layer paints a DisplayList it did not paint before.
+    const DisplayList* display_list = display_list_layer->display_list();
+    DisplayListComplexityCalculator* calculator =
+        context.gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                                 context.gr_context->backend())
+                           : DisplayListComplexityCalculator::GetForSoftware();
+    entry.display_list_id = display_list->unique_id();
+    cost.op_count = display_list->op_count(true);
+    cost.complexity_score = calculator->Compute(display_list);
+  }
+}
+
+bool LayerCostRecorder::ReportsCurrentWindow() const {
+  // A full window is only moved to the completed ones when the next frame
+  // begins.
+  return completed_frame_count_ == 0 || window_frame_count_ >= window_size_;
+}
+
+const LayerCostRecorder::EntryMap& LayerCostRecorder::ReportedEntries() const {
+  return ReportsCurrentWindow() ? entries_ : completed_entries_;
+}
+
+std::vector<LayerCostRecorder::LayerCost> LayerCostRecorder::GetCosts() const {
+  std::vector<LayerCost> costs;
+  const EntryMap& entries = ReportedEntries();
+  costs.reserve(entries.size());
+  for (const auto& [id, entry] : entries) {
+    costs.push_back(entry.cost);
+  }
+  std::sort(costs.begin(), costs.end(),
+            [](const LayerCost& a, const LayerCost& b) {
+              if (a.self_time != b.self_time) {
+                return a.self_time > b.self_time;
+              }
+              return a.layer_id < b.layer_id;
+            });
+  return costs;
+}
+
+size_t LayerCostRecorder::GetFrameCount() const {
+  return ReportsCurrentWindow() ? window_frame_count_ : completed_frame_count_;
+}
+
+void LayerCostRecorder::DrawHeatMap(DlCanvas* canvas) const {
+  std::vector<LayerCost> costs = GetCosts();
+  if (costs.empty() || costs.front().self_time <= fml::TimeDelta::Zero()) {
+    return;
+  }
+  double max_time = costs.front().self_time.ToMicrosecondsF();
+  DlPaint paint;
+  canvas->Save();
+  canvas->TransformReset();
+  // Draw the cheapest layers first so that the expensive ones stay visible
+  // where they overlap.
+  for (auto it = costs.rbegin(); it != costs.rend(); ++it) {
+    if (it->device_bounds.IsEmpty()) {
+      continue;
+    }
+    float heat = std::clamp(
+        static_cast<float>(it->self_time.ToMicrosecondsF() / max_time), 0.0f,
+        1.0f);
+    paint.setColor(DlColor::RGBA(heat, 1.0f - heat, 0.0f, 0.4f));
+    canvas->DrawRect(it->device_bounds, paint);
+  }
+  canvas->Restore();
+}
+
+}  // namespace flutter
@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_COST_RECORDER_H_
+#define FLUTTER_FLOW_LAYER_COST_RECORDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Attributes the raster thread time of each frame to the layers
+///             that were painted in it.
+///
+///             While enabled, |ContainerLayer::PaintChildren| measures the
+///             time each child spends in its |Layer::Paint|. The costs are
+///             aggregated per layer, identified by its original layer id so
+///             that rebuilt layers accumulate into the same entry, over a
+///             window of frames.
+///
+///             With the Impeller backend painting only records the
+///             DisplayList that is rendered later, so the measured times are
+///             recording costs. The renderer then reports the time it spends
+///             turning the DisplayList of each |DisplayListLayer| into
+///             entities, and the GPU time of the frames measured by the GPU
+///             tracer of the backend, if it has an enabled one, is split
+///             between the layers by their share of that time. Both are
+///             attributed when the next frame begins. The op counts and
+///             complexity scores of the DisplayLists hint at the cost of
+///             rendering them on any backend.
+///
+///             All methods must be called on the raster thread.
+///
+class LayerCostRecorder {
+ public:
+  static constexpr size_t kDefaultWindowSize = 120;
+
+  struct LayerCost {
+    uint64_t layer_id = 0;
+    /// Whether the layer is a |DisplayListLayer|.
+    bool is_display_list = false;
+    /// The number of frames of the window in which the layer was painted.
+    size_t frame_count = 0;
+    /// The time spent painting the layer, including its children.
+    fml::TimeDelta total_time;
+    /// The time spent painting the layer, excluding its children.
+    fml::TimeDelta self_time;
+    /// The longest |self_time| of a single frame.
+    fml::TimeDelta max_self_time;
+    /// With the Impeller backend, the time spent turning the DisplayList of
+    /// the layer into entities.
+    fml::TimeDelta render_time;
+    /// With the Impeller backend, the share of the GPU frame times that is
+    /// estimated from the share of the layer in the |render_time| of its
+    /// frames.
+    fml::TimeDelta gpu_time;
+    /// The op count and complexity score of the last painted DisplayList.
+    uint32_t op_count = 0;
+    unsigned int complexity_score = 0;
+    /// The last painted bounds of the layer in device coordinates.
+    DlRect device_bounds;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Measures the |Layer::Paint| of |layer| until it goes out of
+  ///             scope, if the context has an enabled recorder.
+  ///
+  class ScopedLayer {
+   public:
+    ScopedLayer(const PaintContext& context, const Layer& layer);
+
+    ~ScopedLayer();
+
+   private:
+    LayerCostRecorder* recorder_;
+    const Layer& layer_;
+    const PaintContext& context_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedLayer);
+  };
+
+  explicit LayerCostRecorder(
+      size_t window_size = kDefaultWindowSize,
+      fml::TimePoint::ClockSource clock = &fml::TimePoint::Now);
+
+  ~LayerCostRecorder();
+
+  bool enabled() const { return enabled_; }
+
+  /// Enables or disables the recording. Changing it discards the recorded
+  /// costs.
+  void set_enabled(bool enabled);
+
+  bool heat_map_enabled() const { return heat_map_enabled_; }
+
+  void set_heat_map_enabled(bool enabled) { heat_map_enabled_ = enabled; }
+
+  size_t window_size() const { return window_size_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the renderer of |aiks_context| report its costs to this
+  ///             recorder while it is enabled, and takes the GPU time of the
+  ///             last completed frame. Must be called for every frame, enabled
+  ///             or not, so that a disabled recorder stops the reports.
+  ///
+  void AttachToRenderer(impeller::AiksContext* aiks_context);
+
+  void BeginFrame();
+
+  void EndFrame();
+
+  /// Records the time the renderer spent on the DisplayList with the unique
+  /// id |display_list_id| in the last painted frame.
+  void AddDisplayListRenderTime(uint32_t display_list_id, fml::TimeDelta time);
+
+  /// Records the GPU time of a frame that the GPU completed.
+  void AddGPUFrameTime(fml::TimeDelta time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The costs of the last complete window, or of the frames of
+  ///             the current window if none has completed yet, ordered by
+  ///             descending |LayerCost::self_time|.
+  ///
+  std::vector<LayerCost> GetCosts() const;
+
+  /// The number of frames that |GetCosts| covers.
+  size_t GetFrameCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fills the device bounds of the layers of |GetCosts| with a
+  ///             translucent color that goes from green for the cheapest to
+  ///             red for the most expensive |LayerCost::self_time|.
+  ///
+  void DrawHeatMap(DlCanvas* canvas) const;
+
+ private:
+  struct Entry {
+    LayerCost cost;
+    uint32_t display_list_id = 0;
+    size_t last_frame = 0;
+  };
+  using EntryMap = std::unordered_map<uint64_t, Entry>;
+
+  // The costs that the renderer reported since the last frame began. They are
+  // shared with the callback of the renderer, which may outlive the recorder.
+  struct RenderCosts {
+    std::vector<std::pair<uint32_t, fml::TimeDelta>> display_list_times;
+    std::optional<fml::TimeDelta> gpu_frame_time;
+  };
+
+  void BeginLayer();
+
+  void EndLayer(const Layer& layer, const PaintContext& context);
+
+  void AttributeRenderCosts();
+
+  bool ReportsCurrentWindow() const;
+
+  const EntryMap& ReportedEntries() const;
+
+  const size_t window_size_;
+  const fml::TimePoint::ClockSource clock_;
+  bool enabled_ = false;
+  bool heat_map_enabled_ = false;
+
+  size_t frame_number_ = 0;
+  size_t window_frame_count_ = 0;
+  EntryMap entries_;
+  size_t completed_frame_count_ = 0;
+  EntryMap completed_entries_;
+
+  struct OpenLayer {
+    fml::TimePoint start;
+    fml::TimeDelta children_time;
+  };
+  std::vector<OpenLayer> open_layers_;
+
+  // The layers that painted each DisplayList in the current frame, by the
+  // unique id of the DisplayList.
+  std::unordered_map<uint32_t, uint64_t> frame_display_lists_;
+  std::shared_ptr<RenderCosts> render_costs_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerCostRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_COST_RECORDER_H_
@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_recorder.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// The clock of the recorders under test, which only advances while a
+// |SlowMockLayer| paints.
+fml::TimePoint fake_now;
+
+fml::TimePoint FakeNow() {
+  return fake_now;
+}
+
+// A MockLayer that takes 2ms of the fake clock to paint.
+class SlowMockLayer : public MockLayer {
+ public:
+  explicit SlowMockLayer(const DlPath& path) : MockLayer(path) {}
+
+  void Paint(PaintContext& context) const override {
+    fake_now = fake_now + fml::TimeDelta::FromMilliseconds(2);
+    MockLayer::Paint(context);
+  }
+};
+
+std::shared_ptr<DisplayListLayer> MakeDisplayListLayer(const DlRect& rect) {
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, DlPaint());
+  return std::make_shared<DisplayListLayer>(DlPoint(), builder.Build(), false,
+                                            false);
+}
+
+}  // namespace
+
+class LayerCostRecorderTest : public LayerTest {
+ public:
+  LayerCostRecorderTest() : recorder_(2, &FakeNow) {
+    recorder_.set_enabled(true);
+    paint_context().layer_cost_recorder = &recorder_;
+  }
+
+  LayerCostRecorder& recorder() { return recorder_; }
+
+  void PaintFrame(const std::shared_ptr<Layer>& root) {
+    recorder_.BeginFrame();
+    root->Preroll(preroll_context());
+    root->Paint(paint_context());
+    recorder_.EndFrame();
+    reset_display_list();
+  }
+
+ private:
+  LayerCostRecorder recorder_;
+};
+
+TEST_F(LayerCostRecorderTest, AttributesPaintTimeToLayers) {
+  auto slow_layer = std::make_shared<SlowMockLayer>(
+      DlPath::MakeRect(DlRect::MakeLTRB(0, 0, 10, 10)));
+  auto transform =
+      std::make_shared<TransformLayer>(DlMatrix::MakeTranslation({5, 5}));
+  transform->Add(slow_layer);
+  auto display_list_layer =
+      MakeDisplayListLayer(DlRect::MakeLTRB(20, 20, 30, 30));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(transform);
+  root->Add(display_list_layer);
+
+  PaintFrame(root);
+
+  auto costs = recorder().GetCosts();
+  ASSERT_EQ(costs.size(), 3u);
+  EXPECT_EQ(recorder().GetFrameCount(), 1u);
+
+  // The slow layer has the highest self time, and its time is included in
+  // the total time of its parent but not in the parent's self time.
+  const auto& slow_cost = costs[0];
+  EXPECT_EQ(slow_cost.layer_id, slow_layer->original_layer_id());
+  EXPECT_EQ(slow_cost.frame_count, 1u);
+  EXPECT_EQ(slow_cost.self_time, fml::TimeDelta::FromMilliseconds(2));
+  EXPECT_EQ(slow_cost.self_time, slow_cost.total_time);
+  EXPECT_EQ(slow_cost.device_bounds, DlRect::MakeLTRB(5, 5, 15, 15));
+  EXPECT_FALSE(slow_cost.is_display_list);
+
+  for (const auto& cost : costs) {
+    if (cost.layer_id == transform->original_layer_id()) {
+      EXPECT_EQ(cost.total_time, slow_cost.total_time);
+      EXPECT_EQ(cost.self_time, fml::TimeDelta::Zero());
+    } else if (cost.layer_id == display_list_layer->original_layer_id()) {
+      EXPECT_TRUE(cost.is_display_list);
+      EXPECT_EQ(cost.op_count, 1u);
+      EXPECT_GT(cost.complexity_score, 0u);
+      EXPECT_EQ(cost.device_bounds, DlRect::MakeLTRB(20, 20, 30, 30));
+    } else {
+      EXPECT_EQ(cost.layer_id, slow_layer->original_layer_id());
+    }
+  }
+}
+
+TEST_F(LayerCostRecorderTest, AggregatesRebuiltLayersOverWindow) {
+  const DlPath path = DlPath::MakeRect(DlRect::MakeLTRB(0, 0, 10, 10));
+  auto first_layer = std::make_shared<SlowMockLayer>(path);
+  auto first_root = std::make_shared<ContainerLayer>();
+  first_root->Add(first_layer);
+  PaintFrame(first_root);
+
+  // A rebuilt layer that replaces the first one accumulates into its entry.
+  auto second_layer = std::make_shared<SlowMockLayer>(path);
+  second_layer->AssignOldLayer(first_layer.get());
+  auto second_root = std::make_shared<ContainerLayer>();
+  second_root->Add(second_layer);
+  PaintFrame(second_root);
+
+  auto costs = recorder().GetCosts();
+  EXPECT_EQ(recorder().GetFrameCount(), 2u);
+  ASSERT_EQ(costs.size(), 1u);
+  EXPECT_EQ(costs[0].layer_id, first_layer->original_layer_id());
+  EXPECT_EQ(costs[0].frame_count, 2u);
+  EXPECT_EQ(costs[0].self_time, fml::TimeDelta::FromMilliseconds(4));
+  EXPECT_EQ(costs[0].max_self_time, fml::TimeDelta::FromMilliseconds(2));
+
+  // The completed window keeps being reported while the next one fills.
+  auto other_root = std::make_shared<ContainerLayer>();
+  other_root->Add(std::make_shared<MockLayer>(path));
+  PaintFrame(other_root);
+  EXPECT_EQ(recorder().GetFrameCount(), 2u);
+  ASSERT_EQ(recorder().GetCosts().size(), 1u);
+  EXPECT_EQ(recorder().GetCosts()[0].layer_id,
+            first_layer->original_layer_id());
+}
+
+TEST_F(LayerCostRecorderTest, AttributesRenderCostsToDisplayListLayers) {
+  auto cheap_layer = MakeDisplayListLayer(DlRect::MakeLTRB(0, 0, 10, 10));
+  auto expensive_layer = MakeDisplayListLayer(DlRect::MakeLTRB(0, 0, 20, 20));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(cheap_layer);
+  root->Add(expensive_layer);
+  PaintFrame(root);
+
+  // The renderer reports the costs of the frame after it was painted, and
+  // they are attributed when the next frame begins.
+  recorder().AddDisplayListRenderTime(
+      cheap_layer->display_list()->unique_id(),
+      fml::TimeDelta::FromMilliseconds(1));
+  recorder().AddDisplayListRenderTime(
+      expensive_layer->display_list()->unique_id(),
+      fml::TimeDelta::FromMilliseconds(3));
+  // DisplayLists that no layer painted in the frame are ignored.
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeWH(5, 5), DlPaint());
+  recorder().AddDisplayListRenderTime(builder.Build()->unique_id(),
+                                      fml::TimeDelta::FromMilliseconds(5));
+  recorder().AddGPUFrameTime(fml::TimeDelta::FromMilliseconds(8));
+  PaintFrame(root);
+
+  auto costs = recorder().GetCosts();
+  ASSERT_EQ(costs.size(), 2u);
+  for (const auto& cost : costs) {
+    if (cost.layer_id == cheap_layer->original_layer_id()) {
+      EXPECT_EQ(cost.render_time, fml::TimeDelta::FromMilliseconds(1));
+      EXPECT_EQ(cost.gpu_time, fml::TimeDelta::FromMilliseconds(2));
+    } else {
+      EXPECT_EQ(cost.layer_id, expensive_layer->original_layer_id());
+      EXPECT_EQ(cost.render_time, fml::TimeDelta::FromMilliseconds(3));
+      EXPECT_EQ(cost.gpu_time, fml::TimeDelta::FromMilliseconds(6));
+    }
+  }
+}
+
+TEST_F(LayerCostRecorderTest, DisabledRecorderRecordsNothing) {
+  recorder().set_enabled(false);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRect(DlRect::MakeWH(5, 5))));
+
+  PaintFrame(root);
+
+  EXPECT_TRUE(recorder().GetCosts().empty());
+  EXPECT_EQ(recorder().GetFrameCount(), 0u);
+}
+
+TEST_F(LayerCostRecorderTest, DrawsHeatMapOverPaintedLayers) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<SlowMockLayer>(
+      DlPath::MakeRect(DlRect::MakeLTRB(0, 0, 10, 10))));
+  root->Add(std::make_shared<MockLayer>(
+      DlPath::MakeRect(DlRect::MakeLTRB(50, 50, 60, 60))));
+  PaintFrame(root);
+
+  DisplayListBuilder builder;
+  builder.Scale(2, 2);
+  recorder().DrawHeatMap(&builder);
+  auto heat_map = builder.Build();
+
+  // The rects are drawn in device coordinates, ignoring the scale.
+  EXPECT_EQ(heat_map->GetBounds(), DlRect::MakeLTRB(0, 0, 60, 60));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,8 +4,25 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#ifdef IMPELLER_SUPPORTS_RENDERING
+#include "impeller/display_list/aiks_context.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
+namespace {
+
+#ifdef IMPELLER_SUPPORTS_RENDERING
+// Layers that are not part of a backdrop group are given a backdrop id so
+// that Impeller can keep their filtered backdrop across frames. The ids of
+// backdrop groups are never negative, so these can not collide with them.
+int64_t GetBackdropCacheId(uint64_t original_layer_id) {
+  return -1 - static_cast<int64_t>(original_layer_id);
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+}  // namespace
+
 BackdropFilterLayer::BackdropFilterLayer(
     const std::shared_ptr<DlImageFilter>& filter,
     DlBlendMode blend_mode,
@@ -26,12 +43,20 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto paint_bounds = context->GetCullRect();
   context->AddLayerBounds(paint_bounds);
 
+  backdrop_unchanged_ = false;
   if (filter_) {
     paint_bounds = context->MapRect(paint_bounds);
     auto filter_target_bounds = DlIRect::RoundOut(paint_bounds);
     DlIRect filter_input_bounds;  // in screen coordinates
     filter_->get_input_device_bounds(filter_target_bounds, context->GetMatrix(),
                                      filter_input_bounds);
+    // The layers below have been diffed already, and none of them changed
+    // what the filter reads if there is no damage in its input bounds. The
+    // children paint on top of the filtered backdrop and don't affect it.
+    backdrop_unchanged_ = prev && !context->IsSubtreeDirty() &&
+                          filter_input_bounds == prev->filter_input_bounds_ &&
+                          !context->IsDamaged(filter_input_bounds);
+    filter_input_bounds_ = filter_input_bounds;
     context->AddReadbackRegion(filter_target_bounds, filter_input_bounds);
   }
 
@@ -58,9 +83,23 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
+  std::optional<int64_t> backdrop_id = backdrop_id_;
+#ifdef IMPELLER_SUPPORTS_RENDERING
+  if (context.aiks_context && filter_ && !backdrop_id.has_value()) {
+    backdrop_id = GetBackdropCacheId(original_layer_id());
+    if (backdrop_unchanged_) {
+      context.aiks_context->GetContentContext()
+          .GetBackdropFilterCache()
+          .MarkUnchanged(backdrop_id.value());
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  // The result of the diff only applies to the frame it was computed for.
+  backdrop_unchanged_ = false;
+
   auto mutator = context.state_stack.save();
   mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_,
-                              backdrop_id_);
+                              backdrop_id);
 
   PaintChildren(context);
 }
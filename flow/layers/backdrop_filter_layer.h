@@ -21,10 +21,18 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // Whether the last Diff found that nothing below this layer changed in the
+  // region that the filter reads from, so that the filtered backdrop of the
+  // previous frame can be reused. Cleared when the layer is painted.
+  bool backdrop_unchanged() const { return backdrop_unchanged_; }
+
  private:
   std::shared_ptr<DlImageFilter> filter_;
   DlBlendMode blend_mode_;
   std::optional<int64_t> backdrop_id_;
+  // The region the filter reads from in the last Diff, in screen coordinates.
+  DlIRect filter_input_bounds_;
+  mutable bool backdrop_unchanged_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
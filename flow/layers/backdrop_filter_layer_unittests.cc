@@ -531,5 +531,112 @@ TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   EXPECT_EQ(damage.frame_damage, DlIRect::MakeWH(100, 100));
 }
 
+namespace {
+
+struct AppBarLayers {
+  std::shared_ptr<ClipRectLayer> clip;
+  std::shared_ptr<BackdropFilterLayer> backdrop;
+};
+
+// Adds an app bar that filters the content below it, with a title at
+// `title_x` painted over it. The app bar replaces the one in `previous`.
+AppBarLayers AddAppBar(MockLayerTree& tree,
+                       const std::shared_ptr<DlImageFilter>& filter,
+                       DlScalar title_x,
+                       const AppBarLayers* previous = nullptr) {
+  AppBarLayers layers{
+      .clip = std::make_shared<ClipRectLayer>(DlRect::MakeLTRB(0, 0, 100, 20),
+                                              Clip::kHardEdge),
+      .backdrop =
+          std::make_shared<BackdropFilterLayer>(filter, DlBlendMode::kSrcOver),
+  };
+  if (previous) {
+    layers.clip->AssignOldLayer(previous->clip.get());
+    layers.backdrop->AssignOldLayer(previous->backdrop.get());
+  }
+  layers.backdrop->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectXYWH(title_x, 5, 10, 10)));
+  layers.clip->Add(layers.backdrop);
+  tree.root()->Add(layers.clip);
+  return layers;
+}
+
+}  // namespace
+
+TEST_F(BackdropLayerDiffTest, BackdropUnchangedWhenOnlyForegroundChanges) {
+  auto filter = DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp);
+  auto background =
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100));
+
+  MockLayerTree l1(DlISize(100, 100));
+  l1.root()->Add(background);
+  AppBarLayers app_bar1 = AddAppBar(l1, filter, 10);
+  DiffLayerTree(l1, MockLayerTree(DlISize(100, 100)));
+  // There is no previous frame to reuse.
+  EXPECT_FALSE(app_bar1.backdrop->backdrop_unchanged());
+
+  MockLayerTree l2(DlISize(100, 100));
+  l2.root()->Add(background);
+  AppBarLayers app_bar2 = AddAppBar(l2, filter, 20, &app_bar1);
+  auto damage = DiffLayerTree(l2, l1);
+  EXPECT_TRUE(app_bar2.backdrop->backdrop_unchanged());
+  // The moved title still repaints the app bar and the region it reads from.
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(0, 0, 100, 50));
+}
+
+TEST_F(BackdropLayerDiffTest, BackdropUnchangedWhenDamageIsOutsideOfReadback) {
+  auto filter = DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp);
+  auto background =
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100));
+
+  MockLayerTree l1(DlISize(100, 100));
+  l1.root()->Add(background);
+  AppBarLayers app_bar1 = AddAppBar(l1, filter, 10);
+  DiffLayerTree(l1, MockLayerTree(DlISize(100, 100)));
+
+  // The readback region of the app bar ends at y = 50.
+  MockLayerTree l2(DlISize(100, 100));
+  l2.root()->Add(background);
+  l2.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 60, 10, 70)));
+  AppBarLayers app_bar2 = AddAppBar(l2, filter, 10, &app_bar1);
+  DiffLayerTree(l2, l1);
+  EXPECT_TRUE(app_bar2.backdrop->backdrop_unchanged());
+}
+
+TEST_F(BackdropLayerDiffTest, BackdropChangedWhenContentBehindChanges) {
+  auto filter = DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp);
+
+  MockLayerTree l1(DlISize(100, 100));
+  l1.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100)));
+  AppBarLayers app_bar1 = AddAppBar(l1, filter, 10);
+  DiffLayerTree(l1, MockLayerTree(DlISize(100, 100)));
+
+  // Content that changes just inside the readback region, below the app bar.
+  MockLayerTree l2(DlISize(100, 100));
+  l2.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100)));
+  l2.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 45, 10, 55)));
+  AppBarLayers app_bar2 = AddAppBar(l2, filter, 10, &app_bar1);
+  DiffLayerTree(l2, l1);
+  EXPECT_FALSE(app_bar2.backdrop->backdrop_unchanged());
+}
+
+TEST_F(BackdropLayerDiffTest, BackdropChangedWhenFilterChanges) {
+  MockLayerTree l1(DlISize(100, 100));
+  AppBarLayers app_bar1 =
+      AddAppBar(l1, DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp), 10);
+  DiffLayerTree(l1, MockLayerTree(DlISize(100, 100)));
+
+  MockLayerTree l2(DlISize(100, 100));
+  AppBarLayers app_bar2 =
+      AddAppBar(l2, DlImageFilter::MakeBlur(5, 5, DlTileMode::kClamp), 10,
+                &app_bar1);
+  DiffLayerTree(l2, l1);
+  EXPECT_FALSE(app_bar2.backdrop->backdrop_unchanged());
+}
+
 }  // namespace testing
 }  // namespace flutter
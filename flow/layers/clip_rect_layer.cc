@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
 ClipRectLayer::ClipRectLayer(const DlRect& clip_rect, Clip clip_behavior)
@@ -17,4 +19,15 @@ void ClipRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRect(clip_shape(), clip_behavior() != Clip::kHardEdge);
 }
 
+size_t ClipRectLayer::ComputeStructuralHash() const {
+  size_t children_hash = ChildrenStructuralHash();
+  if (children_hash == kNoStructuralHash) {
+    return kNoStructuralHash;
+  }
+  const DlRect& rect = clip_shape();
+  return fml::HashCombine(StructuralHashType::kClipRect, children_hash,
+                          clip_behavior(), rect.GetLeft(), rect.GetTop(),
+                          rect.GetRight(), rect.GetBottom());
+}
+
 }  // namespace flutter
@@ -18,6 +18,12 @@ class ClipRectLayer : public ClipShapeLayer<DlRect> {
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
+  size_t ComputeStructuralHash() const override;
+
+  std::optional<StructuralHashType> structural_hash_type() const override {
+    return StructuralHashType::kClipRect;
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRectLayer);
 };
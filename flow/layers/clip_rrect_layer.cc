@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_rrect_layer.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
 ClipRRectLayer::ClipRRectLayer(const DlRoundRect& clip_rrect,
@@ -18,4 +20,20 @@ void ClipRRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRRect(clip_shape(), clip_behavior() != Clip::kHardEdge);
 }
 
+size_t ClipRRectLayer::ComputeStructuralHash() const {
+  size_t children_hash = ChildrenStructuralHash();
+  if (children_hash == kNoStructuralHash) {
+    return kNoStructuralHash;
+  }
+  const DlRect& rect = clip_shape().GetBounds();
+  const impeller::RoundingRadii& radii = clip_shape().GetRadii();
+  return fml::HashCombine(
+      StructuralHashType::kClipRRect, children_hash, clip_behavior(),
+      rect.GetLeft(), rect.GetTop(), rect.GetRight(), rect.GetBottom(),
+      radii.top_left.width, radii.top_left.height, radii.top_right.width,
+      radii.top_right.height, radii.bottom_left.width,
+      radii.bottom_left.height, radii.bottom_right.width,
+      radii.bottom_right.height);
+}
+
 }  // namespace flutter
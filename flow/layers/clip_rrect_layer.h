@@ -18,6 +18,12 @@ class ClipRRectLayer : public ClipShapeLayer<DlRoundRect> {
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
+  size_t ComputeStructuralHash() const override;
+
+  std::optional<StructuralHashType> structural_hash_type() const override {
+    return StructuralHashType::kClipRRect;
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRRectLayer);
 };
@@ -112,6 +112,13 @@ class ClipShapeLayer : public CacheableContainerLayer {
   const ClipShape& clip_shape() const { return clip_shape_; }
   Clip clip_behavior() const { return clip_behavior_; }
 
+  bool StructuralPropertiesEqual(const Layer& other) const override {
+    auto& other_clip = static_cast<const ClipShapeLayer<ClipShape>&>(other);
+    return clip_behavior_ == other_clip.clip_behavior_ &&
+           clip_shape_ == other_clip.clip_shape_ &&
+           ChildrenStructurallyEqual(other_clip);
+  }
+
  private:
   const ClipShape clip_shape_;
   Clip clip_behavior_;
@@ -6,6 +6,9 @@
 
 #include <optional>
 
+#include "flutter/flow/layer_cost_recorder.h"
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() {}
@@ -107,6 +110,37 @@ void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
 }
 
+void ContainerLayer::ReplaceLayer(size_t index, std::shared_ptr<Layer> layer) {
+  FML_DCHECK(index < layers_.size());
+  FML_DCHECK(layer->structural_hash() == layers_[index]->structural_hash());
+  layers_[index] = std::move(layer);
+}
+
+size_t ContainerLayer::ChildrenStructuralHash() const {
+  size_t hash = fml::HashCombine(layers_.size());
+  for (auto& layer : layers_) {
+    size_t child_hash = layer->structural_hash();
+    if (child_hash == kNoStructuralHash) {
+      return kNoStructuralHash;
+    }
+    fml::HashCombineSeed(hash, child_hash);
+  }
+  return hash;
+}
+
+bool ContainerLayer::ChildrenStructurallyEqual(
+    const ContainerLayer& other) const {
+  if (layers_.size() != other.layers_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < layers_.size(); i++) {
+    if (!layers_[i]->IsStructurallyEqual(*other.layers_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ContainerLayer::Preroll(PrerollContext* context) {
   DlRect child_paint_bounds;
   PrerollChildren(context, &child_paint_bounds);
@@ -141,7 +175,10 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    if (!layer->TryReusePreroll(context)) {
+      layer->Preroll(context);
+      layer->RecordPreroll(context);
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (child_paint_bounds->IntersectsWithRect(layer->paint_bounds())) {
@@ -182,6 +219,7 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
+      LayerCostRecorder::ScopedLayer cost_scope(context, *layer);
       layer->Paint(context);
     }
   }
@@ -25,6 +25,10 @@ class ContainerLayer : public Layer {
 
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  // Replaces the child at |index|. Used by |LayerTree::ReuseIdenticalSubtrees|
+  // to substitute the identical subtrees of the previous frame.
+  void ReplaceLayer(size_t index, std::shared_ptr<Layer> layer);
+
   virtual void DiffChildren(DiffContext* context,
                             const ContainerLayer* old_layer);
 
@@ -47,6 +51,13 @@ class ContainerLayer : public Layer {
  protected:
   void PrerollChildren(PrerollContext* context, DlRect* child_paint_bounds);
 
+  // Combines the structural hashes of the children, or returns
+  // |kNoStructuralHash| if any of them has none.
+  size_t ChildrenStructuralHash() const;
+
+  // Whether the children are pairwise structurally equal to those of |other|.
+  bool ChildrenStructurallyEqual(const ContainerLayer& other) const;
+
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
   DlRect child_paint_bounds_;
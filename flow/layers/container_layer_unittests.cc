@@ -752,6 +752,67 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+// A MockLayer that counts its prerolls and has a fixed structural hash.
+class HashedMockLayer : public MockLayer {
+ public:
+  explicit HashedMockLayer(const DlPath& path) : MockLayer(path) {}
+
+  void Preroll(PrerollContext* context) override {
+    preroll_count_++;
+    MockLayer::Preroll(context);
+  }
+
+  int preroll_count() const { return preroll_count_; }
+
+ protected:
+  size_t ComputeStructuralHash() const override { return 42; }
+
+ private:
+  int preroll_count_ = 0;
+};
+
+TEST_F(ContainerLayerTest, ReusesPrerollOfUnchangedHashedChild) {
+  auto child = std::make_shared<HashedMockLayer>(
+      DlPath::MakeRect(DlRect::MakeLTRB(5, 6, 20, 21)));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(child);
+
+  layer->Preroll(preroll_context());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(child->preroll_count(), 1);
+  EXPECT_EQ(layer->paint_bounds(), DlRect::MakeLTRB(5, 6, 20, 21));
+
+  preroll_context()->state_stack.set_preroll_delegate(
+      DlRect::MakeLTRB(0, 0, 10, 10), DlMatrix());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(child->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, DoesNotReusePrerollOfUnhashedChild) {
+  auto child =
+      std::make_shared<MockLayer>(DlPath::MakeRect(DlRect::MakeWH(5, 5)));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(child);
+
+  EXPECT_EQ(child->structural_hash(), Layer::kNoStructuralHash);
+  EXPECT_EQ(layer->structural_hash(), Layer::kNoStructuralHash);
+  EXPECT_FALSE(child->TryReusePreroll(preroll_context()));
+}
+
+#if !SLIMPELLER
+TEST_F(ContainerLayerTest, DoesNotReusePrerollWithRasterCache) {
+  use_mock_raster_cache();
+  auto child = std::make_shared<HashedMockLayer>(
+      DlPath::MakeRect(DlRect::MakeWH(5, 5)));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(child);
+
+  layer->Preroll(preroll_context());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(child->preroll_count(), 2);
+}
+#endif  //  !SLIMPELLER
+
 }  // namespace testing
 }  // namespace flutter
 
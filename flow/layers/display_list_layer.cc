@@ -11,6 +11,7 @@
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -18,7 +19,10 @@ DisplayListLayer::DisplayListLayer(const DlPoint& offset,
                                    sk_sp<DisplayList> display_list,
                                    bool is_complex,
                                    bool will_change)
-    : offset_(offset), display_list_(std::move(display_list)) {
+    : offset_(offset),
+      display_list_(std::move(display_list)),
+      is_complex_(is_complex),
+      will_change_(will_change) {
   if (display_list_) {
     bounds_ = display_list_->GetBounds().Shift(offset_.x, offset_.y);
 #if !SLIMPELLER
@@ -134,4 +138,24 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   context.canvas->DrawDisplayList(display_list_, opacity);
 }
 
+size_t DisplayListLayer::ComputeStructuralHash() const {
+  if (!display_list_) {
+    return kNoStructuralHash;
+  }
+  // Pictures that are not repainted keep their DisplayList, so its identity
+  // is a cheap and sufficient stand-in for its contents. The hints decide
+  // whether the picture is raster cached, so they are part of the hash too.
+  return fml::HashCombine(StructuralHashType::kDisplayList,
+                          display_list_->unique_id(), offset_.x, offset_.y,
+                          is_complex_, will_change_);
+}
+
+bool DisplayListLayer::StructuralPropertiesEqual(const Layer& other) const {
+  auto& other_display_list = static_cast<const DisplayListLayer&>(other);
+  return display_list_ == other_display_list.display_list_ &&
+         offset_ == other_display_list.offset_ &&
+         is_complex_ == other_display_list.is_complex_ &&
+         will_change_ == other_display_list.will_change_;
+}
+
 }  // namespace flutter
@@ -49,6 +49,15 @@ class DisplayListLayer : public Layer {
   }
 #endif  //  !SLIMPELLER
 
+ protected:
+  size_t ComputeStructuralHash() const override;
+
+  std::optional<StructuralHashType> structural_hash_type() const override {
+    return StructuralHashType::kDisplayList;
+  }
+
+  bool StructuralPropertiesEqual(const Layer& other) const override;
+
  private:
   NOT_SLIMPELLER(std::unique_ptr<DisplayListRasterCacheItem>
                      display_list_raster_cache_item_);
@@ -57,6 +66,8 @@ class DisplayListLayer : public Layer {
   DlRect bounds_;
 
   sk_sp<DisplayList> display_list_;
+  bool is_complex_;
+  bool will_change_;
 
   static bool Compare(DiffContext::Statistics& statistics,
                       const DisplayListLayer* l1,
@@ -21,6 +21,61 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+size_t Layer::structural_hash() const {
+  if (!structural_hash_.has_value()) {
+    structural_hash_ = ComputeStructuralHash();
+  }
+  return structural_hash_.value();
+}
+
+bool Layer::IsStructurallyEqual(const Layer& other) const {
+  std::optional<StructuralHashType> type = structural_hash_type();
+  if (!type.has_value() || type != other.structural_hash_type() ||
+      structural_hash() == kNoStructuralHash ||
+      structural_hash() != other.structural_hash()) {
+    return false;
+  }
+  return StructuralPropertiesEqual(other);
+}
+
+bool Layer::TryReusePreroll(PrerollContext* context) const {
+#if !SLIMPELLER
+  if (context->raster_cache) {
+    return false;
+  }
+#endif  //  !SLIMPELLER
+  if (!last_preroll_.has_value() ||
+      structural_hash() == kNoStructuralHash ||
+      last_preroll_->surface_needs_readback !=
+          context->surface_needs_readback ||
+      last_preroll_->matrix != context->state_stack.matrix() ||
+      last_preroll_->cull_rect != context->state_stack.device_cull_rect()) {
+    return false;
+  }
+  // Hashable subtrees contain neither platform views nor textures, so the
+  // renderable state flags are the only output left to restore.
+  context->renderable_state_flags = last_preroll_->renderable_state_flags;
+  return true;
+}
+
+void Layer::RecordPreroll(const PrerollContext* context) {
+#if !SLIMPELLER
+  if (context->raster_cache) {
+    last_preroll_.reset();
+    return;
+  }
+#endif  //  !SLIMPELLER
+  if (structural_hash() == kNoStructuralHash) {
+    return;
+  }
+  last_preroll_ = {
+      .matrix = context->state_stack.matrix(),
+      .cull_rect = context->state_stack.device_cull_rect(),
+      .surface_needs_readback = context->surface_needs_readback,
+      .renderable_state_flags = context->renderable_state_flags,
+  };
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -33,6 +34,7 @@ class MockLayer;
 
 class ContainerLayer;
 class DisplayListLayer;
+class LayerCostRecorder;
 class PerformanceOverlayLayer;
 class TextureLayer;
 class RasterCacheItem;
@@ -106,6 +108,10 @@ struct PaintContext {
 
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+
+  // Receives the paint times of the layers while the attribution of raster
+  // costs is enabled. See |LayerCostRecorder|.
+  LayerCostRecorder* layer_cost_recorder = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -137,7 +143,7 @@ class Layer {
   // If this method returns true, it is assumed that this layer replaces the old
   // layer in tree and is able to diff with it.
   virtual bool IsReplacing(DiffContext* context, const Layer* old_layer) const {
-    return original_layer_id_ == old_layer->original_layer_id_;
+    return original_layer_id_ == context->GetOldLayerOriginalId(old_layer);
   }
 
   // Performs diff with given layer
@@ -154,6 +160,19 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Returns true if this layer was prerolled with the same inputs before, in
+  // which case the results of that Preroll, which are stored on the layer and
+  // its subtree, still hold and |context| has been updated with its outputs.
+  //
+  // Only subtrees with a structural hash qualify, since their preroll results
+  // depend on nothing but the state stack, and only while no raster cache is
+  // in use, since the raster cache expects to see its items every frame.
+  bool TryReusePreroll(PrerollContext* context) const;
+
+  // Remembers the inputs and outputs of the Preroll that was just performed
+  // for |TryReusePreroll|.
+  void RecordPreroll(const PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -230,6 +249,24 @@ class Layer {
            !context.state_stack.content_culled(paint_bounds_);
   }
 
+  static constexpr size_t kNoStructuralHash = 0;
+
+  // A hash of the type and properties of this layer and of its subtree, or
+  // |kNoStructuralHash| if the subtree contains a layer whose rendering isn't
+  // fully described by its properties, such as textures and platform views.
+  //
+  // Subtrees with equal hashes render identically in the same context, which
+  // allows |LayerTree::ReuseIdenticalSubtrees| to replace a rebuilt subtree
+  // with the instance of the previous frame. Since containers receive their
+  // children after construction, the hash is computed on first use, once the
+  // layer tree has been handed to the raster thread.
+  size_t structural_hash() const;
+
+  // Whether |other| is a hashable subtree that renders identically to this
+  // one. Equal |structural_hash| values only make that likely, so the types,
+  // properties and children of both subtrees are compared as well.
+  bool IsStructurallyEqual(const Layer& other) const;
+
   // Propagated unique_id of the first layer in "chain" of replacement layers
   // that can be diffed.
   uint64_t original_layer_id() const { return original_layer_id_; }
@@ -251,11 +288,49 @@ class Layer {
   }
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
+ protected:
+  // Identifies the layer class in structural hashes.
+  enum class StructuralHashType {
+    kTransform,
+    kClipRect,
+    kClipRRect,
+    kOpacity,
+    kDisplayList,
+  };
+
+  // Computes |structural_hash|. Layers are not hashable by default, and
+  // subclasses that opt in must include all of the properties that affect
+  // their rendering.
+  virtual size_t ComputeStructuralHash() const { return kNoStructuralHash; }
+
+  // The type that |ComputeStructuralHash| identifies this layer by. Layers
+  // that are hashable must return it and implement
+  // |StructuralPropertiesEqual|.
+  virtual std::optional<StructuralHashType> structural_hash_type() const {
+    return std::nullopt;
+  }
+
+  // Compares everything that |ComputeStructuralHash| includes with |other|,
+  // which is a layer of the same |structural_hash_type|.
+  virtual bool StructuralPropertiesEqual(const Layer& other) const {
+    return false;
+  }
+
  private:
+  // The state a layer was last prerolled with, see |TryReusePreroll|.
+  struct PrerollRecord {
+    DlMatrix matrix;
+    DlRect cull_rect;
+    bool surface_needs_readback;
+    int renderable_state_flags;
+  };
+
   DlRect paint_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
+  mutable std::optional<size_t> structural_hash_;
+  std::optional<PrerollRecord> last_preroll_;
 
   static uint64_t NextUniqueID();
 
@@ -7,6 +7,7 @@
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
@@ -63,6 +64,140 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   return context.surface_needs_readback;
 }
 
+namespace {
+
+using LayerSet = std::unordered_set<const Layer*>;
+using SubtreeMap = std::unordered_map<size_t, std::shared_ptr<Layer>>;
+
+void CollectLayers(const Layer* layer, LayerSet& layers) {
+  layers.insert(layer);
+  if (auto* container = layer->as_container_layer()) {
+    for (auto& child : container->layers()) {
+      CollectLayers(child.get(), layers);
+    }
+  }
+}
+
+bool AnyLayerIn(const Layer* layer, const LayerSet& layers) {
+  if (layers.find(layer) != layers.end()) {
+    return true;
+  }
+  if (auto* container = layer->as_container_layer()) {
+    for (auto& child : container->layers()) {
+      if (AnyLayerIn(child.get(), layers)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Collects the hashable subtrees of the previous tree. Of several identical
+// subtrees, the first one in paint order is kept.
+void CollectHashedSubtrees(const std::shared_ptr<Layer>& layer,
+                           SubtreeMap& subtrees,
+                           LayerSet& layers) {
+  layers.insert(layer.get());
+  if (layer->structural_hash() != Layer::kNoStructuralHash) {
+    subtrees.try_emplace(layer->structural_hash(), layer);
+  }
+  if (auto* container = layer->as_container_layer()) {
+    for (auto& child : container->layers()) {
+      CollectHashedSubtrees(child, subtrees, layers);
+    }
+  }
+}
+
+// Records the ids that the UI thread knows the rebuilt layers by for the
+// reused ones, so that the layers of the next frame that were given the
+// rebuilt layers as their old layers still diff against what was actually
+// drawn. The reused layers belong to the previous tree, which the UI thread
+// may still reference, so they are not modified.
+void MapOriginalLayerIds(const Layer* rebuilt,
+                         const Layer* reused,
+                         OriginalLayerIdMap& original_layer_ids) {
+  original_layer_ids[reused->unique_id()] = rebuilt->original_layer_id();
+  auto* rebuilt_container = rebuilt->as_container_layer();
+  auto* reused_container = reused->as_container_layer();
+  if (!rebuilt_container || !reused_container) {
+    return;
+  }
+  // Structurally equal subtrees have the same shape.
+  FML_DCHECK(rebuilt_container->layers().size() ==
+             reused_container->layers().size());
+  for (size_t i = 0; i < rebuilt_container->layers().size(); i++) {
+    MapOriginalLayerIds(rebuilt_container->layers()[i].get(),
+                        reused_container->layers()[i].get(),
+                        original_layer_ids);
+  }
+}
+
+size_t ReplaceHashedSubtrees(ContainerLayer* container,
+                             SubtreeMap& previous_subtrees,
+                             const LayerSet& previous_layers,
+                             LayerSet& used_layers,
+                             OriginalLayerIdMap& original_layer_ids) {
+  size_t replaced = 0;
+  const auto& children = container->layers();
+  for (size_t i = 0; i < children.size(); i++) {
+    const std::shared_ptr<Layer>& child = children[i];
+    if (previous_layers.find(child.get()) != previous_layers.end()) {
+      // Already shared with the previous tree, such as a retained layer.
+      continue;
+    }
+    size_t hash = child->structural_hash();
+    if (hash != Layer::kNoStructuralHash) {
+      auto found = previous_subtrees.find(hash);
+      // Equal hashes are not proof of equal subtrees, so they are compared
+      // before one stands in for the other.
+      if (found != previous_subtrees.end() &&
+          child->IsStructurallyEqual(*found->second) &&
+          !AnyLayerIn(found->second.get(), used_layers)) {
+        CollectLayers(found->second.get(), used_layers);
+        MapOriginalLayerIds(child.get(), found->second.get(),
+                            original_layer_ids);
+        container->ReplaceLayer(i, std::move(found->second));
+        previous_subtrees.erase(found);
+        replaced++;
+        continue;
+      }
+    }
+    if (child->as_container_layer()) {
+      replaced += ReplaceHashedSubtrees(
+          static_cast<ContainerLayer*>(child.get()), previous_subtrees,
+          previous_layers, used_layers, original_layer_ids);
+    }
+  }
+  return replaced;
+}
+
+}  // namespace
+
+size_t LayerTree::ReuseIdenticalSubtrees(const LayerTree* previous) {
+  TRACE_EVENT0("flutter", "LayerTree::ReuseIdenticalSubtrees");
+  if (!previous || previous == this || !previous->root_layer_ ||
+      !root_layer_ || !root_layer_->as_container_layer()) {
+    return 0;
+  }
+
+  SubtreeMap previous_subtrees;
+  LayerSet previous_layers;
+  CollectHashedSubtrees(previous->root_layer_, previous_subtrees,
+                        previous_layers);
+  if (previous_subtrees.empty()) {
+    return 0;
+  }
+
+  // The layers of this tree, to which the previous instances are added as
+  // they are substituted, so that no layer is used twice.
+  LayerSet used_layers;
+  CollectLayers(root_layer_.get(), used_layers);
+
+  return ReplaceHashedSubtrees(
+      static_cast<ContainerLayer*>(root_layer_.get()), previous_subtrees,
+      previous_layers, used_layers, original_layer_id_map_);
+}
+
 #if !SLIMPELLER
 void LayerTree::TryToRasterCache(
     const std::vector<RasterCacheItem*>& raster_cached_items,
@@ -132,6 +267,12 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       // clang-format on
   };
 
+  LayerCostRecorder& cost_recorder = frame.context().layer_cost_recorder();
+  cost_recorder.AttachToRenderer(frame.aiks_context());
+  if (cost_recorder.enabled()) {
+    context.layer_cost_recorder = &cost_recorder;
+  }
+
 #if !SLIMPELLER
   if (cache) {
     cache->EvictUnusedCacheEntries();
@@ -139,9 +280,20 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   }
 #endif  //  !SLIMPELLER
 
+  if (context.layer_cost_recorder) {
+    cost_recorder.BeginFrame();
+  }
+
   if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
+
+  if (context.layer_cost_recorder) {
+    cost_recorder.EndFrame();
+    if (cost_recorder.heat_map_enabled()) {
+      cost_recorder.DrawHeatMap(canvas);
+    }
+  }
 }
 
 sk_sp<DisplayList> LayerTree::Flatten(
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/compositor_context.h"
@@ -45,6 +47,21 @@ class LayerTree {
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
+  // Replaces the subtrees of this tree that are structurally equal to a
+  // subtree of |previous| with the instance from |previous|.
+  //
+  // Rebuilt but unchanged subtrees are then treated like retained layers:
+  // diffing skips them, their raster cache entries keep their keys, and
+  // their preroll results can be reused. Layers that are already shared with
+  // |previous| are left alone, and no layer ends up in the tree twice.
+  //
+  // The substituted layers may still be referenced by the UI thread, so they
+  // are not modified. Instead, |original_layer_id_map| records the ids of the
+  // rebuilt layers they stand in for, which the next frame is diffed with.
+  //
+  // Returns the number of replaced subtrees.
+  size_t ReuseIdenticalSubtrees(const LayerTree* previous);
+
   sk_sp<DisplayList> Flatten(
       const DlRect& bounds,
       const std::shared_ptr<TextureRegistry>& texture_registry = nullptr,
@@ -56,11 +73,16 @@ class LayerTree {
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  const OriginalLayerIdMap& original_layer_id_map() const {
+    return original_layer_id_map_;
+  }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   DlISize frame_size_;  // Physical pixels.
 
   PaintRegionMap paint_region_map_;
+  OriginalLayerIdMap original_layer_id_map_;
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
@@ -7,6 +7,9 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -278,5 +281,149 @@ TEST_F(LayerTreeTest, PaintContextInitialization) {
   expect_defaults(context);
 }
 
+static sk_sp<DisplayList> MakeRectDisplayList(const DlRect& rect) {
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, DlPaint());
+  return builder.Build();
+}
+
+// Builds a transform over an opacity over a picture, as a framework would
+// rebuild it every frame.
+static std::shared_ptr<Layer> BuildSubtree(
+    const sk_sp<DisplayList>& display_list,
+    uint8_t alpha) {
+  auto picture =
+      std::make_shared<DisplayListLayer>(DlPoint(), display_list, false, false);
+  auto opacity = std::make_shared<OpacityLayer>(alpha, DlPoint());
+  opacity->Add(picture);
+  auto transform =
+      std::make_shared<TransformLayer>(DlMatrix::MakeTranslation({5, 5}));
+  transform->Add(opacity);
+  return transform;
+}
+
+TEST_F(LayerTreeTest, ReuseIdenticalSubtrees) {
+  auto display_list1 = MakeRectDisplayList(DlRect::MakeWH(10, 10));
+  auto display_list2 = MakeRectDisplayList(DlRect::MakeWH(20, 20));
+
+  auto old_root = std::make_shared<ContainerLayer>();
+  old_root->Add(BuildSubtree(display_list1, 128));
+  old_root->Add(BuildSubtree(display_list2, 128));
+  auto old_tree = BuildLayerTree(old_root);
+
+  auto new_root = std::make_shared<ContainerLayer>();
+  auto rebuilt = BuildSubtree(display_list1, 128);
+  new_root->Add(rebuilt);
+  new_root->Add(BuildSubtree(display_list2, 255));
+  auto new_tree = BuildLayerTree(new_root);
+
+  EXPECT_EQ(rebuilt->structural_hash(),
+            old_root->layers()[0]->structural_hash());
+  EXPECT_NE(new_root->layers()[1]->structural_hash(),
+            old_root->layers()[1]->structural_hash());
+
+  EXPECT_EQ(new_tree->ReuseIdenticalSubtrees(old_tree.get()), 2u);
+
+  // The unchanged subtree is replaced as a whole, and of the changed one
+  // only the unchanged picture is.
+  EXPECT_EQ(new_root->layers()[0], old_root->layers()[0]);
+  EXPECT_NE(new_root->layers()[1], old_root->layers()[1]);
+  auto* old_transform = old_root->layers()[1]->as_container_layer();
+  auto* new_transform = new_root->layers()[1]->as_container_layer();
+  EXPECT_EQ(new_transform->layers()[0]->as_container_layer()->layers()[0],
+            old_transform->layers()[0]->as_container_layer()->layers()[0]);
+
+  // The layers of the previous tree are left untouched, and layers of the
+  // next frame that name the rebuilt layer as their old layer still diff
+  // against the instance that is actually drawn.
+  const Layer* reused = new_root->layers()[0].get();
+  EXPECT_NE(reused->original_layer_id(), rebuilt->original_layer_id());
+  auto next = BuildSubtree(display_list1, 128);
+  next->AssignOldLayer(rebuilt.get());
+  PaintRegionMap next_paint_region_map;
+  DiffContext diff_context(DlISize(64, 64), next_paint_region_map,
+                           new_tree->paint_region_map(), false, false,
+                           &new_tree->original_layer_id_map());
+  EXPECT_TRUE(next->IsReplacing(&diff_context, reused));
+}
+
+// A picture whose structural hash collides with that of every other one.
+class CollidingDisplayListLayer : public DisplayListLayer {
+ public:
+  using DisplayListLayer::DisplayListLayer;
+
+ protected:
+  size_t ComputeStructuralHash() const override { return 42; }
+};
+
+TEST_F(LayerTreeTest, ReuseIdenticalSubtreesComparesSubtreesWithEqualHashes) {
+  auto old_root = std::make_shared<ContainerLayer>();
+  old_root->Add(std::make_shared<CollidingDisplayListLayer>(
+      DlPoint(), MakeRectDisplayList(DlRect::MakeWH(10, 10)), false, false));
+  auto old_tree = BuildLayerTree(old_root);
+
+  auto new_root = std::make_shared<ContainerLayer>();
+  auto rebuilt = std::make_shared<CollidingDisplayListLayer>(
+      DlPoint(), MakeRectDisplayList(DlRect::MakeWH(20, 20)), false, false);
+  new_root->Add(rebuilt);
+  auto new_tree = BuildLayerTree(new_root);
+
+  EXPECT_EQ(rebuilt->structural_hash(),
+            old_root->layers()[0]->structural_hash());
+  EXPECT_EQ(new_tree->ReuseIdenticalSubtrees(old_tree.get()), 0u);
+  EXPECT_EQ(new_root->layers()[0], rebuilt);
+}
+
+TEST_F(LayerTreeTest, ReuseIdenticalSubtreesComparesPictureHints) {
+  auto display_list = MakeRectDisplayList(DlRect::MakeWH(10, 10));
+
+  auto old_root = std::make_shared<ContainerLayer>();
+  old_root->Add(std::make_shared<DisplayListLayer>(DlPoint(), display_list,
+                                                   false, false));
+  auto old_tree = BuildLayerTree(old_root);
+
+  auto new_root = std::make_shared<ContainerLayer>();
+  new_root->Add(
+      std::make_shared<DisplayListLayer>(DlPoint(), display_list, true, false));
+  new_root->Add(
+      std::make_shared<DisplayListLayer>(DlPoint(), display_list, false, true));
+  auto new_tree = BuildLayerTree(new_root);
+
+  EXPECT_EQ(new_tree->ReuseIdenticalSubtrees(old_tree.get()), 0u);
+}
+
+TEST_F(LayerTreeTest, ReuseIdenticalSubtreesUsesEachLayerOnce) {
+  auto display_list = MakeRectDisplayList(DlRect::MakeWH(10, 10));
+
+  auto old_root = std::make_shared<ContainerLayer>();
+  old_root->Add(BuildSubtree(display_list, 128));
+  auto old_tree = BuildLayerTree(old_root);
+
+  auto new_root = std::make_shared<ContainerLayer>();
+  new_root->Add(BuildSubtree(display_list, 128));
+  new_root->Add(BuildSubtree(display_list, 128));
+  auto new_tree = BuildLayerTree(new_root);
+
+  EXPECT_EQ(new_tree->ReuseIdenticalSubtrees(old_tree.get()), 1u);
+  EXPECT_EQ(new_root->layers()[0], old_root->layers()[0]);
+  EXPECT_NE(new_root->layers()[1], old_root->layers()[0]);
+}
+
+TEST_F(LayerTreeTest, ReuseIdenticalSubtreesSkipsRetainedLayers) {
+  auto display_list = MakeRectDisplayList(DlRect::MakeWH(10, 10));
+  auto retained = BuildSubtree(display_list, 128);
+
+  auto old_root = std::make_shared<ContainerLayer>();
+  old_root->Add(retained);
+  auto old_tree = BuildLayerTree(old_root);
+
+  auto new_root = std::make_shared<ContainerLayer>();
+  new_root->Add(retained);
+  auto new_tree = BuildLayerTree(new_root);
+
+  EXPECT_EQ(new_tree->ReuseIdenticalSubtrees(old_tree.get()), 0u);
+  EXPECT_EQ(new_root->layers()[0], retained);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -95,4 +96,19 @@ void OpacityLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+size_t OpacityLayer::ComputeStructuralHash() const {
+  size_t children_hash = ChildrenStructuralHash();
+  if (children_hash == kNoStructuralHash) {
+    return kNoStructuralHash;
+  }
+  return fml::HashCombine(StructuralHashType::kOpacity, children_hash, alpha_,
+                          offset_.x, offset_.y);
+}
+
+bool OpacityLayer::StructuralPropertiesEqual(const Layer& other) const {
+  auto& other_opacity = static_cast<const OpacityLayer&>(other);
+  return alpha_ == other_opacity.alpha_ && offset_ == other_opacity.offset_ &&
+         ChildrenStructurallyEqual(other_opacity);
+}
+
 }  // namespace flutter
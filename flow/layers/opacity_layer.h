@@ -46,6 +46,15 @@ class OpacityLayer : public CacheableContainerLayer {
 
   DlScalar opacity() const { return DlColor::toOpacity(alpha_); }
 
+ protected:
+  size_t ComputeStructuralHash() const override;
+
+  std::optional<StructuralHashType> structural_hash_type() const override {
+    return StructuralHashType::kOpacity;
+  }
+
+  bool StructuralPropertiesEqual(const Layer& other) const override;
+
  private:
   uint8_t alpha_;
   DlPoint offset_;
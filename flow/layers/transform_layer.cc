@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
 TransformLayer::TransformLayer(const DlMatrix& transform)
@@ -51,4 +53,23 @@ void TransformLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+size_t TransformLayer::ComputeStructuralHash() const {
+  size_t children_hash = ChildrenStructuralHash();
+  if (children_hash == kNoStructuralHash) {
+    return kNoStructuralHash;
+  }
+  size_t hash =
+      fml::HashCombine(StructuralHashType::kTransform, children_hash);
+  for (DlScalar value : transform_.m) {
+    fml::HashCombineSeed(hash, value);
+  }
+  return hash;
+}
+
+bool TransformLayer::StructuralPropertiesEqual(const Layer& other) const {
+  auto& other_transform = static_cast<const TransformLayer&>(other);
+  return transform_ == other_transform.transform_ &&
+         ChildrenStructurallyEqual(other_transform);
+}
+
 }  // namespace flutter
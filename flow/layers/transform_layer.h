@@ -19,6 +19,15 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+ protected:
+  size_t ComputeStructuralHash() const override;
+
+  std::optional<StructuralHashType> structural_hash_type() const override {
+    return StructuralHashType::kTransform;
+  }
+
+  bool StructuralPropertiesEqual(const Layer& other) const override;
+
  private:
   DlMatrix transform_;
 
@@ -0,0 +1,515 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// The type of the records that carry the second and further flow ids of the
+// event recorded before them.
+constexpr uint8_t kFlowIdRecordType = 0xFF;
+
+constexpr size_t kMinRecordsPerThread = 16;
+constexpr size_t kNameCacheSize = 256;
+constexpr size_t kMaxNames = 4096;
+static_assert(kMaxNames <= UINT16_MAX,
+              "The ids of the names of counter values are 16 bit.");
+
+struct Record {
+  int64_t timestamp_micros;
+  // The async or flow id, the end timestamp of a duration, or the bits of the
+  // double value of a counter.
+  int64_t id;
+  uint64_t flow_id;
+  uint32_t name_id;
+  uint16_t argument_name_id;
+  uint8_t type;
+  uint8_t has_flow_id;
+};
+
+// A ring buffer of records that only its thread appends to, and that any
+// thread can copy from while it is being appended to. When its thread exits,
+// the buffer can be reused by a new thread.
+//
+// The records are stored as relaxed atomic words. Before writing a slot,
+// the writer announces the index it is about to write in |started_|. After
+// copying, a reader discards the records that may have been overwritten
+// while it copied them, as told by |started_|.
+class ThreadBuffer {
+ public:
+  ThreadBuffer(size_t capacity, uint32_t thread_id)
+      : thread_id_(thread_id),
+        capacity_(capacity),
+        slots_(new Slot[capacity]()) {}
+
+  uint32_t thread_id() const { return thread_id_; }
+
+  size_t capacity() const { return capacity_; }
+
+  void Append(const Record& record) {
+    uint64_t index = published_.load(std::memory_order_relaxed);
+    started_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = slots_[index & (capacity_ - 1)];
+    slot.words[0].store(static_cast<uint64_t>(record.timestamp_micros),
+                        std::memory_order_relaxed);
+    slot.words[1].store(static_cast<uint64_t>(record.id),
+                        std::memory_order_relaxed);
+    slot.words[2].store(record.flow_id, std::memory_order_relaxed);
+    slot.words[3].store(static_cast<uint64_t>(record.name_id) |
+                            static_cast<uint64_t>(record.argument_name_id)
+                                << 32 |
+                            static_cast<uint64_t>(record.type) << 48 |
+                            static_cast<uint64_t>(record.has_flow_id) << 56,
+                        std::memory_order_relaxed);
+
+    published_.store(index + 1, std::memory_order_release);
+  }
+
+  void Collect(std::vector<Record>& records) const {
+    uint64_t end = published_.load(std::memory_order_acquire);
+    uint64_t begin = std::max(discard_before_.load(std::memory_order_relaxed),
+                              end > capacity_ ? end - capacity_ : 0);
+    std::vector<Record> copied;
+    copied.reserve(end - begin);
+    for (uint64_t index = begin; index < end; index++) {
+      const Slot& slot = slots_[index & (capacity_ - 1)];
+      uint64_t packed = slot.words[3].load(std::memory_order_relaxed);
+      copied.push_back({
+          .timestamp_micros = static_cast<int64_t>(
+              slot.words[0].load(std::memory_order_relaxed)),
+          .id = static_cast<int64_t>(
+              slot.words[1].load(std::memory_order_relaxed)),
+          .flow_id = slot.words[2].load(std::memory_order_relaxed),
+          .name_id = static_cast<uint32_t>(packed),
+          .argument_name_id = static_cast<uint16_t>(packed >> 32),
+          .type = static_cast<uint8_t>(packed >> 48),
+          .has_flow_id = static_cast<uint8_t>(packed >> 56),
+      });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t started = started_.load(std::memory_order_relaxed);
+    uint64_t valid_begin = started > capacity_ ? started - capacity_ : 0;
+    for (uint64_t index = begin; index < end; index++) {
+      if (index >= valid_begin) {
+        records.push_back(copied[index - begin]);
+      }
+    }
+  }
+
+  void Reset() {
+    discard_before_.store(published_.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+  }
+
+  // Hands the buffer of an exited thread to a new thread. Must be called with
+  // the registry locked, as the thread id is read by the dumps.
+  void Reuse(uint32_t thread_id) {
+    thread_id_ = thread_id;
+    Reset();
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> words[4];
+  };
+
+  uint32_t thread_id_;
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> started_ = 0;
+  std::atomic<uint64_t> published_ = 0;
+  std::atomic<uint64_t> discard_before_ = 0;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  // The buffers of the threads that exited, the most recent last.
+  std::vector<ThreadBuffer*> free_buffers;
+  uint32_t next_thread_id = 1;
+  // Name ids start at 1, so that 0 stands for no name.
+  std::unordered_map<std::string, uint32_t> name_ids;
+  std::deque<std::string> names;
+};
+
+// Leaked, as threads may still trace while static objects are destroyed.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+std::atomic<bool> gTraceBufferEnabled = false;
+std::atomic<size_t> gRecordsPerThread = kDefaultTraceBufferRecordsPerThread;
+
+// Bumped when the names are dropped, which invalidates the name caches.
+std::atomic<uint32_t> gNameGeneration = 1;
+
+thread_local ThreadBuffer* tThreadBuffer;
+thread_local bool tThreadExited;
+
+// Returns the buffer of its thread to the free buffers when the thread exits.
+class ThreadBufferOwner {
+ public:
+  ~ThreadBufferOwner() {
+    if (buffer) {
+      Registry& registry = GetRegistry();
+      std::scoped_lock lock(registry.mutex);
+      registry.free_buffers.push_back(buffer);
+    }
+    tThreadBuffer = nullptr;
+    tThreadExited = true;
+  }
+
+  ThreadBuffer* buffer = nullptr;
+};
+thread_local ThreadBufferOwner tThreadBufferOwner;
+
+// Caches the ids of the names by their pointer, which are usually string
+// literals. The hash of the string is compared as well, since the names of
+// some events are built at runtime.
+struct NameCacheEntry {
+  const char* pointer;
+  uint64_t hash;
+  uint32_t generation;
+  uint32_t id;
+};
+thread_local NameCacheEntry tNameCache[kNameCacheSize];
+
+// Returns nullptr once the thread is exiting, as its buffer has been freed.
+ThreadBuffer* GetThreadBuffer() {
+  if (tThreadBuffer || tThreadExited) {
+    return tThreadBuffer;
+  }
+  size_t capacity = gRecordsPerThread.load(std::memory_order_relaxed);
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  ThreadBuffer* buffer = nullptr;
+  while (!registry.free_buffers.empty() && !buffer) {
+    ThreadBuffer* free_buffer = registry.free_buffers.back();
+    registry.free_buffers.pop_back();
+    if (free_buffer->capacity() == capacity) {
+      free_buffer->Reuse(registry.next_thread_id++);
+      buffer = free_buffer;
+    } else {
+      // The capacity changed since the buffer was created.
+      registry.buffers.erase(std::remove_if(
+          registry.buffers.begin(), registry.buffers.end(),
+          [free_buffer](const std::unique_ptr<ThreadBuffer>& other) {
+            return other.get() == free_buffer;
+          }));
+    }
+  }
+  if (!buffer) {
+    registry.buffers.push_back(
+        std::make_unique<ThreadBuffer>(capacity, registry.next_thread_id++));
+    buffer = registry.buffers.back().get();
+  }
+  tThreadBufferOwner.buffer = buffer;
+  tThreadBuffer = buffer;
+  return buffer;
+}
+
+uint64_t HashName(const char* name) {
+  // FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const char* c = name; *c; c++) {
+    hash = (hash ^ static_cast<unsigned char>(*c)) * 0x100000001b3;
+  }
+  return hash;
+}
+
+// Returns 0 for the names that do not fit in the table.
+uint32_t InternName(const char* name) {
+  if (!name) {
+    return 0;
+  }
+  uint64_t hash = HashName(name);
+  NameCacheEntry& entry =
+      tNameCache[(reinterpret_cast<uintptr_t>(name) >> 3) % kNameCacheSize];
+  if (entry.pointer == name && entry.hash == hash &&
+      entry.generation == gNameGeneration.load(std::memory_order_relaxed)) {
+    return entry.id;
+  }
+
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  uint32_t id = 0;
+  auto it = registry.name_ids.find(name);
+  if (it != registry.name_ids.end()) {
+    id = it->second;
+  } else if (registry.names.size() < kMaxNames) {
+    id = static_cast<uint32_t>(registry.names.size() + 1);
+    registry.name_ids.emplace(name, id);
+    registry.names.emplace_back(name);
+  }
+  entry = {
+      .pointer = name,
+      .hash = hash,
+      .generation = gNameGeneration.load(std::memory_order_relaxed),
+      .id = id,
+  };
+  return id;
+}
+
+const char* GetPhase(uint8_t type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return nullptr;
+  }
+}
+
+void WriteJSONString(std::ostringstream& out, const std::string& string) {
+  out << '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out << escaped;
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+void WriteEvent(std::ostringstream& out,
+                const std::deque<std::string>& names,
+                uint32_t thread_id,
+                const Record& record,
+                const std::vector<uint64_t>& flow_ids,
+                bool& first_event) {
+  const char* phase = GetPhase(record.type);
+  if (!phase) {
+    return;
+  }
+  auto name = [&names](uint32_t id) -> const std::string& {
+    static const std::string kUnknown = "unknown";
+    return id > 0 && id <= names.size() ? names[id - 1] : kUnknown;
+  };
+
+  out << (first_event ? "\n" : ",\n") << "{\"name\":";
+  first_event = false;
+  WriteJSONString(out, name(record.name_id));
+  out << ",\"cat\":\"flutter\",\"ph\":\"" << phase
+      << "\",\"ts\":" << record.timestamp_micros << ",\"pid\":0,\"tid\":"
+      << thread_id;
+  switch (record.type) {
+    case Dart_Timeline_Event_Instant:
+      out << ",\"s\":\"t\"";
+      break;
+    case Dart_Timeline_Event_Duration:
+      out << ",\"dur\":" << record.id - record.timestamp_micros;
+      break;
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+      out << ",\"id\":\"0x" << std::hex << static_cast<uint64_t>(record.id)
+          << std::dec << '"';
+      break;
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+      out << ",\"id\":\"0x" << std::hex << static_cast<uint64_t>(record.id)
+          << std::dec << "\",\"bp\":\"e\"";
+      break;
+    case Dart_Timeline_Event_Counter: {
+      double value;
+      std::memcpy(&value, &record.id, sizeof(value));
+      out << ",\"args\":{";
+      WriteJSONString(out, name(record.argument_name_id));
+      out << ':' << value << '}';
+      break;
+    }
+  }
+  if (!flow_ids.empty()) {
+    out << ",\"args\":{\"flow_ids\":[";
+    for (size_t i = 0; i < flow_ids.size(); i++) {
+      out << (i == 0 ? "" : ",") << flow_ids[i];
+    }
+    out << "]}";
+  }
+  out << '}';
+}
+
+}  // namespace
+
+void TraceBufferEnable(size_t records_per_thread) {
+  size_t capacity = kMinRecordsPerThread;
+  while (capacity < records_per_thread) {
+    capacity <<= 1;
+  }
+  gRecordsPerThread.store(capacity, std::memory_order_relaxed);
+  gTraceBufferEnabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceBufferDisable() {
+  gTraceBufferEnabled.store(false, std::memory_order_relaxed);
+}
+
+bool TraceBufferIsEnabled() {
+  return gTraceBufferEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceBufferReset() {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (auto& buffer : registry.buffers) {
+    buffer->Reset();
+  }
+  registry.name_ids.clear();
+  registry.names.clear();
+  gNameGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string TraceBufferDumpJSON() {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+
+  std::ostringstream out;
+  out << "{\"traceEvents\":[";
+  bool first_event = true;
+  std::vector<Record> records;
+  std::vector<uint64_t> flow_ids;
+  for (const auto& buffer : registry.buffers) {
+    records.clear();
+    buffer->Collect(records);
+
+    const Record* event = nullptr;
+    for (const Record& record : records) {
+      if (record.type == kFlowIdRecordType) {
+        // Drop the extra flow ids of an event that has been overwritten.
+        if (event) {
+          flow_ids.push_back(record.flow_id);
+        }
+        continue;
+      }
+      if (event) {
+        WriteEvent(out, registry.names, buffer->thread_id(), *event, flow_ids,
+                   first_event);
+      }
+      event = &record;
+      flow_ids.clear();
+      if (record.has_flow_id) {
+        flow_ids.push_back(record.flow_id);
+      }
+    }
+    if (event) {
+      WriteEvent(out, registry.names, buffer->thread_id(), *event, flow_ids,
+                 first_event);
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return out.str();
+}
+
+void TraceBufferRecord(const char* name,
+                       int64_t timestamp_micros,
+                       int64_t timestamp1_or_id,
+                       intptr_t flow_id_count,
+                       const int64_t* flow_ids,
+                       Dart_Timeline_Event_Type type,
+                       intptr_t argument_count,
+                       const char** argument_names,
+                       const char** argument_values) {
+  if (!TraceBufferIsEnabled()) {
+    return;
+  }
+  // Before the Dart VM has started, the timeline has no clock.
+  if (timestamp_micros < 0) {
+    timestamp_micros = TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  }
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (!buffer) {
+    return;
+  }
+  Record record = {
+      .timestamp_micros = timestamp_micros,
+      .id = timestamp1_or_id,
+      .flow_id = flow_id_count > 0 ? static_cast<uint64_t>(flow_ids[0]) : 0,
+      .name_id = InternName(name),
+      .argument_name_id = 0,
+      .type = static_cast<uint8_t>(type),
+      .has_flow_id = flow_id_count > 0,
+  };
+
+  if (type == Dart_Timeline_Event_Counter) {
+    // A counter is recorded once for each of its values.
+    for (intptr_t i = 0; i < argument_count; i++) {
+      double value = std::strtod(argument_values[i], nullptr);
+      std::memcpy(&record.id, &value, sizeof(value));
+      record.argument_name_id = InternName(argument_names[i]);
+      buffer->Append(record);
+    }
+    return;
+  }
+
+  buffer->Append(record);
+  for (intptr_t i = 1; i < flow_id_count; i++) {
+    buffer->Append({
+        .timestamp_micros = timestamp_micros,
+        .id = 0,
+        .flow_id = static_cast<uint64_t>(flow_ids[i]),
+        .name_id = record.name_id,
+        .argument_name_id = 0,
+        .type = kFlowIdRecordType,
+        .has_flow_id = 1,
+    });
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
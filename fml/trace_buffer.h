@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_BUFFER_H_
+#define FLUTTER_FML_TRACE_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+// An in-memory recorder for the events of the TRACE_EVENT* macros that does
+// not depend on the Dart VM.
+//
+// Every thread records into its own fixed size ring buffer, so recording an
+// event takes no locks and allocates nothing once the names of the events
+// have been interned. Each event is a 32 byte record of its timestamp, the
+// id of its interned name, its async or flow id, its first flow id and its
+// type. Further flow ids and the values of counters take one more record
+// each. The string arguments of events are not recorded.
+//
+// The buffer of a thread that exited keeps its events, so that events of
+// short lived threads, such as those of engine startup, can still be dumped,
+// until a new thread reuses it.
+//
+// At most 4096 distinct event names are interned until the next reset. The
+// events of further names are dumped with the name "unknown".
+
+namespace fml {
+namespace tracing {
+
+static constexpr size_t kDefaultTraceBufferRecordsPerThread = 4096;
+
+//------------------------------------------------------------------------------
+/// @brief      Starts recording trace events into the ring buffers. Events are
+///             recorded even when no timeline event handler has been set.
+///
+/// @param[in]  records_per_thread  The capacity of the ring buffers that are
+///                                 created from now on, rounded up to a power
+///                                 of two. When a buffer is full, the oldest
+///                                 records are overwritten.
+///
+void TraceBufferEnable(
+    size_t records_per_thread = kDefaultTraceBufferRecordsPerThread);
+
+void TraceBufferDisable();
+
+bool TraceBufferIsEnabled();
+
+//------------------------------------------------------------------------------
+/// @brief      Drops the events recorded so far, and the interned names.
+///
+void TraceBufferReset();
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the recorded events of all threads in the Chrome trace
+///             event JSON format, which Perfetto and chrome://tracing load.
+///
+std::string TraceBufferDumpJSON();
+
+// Records an event. Called by the trace event functions of trace_event.h
+// while the buffer is enabled.
+void TraceBufferRecord(const char* name,
+                       int64_t timestamp_micros,
+                       int64_t timestamp1_or_id,
+                       intptr_t flow_id_count,
+                       const int64_t* flow_ids,
+                       Dart_Timeline_Event_Type type,
+                       intptr_t argument_count,
+                       const char** argument_names,
+                       const char** argument_values);
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_BUFFER_H_
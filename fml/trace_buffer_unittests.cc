@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_buffer.h"
+
+#include <string>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+class TraceBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TraceBufferEnable();
+    TraceBufferReset();
+  }
+
+  void TearDown() override {
+    TraceBufferDisable();
+    TraceBufferReset();
+  }
+};
+
+static void RecordEvent(const char* name,
+                        Dart_Timeline_Event_Type type,
+                        intptr_t flow_id_count = 0,
+                        const int64_t* flow_ids = nullptr) {
+  TraceBufferRecord(name, 1000, 0, flow_id_count, flow_ids, type, 0, nullptr,
+                    nullptr);
+}
+
+TEST_F(TraceBufferTest, DumpsEventsAsChromeJSON) {
+  const int64_t flow_ids[] = {42, 43};
+  RecordEvent("TraceBufferTest::Event", Dart_Timeline_Event_Begin, 2,
+              flow_ids);
+  RecordEvent("TraceBufferTest::Event", Dart_Timeline_Event_End);
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_NE(json.find("{\"name\":\"TraceBufferTest::Event\",\"cat\":"
+                      "\"flutter\",\"ph\":\"B\",\"ts\":1000"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"ph\":\"E\""), std::string::npos) << json;
+  EXPECT_NE(json.find("\"args\":{\"flow_ids\":[42,43]}"), std::string::npos)
+      << json;
+}
+
+TEST_F(TraceBufferTest, RecordsCounterValues) {
+  const char* names[] = {"bytes"};
+  const char* values[] = {"1024"};
+  TraceBufferRecord("TraceBufferTest::Counter", 1000, 0, 0, nullptr,
+                    Dart_Timeline_Event_Counter, 1, names, values);
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos) << json;
+  EXPECT_NE(json.find("\"args\":{\"bytes\":1024}"), std::string::npos) << json;
+}
+
+TEST_F(TraceBufferTest, TimestampsEventsWithoutTimelineClock) {
+  TraceBufferRecord("TraceBufferTest::Startup", -1, 0, 0, nullptr,
+                    Dart_Timeline_Event_Instant, 0, nullptr, nullptr);
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_NE(json.find("TraceBufferTest::Startup"), std::string::npos);
+  EXPECT_EQ(json.find("\"ts\":-1"), std::string::npos) << json;
+}
+
+TEST_F(TraceBufferTest, KeepsNewestEventsOfExitedThreads) {
+  TraceBufferEnable(16);
+  // The names are built at runtime and reuse the same storage.
+  std::thread thread([] {
+    for (int i = 0; i < 40; i++) {
+      std::string name = "TraceBufferTest::Wrapped" + std::to_string(i) + ";";
+      RecordEvent(name.c_str(), Dart_Timeline_Event_Instant);
+    }
+  });
+  thread.join();
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_EQ(json.find("TraceBufferTest::Wrapped23;"), std::string::npos);
+  for (int i = 24; i < 40; i++) {
+    EXPECT_NE(json.find("TraceBufferTest::Wrapped" + std::to_string(i) + ";"),
+              std::string::npos)
+        << i;
+  }
+}
+
+TEST_F(TraceBufferTest, ReusesBuffersOfExitedThreads) {
+  std::thread([] {
+    RecordEvent("TraceBufferTest::FirstThread", Dart_Timeline_Event_Instant);
+  }).join();
+  EXPECT_NE(TraceBufferDumpJSON().find("TraceBufferTest::FirstThread"),
+            std::string::npos);
+
+  // The next thread reuses the buffer of the first one, which drops its
+  // events.
+  std::thread([] {
+    RecordEvent("TraceBufferTest::SecondThread", Dart_Timeline_Event_Instant);
+  }).join();
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_EQ(json.find("TraceBufferTest::FirstThread"), std::string::npos)
+      << json;
+  EXPECT_NE(json.find("TraceBufferTest::SecondThread"), std::string::npos)
+      << json;
+}
+
+TEST_F(TraceBufferTest, CapsInternedNames) {
+  TraceBufferEnable(8192);
+  std::thread thread([] {
+    for (int i = 0; i < 5000; i++) {
+      std::string name = "TraceBufferTest::Name" + std::to_string(i) + ";";
+      RecordEvent(name.c_str(), Dart_Timeline_Event_Instant);
+    }
+  });
+  thread.join();
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_NE(json.find("TraceBufferTest::Name0;"), std::string::npos);
+  EXPECT_EQ(json.find("TraceBufferTest::Name4999;"), std::string::npos);
+  EXPECT_NE(json.find("{\"name\":\"unknown\""), std::string::npos);
+
+  // Resetting drops the names, which makes room for new ones.
+  TraceBufferReset();
+  RecordEvent("TraceBufferTest::AfterReset", Dart_Timeline_Event_Instant);
+  EXPECT_NE(TraceBufferDumpJSON().find("TraceBufferTest::AfterReset"),
+            std::string::npos);
+}
+
+TEST_F(TraceBufferTest, DisabledBufferRecordsNothing) {
+  TraceBufferDisable();
+  RecordEvent("TraceBufferTest::Disabled", Dart_Timeline_Event_Instant);
+
+  EXPECT_EQ(TraceBufferDumpJSON().find("TraceBufferTest::Disabled"),
+            std::string::npos);
+}
+
+#if FLUTTER_TIMELINE_ENABLED
+TEST_F(TraceBufferTest, RecordsTraceEventsWithoutTimelineHandler) {
+  ASSERT_FALSE(TraceHasTimelineEventHandler());
+  { TRACE_EVENT0("flutter", "TraceBufferTest::Macro"); }
+
+  std::string json = TraceBufferDumpJSON();
+  EXPECT_NE(json.find("TraceBufferTest::Macro"), std::string::npos);
+}
+#endif  // FLUTTER_TIMELINE_ENABLED
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
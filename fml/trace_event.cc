@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_buffer.h"
 
 namespace fml {
 namespace tracing {
@@ -38,9 +39,17 @@ inline void FlutterTimelineEvent(const char* label,
                                  const char** argument_values) {
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
-  if (handler && gAllowlist.Query(label)) {
-    handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
-            type, argument_count, argument_names, argument_values);
+  bool buffered = TraceBufferIsEnabled();
+  if ((handler || buffered) && gAllowlist.Query(label)) {
+    if (buffered) {
+      TraceBufferRecord(label, timestamp0, timestamp1_or_async_id,
+                        flow_id_count, flow_ids, type, argument_count,
+                        argument_names, argument_values);
+    }
+    if (handler) {
+      handler(label, timestamp0, timestamp1_or_async_id, flow_id_count,
+              flow_ids, type, argument_count, argument_names, argument_values);
+    }
   }
 }
 }  // namespace
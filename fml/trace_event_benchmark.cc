@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_event.h"
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_buffer.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+int64_t MonotonicMicros() {
+  return TimePoint::Now().ToEpochDelta().ToMicroseconds();
+}
+
+struct HandledEvent {
+  const char* label;
+  int64_t timestamp;
+  Dart_Timeline_Event_Type type;
+};
+
+// Stands in for the Dart timeline, which locks its recorder and copies every
+// event. The Dart VM cannot record events in this benchmark because it is
+// not initialized.
+std::mutex gHandledEventsMutex;
+std::vector<HandledEvent> gHandledEvents;
+
+void LockingTimelineEventHandler(const char* label,
+                                 int64_t timestamp0,
+                                 int64_t timestamp1_or_async_id,
+                                 intptr_t flow_id_count,
+                                 const int64_t* flow_ids,
+                                 Dart_Timeline_Event_Type type,
+                                 intptr_t argument_count,
+                                 const char** argument_names,
+                                 const char** argument_values) {
+  std::scoped_lock lock(gHandledEventsMutex);
+  if (gHandledEvents.size() == 4096) {
+    gHandledEvents.clear();
+  }
+  gHandledEvents.push_back({label, timestamp0, type});
+}
+
+enum class TraceBackend {
+  kNone,
+  kTimelineHandler,
+  kTraceBuffer,
+};
+
+void BM_TraceEvent0(benchmark::State& state, TraceBackend backend) {
+  tracing::TraceSetTimelineMicrosSource(MonotonicMicros);
+  switch (backend) {
+    case TraceBackend::kNone:
+      break;
+    case TraceBackend::kTimelineHandler:
+      tracing::TraceSetTimelineEventHandler(LockingTimelineEventHandler);
+      break;
+    case TraceBackend::kTraceBuffer:
+      tracing::TraceBufferEnable();
+      break;
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    TRACE_EVENT0("flutter", "BM_TraceEvent0");
+  }
+
+  tracing::TraceSetTimelineEventHandler(nullptr);
+  tracing::TraceBufferDisable();
+  tracing::TraceBufferReset();
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_TraceEvent0, NoBackend, TraceBackend::kNone);
+BENCHMARK_CAPTURE(BM_TraceEvent0,
+                  TimelineHandler,
+                  TraceBackend::kTimelineHandler);
+BENCHMARK_CAPTURE(BM_TraceEvent0, TraceBuffer, TraceBackend::kTraceBuffer);
+
+}  // namespace benchmarking
+}  // namespace fml
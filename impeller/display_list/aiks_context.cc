@@ -29,8 +29,32 @@ AiksContext::AiksContext(
   is_valid_ = true;
 }
 
+AiksContext::AiksContext(std::shared_ptr<Context> context,
+                         std::unique_ptr<ContentContext> content_context)
+    : context_(std::move(context)),
+      content_context_(std::move(content_context)) {
+  is_valid_ = content_context_ && content_context_->IsValid();
+}
+
 AiksContext::~AiksContext() = default;
 
+std::shared_ptr<AiksContext> AiksContext::CreateShared(
+    std::shared_ptr<Context> context,
+    std::optional<std::shared_ptr<RenderTargetAllocator>>
+        render_target_allocator) const {
+  if (!IsValid() || !context || !context->IsValid()) {
+    return nullptr;
+  }
+  std::unique_ptr<ContentContext> content_context =
+      content_context_->CreateShared(context,
+                                     render_target_allocator.has_value()
+                                         ? render_target_allocator.value()
+                                         : nullptr);
+  // The constructor is private.
+  return std::shared_ptr<AiksContext>(
+      new AiksContext(std::move(context), std::move(content_context)));
+}
+
 bool AiksContext::IsValid() const {
   return is_valid_;
 }
@@ -36,6 +36,22 @@ class AiksContext {
 
   ~AiksContext();
 
+  /// Creates an AiksContext that shares the pipelines and the glyph atlas of
+  /// this one, and so needs no warm up. It must only be used from the thread
+  /// this one is used from.
+  ///
+  /// See |ContentContext::CreateShared|.
+  ///
+  /// @param context                 The Impeller context to render with. It
+  ///                                must use the pipeline library of the
+  ///                                context of this AiksContext.
+  /// @param render_target_allocator Injects a render target allocator or
+  ///                                allocates its own if none is supplied.
+  std::shared_ptr<AiksContext> CreateShared(
+      std::shared_ptr<Context> context,
+      std::optional<std::shared_ptr<RenderTargetAllocator>>
+          render_target_allocator = std::nullopt) const;
+
   bool IsValid() const;
 
   std::shared_ptr<Context> GetContext() const;
@@ -47,6 +63,9 @@ class AiksContext {
   std::unique_ptr<ContentContext> content_context_;
   bool is_valid_ = false;
 
+  AiksContext(std::shared_ptr<Context> context,
+              std::unique_ptr<ContentContext> content_context);
+
   AiksContext(const AiksContext&) = delete;
 
   AiksContext& operator=(const AiksContext&) = delete;
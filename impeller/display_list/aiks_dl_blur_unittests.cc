@@ -349,6 +349,28 @@ TEST_P(AiksTest,
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// The fourth blur samples the levels of a mip pyramid of the image, which is
+// built once the image has been blurred that often. It has the same sigma as
+// the first, which downsamples the image by itself, so the two should look
+// alike.
+TEST_P(AiksTest, CanRenderImageWithSeveralLargeBlurs) {
+  auto image = DlImageImpeller::Make(CreateTextureForFixture("kalimba.jpg"));
+
+  DisplayListBuilder builder;
+  builder.Scale(0.5, 0.5);
+
+  for (int i = 0; i < 4; i++) {
+    DlPaint paint;
+    Scalar sigma = i == 3 ? 20 : 20 * (i + 1);
+    paint.setImageFilter(
+        DlImageFilter::MakeBlur(sigma, sigma, DlTileMode::kDecal));
+    builder.DrawImage(image, SkPoint::Make((i % 2) * 700, (i / 2) * 700),
+                      DlImageSampling::kLinear, &paint);
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   DisplayListBuilder builder;
 
@@ -117,6 +117,31 @@ TEST_P(AiksTest, ClipsUseCurrentTransform) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// A list scrolled by a fractional offset, where the list viewport and each
+// card is clipped to a rect and a round rect with analytic clips. If correct,
+// this test should draw rounded cards with anti-aliased edges, and no blue
+// outside of the cards or the viewport.
+TEST_P(AiksTest, CanRenderScrolledRoundRectClips) {
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+  DlPaint paint;
+  paint.setColor(DlColor::kWhite());
+  builder.DrawPaint(paint);
+
+  builder.ClipRect(SkRect::MakeLTRB(40.5, 40.25, 560.5, 540.75));
+  builder.Translate(0, -37.3);
+  for (int i = 0; i < 8; i++) {
+    builder.Save();
+    builder.ClipRRect(SkRRect::MakeRectXY(
+        SkRect::MakeXYWH(60.25, 60.4 + i * 72, 480, 64), 16, 16));
+    paint.setColor(i % 2 ? DlColor::kBlue() : DlColor::kSkyBlue());
+    builder.DrawPaint(paint);
+    builder.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 /// If correct, this test should draw a green circle. If any red is visible,
 /// there is a depth bug.
 TEST_P(AiksTest, FramebufferBlendsRespectClips) {
@@ -89,14 +89,18 @@ static void ApplyFramebufferBlend(Entity& entity) {
 
 /// @brief Create the subpass restore contents, appling any filters or opacity
 ///        from the provided paint object.
+///
+///        Only the `size` sub-rectangle at the origin of the target holds the
+///        subpass contents, the target may be larger if it was pooled.
 static std::shared_ptr<Contents> CreateContentsForSubpassTarget(
     const Paint& paint,
     const std::shared_ptr<Texture>& target,
+    ISize size,
     const Matrix& effect_transform) {
-  auto contents = TextureContents::MakeRect(Rect::MakeSize(target->GetSize()));
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
   contents->SetTexture(target);
   contents->SetLabel("Subpass");
-  contents->SetSourceRect(Rect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(Rect::MakeSize(size));
   contents->SetOpacity(paint.color.alpha);
   contents->SetDeferApplyingOpacity(true);
 
@@ -201,6 +205,22 @@ Canvas::Canvas(ContentContext& renderer,
 
 void Canvas::Initialize(std::optional<Rect> cull_rect) {
   initial_cull_rect_ = cull_rect;
+  EntityBatcher::PipelineCallback solid_pipeline_callback;
+  if (renderer_.GetDeviceCapabilities().SupportsSSBO()) {
+    solid_pipeline_callback =
+        [&renderer = renderer_](ContentContextOptions options) {
+          return renderer.GetInstancedSolidFillPipeline(options);
+        };
+  }
+  batcher_.emplace(
+      renderer_.GetTransientsBuffer(), std::move(solid_pipeline_callback),
+      [&renderer = renderer_](ContentContextOptions options) {
+        return renderer.GetTexturePipeline(options);
+      },
+      [&renderer = renderer_](const SamplerDescriptor& descriptor) {
+        return renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+            descriptor);
+      });
   transform_stack_.emplace_back(CanvasStackEntry{
       .clip_depth = kMaxDepth,
   });
@@ -275,6 +295,26 @@ bool Canvas::IsSkipping() const {
   return transform_stack_.back().skipping;
 }
 
+void Canvas::DrawBackdropSnapshot(const Snapshot& snapshot,
+                                  const Rect& subpass_coverage,
+                                  BlendMode blend_mode) {
+  std::shared_ptr<TextureContents> contents = TextureContents::MakeRect(
+      subpass_coverage.Shift(-GetGlobalPassPosition()));
+  auto scaled = subpass_coverage.TransformBounds(snapshot.transform.Invert());
+  contents->SetTexture(snapshot.texture);
+  contents->SetSourceRect(scaled);
+  contents->SetSamplerDescriptor(snapshot.sampler_descriptor);
+
+  // This backdrop entity sets a depth value as it is written to the newly
+  // flipped backdrop and not into a new saveLayer.
+  Entity backdrop_entity;
+  backdrop_entity.SetContents(std::move(contents));
+  backdrop_entity.SetClipDepth(++current_depth_);
+  backdrop_entity.SetBlendMode(blend_mode);
+
+  backdrop_entity.Render(renderer_, GetCurrentRenderPass());
+}
+
 void Canvas::RestoreToCount(size_t count) {
   while (GetSaveCount() > count) {
     if (!Restore()) {
@@ -563,6 +603,8 @@ void Canvas::ClipGeometry(const Geometry& geometry,
     return;
   }
 
+  FlushBatchedDraws();
+
   // Ideally the clip depth would be greater than the current rendering
   // depth because any rendering calls that follow this clip operation will
   // pre-increment the depth and then be rendering above our clip depth,
@@ -623,14 +665,29 @@ void Canvas::ClipGeometry(const Geometry& geometry,
   entity.SetTransform(clip_transform);
   entity.SetClipDepth(clip_depth);
 
-  GeometryResult geometry_result = geometry.GetPositionBuffer(
-      renderer_,                                                   //
-      entity,                                                      //
-      *render_passes_.back().inline_pass_context->GetRenderPass()  //
-  );
-  clip_contents.SetGeometry(geometry_result);
-  clip_coverage_stack_.GetLastReplayResult().clip_contents.SetGeometry(
-      geometry_result);
+  // Intersect clips of rects and round rects that are only translated and
+  // scaled only write the depth of the pixels between their shape and the
+  // scissor, which was set to their coverage above.
+  std::optional<GeometryResult> complement_result;
+  if (clip_op == Entity::ClipOperation::kIntersect) {
+    complement_result = geometry.GetClipComplementBuffer(
+        renderer_, entity,
+        *render_passes_.back().inline_pass_context->GetRenderPass());
+  }
+  if (complement_result.has_value()) {
+    clip_contents.SetComplementGeometry(complement_result.value());
+    clip_coverage_stack_.GetLastReplayResult()
+        .clip_contents.SetComplementGeometry(complement_result.value());
+  } else {
+    GeometryResult geometry_result = geometry.GetPositionBuffer(
+        renderer_,                                                   //
+        entity,                                                      //
+        *render_passes_.back().inline_pass_context->GetRenderPass()  //
+    );
+    clip_contents.SetGeometry(geometry_result);
+    clip_coverage_stack_.GetLastReplayResult().clip_contents.SetGeometry(
+        geometry_result);
+  }
 
   clip_contents.Render(
       renderer_, *render_passes_.back().inline_pass_context->GetRenderPass(),
@@ -978,6 +1035,8 @@ void Canvas::SaveLayer(const Paint& paint,
     return;
   }
 
+  FlushBatchedDraws();
+
   std::shared_ptr<FilterContents> filter_contents = paint.WithImageFilter(
       Rect(), transform_stack_.back().transform,
       Entity::RenderingMode::kSubpassPrependSnapshotTransform);
@@ -1065,6 +1124,35 @@ void Canvas::SaveLayer(const Paint& paint,
       }
     }
 
+    // A backdrop filter that is not shared may keep its result across frames.
+    // If the content behind it did not change, draw the previous result and
+    // skip the flip and the filter. The result is drawn straight into the
+    // current pass, so the layer must not have any effects of its own.
+    // Backdrops that were not marked unchanged take the regular path below.
+    std::optional<BackdropFilterCache::Key> backdrop_cache_key;
+    if (backdrop_id.has_value() && !will_cache_backdrop_texture &&
+        renderer_.GetBackdropFilterCache().IsUnchanged(backdrop_id.value()) &&
+        paint.blend_mode == BlendMode::kSourceOver &&
+        paint.color.alpha >= 1.0f && !paint.color_filter &&
+        !paint.image_filter &&
+        transform_stack_.back().distributed_opacity >= 1.0f) {
+      backdrop_cache_key = BackdropFilterCache::Key{
+          .backdrop_id = backdrop_id.value(),
+          .coverage = subpass_coverage,
+          .pass_position = GetGlobalPassPosition(),
+          .transform = transform_stack_.back().transform,
+      };
+      std::optional<Snapshot> cached_snapshot =
+          renderer_.GetBackdropFilterCache().Get(backdrop_cache_key.value());
+      if (cached_snapshot.has_value()) {
+        backdrop_count_ -= backdrop_count;
+        DrawBackdropSnapshot(cached_snapshot.value(), subpass_coverage,
+                             paint.blend_mode);
+        Save(0);
+        return;
+      }
+    }
+
     if (!will_cache_backdrop_texture || !backdrop_data->texture_slot) {
       backdrop_count_ -= backdrop_count;
 
@@ -1115,23 +1203,22 @@ void Canvas::SaveLayer(const Paint& paint,
       std::optional<Snapshot> maybe_snapshot =
           backdrop_data->shared_filter_snapshot;
       if (maybe_snapshot.has_value()) {
-        Snapshot snapshot = maybe_snapshot.value();
-        std::shared_ptr<TextureContents> contents = TextureContents::MakeRect(
-            subpass_coverage.Shift(-GetGlobalPassPosition()));
-        auto scaled =
-            subpass_coverage.TransformBounds(snapshot.transform.Invert());
-        contents->SetTexture(snapshot.texture);
-        contents->SetSourceRect(scaled);
-        contents->SetSamplerDescriptor(snapshot.sampler_descriptor);
-
-        // This backdrop entity sets a depth value as it is written to the newly
-        // flipped backdrop and not into a new saveLayer.
-        Entity backdrop_entity;
-        backdrop_entity.SetContents(std::move(contents));
-        backdrop_entity.SetClipDepth(++current_depth_);
-        backdrop_entity.SetBlendMode(paint.blend_mode);
-
-        backdrop_entity.Render(renderer_, GetCurrentRenderPass());
+        DrawBackdropSnapshot(maybe_snapshot.value(), subpass_coverage,
+                             paint.blend_mode);
+        Save(0);
+        return;
+      }
+    } else if (backdrop_cache_key.has_value()) {
+      // The backdrop is unchanged but was not cached yet. Keep the result for
+      // the following frames.
+      // TODO(157110): compute minimum input hint.
+      std::optional<Snapshot> maybe_snapshot =
+          backdrop_filter_contents->RenderToSnapshot(renderer_, {});
+      if (maybe_snapshot.has_value()) {
+        Snapshot snapshot = renderer_.GetBackdropFilterCache().Set(
+            *renderer_.GetContext(), backdrop_cache_key.value(),
+            maybe_snapshot.value());
+        DrawBackdropSnapshot(snapshot, subpass_coverage, paint.blend_mode);
         Save(0);
         return;
       }
@@ -1143,13 +1230,30 @@ void Canvas::SaveLayer(const Paint& paint,
   paint_copy.color.alpha *= transform_stack_.back().distributed_opacity;
   transform_stack_.back().distributed_opacity = 1.0;
 
+  // Layers whose bounds animate would otherwise need a new texture almost
+  // every frame. Round their size up so that the render target cache can
+  // reuse textures across frames, and only use the top left sub-rectangle.
+  // Filters, advanced blends and backdrop filters snapshot the whole texture
+  // of the pass, so those passes keep their exact size.
+  ISize target_size = subpass_size;
+  if (!paint.image_filter && !paint.color_filter &&
+      paint.blend_mode <= Entity::kLastPipelineBlendMode &&
+      backdrop_count_ == 0) {
+    target_size = renderer_.GetRenderTargetCache()
+                      ->GetPooledSize(subpass_size)
+                      .Min(renderer_.GetContext()
+                               ->GetCapabilities()
+                               ->GetMaximumRenderPassAttachmentSize());
+  }
+
   render_passes_.push_back(
       LazyRenderingConfig(renderer_,                                    //
                           CreateRenderTarget(renderer_,                 //
-                                             subpass_size,              //
+                                             target_size,               //
                                              Color::BlackTransparent()  //
                                              )));
-  save_layer_state_.push_back(SaveLayerState{paint_copy, subpass_coverage});
+  save_layer_state_.push_back(
+      SaveLayerState{paint_copy, subpass_coverage, subpass_size});
 
   CanvasStackEntry entry;
   entry.transform = transform_stack_.back().transform;
@@ -1210,6 +1314,8 @@ bool Canvas::Restore() {
     return true;
   }
 
+  FlushBatchedDraws();
+
   if (transform_stack_.back().rendering_mode ==
           Entity::RenderingMode::kSubpassAppendSnapshotTransform ||
       transform_stack_.back().rendering_mode ==
@@ -1226,6 +1332,7 @@ bool Canvas::Restore() {
     std::shared_ptr<Contents> contents = CreateContentsForSubpassTarget(
         save_layer_state.paint,                                    //
         lazy_render_pass.inline_pass_context->GetTexture(),        //
+        save_layer_state.size,                                     //
         Matrix::MakeTranslation(Vector3{-global_pass_position}) *  //
             transform_stack_.back().transform                      //
     );
@@ -1529,6 +1636,10 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
     return;
   }
 
+  if (batcher_.has_value() && batcher_->Add(entity, *result)) {
+    return;
+  }
+  FlushBatchedDraws();
   entity.Render(renderer_, *result);
 }
 
@@ -1536,6 +1647,12 @@ RenderPass& Canvas::GetCurrentRenderPass() const {
   return *render_passes_.back().inline_pass_context->GetRenderPass();
 }
 
+void Canvas::FlushBatchedDraws() {
+  if (batcher_.has_value() && !batcher_->Flush()) {
+    VALIDATION_LOG << "Failed to encode batched draws.";
+  }
+}
+
 void Canvas::SetBackdropData(
     std::unordered_map<int64_t, BackdropData> backdrop_data,
     size_t backdrop_count) {
@@ -1546,6 +1663,11 @@ void Canvas::SetBackdropData(
 std::shared_ptr<Texture> Canvas::FlipBackdrop(Point global_pass_position,
                                               bool should_remove_texture,
                                               bool should_use_onscreen) {
+  FlushBatchedDraws();
+  // The textures of the pass are rendered to again after the flip, so
+  // pyramids of them built for earlier blurs are stale.
+  renderer_.GetBlurPyramidCache().Clear();
+
   LazyRenderingConfig rendering_config = std::move(render_passes_.back());
   render_passes_.pop_back();
 
@@ -1715,6 +1837,7 @@ bool Canvas::BlitToOnscreen() {
 
 void Canvas::EndReplay() {
   FML_DCHECK(render_passes_.size() == 1u);
+  FlushBatchedDraws();
   render_passes_.back().inline_pass_context->GetRenderPass();
   render_passes_.back().inline_pass_context->EndPass();
   backdrop_data_.clear();
@@ -1732,6 +1855,7 @@ void Canvas::EndReplay() {
   }
   render_passes_.clear();
   renderer_.GetRenderTargetCache()->End();
+  renderer_.GetBlurPyramidCache().Clear();
   clip_geometry_.clear();
 
   Reset();
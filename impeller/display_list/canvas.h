@@ -18,6 +18,7 @@
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_batcher.h"
 #include "impeller/entity/entity_pass_clip_stack.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
@@ -243,6 +244,8 @@ class Canvas {
   struct SaveLayerState {
     Paint paint;
     Rect coverage;
+    /// The size of the subpass contents, at the origin of its render target.
+    ISize size;
   };
 
   // Visible for testing.
@@ -281,6 +284,10 @@ class Canvas {
   // and so must be kept alive longer.
   std::vector<std::unique_ptr<Geometry>> clip_geometry_;
 
+  /// Merges consecutive solid rectangle draws into instanced draws. Absent if
+  /// the device does not support the storage buffers they need.
+  std::optional<EntityBatcher> batcher_;
+
   uint64_t current_depth_ = 0u;
 
   Point GetGlobalPassPosition() const;
@@ -318,6 +325,13 @@ class Canvas {
                                         bool should_remove_texture = false,
                                         bool should_use_onscreen = false);
 
+  /// Draw the filtered backdrop of a save layer into the current render pass
+  /// in place of a subpass, for backdrop filter results that were computed
+  /// once and are reused.
+  void DrawBackdropSnapshot(const Snapshot& snapshot,
+                            const Rect& subpass_coverage,
+                            BlendMode blend_mode);
+
   bool BlitToOnscreen();
 
   size_t GetClipHeight() const;
@@ -339,6 +353,11 @@ class Canvas {
 
   RenderPass& GetCurrentRenderPass() const;
 
+  /// @brief Encode the pending batched draws. This must be done before
+  ///        anything else is encoded into the current render pass and before
+  ///        the pass ends.
+  void FlushBatchedDraws();
+
   Canvas(const Canvas&) = delete;
 
   Canvas& operator=(const Canvas&) = delete;
@@ -12,7 +12,9 @@
 
 #include "display_list/dl_sampling_options.h"
 #include "display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/core/formats.h"
 #include "impeller/display_list/aiks_context.h"
 #include "impeller/display_list/canvas.h"
@@ -730,12 +732,32 @@ void DlDispatcherBase::drawImageRect(
     SrcRectConstraint constraint = SrcRectConstraint::kFast) {
   AUTO_DEPTH_WATCHER(1u);
 
-  GetCanvas().DrawImageRect(
-      image->impeller_texture(),                       // image
-      src,                                             // source rect
-      dst,                                             // destination rect
-      render_with_attributes ? paint_ : Paint(),       // paint
-      skia_conversions::ToSamplerDescriptor(sampling)  // sampling
+  const Paint& paint = render_with_attributes ? paint_ : Paint();
+  SamplerDescriptor sampler = skia_conversions::ToSamplerDescriptor(sampling);
+  std::shared_ptr<Texture> texture = image->impeller_texture();
+  DlRect source = src;
+
+  // Plain draws that sample only within the image use its copy in an image
+  // atlas, so that they can be merged with the draws of other images in the
+  // same atlas page. The pages have no mip levels.
+  DlIRect atlas_bounds;
+  if (sampler.mip_filter == MipFilter::kBase && !paint.image_filter &&
+      !paint.color_filter && !paint.invert_colors &&
+      !paint.mask_blur_descriptor.has_value() &&
+      DlRect::Make(image->GetBounds()).Contains(src)) {
+    if (std::shared_ptr<Texture> atlas_texture =
+            image->impeller_atlas_texture(&atlas_bounds)) {
+      texture = std::move(atlas_texture);
+      source = src.Shift(static_cast<Scalar>(atlas_bounds.GetX()),
+                         static_cast<Scalar>(atlas_bounds.GetY()));
+    }
+  }
+
+  GetCanvas().DrawImageRect(texture,  // image
+                            source,   // source rect
+                            dst,      // destination rect
+                            paint,    // paint
+                            sampler   // sampling
   );
 }
 
@@ -976,6 +998,28 @@ void CanvasDlDispatcher::SetBackdropData(
   GetCanvas().SetBackdropData(std::move(backdrop), backdrop_count);
 }
 
+void CanvasDlDispatcher::SetDisplayListCostCallback(
+    ContentContext::DisplayListCostCallback callback) {
+  display_list_cost_callback_ = std::move(callback);
+}
+
+// |flutter::DlOpReceiver|
+void CanvasDlDispatcher::drawDisplayList(
+    const sk_sp<flutter::DisplayList> display_list,
+    DlScalar opacity) {
+  // The DisplayLists nested in the measured ones are included in their time.
+  if (!display_list_cost_callback_ || display_list_depth_ > 0) {
+    DlDispatcherBase::drawDisplayList(display_list, opacity);
+    return;
+  }
+  display_list_depth_++;
+  fml::TimePoint start = fml::TimePoint::Now();
+  DlDispatcherBase::drawDisplayList(display_list, opacity);
+  display_list_cost_callback_(display_list->unique_id(),
+                              fml::TimePoint::Now() - start);
+  display_list_depth_--;
+}
+
 //// Text Frame Dispatcher
 
 FirstPassDispatcher::FirstPassDispatcher(const ContentContext& renderer,
@@ -1138,19 +1182,14 @@ void FirstPassDispatcher::drawDisplayList(
   has_image_filter_ = false;
 
   if (matrix_.HasPerspective()) {
-    display_list->Dispatch(*this);
+    display_list->DispatchInlined(*this);
   } else {
     Rect local_cull_bounds = GetCurrentLocalCullingBounds();
     if (local_cull_bounds.IsMaximum()) {
-      display_list->Dispatch(*this);
+      display_list->DispatchInlined(*this);
     } else if (!local_cull_bounds.IsEmpty()) {
       IRect cull_rect = IRect::RoundOut(local_cull_bounds);
-      display_list->Dispatch(*this,
-                             SkIRect::MakeLTRB(cull_rect.GetLeft(),   //
-                                               cull_rect.GetTop(),    //
-                                               cull_rect.GetRight(),  //
-                                               cull_rect.GetBottom()  //
-                                               ));
+      display_list->DispatchInlined(*this, Rect::Make(cull_rect));
     }
   }
 
@@ -1265,7 +1304,7 @@ std::shared_ptr<Texture> DisplayListToTexture(
   SkIRect sk_cull_rect = SkIRect::MakeWH(size.width, size.height);
   impeller::FirstPassDispatcher collector(
       context.GetContentContext(), impeller::Matrix(), Rect::MakeSize(size));
-  display_list->Dispatch(collector, sk_cull_rect);
+  display_list->DispatchInlined(collector, flutter::ToDlIRect(sk_cull_rect));
   impeller::CanvasDlDispatcher impeller_dispatcher(
       context.GetContentContext(),               //
       target,                                    //
@@ -1275,7 +1314,8 @@ std::shared_ptr<Texture> DisplayListToTexture(
   );
   const auto& [data, count] = collector.TakeBackdropData();
   impeller_dispatcher.SetBackdropData(data, count);
-  display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
+  display_list->DispatchInlined(impeller_dispatcher,
+                                flutter::ToDlIRect(sk_cull_rect));
   impeller_dispatcher.FinishRecording();
 
   if (reset_host_buffer) {
@@ -1292,10 +1332,13 @@ bool RenderToOnscreen(ContentContext& context,
                       const sk_sp<flutter::DisplayList>& display_list,
                       SkIRect cull_rect,
                       bool reset_host_buffer) {
+  // Traces when the pipelines that frames use are first ready.
+  context.AreFirstFramePipelinesReady();
+
   Rect ip_cull_rect = Rect::MakeLTRB(cull_rect.left(), cull_rect.top(),
                                      cull_rect.right(), cull_rect.bottom());
   FirstPassDispatcher collector(context, impeller::Matrix(), ip_cull_rect);
-  display_list->Dispatch(collector, cull_rect);
+  display_list->DispatchInlined(collector, ip_cull_rect);
 
   impeller::CanvasDlDispatcher impeller_dispatcher(
       context,                                   //
@@ -1306,7 +1349,9 @@ bool RenderToOnscreen(ContentContext& context,
   );
   const auto& [data, count] = collector.TakeBackdropData();
   impeller_dispatcher.SetBackdropData(data, count);
-  display_list->Dispatch(impeller_dispatcher, cull_rect);
+  impeller_dispatcher.SetDisplayListCostCallback(
+      context.GetDisplayListCostCallback());
+  display_list->DispatchInlined(impeller_dispatcher, ip_cull_rect);
   impeller_dispatcher.FinishRecording();
   if (reset_host_buffer) {
     context.GetTransientsBuffer().Reset();
@@ -250,7 +250,7 @@ class DlDispatcherBase : public flutter::DlOpReceiver {
                                  const Paint& paint);
 };
 
-class CanvasDlDispatcher : public DlDispatcherBase {
+class CanvasDlDispatcher final : public DlDispatcherBase {
  public:
   CanvasDlDispatcher(ContentContext& renderer,
                      RenderTarget& render_target,
@@ -263,6 +263,11 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop,
                        size_t backdrop_count);
 
+  /// Measures the DisplayLists drawn into the dispatched DisplayList. See
+  /// |ContentContext::DisplayListCostCallback|.
+  void SetDisplayListCostCallback(
+      ContentContext::DisplayListCostCallback callback);
+
   // |flutter::DlOpReceiver|
   void save() override {
     // This dispatcher should never be used with the save() variant
@@ -288,18 +293,27 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   void drawVertices(const std::shared_ptr<flutter::DlVertices>& vertices,
                     flutter::DlBlendMode dl_mode) override;
 
+  // |flutter::DlOpReceiver|
+  void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
+                       DlScalar opacity) override;
+
  private:
   Canvas canvas_;
   const ContentContext& renderer_;
+  ContentContext::DisplayListCostCallback display_list_cost_callback_;
+  // The nesting depth of the DisplayList being drawn, used to measure only
+  // the DisplayLists drawn into the dispatched one.
+  int display_list_depth_ = 0;
 
   Canvas& GetCanvas() override;
 };
 
 /// Performs a first pass over the display list to collect infomation.
 /// Collects things like text frames and backdrop filters.
-class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
-                            public flutter::IgnoreClipDispatchHelper,
-                            public flutter::IgnoreDrawDispatchHelper {
+class FirstPassDispatcher final
+    : public flutter::IgnoreAttributeDispatchHelper,
+      public flutter::IgnoreClipDispatchHelper,
+      public flutter::IgnoreDrawDispatchHelper {
  public:
   FirstPassDispatcher(const ContentContext& renderer,
                       const Matrix& initial_matrix,
@@ -307,6 +321,9 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
 
   ~FirstPassDispatcher();
 
+  using flutter::DlOpReceiver::save;
+  using flutter::DlOpReceiver::saveLayer;
+
   void save() override;
 
   void saveLayer(const DlRect& bounds,
@@ -391,6 +408,9 @@ std::shared_ptr<Texture> DisplayListToTexture(
     bool generate_mips = false);
 
 /// Render the provided display list to the render target.
+///
+/// The time spent on each DisplayList drawn into it is reported to the
+/// |ContentContext::DisplayListCostCallback| of the context, if it has one.
 bool RenderToOnscreen(ContentContext& context, RenderTarget render_target,
                          const sk_sp<flutter::DisplayList>& display_list,
                          SkIRect cull_rect,
@@ -4,6 +4,8 @@
 
 #include "impeller/display_list/dl_image_impeller.h"
 
+#include <utility>
+
 #include "impeller/display_list/aiks_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 
@@ -85,6 +87,28 @@ std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_texture() const {
   return texture_;
 }
 
+// |DlImage|
+std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_atlas_texture(
+    flutter::DlIRect* bounds) const {
+  if (!atlas_allocation_) {
+    return nullptr;
+  }
+  IRect atlas_bounds;
+  std::shared_ptr<Texture> texture =
+      atlas_allocation_->GetTexture(&atlas_bounds);
+  *bounds = flutter::DlIRect::MakeXYWH(
+      static_cast<int32_t>(atlas_bounds.GetX()),
+      static_cast<int32_t>(atlas_bounds.GetY()),
+      static_cast<int32_t>(atlas_bounds.GetWidth()),
+      static_cast<int32_t>(atlas_bounds.GetHeight()));
+  return texture;
+}
+
+void DlImageImpeller::SetAtlasAllocation(
+    std::unique_ptr<ImageAtlas::Allocation> allocation) {
+  atlas_allocation_ = std::move(allocation);
+}
+
 // |DlImage|
 bool DlImageImpeller::isOpaque() const {
   // Impeller doesn't currently implement opaque alpha types.
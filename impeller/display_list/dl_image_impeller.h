@@ -5,8 +5,11 @@
 #ifndef FLUTTER_IMPELLER_DISPLAY_LIST_DL_IMAGE_IMPELLER_H_
 #define FLUTTER_IMPELLER_DISPLAY_LIST_DL_IMAGE_IMPELLER_H_
 
+#include <memory>
+
 #include "flutter/display_list/image/dl_image.h"
 #include "impeller/core/texture.h"
+#include "impeller/display_list/image_atlas.h"
 
 namespace impeller {
 
@@ -38,6 +41,14 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   std::shared_ptr<impeller::Texture> impeller_texture() const override;
 
+  // |DlImage|
+  std::shared_ptr<impeller::Texture> impeller_atlas_texture(
+      flutter::DlIRect* bounds) const override;
+
+  /// Keep the copy of this image in an `ImageAtlas` until this image is
+  /// collected. Must be called before the image is shared with other threads.
+  void SetAtlasAllocation(std::unique_ptr<ImageAtlas::Allocation> allocation);
+
   // |DlImage|
   bool isOpaque() const override;
 
@@ -63,6 +74,7 @@ class DlImageImpeller final : public flutter::DlImage {
 
  private:
   std::shared_ptr<Texture> texture_;
+  std::unique_ptr<ImageAtlas::Allocation> atlas_allocation_;
   OwningContext owning_context_;
 #if FML_OS_IOS_SIMULATOR
   bool is_fake_image_ = false;
@@ -22,6 +22,7 @@
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/display_list/dl_playground.h"
+#include "impeller/display_list/image_atlas.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
@@ -1556,5 +1557,173 @@ TEST_P(DisplayListTest, DrawMaskBlursThatMightUseSaveLayers) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(DisplayListTest, ImageAtlasPacksSmallImagesIntoOnePage) {
+  if (!GetContext()->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    GTEST_SKIP() << "Images are copied into the atlas with blits.";
+  }
+  auto allocator = GetContext()->GetResourceAllocator();
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {32, 32};
+  desc.usage = TextureUsage::kShaderRead;
+  auto first_texture = allocator->CreateTexture(desc);
+  auto second_texture = allocator->CreateTexture(desc);
+  desc.size = {256, 256};
+  auto large_texture = allocator->CreateTexture(desc);
+  ASSERT_TRUE(first_texture && second_texture && large_texture);
+
+  auto atlas = ImageAtlas::Create();
+  auto image = DlImageImpeller::Make(first_texture);
+  image->SetAtlasAllocation(atlas->Add(*GetContext(), first_texture));
+  auto second = atlas->Add(*GetContext(), second_texture);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(atlas->GetPageCount(), 1u);
+
+  // Large images are not packed.
+  EXPECT_FALSE(atlas->Add(*GetContext(), large_texture));
+
+  flutter::DlIRect first_bounds;
+  IRect second_bounds;
+  auto page = image->impeller_atlas_texture(&first_bounds);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(page, second->GetTexture(&second_bounds));
+  EXPECT_EQ(first_bounds.GetWidth(), 32);
+  EXPECT_EQ(first_bounds.GetHeight(), 32);
+  EXPECT_EQ(second_bounds.GetSize(), ISize(32, 32));
+  // The images do not overlap, including their gutters.
+  IRect first_padded =
+      IRect::MakeXYWH(first_bounds.GetX(), first_bounds.GetY(), 32, 32)
+          .Expand(ImageAtlas::kPadding);
+  EXPECT_FALSE(first_padded.IntersectsWithRect(
+      second_bounds.Expand(ImageAtlas::kPadding)));
+
+  // A page is released with its last image.
+  image.reset();
+  EXPECT_EQ(atlas->GetPageCount(), 1u);
+  second.reset();
+  EXPECT_EQ(atlas->GetPageCount(), 0u);
+}
+
+TEST_P(DisplayListTest, DrawsImagesThroughImageAtlas) {
+  if (!GetContext()->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    GTEST_SKIP() << "Images are copied into the atlas with blits.";
+  }
+  auto atlas = ImageAtlas::Create();
+  auto make_image =
+      [&](const std::array<uint8_t, 4>& color) -> sk_sp<DlImageImpeller> {
+    TextureDescriptor desc;
+    desc.storage_mode = StorageMode::kHostVisible;
+    desc.format = PixelFormat::kR8G8B8A8UNormInt;
+    desc.size = {32, 32};
+    desc.usage = TextureUsage::kShaderRead;
+    auto texture = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+    std::vector<uint8_t> pixels;
+    for (int64_t i = 0; i < desc.size.Area(); i++) {
+      pixels.insert(pixels.end(), color.begin(), color.end());
+    }
+    if (!texture || !texture->SetContents(pixels.data(), pixels.size())) {
+      return nullptr;
+    }
+    auto image = DlImageImpeller::Make(texture);
+    image->SetAtlasAllocation(atlas->Add(*GetContext(), texture));
+    return image;
+  };
+  auto red = make_image({255, 0, 0, 255});
+  auto blue = make_image({0, 0, 255, 255});
+  ASSERT_TRUE(red && blue);
+
+  auto draw_images = [](const std::vector<sk_sp<DlImageImpeller>>& images) {
+    flutter::DisplayListBuilder builder;
+    for (size_t i = 0; i < images.size(); i++) {
+      builder.DrawImage(images[i], SkPoint::Make(10 + i * 40, 10),
+                        flutter::DlImageSampling::kLinear);
+    }
+    return builder.Build();
+  };
+
+  AiksContext renderer(GetContext(), nullptr);
+  ASSERT_TRUE(DisplayListToTexture(draw_images({red, blue}), {100, 100},
+                                   renderer));
+
+  // The frame sampled the page, so an image that is added afterwards is
+  // written to a new page instead.
+  flutter::DlIRect red_bounds;
+  auto sampled_page = red->impeller_atlas_texture(&red_bounds);
+  ASSERT_TRUE(sampled_page);
+  auto green = make_image({0, 255, 0, 255});
+  ASSERT_TRUE(green);
+  EXPECT_EQ(atlas->GetPageCount(), 2u);
+  EXPECT_EQ(atlas->GetRewriteCount(), 0u);
+  flutter::DlIRect unchanged_red_bounds;
+  EXPECT_EQ(red->impeller_atlas_texture(&unchanged_red_bounds), sampled_page);
+  EXPECT_EQ(unchanged_red_bounds, red_bounds);
+  flutter::DlIRect green_bounds;
+  auto green_page = green->impeller_atlas_texture(&green_bounds);
+  ASSERT_TRUE(green_page);
+  EXPECT_NE(green_page, sampled_page);
+
+  ASSERT_TRUE(OpenPlaygroundHere(draw_images({red, blue, green})));
+}
+
+namespace {
+fml::TimePoint image_atlas_now;
+
+fml::TimePoint ImageAtlasNow() {
+  return image_atlas_now;
+}
+}  // namespace
+
+TEST_P(DisplayListTest, ImageAtlasRewritesSampledPagesOncePerInterval) {
+  if (!GetContext()->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    GTEST_SKIP() << "Images are copied into the atlas with blits.";
+  }
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {32, 32};
+  desc.usage = TextureUsage::kShaderRead;
+  auto texture = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(texture);
+
+  auto atlas = ImageAtlas::Create(&ImageAtlasNow);
+  std::vector<std::unique_ptr<ImageAtlas::Allocation>> allocations;
+  // Marks the page of the allocation as sampled by a draw.
+  auto sample = [](const ImageAtlas::Allocation& allocation) {
+    IRect bounds;
+    return allocation.GetTexture(&bounds);
+  };
+
+  // Each image that is added after its page was sampled gets a new page.
+  for (size_t i = 0; i < ImageAtlas::kMaxPageCount; i++) {
+    allocations.push_back(atlas->Add(*GetContext(), texture));
+    ASSERT_TRUE(allocations.back());
+    sample(*allocations.back());
+  }
+  EXPECT_EQ(atlas->GetPageCount(), ImageAtlas::kMaxPageCount);
+  EXPECT_EQ(atlas->GetRewriteCount(), 0u);
+
+  // Once no more pages may be created, a sampled page is rewritten, and it
+  // takes the next images until it is sampled again.
+  auto sampled_page = sample(*allocations.front());
+  allocations.push_back(atlas->Add(*GetContext(), texture));
+  ASSERT_TRUE(allocations.back());
+  EXPECT_EQ(atlas->GetRewriteCount(), 1u);
+  allocations.push_back(atlas->Add(*GetContext(), texture));
+  ASSERT_TRUE(allocations.back());
+  EXPECT_EQ(atlas->GetRewriteCount(), 1u);
+  auto rewritten_page = sample(*allocations.back());
+  EXPECT_NE(rewritten_page, sampled_page);
+  EXPECT_EQ(sample(*allocations.front()), rewritten_page);
+
+  // Within the interval, images are not packed rather than rewriting again.
+  EXPECT_FALSE(atlas->Add(*GetContext(), texture));
+  image_atlas_now = image_atlas_now + ImageAtlas::kMinRewriteInterval;
+  allocations.push_back(atlas->Add(*GetContext(), texture));
+  ASSERT_TRUE(allocations.back());
+  EXPECT_EQ(atlas->GetRewriteCount(), 2u);
+  EXPECT_EQ(atlas->GetPageCount(), ImageAtlas::kMaxPageCount);
+}
+
 }  // namespace testing
 }  // namespace impeller
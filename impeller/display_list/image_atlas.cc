@@ -0,0 +1,350 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/image_atlas.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "impeller/core/formats.h"
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/command_queue.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr PixelFormat kPageFormat = PixelFormat::kR8G8B8A8UNormInt;
+
+ISize GetPaddedSize(ISize size) {
+  return size + ISize(2 * ImageAtlas::kPadding, 2 * ImageAtlas::kPadding);
+}
+
+// Records the copies of an image of `size` from `source` to `destination`,
+// with its top left pixel at `origin`, and of its edge pixels into the gutter
+// around it.
+bool AddPaddedCopy(BlitPass& blit_pass,
+                   const std::shared_ptr<Texture>& source,
+                   const std::shared_ptr<Texture>& destination,
+                   ISize size,
+                   IPoint origin) {
+  const int64_t w = size.width;
+  const int64_t h = size.height;
+  const int64_t p = ImageAtlas::kPadding;
+  struct Copy {
+    IRect source_region;
+    IPoint destination_origin;
+  };
+  const Copy copies[] = {
+      // The image.
+      {IRect::MakeXYWH(0, 0, w, h), origin},
+      // The edges.
+      {IRect::MakeXYWH(0, 0, w, 1), origin + IPoint(0, -p)},
+      {IRect::MakeXYWH(0, h - 1, w, 1), origin + IPoint(0, h)},
+      {IRect::MakeXYWH(0, 0, 1, h), origin + IPoint(-p, 0)},
+      {IRect::MakeXYWH(w - 1, 0, 1, h), origin + IPoint(w, 0)},
+      // The corners.
+      {IRect::MakeXYWH(0, 0, 1, 1), origin + IPoint(-p, -p)},
+      {IRect::MakeXYWH(w - 1, 0, 1, 1), origin + IPoint(w, -p)},
+      {IRect::MakeXYWH(0, h - 1, 1, 1), origin + IPoint(-p, h)},
+      {IRect::MakeXYWH(w - 1, h - 1, 1, 1), origin + IPoint(w, h)},
+  };
+  for (const Copy& copy : copies) {
+    if (!blit_pass.AddCopy(source, destination, copy.source_region,
+                           copy.destination_origin, "ImageAtlas Copy")) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Encodes the copies recorded by `record` into a command buffer and submits
+// it.
+template <typename RecordCallback>
+bool SubmitCopies(Context& context, const RecordCallback& record) {
+  std::shared_ptr<CommandBuffer> command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("ImageAtlas Command Buffer");
+  std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("ImageAtlas Blit Pass");
+  if (!record(*blit_pass) ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator())) {
+    return false;
+  }
+  return context.GetCommandQueue()->Submit({command_buffer}).ok();
+}
+
+}  // namespace
+
+ImageAtlas::Allocation::Allocation(std::shared_ptr<ImageAtlas> atlas,
+                                   ISize size)
+    : atlas_(std::move(atlas)), size_(size) {}
+
+ImageAtlas::Allocation::~Allocation() {
+  atlas_->Remove(this);
+}
+
+std::shared_ptr<Texture> ImageAtlas::Allocation::GetTexture(
+    IRect* bounds) const {
+  Lock lock(atlas_->mutex_);
+  *bounds = IRect::MakeOriginSize(origin_, size_);
+  page_->sampled = true;
+  return page_->texture;
+}
+
+std::shared_ptr<ImageAtlas> ImageAtlas::Create(
+    fml::TimePoint::ClockSource clock) {
+  return std::shared_ptr<ImageAtlas>(new ImageAtlas(clock));
+}
+
+ImageAtlas::ImageAtlas(fml::TimePoint::ClockSource clock) : clock_(clock) {}
+
+ImageAtlas::~ImageAtlas() = default;
+
+bool ImageAtlas::CanAdd(const Context& context, const Texture& texture) {
+  const TextureDescriptor& desc = texture.GetTextureDescriptor();
+  return context.GetCapabilities()->SupportsTextureToTextureBlits() &&
+         desc.type == TextureType::kTexture2D &&
+         desc.sample_count == SampleCount::kCount1 &&
+         desc.format == kPageFormat && !desc.size.IsEmpty() &&
+         desc.size.width <= kMaxImageSize && desc.size.height <= kMaxImageSize;
+}
+
+std::unique_ptr<ImageAtlas::Allocation> ImageAtlas::Add(
+    Context& context,
+    const std::shared_ptr<Texture>& texture) {
+  if (!texture || !CanAdd(context, *texture)) {
+    return nullptr;
+  }
+  const ISize size = texture->GetSize();
+  const ISize padded_size = GetPaddedSize(size);
+
+  Lock lock(mutex_);
+  IPoint origin;
+  Page* page = FindSpace(context, padded_size, &origin);
+  if (!page) {
+    return nullptr;
+  }
+  origin += IPoint(kPadding, kPadding);
+
+  // Frames that were recorded with the page texture may still be sampling it,
+  // so the page is copied into a new texture instead of being written.
+  const bool rewrite = page->sampled;
+  std::shared_ptr<Texture> destination =
+      rewrite ? CreatePageTexture(context) : page->texture;
+  if (!destination ||
+      !SubmitCopies(context, [&](BlitPass& blit_pass) {
+        if (destination != page->texture) {
+          for (const Allocation* live : page->allocations) {
+            const IPoint padding(kPadding, kPadding);
+            if (!blit_pass.AddCopy(
+                    page->texture, destination,
+                    IRect::MakeOriginSize(live->origin_ - padding,
+                                          GetPaddedSize(live->size_)),
+                    live->origin_ - padding, "ImageAtlas Page Copy")) {
+              return false;
+            }
+          }
+        }
+        return AddPaddedCopy(blit_pass, texture, destination, size, origin);
+      })) {
+    // The space stays reserved in the packer, and is released with the page.
+    if (page->allocations.empty()) {
+      pages_.erase(std::find_if(
+          pages_.begin(), pages_.end(),
+          [page](const std::unique_ptr<Page>& p) { return p.get() == page; }));
+    }
+    return nullptr;
+  }
+
+  // Draws that were already recorded keep the old texture alive.
+  page->texture = std::move(destination);
+  page->sampled = false;
+  if (rewrite) {
+    last_rewrite_ = clock_();
+    rewrite_count_++;
+  }
+
+  std::unique_ptr<Allocation> allocation(
+      new Allocation(shared_from_this(), size));
+  allocation->page_ = page;
+  allocation->origin_ = origin;
+  page->allocations.push_back(allocation.get());
+  page->live_area += padded_size.Area();
+  return allocation;
+}
+
+size_t ImageAtlas::GetPageCount() const {
+  Lock lock(mutex_);
+  return pages_.size();
+}
+
+size_t ImageAtlas::GetCompactionCount() const {
+  Lock lock(mutex_);
+  return compaction_count_;
+}
+
+size_t ImageAtlas::GetRewriteCount() const {
+  Lock lock(mutex_);
+  return rewrite_count_;
+}
+
+bool ImageAtlas::CanRewrite() const {
+  return !last_rewrite_.has_value() ||
+         clock_() - last_rewrite_.value() >= kMinRewriteInterval;
+}
+
+std::shared_ptr<Texture> ImageAtlas::CreatePageTexture(
+    Context& context) const {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = kPageFormat;
+  desc.size = {kPageSize, kPageSize};
+  desc.usage = TextureUsage::kShaderRead;
+  std::shared_ptr<Texture> texture =
+      context.GetResourceAllocator()->CreateTexture(desc);
+  if (texture) {
+    texture->SetLabel("ImageAtlas Page");
+  }
+  return texture;
+}
+
+std::unique_ptr<ImageAtlas::Page> ImageAtlas::CreatePage(
+    Context& context) const {
+  std::shared_ptr<Texture> texture = CreatePageTexture(context);
+  if (!texture) {
+    return nullptr;
+  }
+  auto page = std::make_unique<Page>();
+  page->texture = std::move(texture);
+  page->packer = RectanglePacker::Factory(kPageSize, kPageSize);
+  return page;
+}
+
+ImageAtlas::Page* ImageAtlas::FindSpace(Context& context,
+                                        ISize padded_size,
+                                        IPoint* origin) {
+  auto pack = [&](bool sampled) -> Page* {
+    for (const std::unique_ptr<Page>& page : pages_) {
+      if (page->sampled != sampled) {
+        continue;
+      }
+      IPoint16 location;
+      if (page->packer->AddRect(padded_size.width, padded_size.height,
+                                &location)) {
+        *origin = IPoint(location.x(), location.y());
+        return page.get();
+      }
+    }
+    return nullptr;
+  };
+
+  // Pages that no draw sampled yet are written in place, and new pages are
+  // preferred to the rewrite of a sampled page.
+  if (Page* page = pack(false)) {
+    return page;
+  }
+  if (pages_.size() < kMaxPageCount) {
+    std::unique_ptr<Page> page = CreatePage(context);
+    if (!page) {
+      return nullptr;
+    }
+    pages_.push_back(std::move(page));
+    return pack(false);
+  }
+  if (!CanRewrite()) {
+    return nullptr;
+  }
+  if (Page* page = pack(true)) {
+    return page;
+  }
+  if (!Compact(context)) {
+    return nullptr;
+  }
+  return pack(false);
+}
+
+bool ImageAtlas::Compact(Context& context) {
+  // The packers never reuse the space of removed images, so the sparsest page
+  // is rebuilt into a new texture with only its live images.
+  Page* sparsest = nullptr;
+  for (const std::unique_ptr<Page>& page : pages_) {
+    if (!sparsest || page->live_area < sparsest->live_area) {
+      sparsest = page.get();
+    }
+  }
+  if (!sparsest ||
+      sparsest->live_area >= kMinLiveRatio * kPageSize * kPageSize) {
+    return false;
+  }
+
+  std::unique_ptr<Page> compacted = CreatePage(context);
+  if (!compacted) {
+    return false;
+  }
+  std::vector<IPoint> origins;
+  origins.reserve(sparsest->allocations.size());
+  for (const Allocation* allocation : sparsest->allocations) {
+    const ISize padded_size = GetPaddedSize(allocation->size_);
+    IPoint16 location;
+    if (!compacted->packer->AddRect(padded_size.width, padded_size.height,
+                                    &location)) {
+      return false;
+    }
+    origins.push_back(IPoint(location.x(), location.y()));
+  }
+  if (!SubmitCopies(context, [&](BlitPass& blit_pass) {
+        for (size_t i = 0; i < origins.size(); i++) {
+          const Allocation* allocation = sparsest->allocations[i];
+          const IPoint padding(kPadding, kPadding);
+          if (!blit_pass.AddCopy(
+                  sparsest->texture, compacted->texture,
+                  IRect::MakeOriginSize(allocation->origin_ - padding,
+                                        GetPaddedSize(allocation->size_)),
+                  origins[i], "ImageAtlas Compaction")) {
+            return false;
+          }
+        }
+        return true;
+      })) {
+    return false;
+  }
+
+  // Draws that were already recorded keep the old texture alive.
+  sparsest->texture = std::move(compacted->texture);
+  sparsest->packer = std::move(compacted->packer);
+  sparsest->sampled = false;
+  for (size_t i = 0; i < origins.size(); i++) {
+    sparsest->allocations[i]->origin_ = origins[i] + IPoint(kPadding, kPadding);
+  }
+  last_rewrite_ = clock_();
+  compaction_count_++;
+  return true;
+}
+
+void ImageAtlas::Remove(Allocation* allocation) {
+  Lock lock(mutex_);
+  Page* page = allocation->page_;
+  auto found = std::find(page->allocations.begin(), page->allocations.end(),
+                         allocation);
+  if (found == page->allocations.end()) {
+    return;
+  }
+  page->allocations.erase(found);
+  page->live_area -= GetPaddedSize(allocation->size_).Area();
+  if (page->allocations.empty()) {
+    pages_.erase(std::find_if(
+        pages_.begin(), pages_.end(),
+        [page](const std::unique_ptr<Page>& p) { return p.get() == page; }));
+  }
+}
+
+}  // namespace impeller
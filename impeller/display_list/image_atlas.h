@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_DISPLAY_LIST_IMAGE_ATLAS_H_
+#define FLUTTER_IMPELLER_DISPLAY_LIST_IMAGE_ATLAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/context.h"
+#include "impeller/typographer/rectangle_packer.h"
+
+namespace impeller {
+
+/// @brief Packs copies of small decoded images into a few large textures, so
+///        that consecutive draws of different small images, like the icons of
+///        a grid, sample the same texture and can be merged into one draw.
+///
+///        Each image is surrounded by a gutter of its own edge pixels, so
+///        that linear filtering at the edges of the image does not sample
+///        its neighbours in the page.
+///
+///        The images keep their own textures, which are used for everything
+///        but plain draws. A page whose images were all collected is released.
+///        When the pages are full and no more may be created, the page with
+///        the least live area is compacted into a new texture.
+///
+///        A page texture is never written after a draw may have sampled it,
+///        since frames that are still in flight may be reading it. New images
+///        are packed into pages that no draw sampled yet, and into new pages
+///        while there may be more. Only when neither has room is a sampled
+///        page rewritten: its live images and the new image are copied into
+///        a new texture, or the page is compacted. That happens at most once
+///        per `kMinRewriteInterval`, about a frame, and the rewritten page
+///        takes the images that are added until a draw samples it. Other
+///        images are not packed.
+///
+///        All methods may be called from any thread.
+class ImageAtlas : public std::enable_shared_from_this<ImageAtlas> {
+ private:
+  struct Page;
+
+ public:
+  /// The width and height of a page.
+  static constexpr int64_t kPageSize = 1024;
+
+  /// The maximum width and height of an image that is packed.
+  static constexpr int64_t kMaxImageSize = 128;
+
+  /// The width of the gutter around each image.
+  static constexpr int64_t kPadding = 1;
+
+  /// The maximum number of pages.
+  static constexpr size_t kMaxPageCount = 4u;
+
+  /// The fraction of the area of a page that must be live for the page to be
+  /// kept as is instead of being compacted.
+  static constexpr Scalar kMinLiveRatio = 0.5f;
+
+  /// The minimum time between two rewrites of sampled pages.
+  static constexpr fml::TimeDelta kMinRewriteInterval =
+      fml::TimeDelta::FromMilliseconds(16);
+
+  /// @brief The location of an image in the atlas. The image is removed from
+  ///        the atlas when its allocation is destroyed.
+  class Allocation {
+   public:
+    ~Allocation();
+
+    //--------------------------------------------------------------------------
+    /// @brief  The page texture that holds the image and the bounds of the
+    ///         image in it. These change when the page is compacted or
+    ///         written, so they must be read for each draw.
+    ///
+    std::shared_ptr<Texture> GetTexture(IRect* bounds) const;
+
+   private:
+    friend class ImageAtlas;
+
+    Allocation(std::shared_ptr<ImageAtlas> atlas, ISize size);
+
+    std::shared_ptr<ImageAtlas> atlas_;
+    ISize size_;
+    // Guarded by the mutex of the atlas.
+    Page* page_ = nullptr;
+    IPoint origin_;
+
+    Allocation(const Allocation&) = delete;
+
+    Allocation& operator=(const Allocation&) = delete;
+  };
+
+  static std::shared_ptr<ImageAtlas> Create(
+      fml::TimePoint::ClockSource clock = &fml::TimePoint::Now);
+
+  ~ImageAtlas();
+
+  //----------------------------------------------------------------------------
+  /// @brief  Whether a texture can be added to the atlas of `context`.
+  ///
+  static bool CanAdd(const Context& context, const Texture& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Copy the first mip level of `texture` into a page of the atlas.
+  ///
+  ///         The copy is submitted to the command queue of `context` after
+  ///         any work that was already submitted to it, such as the upload of
+  ///         the texture.
+  ///
+  /// @return The allocation of the image, or null if the texture can not be
+  ///         added or the atlas is full.
+  ///
+  std::unique_ptr<Allocation> Add(Context& context,
+                                  const std::shared_ptr<Texture>& texture);
+
+  /// The number of pages with live images.
+  size_t GetPageCount() const;
+
+  /// The number of times a page was compacted.
+  size_t GetCompactionCount() const;
+
+  /// The number of times a sampled page was copied into a new texture to add
+  /// an image to it.
+  size_t GetRewriteCount() const;
+
+ private:
+  struct Page {
+    std::shared_ptr<Texture> texture;
+    std::shared_ptr<RectanglePacker> packer;
+    std::vector<Allocation*> allocations;
+    /// The padded area of the live images, in pixels.
+    int64_t live_area = 0;
+    /// Whether a draw may have been recorded with the texture.
+    bool sampled = false;
+  };
+
+  const fml::TimePoint::ClockSource clock_;
+  mutable Mutex mutex_;
+  std::vector<std::unique_ptr<Page>> pages_ IPLR_GUARDED_BY(mutex_);
+  size_t compaction_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t rewrite_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::optional<fml::TimePoint> last_rewrite_ IPLR_GUARDED_BY(mutex_);
+
+  explicit ImageAtlas(fml::TimePoint::ClockSource clock);
+
+  bool CanRewrite() const IPLR_REQUIRES(mutex_);
+
+  std::shared_ptr<Texture> CreatePageTexture(Context& context) const;
+
+  std::unique_ptr<Page> CreatePage(Context& context) const;
+
+  Page* FindSpace(Context& context, ISize padded_size, IPoint* origin)
+      IPLR_REQUIRES(mutex_);
+
+  bool Compact(Context& context) IPLR_REQUIRES(mutex_);
+
+  void Remove(Allocation* allocation);
+
+  ImageAtlas(const ImageAtlas&) = delete;
+
+  ImageAtlas& operator=(const ImageAtlas&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_DISPLAY_LIST_IMAGE_ATLAS_H_
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/backdrop_filter_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+namespace {
+
+/// Copies `source` into `destination`, or into a new texture if
+/// `destination` does not have the same size and format.
+std::shared_ptr<Texture> CopyTexture(Context& context,
+                                     const std::shared_ptr<Texture>& source,
+                                     std::shared_ptr<Texture> destination) {
+  if (!source || !context.GetCapabilities()->SupportsTextureToTextureBlits()) {
+    return nullptr;
+  }
+
+  TextureDescriptor desc = source->GetTextureDescriptor();
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.mip_count = 1;
+  desc.usage = TextureUsage::kShaderRead;
+  std::shared_ptr<Texture> copy = std::move(destination);
+  if (!copy || copy->GetTextureDescriptor().size != desc.size ||
+      copy->GetTextureDescriptor().format != desc.format) {
+    copy = context.GetResourceAllocator()->CreateTexture(desc);
+    if (!copy) {
+      return nullptr;
+    }
+    copy->SetLabel("Backdrop Filter Cache");
+  }
+
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  command_buffer->SetLabel("Backdrop Filter Cache Copy");
+  std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass || !blit_pass->AddCopy(source, copy) ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator()) ||
+      !context.EnqueueCommandBuffer(std::move(command_buffer))) {
+    return nullptr;
+  }
+  return copy;
+}
+
+}  // namespace
+
+BackdropFilterCache::BackdropFilterCache() = default;
+
+BackdropFilterCache::~BackdropFilterCache() = default;
+
+void BackdropFilterCache::MarkUnchanged(int64_t backdrop_id) {
+  unchanged_backdrop_ids_.insert(backdrop_id);
+}
+
+bool BackdropFilterCache::IsUnchanged(int64_t backdrop_id) const {
+  return unchanged_backdrop_ids_.find(backdrop_id) !=
+         unchanged_backdrop_ids_.end();
+}
+
+std::optional<Snapshot> BackdropFilterCache::Get(const Key& key) {
+  if (!IsUnchanged(key.backdrop_id)) {
+    return std::nullopt;
+  }
+  for (Entry& entry : entries_) {
+    if (entry.key == key) {
+      entry.used_this_frame = true;
+      return entry.snapshot;
+    }
+  }
+  return std::nullopt;
+}
+
+Snapshot BackdropFilterCache::Set(Context& context,
+                                  const Key& key,
+                                  Snapshot snapshot) {
+  if (!IsUnchanged(key.backdrop_id)) {
+    return snapshot;
+  }
+
+  // There is at most one result for each backdrop id. Results for other keys
+  // with the same id are stale, but their texture can hold the new result.
+  std::shared_ptr<Texture> stale_texture;
+  auto stale = std::find_if(entries_.begin(), entries_.end(),
+                            [&key](const Entry& entry) {
+                              return entry.key.backdrop_id == key.backdrop_id;
+                            });
+  if (stale != entries_.end()) {
+    stale_texture = std::move(stale->snapshot.texture);
+    entries_.erase(stale);
+  }
+
+  std::shared_ptr<Texture> copy =
+      CopyTexture(context, snapshot.texture, std::move(stale_texture));
+  if (!copy) {
+    return snapshot;
+  }
+  snapshot.texture = std::move(copy);
+  entries_.push_back(Entry{.key = key, .snapshot = snapshot});
+  return snapshot;
+}
+
+void BackdropFilterCache::End() {
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [](const Entry& entry) {
+                                  return !entry.used_this_frame;
+                                }),
+                 entries_.end());
+  for (Entry& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+  unchanged_backdrop_ids_.clear();
+}
+
+size_t BackdropFilterCache::GetCachedCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
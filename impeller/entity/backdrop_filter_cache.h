@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_BACKDROP_FILTER_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_BACKDROP_FILTER_CACHE_H_
+
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+/// @brief Keeps the filtered backdrops of backdrop filters across frames, so
+///        that the backdrop of a filter whose content behind it did not
+///        change is not flipped and filtered again.
+///
+///        Whether the content behind a backdrop filter changed can not be
+///        known from the draws of a single frame. The caller that diffs the
+///        frames, like the layer tree, marks the backdrop ids whose content
+///        is unchanged before the frame is rendered. Results are only kept
+///        and reused for marked ids, and when the filter is applied to the
+///        same region of the same render pass. A backdrop is cached on the
+///        first frame it is marked, so backdrops that change every frame
+///        never pay for the copy.
+///
+///        Results that are not used in a frame, and the marks, are discarded
+///        when the caller that marked them ends the frame.
+class BackdropFilterCache {
+ public:
+  /// Identifies where the backdrop filter of a save layer was applied.
+  struct Key {
+    int64_t backdrop_id = 0;
+    /// The coverage of the save layer, in the coordinates of the root pass.
+    Rect coverage;
+    /// The position of the pass the save layer was drawn into.
+    Point pass_position;
+    Matrix transform;
+
+    bool operator==(const Key& other) const {
+      return backdrop_id == other.backdrop_id && coverage == other.coverage &&
+             pass_position == other.pass_position &&
+             transform == other.transform;
+    }
+  };
+
+  BackdropFilterCache();
+
+  ~BackdropFilterCache();
+
+  /// Marks the content behind the backdrop filter with `backdrop_id` as
+  /// unchanged since the previous frame, for the next frame rendered.
+  void MarkUnchanged(int64_t backdrop_id);
+
+  /// Whether the backdrop with `backdrop_id` was marked unchanged for this
+  /// frame.
+  bool IsUnchanged(int64_t backdrop_id) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Get the filtered backdrop of the previous frame for `key`, if
+  ///         its backdrop id was marked unchanged for this frame.
+  ///
+  std::optional<Snapshot> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Keep a copy of the filtered backdrop of this frame for `key`.
+  ///
+  ///         The snapshot texture is usually owned by the render target cache,
+  ///         which recycles it in later frames, so it is copied with a blit
+  ///         into a texture owned by this cache. The texture of a previous
+  ///         result for the same backdrop id is reused when it fits.
+  ///
+  /// @return The snapshot of the copy, or the given snapshot if it could not
+  ///         be copied and was not kept.
+  ///
+  Snapshot Set(Context& context, const Key& key, Snapshot snapshot);
+
+  /// Mark the end of the frame the marks were made for. Discards the results
+  /// not used in the frame and all marks.
+  void End();
+
+  // Visible for testing.
+  size_t GetCachedCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    Snapshot snapshot;
+    bool used_this_frame = true;
+  };
+
+  std::vector<Entry> entries_;
+  std::unordered_set<int64_t> unchanged_backdrop_ids_;
+
+  BackdropFilterCache(const BackdropFilterCache&) = delete;
+
+  BackdropFilterCache& operator=(const BackdropFilterCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_BACKDROP_FILTER_CACHE_H_
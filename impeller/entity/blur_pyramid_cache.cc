@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/blur_pyramid_cache.h"
+
+#include <utility>
+
+namespace impeller {
+
+BlurPyramidCache::BlurPyramidCache() = default;
+
+BlurPyramidCache::~BlurPyramidCache() = default;
+
+std::shared_ptr<Texture> BlurPyramidCache::Get(
+    const std::shared_ptr<Texture>& texture) {
+  if (!texture) {
+    return nullptr;
+  }
+  Entry& entry = entries_[texture.get()];
+  entry.texture = texture;
+  entry.blur_count++;
+  if (entry.pyramid) {
+    stats_.reuses++;
+  }
+  return entry.pyramid;
+}
+
+bool BlurPyramidCache::ShouldBuild(
+    const std::shared_ptr<Texture>& texture) const {
+  auto found = entries_.find(texture.get());
+  return found != entries_.end() && !found->second.pyramid &&
+         found->second.blur_count >= kMinBlurCountForPyramid;
+}
+
+void BlurPyramidCache::Set(const std::shared_ptr<Texture>& texture,
+                           std::shared_ptr<Texture> pyramid) {
+  if (!texture || !pyramid) {
+    return;
+  }
+  stats_.pyramids++;
+  stats_.pyramid_bytes +=
+      pyramid->GetTextureDescriptor().GetByteSizeOfAllMipLevels();
+  Entry& entry = entries_[texture.get()];
+  entry.texture = texture;
+  entry.pyramid = std::move(pyramid);
+}
+
+void BlurPyramidCache::Clear() {
+  entries_.clear();
+}
+
+const BlurPyramidCache::Stats& BlurPyramidCache::GetStats() const {
+  return stats_;
+}
+
+}  // namespace impeller
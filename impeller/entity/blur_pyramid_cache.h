@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_BLUR_PYRAMID_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_BLUR_PYRAMID_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "impeller/core/texture.h"
+
+namespace impeller {
+
+/// @brief Shares the downsampled levels of a texture between the gaussian
+///        blurs of it in a frame.
+///
+///        Blurs with large sigmas start with a downsample pass that reads the
+///        whole input to render it at 1/4 to 1/16 of its size. Several blurs
+///        of one input, like nested frosted panels over one backdrop or an
+///        image drawn with different blurs, would each read the whole input
+///        again. From the `kMinBlurCountForPyramid`th blur of a texture in a
+///        frame on, a mip pyramid of the texture is built once, and the
+///        downsample pass of each later blur samples the level for its
+///        scale.
+///
+///        Textures are identified by their address, so the cache must be
+///        cleared whenever a texture that was blurred may be rendered to
+///        again, like when the backdrop of a render pass is flipped, and at
+///        the end of each frame.
+class BlurPyramidCache {
+ public:
+  /// The number of blurs of a texture in a frame from which on its pyramid is
+  /// used.
+  ///
+  /// Building a pyramid copies the texture and generates its levels, which
+  /// moves about as many bytes as four downsample passes that read the whole
+  /// texture, while each blur that samples the pyramid saves about one such
+  /// read. A texture that was blurred this often in a frame, like the
+  /// backdrop of a stack of frosted panels, is likely to be blurred as often
+  /// again, so that the reuse makes up for the copy.
+  static constexpr size_t kMinBlurCountForPyramid = 4u;
+
+  /// The maximum number of levels of a pyramid, which covers the smallest
+  /// blur downsample scale of 1/16.
+  static constexpr int32_t kMaxLevelCount = 5;
+
+  struct Stats {
+    /// The number of pyramids built since the cache was created.
+    size_t pyramids = 0;
+    /// The number of blurs that sampled an existing pyramid.
+    size_t reuses = 0;
+    /// The size of the pyramids built, in bytes.
+    size_t pyramid_bytes = 0;
+  };
+
+  BlurPyramidCache();
+
+  ~BlurPyramidCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief  Record a blur of `texture` that downsamples it below half its
+  ///         size.
+  ///
+  /// @return The pyramid of the texture, if it was built for an earlier blur
+  ///         in this frame.
+  ///
+  std::shared_ptr<Texture> Get(const std::shared_ptr<Texture>& texture);
+
+  /// Whether enough blurs of `texture` were recorded to build its pyramid.
+  bool ShouldBuild(const std::shared_ptr<Texture>& texture) const;
+
+  /// Keep the pyramid built for `texture` until the cache is cleared.
+  void Set(const std::shared_ptr<Texture>& texture,
+           std::shared_ptr<Texture> pyramid);
+
+  /// Forget all recorded blurs and pyramids.
+  void Clear();
+
+  const Stats& GetStats() const;
+
+ private:
+  struct Entry {
+    /// Keeps the address of the texture from being reused while it is a key.
+    std::shared_ptr<Texture> texture;
+    size_t blur_count = 0;
+    std::shared_ptr<Texture> pyramid;
+  };
+
+  std::unordered_map<const Texture*, Entry> entries_;
+  Stats stats_;
+
+  BlurPyramidCache(const BlurPyramidCache&) = delete;
+
+  BlurPyramidCache& operator=(const BlurPyramidCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_BLUR_PYRAMID_CACHE_H_
@@ -37,6 +37,12 @@ void ClipContents::SetGeometry(GeometryResult clip_geometry) {
   clip_geometry_ = std::move(clip_geometry);
 }
 
+void ClipContents::SetComplementGeometry(GeometryResult complement_geometry) {
+  FML_DCHECK(clip_op_ == Entity::ClipOperation::kIntersect);
+  clip_geometry_ = std::move(complement_geometry);
+  is_complement_geometry_ = true;
+}
+
 void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
@@ -83,6 +89,19 @@ bool ClipContents::Render(const ContentContext& renderer,
 
   pass.SetStencilReference(0);
 
+  if (is_complement_geometry_) {
+    pass.SetCommandLabel("Analytic Clip");
+    options.depth_write_enabled = true;
+    options.primitive_type = clip_geometry_.type;
+    pass.SetVertexBuffer(clip_geometry_.vertex_buffer);
+    pass.SetPipeline(renderer.GetClipPipeline(options));
+
+    info.mvp = clip_geometry_.transform;
+    VS::BindFrameInfo(pass,
+                      renderer.GetTransientsBuffer().EmplaceUniform(info));
+    return pass.Draw().ok();
+  }
+
   /// Stencil preparation draw.
 
   options.depth_write_enabled = false;
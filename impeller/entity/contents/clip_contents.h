@@ -35,6 +35,12 @@ class ClipContents {
   /// @brief Set the pre-tessellated clip geometry.
   void SetGeometry(GeometryResult geometry);
 
+  /// @brief Set the pre-tessellated pixels that an intersect clip removes
+  ///        within the scissor of its coverage, see
+  ///        `Geometry::GetClipComplementBuffer`. The depth of these is written
+  ///        directly, without a stencil preparation draw.
+  void SetComplementGeometry(GeometryResult complement_geometry);
+
   void SetClipOperation(Entity::ClipOperation clip_op);
 
   //----------------------------------------------------------------------------
@@ -59,6 +65,7 @@ class ClipContents {
   // Coverage rect of the tessellated geometry.
   Rect coverage_rect_;
   bool is_axis_aligned_rect_ = false;
+  bool is_complement_geometry_ = false;
   Entity::ClipOperation clip_op_ = Entity::ClipOperation::kIntersect;
 };
 
@@ -239,18 +239,29 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
 
 ContentContext::ContentContext(
     std::shared_ptr<Context> context,
-    std::shared_ptr<TypographerContext> typographer_context,
+    std::shared_ptr<SharedState> shared,
     std::shared_ptr<RenderTargetAllocator> render_target_allocator)
     : context_(std::move(context)),
-      lazy_glyph_atlas_(
-          std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
-      tessellator_(std::make_shared<Tessellator>()),
+      shared_(std::move(shared)),
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
                                : std::move(render_target_allocator)),
+      backdrop_filter_cache_(std::make_unique<BackdropFilterCache>()),
+      blur_pyramid_cache_(std::make_unique<BlurPyramidCache>()),
       host_buffer_(HostBuffer::Create(context_->GetResourceAllocator(),
-                                      context_->GetIdleWaiter())) {
+                                      context_->GetIdleWaiter())) {}
+
+ContentContext::ContentContext(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<TypographerContext> typographer_context,
+    std::shared_ptr<RenderTargetAllocator> render_target_allocator)
+    : ContentContext(std::move(context),
+                     std::make_shared<SharedState>(),
+                     std::move(render_target_allocator)) {
+  shared_->lazy_glyph_atlas =
+      std::make_shared<LazyGlyphAtlas>(std::move(typographer_context));
+  shared_->tessellator = std::make_shared<Tessellator>();
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -260,13 +271,14 @@ ContentContext::ContentContext(
     desc.storage_mode = StorageMode::kDevicePrivate;
     desc.format = PixelFormat::kR8G8B8A8UNormInt;
     desc.size = ISize{1, 1};
-    empty_texture_ = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+    shared_->empty_texture =
+        GetContext()->GetResourceAllocator()->CreateTexture(desc);
     auto data = Color::BlackTransparent().ToR8G8B8A8();
     auto cmd_buffer = GetContext()->CreateCommandBuffer();
     auto blit_pass = cmd_buffer->CreateBlitPass();
     auto& host_buffer = GetTransientsBuffer();
     auto buffer_view = host_buffer.Emplace(data);
-    blit_pass->AddCopy(buffer_view, empty_texture_);
+    blit_pass->AddCopy(buffer_view, shared_->empty_texture);
 
     if (!blit_pass->EncodeCommands(GetContext()->GetResourceAllocator()) ||
         !GetContext()
@@ -288,37 +300,30 @@ ContentContext::ContentContext(
           context_->GetCapabilities()->GetDefaultColorFormat()};
   const auto supports_decal = static_cast<Scalar>(
       context_->GetCapabilities()->SupportsDecalSamplerAddressMode());
+  // The options of the render passes of a frame, see `OptionsFromPass`.
+  const auto pass_options = ContentContextOptions{
+      .sample_count = context_->GetCapabilities()->SupportsOffscreenMSAA()
+                          ? SampleCount::kCount4
+                          : SampleCount::kCount1,
+      .depth_compare = CompareFunction::kGreaterEqual,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format =
+          context_->GetCapabilities()->GetDefaultColorFormat()};
 
-  // Futures for the following pipelines may block in case the first frame is
-  // rendered without the pipelines being ready. Put pipelines that are more
-  // likely to be used first.
+  // The pipelines are created asynchronously in the order in which they are
+  // requested here. The first frame only waits for the pipelines that it
+  // uses, so the pipelines are requested in the order in which they are
+  // likely to be first used: the pipelines of plain fills, images, text and
+  // clips first, the pipelines of filters next and advanced blends last.
   {
-    glyph_atlas_pipelines_.CreateDefault(
+    TRACE_EVENT0("impeller", "CreateFirstFramePipelines");
+    shared_->solid_fill_pipelines.CreateDefault(*context_, options);
+    shared_->texture_pipelines.CreateDefault(*context_, options);
+    shared_->glyph_atlas_pipelines.CreateDefault(
         *context_, options,
         {static_cast<Scalar>(
             GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat() ==
             PixelFormat::kA8UNormInt)});
-    solid_fill_pipelines_.CreateDefault(*context_, options);
-    texture_pipelines_.CreateDefault(*context_, options);
-    fast_gradient_pipelines_.CreateDefault(*context_, options);
-
-    if (context_->GetCapabilities()->SupportsSSBO()) {
-      linear_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
-      radial_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
-      conical_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
-      sweep_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
-    } else {
-      linear_gradient_uniform_fill_pipelines_.CreateDefault(*context_, options);
-      radial_gradient_uniform_fill_pipelines_.CreateDefault(*context_, options);
-      conical_gradient_uniform_fill_pipelines_.CreateDefault(*context_,
-                                                             options);
-      sweep_gradient_uniform_fill_pipelines_.CreateDefault(*context_, options);
-
-      linear_gradient_fill_pipelines_.CreateDefault(*context_, options);
-      radial_gradient_fill_pipelines_.CreateDefault(*context_, options);
-      conical_gradient_fill_pipelines_.CreateDefault(*context_, options);
-      sweep_gradient_fill_pipelines_.CreateDefault(*context_, options);
-    }
 
     /// Setup default clip pipeline.
     auto clip_pipeline_descriptor =
@@ -339,150 +344,280 @@ ContentContext::ContentContext(
     }
     clip_pipeline_descriptor->SetColorAttachmentDescriptors(
         std::move(clip_color_attachments));
-    clip_pipelines_.SetDefault(
+    shared_->clip_pipelines.SetDefault(
         options,
         std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor));
-    texture_downsample_pipelines_.CreateDefault(*context_,
+    shared_->texture_strict_src_pipelines.CreateDefault(*context_, options);
+    shared_->fast_gradient_pipelines.CreateDefault(*context_, options);
+    if (context_->GetCapabilities()->SupportsSSBO()) {
+      shared_->instanced_solid_fill_pipelines.CreateDefault(*context_, options);
+    }
+  }
+
+  {
+    TRACE_EVENT0("impeller", "CreateCommonPipelines");
+    if (context_->GetCapabilities()->SupportsSSBO()) {
+      shared_->linear_gradient_ssbo_fill_pipelines.CreateDefault(*context_,
+                                                                 options);
+      shared_->radial_gradient_ssbo_fill_pipelines.CreateDefault(*context_,
+                                                                 options);
+      shared_->conical_gradient_ssbo_fill_pipelines.CreateDefault(*context_,
+                                                                  options);
+      shared_->sweep_gradient_ssbo_fill_pipelines.CreateDefault(*context_,
+                                                                options);
+    } else {
+      shared_->linear_gradient_uniform_fill_pipelines.CreateDefault(*context_,
+                                                                    options);
+      shared_->radial_gradient_uniform_fill_pipelines.CreateDefault(*context_,
+                                                                    options);
+      shared_->conical_gradient_uniform_fill_pipelines.CreateDefault(*context_,
+                                                                     options);
+      shared_->sweep_gradient_uniform_fill_pipelines.CreateDefault(*context_,
+                                                                   options);
+
+      shared_->linear_gradient_fill_pipelines.CreateDefault(*context_, options);
+      shared_->radial_gradient_fill_pipelines.CreateDefault(*context_, options);
+      shared_->conical_gradient_fill_pipelines.CreateDefault(*context_,
+                                                             options);
+      shared_->sweep_gradient_fill_pipelines.CreateDefault(*context_, options);
+    }
+    shared_->rrect_blur_pipelines.CreateDefault(*context_,
                                                 options_trianglestrip);
-    rrect_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
-    texture_strict_src_pipelines_.CreateDefault(*context_, options);
-    tiled_texture_pipelines_.CreateDefault(*context_, options,
-                                           {supports_decal});
-    gaussian_blur_pipelines_.CreateDefault(*context_, options_trianglestrip,
-                                           {supports_decal});
-    border_mask_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
-    color_matrix_color_filter_pipelines_.CreateDefault(*context_,
+    shared_->texture_downsample_pipelines.CreateDefault(*context_,
+                                                        options_trianglestrip);
+    shared_->gaussian_blur_pipelines.CreateDefault(*context_,
+                                                   options_trianglestrip,
+                                                   {supports_decal});
+    shared_->tiled_texture_pipelines.CreateDefault(*context_, options,
+                                                   {supports_decal});
+    shared_->porter_duff_blend_pipelines.CreateDefault(*context_,
+                                                       options_trianglestrip,
+                                                       {supports_decal});
+    shared_->color_matrix_color_filter_pipelines.CreateDefault(
+        *context_, options_trianglestrip);
+    shared_->border_mask_blur_pipelines.CreateDefault(*context_,
+                                                      options_trianglestrip);
+    shared_->vertices_uber_shader.CreateDefault(*context_, options,
+                                                {supports_decal});
+    shared_->morphology_filter_pipelines.CreateDefault(*context_,
+                                                       options_trianglestrip,
+                                                       {supports_decal});
+    shared_->linear_to_srgb_filter_pipelines.CreateDefault(
+        *context_, options_trianglestrip);
+    shared_->srgb_to_linear_filter_pipelines.CreateDefault(
+        *context_, options_trianglestrip);
+    shared_->yuv_to_rgb_filter_pipelines.CreateDefault(*context_,
                                                        options_trianglestrip);
-    porter_duff_blend_pipelines_.CreateDefault(*context_, options_trianglestrip,
-                                               {supports_decal});
-    vertices_uber_shader_.CreateDefault(*context_, options, {supports_decal});
+
+#if defined(IMPELLER_ENABLE_OPENGLES)
+    if (GetContext()->GetBackendType() == Context::BackendType::kOpenGLES) {
+#if !defined(FML_OS_MACOSX)
+      // GLES only shader that is unsupported on macOS.
+      shared_->tiled_texture_external_pipelines.CreateDefault(*context_,
+                                                              options);
+#endif  // !defined(FML_OS_MACOSX)
+      shared_->texture_downsample_gles_pipelines.CreateDefault(
+          *context_, options_trianglestrip);
+    }
+#endif  // IMPELLER_ENABLE_OPENGLES
   }
 
+  // The uber pipeline of the advanced blends draws every blend mode while the
+  // specialized pipeline of a blend mode is created on its first use, so it is
+  // created before the specialized pipelines along with variants for the
+  // render passes that draw advanced blends.
+  auto create_uber_pipelines = [&](auto& uber_pipelines) {
+    const auto uber = static_cast<Scalar>(BlendSelectValues::kUber);
+    uber_pipelines.CreateDefault(*context_, options_trianglestrip,
+                                 {uber, supports_decal});
+    for (bool has_depth_stencil_attachments : {true, false}) {
+      for (BlendMode blend_mode :
+           {BlendMode::kSource, BlendMode::kSourceOver}) {
+        ContentContextOptions uber_options = pass_options;
+        uber_options.blend_mode = blend_mode;
+        uber_options.has_depth_stencil_attachments =
+            has_depth_stencil_attachments;
+        uber_pipelines.CreateVariant(*context_, uber_options,
+                                     {uber, supports_decal});
+      }
+    }
+  };
+
   if (context_->GetCapabilities()->SupportsFramebufferFetch()) {
-    framebuffer_blend_color_pipelines_.CreateDefault(
+    create_uber_pipelines(shared_->framebuffer_blend_uber_pipelines);
+    shared_->framebuffer_blend_color_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColor), supports_decal});
-    framebuffer_blend_colorburn_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_colorburn_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColorBurn), supports_decal});
-    framebuffer_blend_colordodge_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_colordodge_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColorDodge), supports_decal});
-    framebuffer_blend_darken_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_darken_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kDarken), supports_decal});
-    framebuffer_blend_difference_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_difference_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kDifference), supports_decal});
-    framebuffer_blend_exclusion_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_exclusion_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kExclusion), supports_decal});
-    framebuffer_blend_hardlight_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_hardlight_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kHardLight), supports_decal});
-    framebuffer_blend_hue_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_hue_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kHue), supports_decal});
-    framebuffer_blend_lighten_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_lighten_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kLighten), supports_decal});
-    framebuffer_blend_luminosity_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_luminosity_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kLuminosity), supports_decal});
-    framebuffer_blend_multiply_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_multiply_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kMultiply), supports_decal});
-    framebuffer_blend_overlay_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_overlay_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kOverlay), supports_decal});
-    framebuffer_blend_saturation_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_saturation_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kSaturation), supports_decal});
-    framebuffer_blend_screen_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_screen_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kScreen), supports_decal});
-    framebuffer_blend_softlight_pipelines_.CreateDefault(
+    shared_->framebuffer_blend_softlight_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kSoftLight), supports_decal});
   } else {
-    blend_color_pipelines_.CreateDefault(
+    create_uber_pipelines(shared_->blend_uber_pipelines);
+    shared_->blend_color_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColor), supports_decal});
-    blend_colorburn_pipelines_.CreateDefault(
+    shared_->blend_colorburn_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColorBurn), supports_decal});
-    blend_colordodge_pipelines_.CreateDefault(
+    shared_->blend_colordodge_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kColorDodge), supports_decal});
-    blend_darken_pipelines_.CreateDefault(
+    shared_->blend_darken_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kDarken), supports_decal});
-    blend_difference_pipelines_.CreateDefault(
+    shared_->blend_difference_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kDifference), supports_decal});
-    blend_exclusion_pipelines_.CreateDefault(
+    shared_->blend_exclusion_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kExclusion), supports_decal});
-    blend_hardlight_pipelines_.CreateDefault(
+    shared_->blend_hardlight_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kHardLight), supports_decal});
-    blend_hue_pipelines_.CreateDefault(
+    shared_->blend_hue_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kHue), supports_decal});
-    blend_lighten_pipelines_.CreateDefault(
+    shared_->blend_lighten_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kLighten), supports_decal});
-    blend_luminosity_pipelines_.CreateDefault(
+    shared_->blend_luminosity_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kLuminosity), supports_decal});
-    blend_multiply_pipelines_.CreateDefault(
+    shared_->blend_multiply_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kMultiply), supports_decal});
-    blend_overlay_pipelines_.CreateDefault(
+    shared_->blend_overlay_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kOverlay), supports_decal});
-    blend_saturation_pipelines_.CreateDefault(
+    shared_->blend_saturation_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kSaturation), supports_decal});
-    blend_screen_pipelines_.CreateDefault(
+    shared_->blend_screen_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kScreen), supports_decal});
-    blend_softlight_pipelines_.CreateDefault(
+    shared_->blend_softlight_pipelines.CreateDefault(
         *context_, options_trianglestrip,
         {static_cast<Scalar>(BlendSelectValues::kSoftLight), supports_decal});
   }
 
-  morphology_filter_pipelines_.CreateDefault(*context_, options_trianglestrip,
-                                             {supports_decal});
-  linear_to_srgb_filter_pipelines_.CreateDefault(*context_,
-                                                 options_trianglestrip);
-  srgb_to_linear_filter_pipelines_.CreateDefault(*context_,
-                                                 options_trianglestrip);
-  yuv_to_rgb_filter_pipelines_.CreateDefault(*context_, options_trianglestrip);
-
-#if defined(IMPELLER_ENABLE_OPENGLES)
-  if (GetContext()->GetBackendType() == Context::BackendType::kOpenGLES) {
-#if !defined(FML_OS_MACOSX)
-    // GLES only shader that is unsupported on macOS.
-    tiled_texture_external_pipelines_.CreateDefault(*context_, options);
-#endif  // !defined(FML_OS_MACOSX)
-    texture_downsample_gles_pipelines_.CreateDefault(*context_,
-                                                     options_trianglestrip);
-  }
-#endif  // IMPELLER_ENABLE_OPENGLES
-
   is_valid_ = true;
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
 ContentContext::~ContentContext() = default;
 
+std::unique_ptr<ContentContext> ContentContext::CreateShared(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<RenderTargetAllocator> render_target_allocator) const {
+  FML_DCHECK(context && context->GetPipelineLibrary() ==
+                            context_->GetPipelineLibrary());
+  auto content_context = std::unique_ptr<ContentContext>(new ContentContext(
+      std::move(context), shared_, std::move(render_target_allocator)));
+  content_context->is_valid_ = is_valid_;
+  content_context->wireframe_ = wireframe_;
+  return content_context;
+}
+
 bool ContentContext::IsValid() const {
   return is_valid_;
 }
 
+template <class IsReady>
+bool ContentContext::CheckFirstFramePipelines(const IsReady& is_ready) const {
+  if (!IsValid()) {
+    return false;
+  }
+  auto check = [&is_ready](const auto& variants) {
+    auto* handle = variants.GetDefault();
+    return handle != nullptr && is_ready(*handle);
+  };
+  bool ready = check(shared_->solid_fill_pipelines) &&
+               check(shared_->texture_pipelines) &&
+               check(shared_->glyph_atlas_pipelines) &&
+               check(shared_->clip_pipelines) &&
+               check(shared_->texture_strict_src_pipelines) &&
+               check(shared_->fast_gradient_pipelines);
+  if (ready && context_->GetCapabilities()->SupportsSSBO()) {
+    ready = check(shared_->instanced_solid_fill_pipelines);
+  }
+  return ready;
+}
+
+void ContentContext::MarkFirstFramePipelinesReady() const {
+  if (shared_->first_frame_pipelines_ready) {
+    return;
+  }
+  shared_->first_frame_pipelines_ready = true;
+  TRACE_EVENT_INSTANT0("impeller", "FirstFramePipelinesReady");
+}
+
+bool ContentContext::WaitForFirstFramePipelines() const {
+  TRACE_EVENT0("impeller", "WaitForFirstFramePipelines");
+  bool ready = CheckFirstFramePipelines(
+      [](auto& handle) { return handle.WaitAndGet() != nullptr; });
+  if (ready) {
+    MarkFirstFramePipelinesReady();
+  }
+  return ready;
+}
+
+bool ContentContext::AreFirstFramePipelinesReady() const {
+  if (IsValid() && shared_->first_frame_pipelines_ready) {
+    return true;
+  }
+  bool ready = CheckFirstFramePipelines(
+      [](const auto& handle) { return handle.IsReady(); });
+  if (ready) {
+    MarkFirstFramePipelinesReady();
+  }
+  return ready;
+}
+
+size_t ContentContext::GetSynchronousVariantCount() const {
+  return shared_->synchronous_variant_count;
+}
+
 std::shared_ptr<Texture> ContentContext::GetEmptyTexture() const {
-  return empty_texture_;
+  return shared_->empty_texture;
 }
 
 fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
@@ -554,7 +689,7 @@ fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
 }
 
 Tessellator& ContentContext::GetTessellator() const {
-  return *tessellator_;
+  return *shared_->tessellator;
 }
 
 std::shared_ptr<Context> ContentContext::GetContext() const {
@@ -569,25 +704,30 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetDisplayListCostCallback(
+    DisplayListCostCallback callback) {
+  display_list_cost_callback_ = std::move(callback);
+}
+
 PipelineRef ContentContext::GetCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name,
     const ContentContextOptions& options,
     const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
         create_callback) const {
   RuntimeEffectPipelineKey key{unique_entrypoint_name, options};
-  auto it = runtime_effect_pipelines_.find(key);
-  if (it == runtime_effect_pipelines_.end()) {
-    it = runtime_effect_pipelines_.insert(it, {key, create_callback()});
+  auto it = shared_->runtime_effect_pipelines.find(key);
+  if (it == shared_->runtime_effect_pipelines.end()) {
+    it = shared_->runtime_effect_pipelines.insert(it, {key, create_callback()});
   }
   return raw_ptr(it->second);
 }
 
 void ContentContext::ClearCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name) const {
-  for (auto it = runtime_effect_pipelines_.begin();
-       it != runtime_effect_pipelines_.end();) {
+  for (auto it = shared_->runtime_effect_pipelines.begin();
+       it != shared_->runtime_effect_pipelines.end();) {
     if (it->first.unique_entrypoint_name == unique_entrypoint_name) {
-      it = runtime_effect_pipelines_.erase(it);
+      it = shared_->runtime_effect_pipelines.erase(it);
     } else {
       it++;
     }
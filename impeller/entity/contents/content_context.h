@@ -12,9 +12,12 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/status_or.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/backdrop_filter_cache.h"
+#include "impeller/entity/blur_pyramid_cache.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
@@ -66,6 +69,9 @@
 #include "impeller/entity/radial_gradient_ssbo_fill.frag.h"
 #include "impeller/entity/sweep_gradient_ssbo_fill.frag.h"
 
+#include "impeller/entity/instanced_solid_fill.frag.h"
+#include "impeller/entity/instanced_solid_fill.vert.h"
+
 #include "impeller/entity/advanced_blend.frag.h"
 #include "impeller/entity/advanced_blend.vert.h"
 
@@ -121,6 +127,9 @@ using RadialGradientSSBOFillPipeline =
 using SweepGradientSSBOFillPipeline =
     RenderPipelineHandle<GradientFillVertexShader,
                          SweepGradientSsboFillFragmentShader>;
+using InstancedSolidFillPipeline =
+    RenderPipelineHandle<InstancedSolidFillVertexShader,
+                         InstancedSolidFillFragmentShader>;
 using RRectBlurPipeline =
     RenderPipelineHandle<RrectBlurVertexShader, RrectBlurFragmentShader>;
 using TexturePipeline =
@@ -202,6 +211,8 @@ using BlendScreenPipeline = RenderPipelineHandle<AdvancedBlendVertexShader,
 using BlendSoftLightPipeline =
     RenderPipelineHandle<AdvancedBlendVertexShader,
                          AdvancedBlendFragmentShader>;
+using BlendUberPipeline = RenderPipelineHandle<AdvancedBlendVertexShader,
+                                               AdvancedBlendFragmentShader>;
 // Framebuffer Advanced Blends
 using FramebufferBlendColorPipeline =
     RenderPipelineHandle<FramebufferBlendVertexShader,
@@ -248,6 +259,9 @@ using FramebufferBlendScreenPipeline =
 using FramebufferBlendSoftLightPipeline =
     RenderPipelineHandle<FramebufferBlendVertexShader,
                          FramebufferBlendFragmentShader>;
+using FramebufferBlendUberPipeline =
+    RenderPipelineHandle<FramebufferBlendVertexShader,
+                         FramebufferBlendFragmentShader>;
 
 /// Draw Vertices/Atlas Uber Shader
 using VerticesUberShader = RenderPipelineHandle<PorterDuffBlendVertexShader,
@@ -373,307 +387,388 @@ class ContentContext {
 
   ~ContentContext();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a content context that shares the pipelines, the
+  ///             glyph atlas and the tessellator of this one, and so needs no
+  ///             warm up. It has its own transients buffer and render target
+  ///             cache, so that the frames rendered with one content context
+  ///             neither overwrite the transient data of the frames in flight
+  ///             of another nor evict its render targets.
+  ///
+  ///             The content contexts sharing state must only be used from the
+  ///             same thread.
+  ///
+  /// @param[in]  context                  The context to render with. It must
+  ///                                      use the pipeline library of the
+  ///                                      context of this content context,
+  ///                                      like the surface contexts of one
+  ///                                      Vulkan context do.
+  /// @param[in]  render_target_allocator  Injects a render target allocator
+  ///                                      or allocates its own if `nullptr`
+  ///                                      is supplied.
+  ///
+  std::unique_ptr<ContentContext> CreateShared(
+      std::shared_ptr<Context> context,
+      std::shared_ptr<RenderTargetAllocator> render_target_allocator =
+          nullptr) const;
+
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wait for the pipelines that are created first at startup
+  ///             because nearly every frame uses them, such as the pipelines
+  ///             of solid fills, images, text and clips.
+  ///
+  ///             The other pipelines keep being created in the background.
+  ///
+  /// @return     Whether all of those pipelines were created successfully.
+  ///
+  bool WaitForFirstFramePipelines() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the pipelines that `WaitForFirstFramePipelines` waits
+  ///             for have been created, without waiting for them.
+  ///
+  ///             The first call that finds them created emits the
+  ///             "FirstFramePipelinesReady" trace event. Frames call this
+  ///             before they render, so startup traces show whether the first
+  ///             frames stalled on pipeline creation.
+  ///
+  bool AreFirstFramePipelinesReady() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of pipeline variants that were created
+  ///             synchronously, or waited for, on their first use, stalling
+  ///             the thread that rendered with them.
+  ///
+  ///             Only advanced blends have an uber pipeline that draws them
+  ///             while their variants are created in the background. No
+  ///             pipeline can stand in for the fixed function blending of the
+  ///             blend modes up to Entity::kLastPipelineBlendMode, so the
+  ///             first use of one of those under new options is still
+  ///             created synchronously and counted here.
+  ///
+  size_t GetSynchronousVariantCount() const;
+
   Tessellator& GetTessellator() const;
 
   PipelineRef GetFastGradientPipeline(ContentContextOptions opts) const {
-    return GetPipeline(fast_gradient_pipelines_, opts);
+    return GetPipeline(shared_->fast_gradient_pipelines, opts);
   }
 
   PipelineRef GetLinearGradientFillPipeline(ContentContextOptions opts) const {
-    return GetPipeline(linear_gradient_fill_pipelines_, opts);
+    return GetPipeline(shared_->linear_gradient_fill_pipelines, opts);
   }
 
   PipelineRef GetLinearGradientUniformFillPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(linear_gradient_uniform_fill_pipelines_, opts);
+    return GetPipeline(shared_->linear_gradient_uniform_fill_pipelines, opts);
   }
 
   PipelineRef GetRadialGradientUniformFillPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(radial_gradient_uniform_fill_pipelines_, opts);
+    return GetPipeline(shared_->radial_gradient_uniform_fill_pipelines, opts);
   }
 
   PipelineRef GetConicalGradientUniformFillPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(conical_gradient_uniform_fill_pipelines_, opts);
+    return GetPipeline(shared_->conical_gradient_uniform_fill_pipelines, opts);
   }
 
   PipelineRef GetSweepGradientUniformFillPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(sweep_gradient_uniform_fill_pipelines_, opts);
+    return GetPipeline(shared_->sweep_gradient_uniform_fill_pipelines, opts);
   }
 
   PipelineRef GetLinearGradientSSBOFillPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(linear_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(shared_->linear_gradient_ssbo_fill_pipelines, opts);
   }
 
   PipelineRef GetRadialGradientSSBOFillPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(radial_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(shared_->radial_gradient_ssbo_fill_pipelines, opts);
   }
 
   PipelineRef GetConicalGradientSSBOFillPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(conical_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(shared_->conical_gradient_ssbo_fill_pipelines, opts);
   }
 
   PipelineRef GetSweepGradientSSBOFillPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(sweep_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(shared_->sweep_gradient_ssbo_fill_pipelines, opts);
+  }
+
+  PipelineRef GetInstancedSolidFillPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(shared_->instanced_solid_fill_pipelines, opts);
   }
 
   PipelineRef GetRadialGradientFillPipeline(ContentContextOptions opts) const {
-    return GetPipeline(radial_gradient_fill_pipelines_, opts);
+    return GetPipeline(shared_->radial_gradient_fill_pipelines, opts);
   }
 
   PipelineRef GetConicalGradientFillPipeline(ContentContextOptions opts) const {
-    return GetPipeline(conical_gradient_fill_pipelines_, opts);
+    return GetPipeline(shared_->conical_gradient_fill_pipelines, opts);
   }
 
   PipelineRef GetRRectBlurPipeline(ContentContextOptions opts) const {
-    return GetPipeline(rrect_blur_pipelines_, opts);
+    return GetPipeline(shared_->rrect_blur_pipelines, opts);
   }
 
   PipelineRef GetSweepGradientFillPipeline(ContentContextOptions opts) const {
-    return GetPipeline(sweep_gradient_fill_pipelines_, opts);
+    return GetPipeline(shared_->sweep_gradient_fill_pipelines, opts);
   }
 
   PipelineRef GetSolidFillPipeline(ContentContextOptions opts) const {
-    return GetPipeline(solid_fill_pipelines_, opts);
+    return GetPipeline(shared_->solid_fill_pipelines, opts);
   }
 
   PipelineRef GetTexturePipeline(ContentContextOptions opts) const {
-    return GetPipeline(texture_pipelines_, opts);
+    return GetPipeline(shared_->texture_pipelines, opts);
   }
 
   PipelineRef GetTextureStrictSrcPipeline(ContentContextOptions opts) const {
-    return GetPipeline(texture_strict_src_pipelines_, opts);
+    return GetPipeline(shared_->texture_strict_src_pipelines, opts);
   }
 
 #ifdef IMPELLER_ENABLE_OPENGLES
   PipelineRef GetDownsampleTextureGlesPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(texture_downsample_gles_pipelines_, opts);
+    return GetPipeline(shared_->texture_downsample_gles_pipelines, opts);
   }
 
   PipelineRef GetTiledTextureExternalPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetContext()->GetBackendType() ==
                Context::BackendType::kOpenGLES);
-    return GetPipeline(tiled_texture_external_pipelines_, opts);
+    return GetPipeline(shared_->tiled_texture_external_pipelines, opts);
   }
 #endif  // IMPELLER_ENABLE_OPENGLES
 
   PipelineRef GetTiledTexturePipeline(ContentContextOptions opts) const {
-    return GetPipeline(tiled_texture_pipelines_, opts);
+    return GetPipeline(shared_->tiled_texture_pipelines, opts);
   }
 
   PipelineRef GetGaussianBlurPipeline(ContentContextOptions opts) const {
-    return GetPipeline(gaussian_blur_pipelines_, opts);
+    return GetPipeline(shared_->gaussian_blur_pipelines, opts);
   }
 
   PipelineRef GetBorderMaskBlurPipeline(ContentContextOptions opts) const {
-    return GetPipeline(border_mask_blur_pipelines_, opts);
+    return GetPipeline(shared_->border_mask_blur_pipelines, opts);
   }
 
   PipelineRef GetMorphologyFilterPipeline(ContentContextOptions opts) const {
-    return GetPipeline(morphology_filter_pipelines_, opts);
+    return GetPipeline(shared_->morphology_filter_pipelines, opts);
   }
 
   PipelineRef GetColorMatrixColorFilterPipeline(
       ContentContextOptions opts) const {
-    return GetPipeline(color_matrix_color_filter_pipelines_, opts);
+    return GetPipeline(shared_->color_matrix_color_filter_pipelines, opts);
   }
 
   PipelineRef GetLinearToSrgbFilterPipeline(ContentContextOptions opts) const {
-    return GetPipeline(linear_to_srgb_filter_pipelines_, opts);
+    return GetPipeline(shared_->linear_to_srgb_filter_pipelines, opts);
   }
 
   PipelineRef GetSrgbToLinearFilterPipeline(ContentContextOptions opts) const {
-    return GetPipeline(srgb_to_linear_filter_pipelines_, opts);
+    return GetPipeline(shared_->srgb_to_linear_filter_pipelines, opts);
   }
 
   PipelineRef GetClipPipeline(ContentContextOptions opts) const {
-    return GetPipeline(clip_pipelines_, opts);
+    return GetPipeline(shared_->clip_pipelines, opts);
   }
 
   PipelineRef GetGlyphAtlasPipeline(ContentContextOptions opts) const {
-    return GetPipeline(glyph_atlas_pipelines_, opts);
+    return GetPipeline(shared_->glyph_atlas_pipelines, opts);
   }
 
   PipelineRef GetYUVToRGBFilterPipeline(ContentContextOptions opts) const {
-    return GetPipeline(yuv_to_rgb_filter_pipelines_, opts);
+    return GetPipeline(shared_->yuv_to_rgb_filter_pipelines, opts);
   }
 
   PipelineRef GetPorterDuffBlendPipeline(ContentContextOptions opts) const {
-    return GetPipeline(porter_duff_blend_pipelines_, opts);
+    return GetPipeline(shared_->porter_duff_blend_pipelines, opts);
   }
 
   // Advanced blends.
 
   PipelineRef GetBlendColorPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_color_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_color_pipelines, opts);
   }
 
   PipelineRef GetBlendColorBurnPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_colorburn_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_colorburn_pipelines, opts);
   }
 
   PipelineRef GetBlendColorDodgePipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_colordodge_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_colordodge_pipelines, opts);
   }
 
   PipelineRef GetBlendDarkenPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_darken_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_darken_pipelines, opts);
   }
 
   PipelineRef GetBlendDifferencePipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_difference_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_difference_pipelines, opts);
   }
 
   PipelineRef GetBlendExclusionPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_exclusion_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_exclusion_pipelines, opts);
   }
 
   PipelineRef GetBlendHardLightPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_hardlight_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_hardlight_pipelines, opts);
   }
 
   PipelineRef GetBlendHuePipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_hue_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_hue_pipelines, opts);
   }
 
   PipelineRef GetBlendLightenPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_lighten_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_lighten_pipelines, opts);
   }
 
   PipelineRef GetBlendLuminosityPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_luminosity_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_luminosity_pipelines, opts);
   }
 
   PipelineRef GetBlendMultiplyPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_multiply_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_multiply_pipelines, opts);
   }
 
   PipelineRef GetBlendOverlayPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_overlay_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_overlay_pipelines, opts);
   }
 
   PipelineRef GetBlendSaturationPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_saturation_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_saturation_pipelines, opts);
   }
 
   PipelineRef GetBlendScreenPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_screen_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_screen_pipelines, opts);
   }
 
   PipelineRef GetBlendSoftLightPipeline(ContentContextOptions opts) const {
-    return GetPipeline(blend_softlight_pipelines_, opts);
+    return GetBlendPipeline(shared_->blend_softlight_pipelines, opts);
   }
 
   PipelineRef GetDownsamplePipeline(ContentContextOptions opts) const {
-    return GetPipeline(texture_downsample_pipelines_, opts);
+    return GetPipeline(shared_->texture_downsample_pipelines, opts);
   }
 
   // Framebuffer Advanced Blends
   PipelineRef GetFramebufferBlendColorPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_color_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_color_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendColorBurnPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_colorburn_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_colorburn_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendColorDodgePipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_colordodge_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_colordodge_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendDarkenPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_darken_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_darken_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendDifferencePipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_difference_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_difference_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendExclusionPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_exclusion_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_exclusion_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendHardLightPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_hardlight_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_hardlight_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendHuePipeline(ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_hue_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_hue_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendLightenPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_lighten_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_lighten_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendLuminosityPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_luminosity_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_luminosity_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendMultiplyPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_multiply_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_multiply_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendOverlayPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_overlay_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_overlay_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendSaturationPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_saturation_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_saturation_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendScreenPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_screen_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_screen_pipelines, opts);
   }
 
   PipelineRef GetFramebufferBlendSoftLightPipeline(
       ContentContextOptions opts) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsFramebufferFetch());
-    return GetPipeline(framebuffer_blend_softlight_pipelines_, opts);
+    return GetFramebufferBlendPipeline(
+        shared_->framebuffer_blend_softlight_pipelines, opts);
   }
 
   PipelineRef GetDrawVerticesUberShader(ContentContextOptions opts) const {
-    return GetPipeline(vertices_uber_shader_, opts);
+    return GetPipeline(shared_->vertices_uber_shader, opts);
   }
 
   // An empty 1x1 texture for binding drawVertices/drawAtlas or other cases
@@ -686,6 +781,20 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  /// Receives the time spent turning a DisplayList that was drawn into the
+  /// root DisplayList of a frame into entities, which includes encoding them
+  /// into render passes, keyed by the unique id of the DisplayList.
+  ///
+  /// See |RenderToOnscreen|.
+  using DisplayListCostCallback =
+      std::function<void(uint32_t display_list_id, fml::TimeDelta time)>;
+
+  void SetDisplayListCostCallback(DisplayListCostCallback callback);
+
+  const DisplayListCostCallback& GetDisplayListCostCallback() const {
+    return display_list_cost_callback_;
+  }
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -708,13 +817,21 @@ class ContentContext {
       const SubpassCallback& subpass_callback) const;
 
   const std::shared_ptr<LazyGlyphAtlas>& GetLazyGlyphAtlas() const {
-    return lazy_glyph_atlas_;
+    return shared_->lazy_glyph_atlas;
   }
 
   const std::shared_ptr<RenderTargetAllocator>& GetRenderTargetCache() const {
     return render_target_cache_;
   }
 
+  BackdropFilterCache& GetBackdropFilterCache() const {
+    return *backdrop_filter_cache_;
+  }
+
+  BlurPyramidCache& GetBlurPyramidCache() const {
+    return *blur_pyramid_cache_;
+  }
+
   /// RuntimeEffect pipelines must be obtained via this method to avoid
   /// re-creating them every frame.
   ///
@@ -743,7 +860,6 @@ class ContentContext {
 
  private:
   std::shared_ptr<Context> context_;
-  std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
 
   /// Run backend specific additional setup and create common shader variants.
   ///
@@ -773,12 +889,6 @@ class ContentContext {
     };
   };
 
-  mutable std::unordered_map<RuntimeEffectPipelineKey,
-                             std::shared_ptr<Pipeline<PipelineDescriptor>>,
-                             RuntimeEffectPipelineKey::Hash,
-                             RuntimeEffectPipelineKey::Equal>
-      runtime_effect_pipelines_;
-
   /// Holds multiple Pipelines associated with the same PipelineHandle types.
   ///
   /// For example, it may have multiple
@@ -827,6 +937,21 @@ class ContentContext {
       SetDefault(options, std::make_unique<PipelineHandleT>(context, desc));
     }
 
+    /// Create a variant from the shaders of the default before it is first
+    /// used, so that it is not created synchronously on first use.
+    void CreateVariant(const Context& context,
+                       const ContentContextOptions& options,
+                       const std::initializer_list<Scalar>& constants = {}) {
+      auto desc = PipelineHandleT::Builder::MakeDefaultPipelineDescriptor(
+          context, constants);
+      if (!desc.has_value()) {
+        VALIDATION_LOG << "Failed to create pipeline variant.";
+        return;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      Set(options, std::make_unique<PipelineHandleT>(context, desc));
+    }
+
     PipelineHandleT* Get(const ContentContextOptions& options) const {
       uint64_t p_key = options.ToKey();
       for (const auto& [key, pipeline] : pipelines_) {
@@ -856,103 +981,120 @@ class ContentContext {
     Variants& operator=(const Variants&) = delete;
   };
 
-  // These are mutable because while the prototypes are created eagerly, any
-  // variants requested from that are lazily created and cached in the variants
-  // map.
-
-  mutable Variants<SolidFillPipeline> solid_fill_pipelines_;
-  mutable Variants<FastGradientPipeline> fast_gradient_pipelines_;
-  mutable Variants<LinearGradientFillPipeline> linear_gradient_fill_pipelines_;
-  mutable Variants<RadialGradientFillPipeline> radial_gradient_fill_pipelines_;
-  mutable Variants<ConicalGradientFillPipeline>
-      conical_gradient_fill_pipelines_;
-  mutable Variants<SweepGradientFillPipeline> sweep_gradient_fill_pipelines_;
-  mutable Variants<LinearGradientUniformFillPipeline>
-      linear_gradient_uniform_fill_pipelines_;
-  mutable Variants<RadialGradientUniformFillPipeline>
-      radial_gradient_uniform_fill_pipelines_;
-  mutable Variants<ConicalGradientUniformFillPipeline>
-      conical_gradient_uniform_fill_pipelines_;
-  mutable Variants<SweepGradientUniformFillPipeline>
-      sweep_gradient_uniform_fill_pipelines_;
-  mutable Variants<LinearGradientSSBOFillPipeline>
-      linear_gradient_ssbo_fill_pipelines_;
-  mutable Variants<RadialGradientSSBOFillPipeline>
-      radial_gradient_ssbo_fill_pipelines_;
-  mutable Variants<ConicalGradientSSBOFillPipeline>
-      conical_gradient_ssbo_fill_pipelines_;
-  mutable Variants<SweepGradientSSBOFillPipeline>
-      sweep_gradient_ssbo_fill_pipelines_;
-  mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
-  mutable Variants<TexturePipeline> texture_pipelines_;
-  mutable Variants<TextureDownsamplePipeline> texture_downsample_pipelines_;
-  mutable Variants<TextureStrictSrcPipeline> texture_strict_src_pipelines_;
+  /// The pipelines and caches that a content context has in common with the
+  /// content contexts created from it by |CreateShared|.
+  struct SharedState {
+    std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas;
+    std::shared_ptr<Tessellator> tessellator;
+    std::shared_ptr<Texture> empty_texture;
+    std::unordered_map<RuntimeEffectPipelineKey,
+                       std::shared_ptr<Pipeline<PipelineDescriptor>>,
+                       RuntimeEffectPipelineKey::Hash,
+                       RuntimeEffectPipelineKey::Equal>
+        runtime_effect_pipelines;
+
+    // The prototypes are created eagerly by the first content context, any
+    // variants requested from them are lazily created and cached here.
+    Variants<SolidFillPipeline> solid_fill_pipelines;
+    Variants<FastGradientPipeline> fast_gradient_pipelines;
+    Variants<LinearGradientFillPipeline> linear_gradient_fill_pipelines;
+    Variants<RadialGradientFillPipeline> radial_gradient_fill_pipelines;
+    Variants<ConicalGradientFillPipeline> conical_gradient_fill_pipelines;
+    Variants<SweepGradientFillPipeline> sweep_gradient_fill_pipelines;
+    Variants<LinearGradientUniformFillPipeline>
+        linear_gradient_uniform_fill_pipelines;
+    Variants<RadialGradientUniformFillPipeline>
+        radial_gradient_uniform_fill_pipelines;
+    Variants<ConicalGradientUniformFillPipeline>
+        conical_gradient_uniform_fill_pipelines;
+    Variants<SweepGradientUniformFillPipeline>
+        sweep_gradient_uniform_fill_pipelines;
+    Variants<LinearGradientSSBOFillPipeline>
+        linear_gradient_ssbo_fill_pipelines;
+    Variants<RadialGradientSSBOFillPipeline>
+        radial_gradient_ssbo_fill_pipelines;
+    Variants<ConicalGradientSSBOFillPipeline>
+        conical_gradient_ssbo_fill_pipelines;
+    Variants<SweepGradientSSBOFillPipeline> sweep_gradient_ssbo_fill_pipelines;
+    Variants<InstancedSolidFillPipeline> instanced_solid_fill_pipelines;
+    Variants<RRectBlurPipeline> rrect_blur_pipelines;
+    Variants<TexturePipeline> texture_pipelines;
+    Variants<TextureDownsamplePipeline> texture_downsample_pipelines;
+    Variants<TextureStrictSrcPipeline> texture_strict_src_pipelines;
 #ifdef IMPELLER_ENABLE_OPENGLES
-  mutable Variants<TiledTextureExternalPipeline>
-      tiled_texture_external_pipelines_;
-  mutable Variants<TextureDownsampleGlesPipeline>
-      texture_downsample_gles_pipelines_;
+    Variants<TiledTextureExternalPipeline> tiled_texture_external_pipelines;
+    Variants<TextureDownsampleGlesPipeline> texture_downsample_gles_pipelines;
 #endif  // IMPELLER_ENABLE_OPENGLES
-  mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
-  mutable Variants<GaussianBlurPipeline> gaussian_blur_pipelines_;
-  mutable Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines_;
-  mutable Variants<MorphologyFilterPipeline> morphology_filter_pipelines_;
-  mutable Variants<ColorMatrixColorFilterPipeline>
-      color_matrix_color_filter_pipelines_;
-  mutable Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter_pipelines_;
-  mutable Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter_pipelines_;
-  mutable Variants<ClipPipeline> clip_pipelines_;
-  mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
-  mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
-  mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
-  // Advanced blends.
-  mutable Variants<BlendColorPipeline> blend_color_pipelines_;
-  mutable Variants<BlendColorBurnPipeline> blend_colorburn_pipelines_;
-  mutable Variants<BlendColorDodgePipeline> blend_colordodge_pipelines_;
-  mutable Variants<BlendDarkenPipeline> blend_darken_pipelines_;
-  mutable Variants<BlendDifferencePipeline> blend_difference_pipelines_;
-  mutable Variants<BlendExclusionPipeline> blend_exclusion_pipelines_;
-  mutable Variants<BlendHardLightPipeline> blend_hardlight_pipelines_;
-  mutable Variants<BlendHuePipeline> blend_hue_pipelines_;
-  mutable Variants<BlendLightenPipeline> blend_lighten_pipelines_;
-  mutable Variants<BlendLuminosityPipeline> blend_luminosity_pipelines_;
-  mutable Variants<BlendMultiplyPipeline> blend_multiply_pipelines_;
-  mutable Variants<BlendOverlayPipeline> blend_overlay_pipelines_;
-  mutable Variants<BlendSaturationPipeline> blend_saturation_pipelines_;
-  mutable Variants<BlendScreenPipeline> blend_screen_pipelines_;
-  mutable Variants<BlendSoftLightPipeline> blend_softlight_pipelines_;
-  // Framebuffer Advanced blends.
-  mutable Variants<FramebufferBlendColorPipeline>
-      framebuffer_blend_color_pipelines_;
-  mutable Variants<FramebufferBlendColorBurnPipeline>
-      framebuffer_blend_colorburn_pipelines_;
-  mutable Variants<FramebufferBlendColorDodgePipeline>
-      framebuffer_blend_colordodge_pipelines_;
-  mutable Variants<FramebufferBlendDarkenPipeline>
-      framebuffer_blend_darken_pipelines_;
-  mutable Variants<FramebufferBlendDifferencePipeline>
-      framebuffer_blend_difference_pipelines_;
-  mutable Variants<FramebufferBlendExclusionPipeline>
-      framebuffer_blend_exclusion_pipelines_;
-  mutable Variants<FramebufferBlendHardLightPipeline>
-      framebuffer_blend_hardlight_pipelines_;
-  mutable Variants<FramebufferBlendHuePipeline>
-      framebuffer_blend_hue_pipelines_;
-  mutable Variants<FramebufferBlendLightenPipeline>
-      framebuffer_blend_lighten_pipelines_;
-  mutable Variants<FramebufferBlendLuminosityPipeline>
-      framebuffer_blend_luminosity_pipelines_;
-  mutable Variants<FramebufferBlendMultiplyPipeline>
-      framebuffer_blend_multiply_pipelines_;
-  mutable Variants<FramebufferBlendOverlayPipeline>
-      framebuffer_blend_overlay_pipelines_;
-  mutable Variants<FramebufferBlendSaturationPipeline>
-      framebuffer_blend_saturation_pipelines_;
-  mutable Variants<FramebufferBlendScreenPipeline>
-      framebuffer_blend_screen_pipelines_;
-  mutable Variants<FramebufferBlendSoftLightPipeline>
-      framebuffer_blend_softlight_pipelines_;
-  mutable Variants<VerticesUberShader> vertices_uber_shader_;
+    Variants<TiledTexturePipeline> tiled_texture_pipelines;
+    Variants<GaussianBlurPipeline> gaussian_blur_pipelines;
+    Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines;
+    Variants<MorphologyFilterPipeline> morphology_filter_pipelines;
+    Variants<ColorMatrixColorFilterPipeline>
+        color_matrix_color_filter_pipelines;
+    Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter_pipelines;
+    Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter_pipelines;
+    Variants<ClipPipeline> clip_pipelines;
+    Variants<GlyphAtlasPipeline> glyph_atlas_pipelines;
+    Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines;
+    Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines;
+    // Advanced blends.
+    Variants<BlendColorPipeline> blend_color_pipelines;
+    Variants<BlendColorBurnPipeline> blend_colorburn_pipelines;
+    Variants<BlendColorDodgePipeline> blend_colordodge_pipelines;
+    Variants<BlendDarkenPipeline> blend_darken_pipelines;
+    Variants<BlendDifferencePipeline> blend_difference_pipelines;
+    Variants<BlendExclusionPipeline> blend_exclusion_pipelines;
+    Variants<BlendHardLightPipeline> blend_hardlight_pipelines;
+    Variants<BlendHuePipeline> blend_hue_pipelines;
+    Variants<BlendLightenPipeline> blend_lighten_pipelines;
+    Variants<BlendLuminosityPipeline> blend_luminosity_pipelines;
+    Variants<BlendMultiplyPipeline> blend_multiply_pipelines;
+    Variants<BlendOverlayPipeline> blend_overlay_pipelines;
+    Variants<BlendSaturationPipeline> blend_saturation_pipelines;
+    Variants<BlendScreenPipeline> blend_screen_pipelines;
+    Variants<BlendSoftLightPipeline> blend_softlight_pipelines;
+    Variants<BlendUberPipeline> blend_uber_pipelines;
+    // Framebuffer Advanced blends.
+    Variants<FramebufferBlendColorPipeline> framebuffer_blend_color_pipelines;
+    Variants<FramebufferBlendColorBurnPipeline>
+        framebuffer_blend_colorburn_pipelines;
+    Variants<FramebufferBlendColorDodgePipeline>
+        framebuffer_blend_colordodge_pipelines;
+    Variants<FramebufferBlendDarkenPipeline> framebuffer_blend_darken_pipelines;
+    Variants<FramebufferBlendDifferencePipeline>
+        framebuffer_blend_difference_pipelines;
+    Variants<FramebufferBlendExclusionPipeline>
+        framebuffer_blend_exclusion_pipelines;
+    Variants<FramebufferBlendHardLightPipeline>
+        framebuffer_blend_hardlight_pipelines;
+    Variants<FramebufferBlendHuePipeline> framebuffer_blend_hue_pipelines;
+    Variants<FramebufferBlendLightenPipeline>
+        framebuffer_blend_lighten_pipelines;
+    Variants<FramebufferBlendLuminosityPipeline>
+        framebuffer_blend_luminosity_pipelines;
+    Variants<FramebufferBlendMultiplyPipeline>
+        framebuffer_blend_multiply_pipelines;
+    Variants<FramebufferBlendOverlayPipeline>
+        framebuffer_blend_overlay_pipelines;
+    Variants<FramebufferBlendSaturationPipeline>
+        framebuffer_blend_saturation_pipelines;
+    Variants<FramebufferBlendScreenPipeline> framebuffer_blend_screen_pipelines;
+    Variants<FramebufferBlendSoftLightPipeline>
+        framebuffer_blend_softlight_pipelines;
+    Variants<FramebufferBlendUberPipeline> framebuffer_blend_uber_pipelines;
+    Variants<VerticesUberShader> vertices_uber_shader;
+    size_t synchronous_variant_count = 0u;
+    bool first_frame_pipelines_ready = false;
+  };
+
+  std::shared_ptr<SharedState> shared_;
+
+  // Whether `is_ready` holds for the default handle of each pipeline that the
+  // first frame uses.
+  template <class IsReady>
+  bool CheckFirstFramePipelines(const IsReady& is_ready) const;
+
+  void MarkFirstFramePipelinesReady() const;
 
   template <class TypedPipeline>
   PipelineRef GetPipeline(Variants<TypedPipeline>& container,
@@ -991,9 +1133,19 @@ class ContentContext {
       return nullptr;
     }
 
-    auto variant_future = pipeline->CreateVariant(
-        /*async=*/false, [&opts, variants_count = container.GetPipelineCount()](
-                             PipelineDescriptor& desc) {
+    shared_->synchronous_variant_count++;
+    return AddVariant(container, *pipeline, opts, /*async=*/false);
+  }
+
+  template <class RenderPipelineHandleT>
+  RenderPipelineHandleT* AddVariant(
+      Variants<RenderPipelineHandleT>& container,
+      const Pipeline<PipelineDescriptor>& prototype,
+      const ContentContextOptions& opts,
+      bool async) const {
+    auto variant_future = prototype.CreateVariant(
+        async, [&opts, variants_count = container.GetPipelineCount()](
+                   PipelineDescriptor& desc) {
           opts.ApplyToPipelineDescriptor(desc);
           desc.SetLabel(
               SPrintF("%s V#%zu", desc.GetLabel().data(), variants_count));
@@ -1004,12 +1156,81 @@ class ContentContext {
     return container.Get(opts);
   }
 
+  /// Get a variant of a pipeline that is specialized for one of several
+  /// modes, such as an advanced blend.
+  ///
+  /// A variant that does not exist yet is created in the background, and the
+  /// variant of the uber pipeline that handles every mode is returned until
+  /// it is ready. The uber pipeline is only skipped if it has no variant for
+  /// the options either.
+  template <class RenderPipelineHandleT>
+  PipelineRef GetPipelineOrUber(Variants<RenderPipelineHandleT>& container,
+                                Variants<RenderPipelineHandleT>& uber,
+                                ContentContextOptions opts) const {
+    if (!IsValid()) {
+      return raw_ptr<Pipeline<PipelineDescriptor>>();
+    }
+
+    if (wireframe_) {
+      opts.wireframe = true;
+    }
+
+    RenderPipelineHandleT* variant = container.Get(opts);
+    if (!variant) {
+      RenderPipelineHandleT* default_handle = container.GetDefault();
+
+      // The default must always be initialized in the constructor.
+      FML_CHECK(default_handle != nullptr);
+
+      if (default_handle->IsReady()) {
+        const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline =
+            default_handle->WaitAndGet();
+        if (!pipeline) {
+          return raw_ptr<Pipeline<PipelineDescriptor>>();
+        }
+        variant = AddVariant(container, *pipeline, opts, /*async=*/true);
+      }
+    }
+    if (variant && variant->IsReady()) {
+      return raw_ptr(variant->WaitAndGet());
+    }
+    if (RenderPipelineHandleT* uber_variant = uber.Get(opts)) {
+      return raw_ptr(uber_variant->WaitAndGet());
+    }
+    if (variant) {
+      // Neither pipeline can be used yet, so the variant that is being created
+      // in the background is waited for, which stalls like a synchronous
+      // creation.
+      shared_->synchronous_variant_count++;
+      return raw_ptr(variant->WaitAndGet());
+    }
+    return GetPipeline(container, opts);
+  }
+
+  PipelineRef GetBlendPipeline(Variants<BlendUberPipeline>& container,
+                               ContentContextOptions opts) const {
+    return GetPipelineOrUber(container, shared_->blend_uber_pipelines, opts);
+  }
+
+  PipelineRef GetFramebufferBlendPipeline(
+      Variants<FramebufferBlendUberPipeline>& container,
+      ContentContextOptions opts) const {
+    return GetPipelineOrUber(container,
+                             shared_->framebuffer_blend_uber_pipelines, opts);
+  }
+
   bool is_valid_ = false;
-  std::shared_ptr<Tessellator> tessellator_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::unique_ptr<BackdropFilterCache> backdrop_filter_cache_;
+  std::unique_ptr<BlurPyramidCache> blur_pyramid_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
-  std::shared_ptr<Texture> empty_texture_;
   bool wireframe_ = false;
+  DisplayListCostCallback display_list_cost_callback_;
+
+  ContentContext(
+      std::shared_ptr<Context> context,
+      std::shared_ptr<SharedState> shared,
+      std::shared_ptr<RenderTargetAllocator> render_target_allocator);
 
   ContentContext(const ContentContext&) = delete;
 
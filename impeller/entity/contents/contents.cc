@@ -128,6 +128,16 @@ std::optional<Color> Contents::AsBackgroundColor(const Entity& entity,
   return {};
 }
 
+std::optional<Contents::SolidRect> Contents::AsSolidRect(
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
+std::optional<Contents::TextureRect> Contents::AsTextureRect(
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
@@ -39,6 +39,24 @@ class Contents {
                                         RenderPass& pass)>;
   using CoverageProc = std::function<std::optional<Rect>(const Entity& entity)>;
 
+  /// An axis aligned rectangle in the coordinate space of the render pass,
+  /// filled with a single premultiplied color.
+  struct SolidRect {
+    Rect rect;
+    Color color;
+  };
+
+  /// An axis aligned rectangle in the coordinate space of the render pass,
+  /// filled with a region of a texture.
+  struct TextureRect {
+    Rect rect;
+    /// The region of the texture mapped onto the rectangle, in texels.
+    Rect source_rect;
+    std::shared_ptr<Texture> texture;
+    SamplerDescriptor sampler_descriptor;
+    Scalar alpha = 1.0f;
+  };
+
   static std::shared_ptr<Contents> MakeAnonymous(RenderProc render_proc,
                                                  CoverageProc coverage_proc);
 
@@ -126,6 +144,27 @@ class Contents {
   virtual std::optional<Color> AsBackgroundColor(const Entity& entity,
                                                  ISize target_size) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Returns a solid rectangle if rendering this Contents with the
+  ///        given entity amounts to filling an axis aligned rectangle of the
+  ///        render pass with a single color.
+  ///
+  ///        Such draws can be merged with their neighbours into a single
+  ///        instanced draw. See `EntityBatcher`.
+  ///
+  virtual std::optional<SolidRect> AsSolidRect(const Entity& entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return the texture rectangle if rendering this contents with
+  ///             the given entity amounts to mapping a region of a texture
+  ///             onto an axis aligned rectangle of the render pass, without a
+  ///             strict source rectangle.
+  ///
+  ///             Consecutive such draws that sample the same texture can be
+  ///             merged into a single draw. See `EntityBatcher`.
+  ///
+  virtual std::optional<TextureRect> AsTextureRect(const Entity& entity) const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
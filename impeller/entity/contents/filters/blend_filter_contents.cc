@@ -19,6 +19,7 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/rect_geometry.h"
@@ -235,6 +236,7 @@ static std::optional<Entity> AdvancedBlend(
       FS::BindTextureSamplerSrc(pass, src_snapshot->texture, src_sampler);
       frame_info.src_y_coord_scale = src_snapshot->texture->GetYCoordScale();
     }
+    blend_info.uber_blend_type = BlendSelectValueForMode(blend_mode);
     auto blend_uniform = host_buffer.EmplaceUniform(blend_info);
     FS::BindBlendInfo(pass, blend_uniform);
 
@@ -399,6 +401,7 @@ std::optional<Entity> BlendFilterContents::CreateForegroundAdvancedBlend(
     // binding.
     FS::BindTextureSamplerSrc(pass, dst_snapshot->texture, dst_sampler);
 
+    blend_info.uber_blend_type = BlendSelectValueForMode(blend_mode);
     auto blend_uniform = host_buffer.EmplaceUniform(blend_info);
     FS::BindBlendInfo(pass, blend_uniform);
 
@@ -867,6 +870,7 @@ std::optional<Entity> BlendFilterContents::CreateFramebufferAdvancedBlend(
           absorb_opacity == ColorFilterContents::AbsorbOpacity::kYes
               ? dst_snapshot->opacity
               : 1.0;
+      frag_info.uber_blend_type = BlendSelectValueForMode(blend_mode);
       FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
 
       return pass.Draw().ok();
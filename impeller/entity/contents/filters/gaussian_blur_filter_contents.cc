@@ -8,6 +8,7 @@
 
 #include "flutter/fml/make_copyable.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/blur_pyramid_cache.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_downsample.frag.h"
@@ -319,6 +320,68 @@ DownsamplePassArgs CalculateDownsamplePassArgs(
   }
 }
 
+/// Makes a copy of `input_texture` with the mip levels that the downsample
+/// passes of large sigma blurs can sample from.
+std::shared_ptr<Texture> MakeDownsamplePyramid(
+    const ContentContext& renderer,
+    const std::shared_ptr<CommandBuffer>& command_buffer,
+    const std::shared_ptr<Texture>& input_texture) {
+  using VS = TextureFillVertexShader;
+
+  ISize size = input_texture->GetSize();
+  int32_t mip_count = std::min(BlurPyramidCache::kMaxLevelCount,
+                               static_cast<int32_t>(size.MipCount()));
+  if (mip_count <= 1) {
+    return nullptr;
+  }
+
+  ContentContext::SubpassCallback subpass_callback =
+      [&](const ContentContext& renderer, RenderPass& pass) {
+        HostBuffer& host_buffer = renderer.GetTransientsBuffer();
+
+        pass.SetCommandLabel("Gaussian blur pyramid");
+        auto pipeline_options = OptionsFromPass(pass);
+        pipeline_options.primitive_type = PrimitiveType::kTriangleStrip;
+        pipeline_options.blend_mode = BlendMode::kSource;
+        pass.SetPipeline(renderer.GetTexturePipeline(pipeline_options));
+
+        TextureFillVertexShader::FrameInfo frame_info;
+        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+        frame_info.texture_sampler_y_coord_scale =
+            input_texture->GetYCoordScale();
+
+        TextureFillFragmentShader::FragInfo frag_info;
+        frag_info.alpha = 1.0;
+
+        std::array<VS::PerVertexData, 4> vertices = {
+            VS::PerVertexData{Point(0, 0), Point(0, 0)},
+            VS::PerVertexData{Point(1, 0), Point(1, 0)},
+            VS::PerVertexData{Point(0, 1), Point(0, 1)},
+            VS::PerVertexData{Point(1, 1), Point(1, 1)},
+        };
+        pass.SetVertexBuffer(CreateVertexBuffer(vertices, host_buffer));
+
+        TextureFillVertexShader::BindFrameInfo(
+            pass, host_buffer.EmplaceUniform(frame_info));
+        TextureFillFragmentShader::BindFragInfo(
+            pass, host_buffer.EmplaceUniform(frag_info));
+        TextureFillFragmentShader::BindTextureSampler(
+            pass, input_texture,
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                MakeSamplerDescriptor(MinMagFilter::kNearest,
+                                      SamplerAddressMode::kClampToEdge)));
+
+        return pass.Draw().ok();
+      };
+  fml::StatusOr<RenderTarget> pyramid = renderer.MakeSubpass(
+      "Gaussian Blur Pyramid", size, command_buffer, subpass_callback,
+      /*msaa_enabled=*/false, /*depth_stencil_enabled=*/false, mip_count);
+  if (!pyramid.ok()) {
+    return nullptr;
+  }
+  return pyramid.value().GetRenderTargetTexture();
+}
+
 /// Makes a subpass that will render the scaled down input and add the
 /// transparent gutter required for the blur halo.
 fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
@@ -327,14 +390,13 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     const std::shared_ptr<Texture>& input_texture,
     const SamplerDescriptor& sampler_descriptor,
     const DownsamplePassArgs& pass_args,
-    Entity::TileMode tile_mode) {
+    Entity::TileMode tile_mode,
+    bool input_has_mipmaps) {
   using VS = TextureFillVertexShader;
 
   // If the texture already had mip levels generated, then we can use the
   // original downsample shader.
-  if (pass_args.effective_scalar.x >= 0.5f ||
-      (!input_texture->NeedsMipmapGeneration() &&
-       input_texture->GetTextureDescriptor().mip_count > 1)) {
+  if (pass_args.effective_scalar.x >= 0.5f || input_has_mipmaps) {
     ContentContext::SubpassCallback subpass_callback =
         [&](const ContentContext& renderer, RenderPass& pass) {
           HostBuffer& host_buffer = renderer.GetTransientsBuffer();
@@ -772,9 +834,33 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
       blur_info.scaled_sigma, blur_info.padding, input_snapshot.value(),
       source_expanded_coverage_hint, inputs[0], snapshot_entity);
 
+  // Several blurs of one texture in a frame, like nested frosted panels over
+  // one backdrop, would each read the whole texture in their downsample pass.
+  // Past the first of them, a mip pyramid of the texture is built once and
+  // each downsample pass samples the level for its scale instead.
+  std::shared_ptr<Texture> downsample_input = input_snapshot->texture;
+  SamplerDescriptor downsample_sampler = input_snapshot->sampler_descriptor;
+  bool input_has_mipmaps =
+      !downsample_input->NeedsMipmapGeneration() &&
+      downsample_input->GetTextureDescriptor().mip_count > 1;
+  if (!input_has_mipmaps && downsample_pass_args.effective_scalar.x < 0.5f) {
+    BlurPyramidCache& pyramid_cache = renderer.GetBlurPyramidCache();
+    std::shared_ptr<Texture> pyramid = pyramid_cache.Get(downsample_input);
+    if (!pyramid && pyramid_cache.ShouldBuild(downsample_input)) {
+      pyramid = MakeDownsamplePyramid(renderer, command_buffer_1,
+                                      downsample_input);
+      pyramid_cache.Set(downsample_input, pyramid);
+    }
+    if (pyramid) {
+      downsample_input = std::move(pyramid);
+      downsample_sampler.mip_filter = MipFilter::kLinear;
+      input_has_mipmaps = true;
+    }
+  }
+
   fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
-      renderer, command_buffer_1, input_snapshot->texture,
-      input_snapshot->sampler_descriptor, downsample_pass_args, tile_mode_);
+      renderer, command_buffer_1, downsample_input, downsample_sampler,
+      downsample_pass_args, tile_mode_, input_has_mipmaps);
 
   if (!pass1_out.ok()) {
     return std::nullopt;
@@ -5,6 +5,7 @@
 #include "flutter/testing/testing.h"
 #include "fml/status_or.h"
 #include "gmock/gmock.h"
+#include "impeller/entity/blur_pyramid_cache.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -455,6 +456,39 @@ TEST_P(GaussianBlurFilterContentsTest, TextureContentsWithEffectTransform) {
   }
 }
 
+TEST_P(GaussianBlurFilterContentsTest, LargeBlursOfOneTextureShareAPyramid) {
+  std::shared_ptr<Texture> texture = MakeTexture(ISize(400, 300));
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  BlurPyramidCache& pyramid_cache = renderer->GetBlurPyramidCache();
+  pyramid_cache.Clear();
+  BlurPyramidCache::Stats stats = pyramid_cache.GetStats();
+
+  Entity entity;
+  constexpr Scalar kSigmas[] = {20, 30, 40, 60, 80};
+  static_assert(std::size(kSigmas) > BlurPyramidCache::kMinBlurCountForPyramid);
+  for (Scalar sigma : kSigmas) {
+    auto contents = std::make_unique<GaussianBlurFilterContents>(
+        sigma, sigma, Entity::TileMode::kDecal,
+        FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+    contents->SetInputs({FilterInput::Make(texture)});
+    std::optional<Entity> result =
+        contents->GetEntity(*renderer, entity, /*coverage_hint=*/{});
+    ASSERT_TRUE(result.has_value());
+    std::optional<Rect> result_coverage = result.value().GetCoverage();
+    std::optional<Rect> contents_coverage = contents->GetCoverage(entity);
+    ASSERT_TRUE(result_coverage.has_value());
+    ASSERT_TRUE(contents_coverage.has_value());
+    EXPECT_TRUE(RectNear(result_coverage.value(), contents_coverage.value()));
+  }
+
+  // The first blurs downsample the texture by themselves, the
+  // |kMinBlurCountForPyramid|th builds the pyramid and the rest sample it.
+  EXPECT_EQ(pyramid_cache.GetStats().pyramids - stats.pyramids, 1u);
+  EXPECT_EQ(pyramid_cache.GetStats().reuses - stats.reuses,
+            std::size(kSigmas) - BlurPyramidCache::kMinBlurCountForPyramid);
+  pyramid_cache.Clear();
+}
+
 TEST(GaussianBlurFilterContentsTest, CalculateSigmaForBlurRadius) {
   Scalar sigma = 1.0;
   Scalar radius = GaussianBlurFilterContents::CalculateBlurRadius(
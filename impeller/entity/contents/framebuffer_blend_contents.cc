@@ -140,6 +140,7 @@ bool FramebufferBlendContents::Render(const ContentContext& renderer,
 
   frag_info.src_input_alpha = src_snapshot->opacity;
   frag_info.dst_input_alpha = 1.0;
+  frag_info.uber_blend_type = BlendSelectValueForMode(blend_mode_);
   FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
 
   return pass.Draw().ok();
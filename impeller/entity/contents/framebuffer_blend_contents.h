@@ -13,6 +13,8 @@
 namespace impeller {
 
 enum class BlendSelectValues {
+  // Selects the blend from the uniforms of the shader instead.
+  kUber = -1,
   kScreen = 0,
   kOverlay,
   kDarken,
@@ -30,6 +32,13 @@ enum class BlendSelectValues {
   kLuminosity,
 };
 
+/// The value that the uber pipelines of the advanced blends read from their
+/// uniforms to select an advanced blend mode.
+constexpr Scalar BlendSelectValueForMode(BlendMode blend_mode) {
+  return static_cast<Scalar>(blend_mode) -
+         static_cast<Scalar>(BlendMode::kScreen);
+}
+
 class FramebufferBlendContents final : public ColorSourceContents {
  public:
   FramebufferBlendContents();
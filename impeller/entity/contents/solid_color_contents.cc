@@ -78,6 +78,29 @@ std::optional<Color> SolidColorContents::AsBackgroundColor(
              : std::optional<Color>();
 }
 
+std::optional<Contents::SolidRect> SolidColorContents::AsSolidRect(
+    const Entity& entity) const {
+  const Geometry* geometry = GetGeometry();
+  const Matrix& transform = entity.GetTransform();
+  if (geometry == nullptr || !geometry->IsAxisAlignedRect() ||
+      geometry->GetResultMode() != GeometryResult::Mode::kNormal ||
+      !transform.IsTranslationScaleOnly()) {
+    return std::nullopt;
+  }
+  // The coverage of an axis aligned rectangle geometry is the rectangle
+  // itself. It is computed with the entity transform because the size of
+  // some geometries, such as hairlines, depends on it.
+  std::optional<Rect> rect = geometry->GetCoverage(transform);
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return SolidRect{
+      .rect = rect.value(),
+      .color = GetColor().Premultiply() *
+               geometry->ComputeAlphaCoverage(transform),
+  };
+}
+
 bool SolidColorContents::ApplyColorFilter(
     const ColorFilterProc& color_filter_proc) {
   color_ = color_filter_proc(color_);
@@ -70,6 +70,33 @@ std::optional<Rect> TextureContents::GetCoverage(const Entity& entity) const {
   return destination_rect_.TransformBounds(entity.GetTransform());
 };
 
+std::optional<Contents::TextureRect> TextureContents::AsTextureRect(
+    const Entity& entity) const {
+  const Matrix& transform = entity.GetTransform();
+  // Mirrored draws would need their texture coordinates flipped, so only
+  // positive scales are merged.
+  if (strict_source_rect_enabled_ || !stencil_enabled_ ||
+      texture_ == nullptr || texture_->GetSize().IsEmpty() ||
+      destination_rect_.IsEmpty() || source_rect_.IsEmpty() ||
+      !transform.IsTranslationScaleOnly() || transform.m[0] <= 0 ||
+      transform.m[5] <= 0) {
+    return std::nullopt;
+  }
+#ifdef IMPELLER_ENABLE_OPENGLES
+  if (texture_->GetTextureDescriptor().type ==
+      TextureType::kTextureExternalOES) {
+    return std::nullopt;
+  }
+#endif  // IMPELLER_ENABLE_OPENGLES
+  return TextureRect{
+      .rect = destination_rect_.TransformBounds(transform),
+      .source_rect = source_rect_,
+      .texture = texture_,
+      .sampler_descriptor = sampler_descriptor_,
+      .alpha = GetOpacity(),
+  };
+}
+
 std::optional<Snapshot> TextureContents::RenderToSnapshot(
     const ContentContext& renderer,
     const Entity& entity,
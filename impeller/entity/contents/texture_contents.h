@@ -54,6 +54,9 @@ class TextureContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  std::optional<TextureRect> AsTextureRect(const Entity& entity) const override;
+
   // |Contents|
   std::optional<Snapshot> RenderToSnapshot(
       const ContentContext& renderer,
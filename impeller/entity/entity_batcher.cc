@@ -0,0 +1,207 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/entity_batcher.h"
+
+#include <optional>
+#include <utility>
+
+#include "impeller/core/platform.h"
+#include "impeller/entity/contents/contents.h"
+
+namespace impeller {
+
+namespace {
+
+// The corners of the unit square, in triangle strip order. The transform of
+// each instance maps it onto the rectangle of the instance.
+constexpr Point kUnitSquare[] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+
+// The vertices of the two triangles of a texture rectangle.
+constexpr size_t kVerticesPerRect = 6u;
+
+}  // namespace
+
+EntityBatcher::EntityBatcher(HostBuffer& host_buffer,
+                             PipelineCallback pipeline_callback,
+                             PipelineCallback texture_pipeline_callback,
+                             SamplerCallback sampler_callback)
+    : host_buffer_(host_buffer),
+      pipeline_callback_(std::move(pipeline_callback)),
+      texture_pipeline_callback_(std::move(texture_pipeline_callback)),
+      sampler_callback_(std::move(sampler_callback)) {}
+
+EntityBatcher::~EntityBatcher() = default;
+
+bool EntityBatcher::Add(const Entity& entity, RenderPass& pass) {
+  const std::shared_ptr<Contents>& contents = entity.GetContents();
+  if (!contents) {
+    return false;
+  }
+  if (pipeline_callback_) {
+    std::optional<Contents::SolidRect> solid_rect =
+        contents->AsSolidRect(entity);
+    if (solid_rect.has_value()) {
+      return AddSolidRect(entity, pass, solid_rect.value());
+    }
+  }
+  // Texture rectangles that write depth would occlude each other at the
+  // shared clip depth of the batch.
+  if (texture_pipeline_callback_ && sampler_callback_ &&
+      entity.GetBlendMode() != BlendMode::kSource) {
+    std::optional<Contents::TextureRect> texture_rect =
+        contents->AsTextureRect(entity);
+    if (texture_rect.has_value()) {
+      return AddTextureRect(entity, pass, std::move(texture_rect.value()));
+    }
+  }
+  return false;
+}
+
+bool EntityBatcher::AddSolidRect(const Entity& entity,
+                                 RenderPass& pass,
+                                 const Contents::SolidRect& solid_rect) {
+  if ((!instances_.empty() &&
+       (pass_ != &pass || blend_mode_ != entity.GetBlendMode() ||
+        instances_.size() >= kMaxInstanceCount)) ||
+      !texture_vertices_.empty()) {
+    if (!Flush()) {
+      return false;
+    }
+  }
+
+  pass_ = &pass;
+  blend_mode_ = entity.GetBlendMode();
+  const Rect& rect = solid_rect.rect;
+  instances_.push_back(InstancedSolidFillData{
+      .mvp = Entity::GetShaderTransform(
+          entity.GetShaderClipDepth(), pass,
+          Matrix::MakeTranslateScale({rect.GetWidth(), rect.GetHeight(), 1},
+                                     {rect.GetX(), rect.GetY(), 0})),
+      .color = solid_rect.color,
+  });
+  return true;
+}
+
+bool EntityBatcher::AddTextureRect(const Entity& entity,
+                                   RenderPass& pass,
+                                   Contents::TextureRect texture_rect) {
+  if ((!texture_vertices_.empty() &&
+       (pass_ != &pass || blend_mode_ != entity.GetBlendMode() ||
+        texture_ != texture_rect.texture ||
+        SamplerDescriptor::ToKey(sampler_descriptor_) !=
+            SamplerDescriptor::ToKey(texture_rect.sampler_descriptor) ||
+        alpha_ != texture_rect.alpha ||
+        texture_vertices_.size() >= kMaxInstanceCount * kVerticesPerRect)) ||
+      !instances_.empty()) {
+    if (!Flush()) {
+      return false;
+    }
+  }
+
+  pass_ = &pass;
+  blend_mode_ = entity.GetBlendMode();
+  texture_ = std::move(texture_rect.texture);
+  sampler_descriptor_ = texture_rect.sampler_descriptor;
+  alpha_ = texture_rect.alpha;
+  clip_depth_ = entity.GetClipDepth();
+
+  const Rect& rect = texture_rect.rect;
+  const Rect uvs =
+      Rect::MakeSize(texture_->GetSize()).Project(texture_rect.source_rect);
+  using PerVertexData = TexturePipeline::VertexShader::PerVertexData;
+  const PerVertexData lt{rect.GetLeftTop(), uvs.GetLeftTop()};
+  const PerVertexData rt{rect.GetRightTop(), uvs.GetRightTop()};
+  const PerVertexData lb{rect.GetLeftBottom(), uvs.GetLeftBottom()};
+  const PerVertexData rb{rect.GetRightBottom(), uvs.GetRightBottom()};
+  texture_vertices_.insert(texture_vertices_.end(), {lt, rt, lb, rt, lb, rb});
+  return true;
+}
+
+bool EntityBatcher::Flush() {
+  if (!instances_.empty()) {
+    return FlushSolidRects();
+  }
+  if (!texture_vertices_.empty()) {
+    return FlushTextureRects();
+  }
+  return true;
+}
+
+bool EntityBatcher::FlushSolidRects() {
+  using VS = InstancedSolidFillPipeline::VertexShader;
+
+  RenderPass& pass = *pass_;
+  ContentContextOptions options = OptionsFromPass(pass);
+  options.blend_mode = blend_mode_;
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  // Match the depth writes of the entities that are drawn one at a time, see
+  // `ColorSourceContents::DrawGeometry`.
+  options.depth_write_enabled = blend_mode_ == BlendMode::kSource;
+
+  pass.SetCommandLabel("Instanced Solid Fill");
+  pass.SetPipeline(pipeline_callback_(options));
+  pass.SetStencilReference(0);
+  pass.SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = host_buffer_.Emplace(kUnitSquare, sizeof(kUnitSquare),
+                                            alignof(Point)),
+      .vertex_count = 4,
+      .index_type = IndexType::kNone,
+  });
+  VS::BindInstanceInfo(
+      pass, host_buffer_.Emplace(
+                instances_.data(),
+                instances_.size() * sizeof(InstancedSolidFillData),
+                DefaultUniformAlignment()));
+  pass.SetInstanceCount(instances_.size());
+
+  instances_.clear();
+  pass_ = nullptr;
+  return pass.Draw().ok();
+}
+
+bool EntityBatcher::FlushTextureRects() {
+  using VS = TexturePipeline::VertexShader;
+  using FS = TexturePipeline::FragmentShader;
+
+  RenderPass& pass = *pass_;
+  ContentContextOptions options = OptionsFromPass(pass);
+  options.blend_mode = blend_mode_;
+  options.primitive_type = PrimitiveType::kTriangle;
+
+  pass.SetCommandLabel("Batched Texture Fill");
+  pass.SetPipeline(texture_pipeline_callback_(options));
+  pass.SetStencilReference(0);
+  pass.SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = host_buffer_.Emplace(
+          texture_vertices_.data(),
+          texture_vertices_.size() * sizeof(VS::PerVertexData),
+          alignof(VS::PerVertexData)),
+      .vertex_count = texture_vertices_.size(),
+      .index_type = IndexType::kNone,
+  });
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Entity::GetShaderTransform(
+      Entity::GetShaderClipDepth(clip_depth_), pass, Matrix());
+  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  VS::BindFrameInfo(pass, host_buffer_.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = alpha_;
+  FS::BindFragInfo(pass, host_buffer_.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(pass, texture_,
+                         sampler_callback_(sampler_descriptor_));
+
+  texture_vertices_.clear();
+  texture_.reset();
+  pass_ = nullptr;
+  return pass.Draw().ok();
+}
+
+size_t EntityBatcher::GetPendingCount() const {
+  return instances_.size() + texture_vertices_.size() / kVerticesPerRect;
+}
+
+}  // namespace impeller
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_ENTITY_BATCHER_H_
+#define FLUTTER_IMPELLER_ENTITY_ENTITY_BATCHER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/raw_ptr.h"
+#include "impeller/core/sampler.h"
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+/// The per-instance data of `InstancedSolidFillPipeline`, laid out as the
+/// elements of its std140 storage buffer.
+struct InstancedSolidFillData {
+  Matrix mvp;
+  Color color;
+};
+
+static_assert(sizeof(InstancedSolidFillData) == 80);
+
+/// @brief Merges runs of consecutive entities that fill axis aligned
+///        rectangles with solid colors into single instanced draws, and runs
+///        of consecutive entities that map regions of the same texture onto
+///        axis aligned rectangles into single texture fill draws.
+///
+///        Entities are rendered in submission order, so only consecutive
+///        entities that are drawn into the same render pass with the same
+///        blend mode are merged. Each solid instance carries its own
+///        transform, including the clip depth of its entity, so merged
+///        entities are still clipped and depth tested exactly as if they were
+///        drawn one at a time. Instances of a draw are rasterized in order,
+///        which preserves their blending order.
+///
+///        The rectangles of a texture batch share one transform, which has
+///        the clip depth of the last entity. Entities between which no clip
+///        changes are clipped alike by it, and texture rectangles are only
+///        merged when they do not write depth.
+///
+///        The batch must be flushed before anything else is encoded into its
+///        render pass and before the render pass ends.
+///
+///        The instance data is read from a storage buffer, so solid batching
+///        is only available on backends that support SSBOs.
+class EntityBatcher {
+ public:
+  using PipelineCallback = std::function<PipelineRef(ContentContextOptions)>;
+  using SamplerCallback =
+      std::function<raw_ptr<const Sampler>(const SamplerDescriptor&)>;
+
+  /// The maximum number of instances of a single draw.
+  static constexpr size_t kMaxInstanceCount = 1024u;
+
+  /// Create a batcher that allocates the instance data from `host_buffer`
+  /// and gets the pipelines of the instanced draws from `pipeline_callback`.
+  ///
+  /// Texture rectangles are merged if `texture_pipeline_callback`, which
+  /// returns texture fill pipelines, and `sampler_callback` are given. Solid
+  /// rectangles are not merged if `pipeline_callback` is null.
+  EntityBatcher(HostBuffer& host_buffer,
+                PipelineCallback pipeline_callback,
+                PipelineCallback texture_pipeline_callback = nullptr,
+                SamplerCallback sampler_callback = nullptr);
+
+  ~EntityBatcher();
+
+  //----------------------------------------------------------------------------
+  /// @brief  Add the entity to the pending batch if it can be drawn as an
+  ///         instanced rectangle or as a texture rectangle. A pending batch
+  ///         that the entity can not be merged with is flushed first.
+  ///
+  /// @return Whether the entity was added. If not, the pending batch must be
+  ///         flushed before the entity is rendered by itself.
+  ///
+  bool Add(const Entity& entity, RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Encode the pending batch, if any, into its render pass.
+  ///
+  /// @return Whether the batch was encoded successfully.
+  ///
+  bool Flush();
+
+  /// The number of entities in the pending batch.
+  size_t GetPendingCount() const;
+
+ private:
+  HostBuffer& host_buffer_;
+  PipelineCallback pipeline_callback_;
+  PipelineCallback texture_pipeline_callback_;
+  SamplerCallback sampler_callback_;
+  RenderPass* pass_ = nullptr;
+  BlendMode blend_mode_ = BlendMode::kSourceOver;
+  std::vector<InstancedSolidFillData> instances_;
+
+  // The pending texture batch, as a triangle list of its rectangles.
+  std::vector<TexturePipeline::VertexShader::PerVertexData> texture_vertices_;
+  std::shared_ptr<Texture> texture_;
+  SamplerDescriptor sampler_descriptor_;
+  Scalar alpha_ = 1.0f;
+  uint32_t clip_depth_ = 0u;
+
+  bool AddSolidRect(const Entity& entity,
+                    RenderPass& pass,
+                    const Contents::SolidRect& solid_rect);
+
+  bool AddTextureRect(const Entity& entity,
+                      RenderPass& pass,
+                      Contents::TextureRect texture_rect);
+
+  bool FlushSolidRects();
+
+  bool FlushTextureRects();
+
+  EntityBatcher(const EntityBatcher&) = delete;
+
+  EntityBatcher& operator=(const EntityBatcher&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_ENTITY_BATCHER_H_
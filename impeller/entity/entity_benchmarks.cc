@@ -0,0 +1,634 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/idle_waiter.h"
+#include "impeller/core/sampler.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/blur_pyramid_cache.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/entity_batcher.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/rect_geometry.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/geometry/constants.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+namespace {
+
+// Most of the benchmarks measure the cost of encoding draws into a render
+// pass, so the backend below only keeps the recorded commands and the host
+// buffer contents in memory. The benchmarks of GPU work render on a Vulkan
+// context instead.
+
+class BenchmarkDeviceBuffer final : public DeviceBuffer {
+ public:
+  explicit BenchmarkDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), storage_(desc.size) {}
+
+  bool SetLabel(std::string_view label) override { return true; }
+
+  bool SetLabel(std::string_view label, Range range) override { return true; }
+
+  uint8_t* OnGetContents() const override { return storage_.data(); }
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    std::memcpy(storage_.data() + offset, source + source_range.offset,
+                source_range.length);
+    return true;
+  }
+
+ private:
+  mutable std::vector<uint8_t> storage_;
+};
+
+class BenchmarkTexture final : public Texture {
+ public:
+  explicit BenchmarkTexture(const TextureDescriptor& desc) : Texture(desc) {}
+
+  void SetLabel(std::string_view label) override {}
+
+  void SetLabel(std::string_view label, std::string_view trailing) override {}
+
+  bool IsValid() const override { return true; }
+
+  ISize GetSize() const override { return GetTextureDescriptor().size; }
+
+ private:
+  bool OnSetContents(const uint8_t* contents,
+                     size_t length,
+                     size_t slice) override {
+    return true;
+  }
+
+  bool OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
+                     size_t slice) override {
+    return true;
+  }
+};
+
+class BenchmarkAllocator final : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {4096, 4096}; }
+
+ private:
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return std::make_shared<BenchmarkDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return std::make_shared<BenchmarkTexture>(desc);
+  }
+};
+
+class BenchmarkSampler final : public Sampler {
+ public:
+  BenchmarkSampler() : Sampler(SamplerDescriptor{}) {}
+};
+
+class BenchmarkPipeline final : public Pipeline<PipelineDescriptor> {
+ public:
+  BenchmarkPipeline() : Pipeline({}, PipelineDescriptor{}) {}
+
+  bool IsValid() const override { return true; }
+};
+
+class BenchmarkRenderPass final : public RenderPass {
+ public:
+  explicit BenchmarkRenderPass(const RenderTarget& target)
+      : RenderPass(nullptr, target) {}
+
+  bool IsValid() const override { return true; }
+
+ private:
+  void OnSetLabel(std::string_view label) override {}
+
+  bool OnEncodeCommands(const Context& context) const override { return true; }
+};
+
+/// A context that only provides the capabilities and the allocator that
+/// render targets are created with.
+class BenchmarkContext final : public Context {
+ public:
+  BenchmarkContext()
+      : capabilities_(
+            CapabilitiesBuilder()
+                .SetDefaultColorFormat(PixelFormat::kR8G8B8A8UNormInt)
+                .SetDefaultStencilFormat(PixelFormat::kS8UInt)
+                .SetDefaultDepthStencilFormat(PixelFormat::kD24UnormS8Uint)
+                .SetSupportsDeviceTransientTextures(true)
+                .Build()),
+        allocator_(std::make_shared<BenchmarkAllocator>()) {}
+
+  BackendType GetBackendType() const override { return BackendType::kVulkan; }
+
+  std::string DescribeGpuModel() const override { return "Benchmark"; }
+
+  bool IsValid() const override { return true; }
+
+  const std::shared_ptr<const Capabilities>& GetCapabilities() const override {
+    return capabilities_;
+  }
+
+  std::shared_ptr<Allocator> GetResourceAllocator() const override {
+    return allocator_;
+  }
+
+  std::shared_ptr<ShaderLibrary> GetShaderLibrary() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<SamplerLibrary> GetSamplerLibrary() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<PipelineLibrary> GetPipelineLibrary() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<CommandQueue> GetCommandQueue() const override {
+    return nullptr;
+  }
+
+  void Shutdown() override {}
+
+  RuntimeStageBackend GetRuntimeStageBackend() const override {
+    return RuntimeStageBackend::kVulkan;
+  }
+
+ private:
+  std::shared_ptr<const Capabilities> capabilities_;
+  std::shared_ptr<Allocator> allocator_;
+};
+
+/// Provides a GPU context for the benchmarks that render, without opening a
+/// window.
+class BenchmarkPlayground final : public Playground {
+ public:
+  BenchmarkPlayground() : Playground(PlaygroundSwitches{}) {}
+
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override {
+    return nullptr;
+  }
+
+  std::string GetWindowTitle() const override { return "Benchmark"; }
+};
+
+/// Creates a texture of `size` that has been cleared to transparent black.
+std::shared_ptr<Texture> MakeClearedTexture(const ContentContext& renderer,
+                                            ISize size) {
+  std::shared_ptr<CommandBuffer> command_buffer =
+      renderer.GetContext()->CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  fml::StatusOr<RenderTarget> render_target = renderer.MakeSubpass(
+      "Clear Subpass", size, command_buffer,
+      [](const ContentContext&, RenderPass&) { return true; });
+  if (!render_target.ok() || !renderer.GetContext()
+                                  ->GetCommandQueue()
+                                  ->Submit(/*buffers=*/{command_buffer})
+                                  .ok()) {
+    return nullptr;
+  }
+  return render_target.value().GetRenderTargetTexture();
+}
+
+constexpr size_t kGridColumns = 100;
+constexpr size_t kGridRows = 50;
+
+/// A grid of 5,000 small opaque rectangles in alternating colors, with the
+/// increasing clip depths that the canvas assigns to consecutive draws.
+class RectGrid {
+ public:
+  RectGrid() {
+    for (size_t row = 0; row < kGridRows; row++) {
+      for (size_t column = 0; column < kGridColumns; column++) {
+        geometries_.push_back(std::make_unique<RectGeometry>(
+            Rect::MakeXYWH(column * 10, row * 10, 8, 8)));
+        auto contents = std::make_shared<SolidColorContents>();
+        contents->SetGeometry(geometries_.back().get());
+        contents->SetColor((row + column) % 2 ? Color::Red() : Color::Blue());
+        Entity entity;
+        entity.SetContents(std::move(contents));
+        entity.SetBlendMode(BlendMode::kSource);
+        entity.SetClipDepth(entities_.size() + 1);
+        entities_.push_back(std::move(entity));
+      }
+    }
+  }
+
+  const std::vector<Entity>& GetEntities() const { return entities_; }
+
+ private:
+  std::vector<std::unique_ptr<RectGeometry>> geometries_;
+  std::vector<Entity> entities_;
+};
+
+constexpr size_t kIconColumns = 20;
+constexpr size_t kIconRows = 10;
+constexpr int64_t kIconSize = 24;
+
+/// A grid of 200 small icons, each drawn from its own texture or from its
+/// region of one shared atlas texture, with a 1px gutter around each region.
+class IconGrid {
+ public:
+  explicit IconGrid(bool atlas) {
+    TextureDescriptor desc;
+    desc.format = PixelFormat::kR8G8B8A8UNormInt;
+    desc.usage = TextureUsage::kShaderRead;
+    desc.size = {1024, 1024};
+    std::shared_ptr<Texture> page = std::make_shared<BenchmarkTexture>(desc);
+    desc.size = {kIconSize, kIconSize};
+    for (size_t row = 0; row < kIconRows; row++) {
+      for (size_t column = 0; column < kIconColumns; column++) {
+        auto contents = TextureContents::MakeRect(
+            Rect::MakeXYWH(column * 40, row * 40, kIconSize, kIconSize));
+        if (atlas) {
+          contents->SetTexture(page);
+          contents->SetSourceRect(
+              Rect::MakeXYWH(column * (kIconSize + 2) + 1,
+                             row * (kIconSize + 2) + 1, kIconSize, kIconSize));
+        } else {
+          contents->SetTexture(std::make_shared<BenchmarkTexture>(desc));
+          contents->SetSourceRect(Rect::MakeXYWH(0, 0, kIconSize, kIconSize));
+        }
+        Entity entity;
+        entity.SetContents(std::move(contents));
+        entity.SetClipDepth(entities_.size() + 1);
+        entities_.push_back(std::move(entity));
+      }
+    }
+  }
+
+  const std::vector<Entity>& GetEntities() const { return entities_; }
+
+ private:
+  std::vector<Entity> entities_;
+};
+
+RenderTarget CreateRenderTarget() {
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {1000, 500};
+  desc.usage = TextureUsage::kRenderTarget;
+  ColorAttachment color;
+  color.texture = std::make_shared<BenchmarkTexture>(desc);
+  color.load_action = LoadAction::kClear;
+  color.store_action = StoreAction::kStore;
+  RenderTarget target;
+  target.SetColorAttachment(color, 0u);
+  return target;
+}
+
+// Encodes a solid rectangle the way `SolidColorContents` does when it is
+// rendered by itself: a vertex buffer, two uniform uploads and a draw.
+void EncodeSolidRect(const Entity& entity,
+                     const SolidColorContents& contents,
+                     HostBuffer& host_buffer,
+                     const PipelineRef& pipeline,
+                     RenderPass& pass) {
+  using VS = SolidFillPipeline::VertexShader;
+  using FS = SolidFillPipeline::FragmentShader;
+
+  const Rect rect = contents.GetGeometry()->GetCoverage({}).value();
+  pass.SetCommandLabel("Solid Fill");
+  pass.SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = host_buffer.Emplace(rect.GetPoints().data(),
+                                           8 * sizeof(float), alignof(float)),
+      .vertex_count = 4,
+      .index_type = IndexType::kNone,
+  });
+  pass.SetStencilReference(0);
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = entity.GetShaderTransform(pass);
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.color = contents.GetColor().Premultiply();
+  FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
+
+  pass.SetPipeline(pipeline);
+  pass.Draw();
+}
+
+// Encodes a clip draw with the vertices and the label of one of the draws of
+// `ClipContents`.
+void EncodeClipDraw(const VertexBuffer& vertex_buffer,
+                    const Matrix& mvp,
+                    const char* label,
+                    HostBuffer& host_buffer,
+                    const PipelineRef& pipeline,
+                    RenderPass& pass) {
+  using VS = ClipPipeline::VertexShader;
+
+  pass.SetCommandLabel(label);
+  pass.SetStencilReference(0);
+  pass.SetVertexBuffer(vertex_buffer);
+  pass.SetPipeline(pipeline);
+  VS::FrameInfo info;
+  info.mvp = mvp;
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(info));
+  pass.Draw();
+}
+
+}  // namespace
+
+static void BM_SolidRectGrid(benchmark::State& state, bool batched) {
+  RectGrid grid;
+  RenderTarget target = CreateRenderTarget();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      std::make_shared<BenchmarkPipeline>();
+  auto host_buffer =
+      HostBuffer::Create(std::make_shared<BenchmarkAllocator>(), nullptr);
+  EntityBatcher batcher(*host_buffer, [&pipeline](ContentContextOptions) {
+    return PipelineRef(pipeline);
+  });
+
+  size_t draw_calls = 0;
+  for (auto _ : state) {
+    BenchmarkRenderPass pass(target);
+    for (const Entity& entity : grid.GetEntities()) {
+      if (batched && batcher.Add(entity, pass)) {
+        continue;
+      }
+      batcher.Flush();
+      EncodeSolidRect(
+          entity,
+          static_cast<const SolidColorContents&>(*entity.GetContents()),
+          *host_buffer, PipelineRef(pipeline), pass);
+    }
+    batcher.Flush();
+    draw_calls = pass.GetCommands().size();
+    host_buffer->Reset();
+  }
+
+  state.counters["DrawCalls"] = draw_calls;
+  state.counters["Rects"] = grid.GetEntities().size();
+}
+
+// Encodes a grid of icons the way the canvas does, through a batcher that
+// merges the draws of consecutive icons that sample the same texture.
+static void BM_IconGrid(benchmark::State& state, bool atlas) {
+  IconGrid grid(atlas);
+  RenderTarget target = CreateRenderTarget();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      std::make_shared<BenchmarkPipeline>();
+  std::shared_ptr<const Sampler> sampler =
+      std::make_shared<BenchmarkSampler>();
+  auto host_buffer =
+      HostBuffer::Create(std::make_shared<BenchmarkAllocator>(), nullptr);
+  EntityBatcher batcher(
+      *host_buffer, nullptr,
+      [&pipeline](ContentContextOptions) { return PipelineRef(pipeline); },
+      [&sampler](const SamplerDescriptor&) {
+        return raw_ptr<const Sampler>(sampler);
+      });
+
+  size_t draw_calls = 0;
+  for (auto _ : state) {
+    BenchmarkRenderPass pass(target);
+    for (const Entity& entity : grid.GetEntities()) {
+      batcher.Add(entity, pass);
+    }
+    batcher.Flush();
+    draw_calls = pass.GetCommands().size();
+    host_buffer->Reset();
+  }
+
+  state.counters["DrawCalls"] = draw_calls;
+  state.counters["Icons"] = grid.GetEntities().size();
+}
+
+// Replays the save layers of a card that grows and shrinks over two seconds
+// at 60fps, the way a hero or an expanding list tile animates its bounds.
+static void BM_AnimatedSaveLayerBounds(benchmark::State& state, bool pooled) {
+  constexpr size_t kFrameCount = 120;
+  BenchmarkContext context;
+
+  size_t allocations = 0;
+  size_t reuses = 0;
+  size_t pooled_bytes = 0;
+  for (auto _ : state) {
+    RenderTargetCache cache(context.GetResourceAllocator());
+    allocations = 0;
+    reuses = 0;
+    for (size_t frame = 0; frame < kFrameCount; frame++) {
+      const Scalar t = std::sin(kPi * frame / kFrameCount);
+      const ISize layer_size(static_cast<int64_t>(320 + 80 * t),
+                             static_cast<int64_t>(200 + 120 * t));
+      cache.Start();
+      // The card and the shadow behind it.
+      for (ISize size : {layer_size, layer_size + ISize(24, 24)}) {
+        RenderTarget target = cache.CreateOffscreen(
+            context, pooled ? cache.GetPooledSize(size) : size, 1);
+        benchmark::DoNotOptimize(target);
+      }
+      allocations += cache.GetStats().allocations;
+      reuses += cache.GetStats().reuses;
+      cache.End();
+    }
+    pooled_bytes = cache.GetStats().pooled_bytes;
+  }
+
+  state.counters["Allocations"] = allocations;
+  state.counters["Reuses"] = reuses;
+  state.counters["PooledBytes"] = pooled_bytes;
+}
+
+// Renders blurs of one 1024x768 backdrop per frame through
+// `GaussianBlurFilterContents`, like a stack of frosted panels with different
+// sigmas, and waits for the GPU to finish each frame. Without the pyramid,
+// the pyramid cache is cleared after each blur, so that every blur
+// downsamples the whole backdrop by itself.
+static void BM_SharedBlurDownsample(benchmark::State& state, bool pyramid) {
+  constexpr Scalar kSigmas[] = {20, 30, 40, 60, 80};
+
+  if (!Playground::SupportsBackend(PlaygroundBackend::kVulkan)) {
+    state.SkipWithError("The Vulkan backend is not available.");
+    return;
+  }
+  BenchmarkPlayground playground;
+  playground.SetupContext(PlaygroundBackend::kVulkan, PlaygroundSwitches{});
+  std::shared_ptr<Context> context = playground.GetContext();
+  if (!context) {
+    state.SkipWithError("Could not create a Vulkan context.");
+    return;
+  }
+  ContentContext renderer(context, /*typographer_context=*/nullptr);
+  std::shared_ptr<Texture> backdrop = MakeClearedTexture(renderer, {1024, 768});
+  if (!renderer.IsValid() || !backdrop) {
+    state.SkipWithError("Could not create the backdrop.");
+    return;
+  }
+
+  BlurPyramidCache& pyramid_cache = renderer.GetBlurPyramidCache();
+  const size_t pyramids_before = pyramid_cache.GetStats().pyramids;
+  for (auto _ : state) {
+    renderer.GetRenderTargetCache()->Start();
+    for (Scalar sigma : kSigmas) {
+      GaussianBlurFilterContents contents(
+          sigma, sigma, Entity::TileMode::kDecal,
+          FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+      contents.SetInputs({FilterInput::Make(backdrop)});
+      std::optional<Entity> result =
+          contents.GetEntity(renderer, Entity(), /*coverage_hint=*/{});
+      benchmark::DoNotOptimize(result);
+      if (!pyramid) {
+        pyramid_cache.Clear();
+      }
+    }
+    renderer.GetRenderTargetCache()->End();
+    pyramid_cache.Clear();
+    renderer.GetTransientsBuffer().Reset();
+    if (!context->FlushCommandBuffers()) {
+      state.SkipWithError("Could not submit the blurs.");
+      break;
+    }
+    if (std::shared_ptr<const IdleWaiter> idle_waiter =
+            context->GetIdleWaiter()) {
+      idle_waiter->WaitIdle();
+    }
+  }
+
+  state.counters["Blurs"] = std::size(kSigmas);
+  state.counters["Pyramids"] = benchmark::Counter(
+      pyramid_cache.GetStats().pyramids - pyramids_before,
+      benchmark::Counter::kAvgIterations);
+  context->Shutdown();
+}
+
+// Replays the clips of a list of round rect cards scrolled by a fractional
+// offset every frame over two seconds at 60fps, and counts the clip draws and
+// the clip vertices. Each card is clipped either with the stencil preparation
+// and cover draws, or with the single draw of its complement.
+static void BM_ScrollingClips(benchmark::State& state, bool analytic) {
+  constexpr size_t kFrameCount = 120;
+  constexpr size_t kCardCount = 12;
+  constexpr Size kCardRadii(16, 16);
+
+  RenderTarget target = CreateRenderTarget();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      std::make_shared<BenchmarkPipeline>();
+  auto host_buffer =
+      HostBuffer::Create(std::make_shared<BenchmarkAllocator>(), nullptr);
+  Tessellator tessellator;
+
+  size_t draw_calls = 0;
+  size_t vertices = 0;
+  for (auto _ : state) {
+    draw_calls = 0;
+    vertices = 0;
+    for (size_t frame = 0; frame < kFrameCount; frame++) {
+      BenchmarkRenderPass pass(target);
+      Entity entity;
+      entity.SetTransform(Matrix::MakeTranslation({0, frame * -3.7f}));
+      for (size_t card = 0; card < kCardCount; card++) {
+        const Rect bounds = Rect::MakeXYWH(20.25, 20.5 + card * 48, 960, 40);
+        entity.SetClipDepth(card + 1);
+        if (analytic) {
+          GeometryResult result = Geometry::ComputeClipComplementGeometry(
+              *host_buffer, entity, pass, bounds, kCardRadii);
+          EncodeClipDraw(result.vertex_buffer, result.transform,
+                         "Analytic Clip", *host_buffer, PipelineRef(pipeline),
+                         pass);
+          vertices += result.vertex_buffer.vertex_count;
+          continue;
+        }
+        auto generator = tessellator.FilledRoundRect(entity.GetTransform(),
+                                                     bounds, kCardRadii);
+        std::vector<Point> points;
+        points.reserve(generator.GetVertexCount());
+        generator.GenerateVertices(
+            [&points](const Point& p) { points.push_back(p); });
+        EncodeClipDraw(
+            VertexBuffer{
+                .vertex_buffer = host_buffer->Emplace(
+                    points.data(), points.size() * sizeof(Point),
+                    alignof(Point)),
+                .vertex_count = points.size(),
+                .index_type = IndexType::kNone,
+            },
+            entity.GetShaderTransform(pass),
+            "Clip stencil preparation (Increment)", *host_buffer,
+            PipelineRef(pipeline), pass);
+        auto cover = Rect::MakeSize(pass.GetRenderTargetSize()).GetPoints();
+        EncodeClipDraw(
+            VertexBuffer{
+                .vertex_buffer = host_buffer->Emplace(
+                    cover.data(), sizeof(cover), alignof(Point)),
+                .vertex_count = cover.size(),
+                .index_type = IndexType::kNone,
+            },
+            pass.GetOrthographicTransform(), "Intersect Clip", *host_buffer,
+            PipelineRef(pipeline), pass);
+        vertices += points.size() + cover.size();
+      }
+      draw_calls += pass.GetCommands().size();
+      host_buffer->Reset();
+    }
+  }
+
+  state.counters["DrawCalls"] = draw_calls;
+  state.counters["Vertices"] = vertices;
+}
+
+BENCHMARK_CAPTURE(BM_SolidRectGrid, unbatched, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SolidRectGrid, batched, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_IconGrid, separate_textures, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_IconGrid, atlas, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_AnimatedSaveLayerBounds, exact, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_AnimatedSaveLayerBounds, pooled, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SharedBlurDownsample, separate, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SharedBlurDownsample, pyramid, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ScrollingClips, stencil, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ScrollingClips, analytic, true)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace impeller
@@ -37,6 +37,7 @@ bool EntityPlayground::OpenPlaygroundHere(Entity entity) {
     content_context->GetRenderTargetCache()->Start();
     bool result = entity.Render(*content_context, pass);
     content_context->GetRenderTargetCache()->End();
+    content_context->GetBlurPyramidCache().Clear();
     content_context->GetTransientsBuffer().Reset();
     return result;
   };
@@ -61,6 +62,7 @@ bool EntityPlayground::OpenPlaygroundHere(EntityPlaygroundCallback callback) {
     content_context.GetRenderTargetCache()->Start();
     bool result = callback(content_context, pass);
     content_context.GetRenderTargetCache()->End();
+    content_context.GetBlurPyramidCache().Clear();
     content_context.GetTransientsBuffer().Reset();
     return result;
   };
@@ -3,20 +3,24 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "fml/logging.h"
+#include "fml/time/time_point.h"
 #include "gtest/gtest.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/core/raw_ptr.h"
 #include "impeller/core/texture_descriptor.h"
+#include "impeller/entity/backdrop_filter_cache.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -35,9 +39,13 @@
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_batcher.h"
 #include "impeller/entity/entity_playground.h"
+#include "impeller/entity/geometry/circle_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
+#include "impeller/entity/geometry/rect_geometry.h"
+#include "impeller/entity/geometry/round_rect_geometry.h"
 #include "impeller/entity/geometry/round_superellipse_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/entity/geometry/superellipse_geometry.h"
@@ -55,6 +63,7 @@
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/testing/mocks.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/tessellator/tessellator.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "third_party/imgui/imgui.h"
@@ -2153,6 +2162,257 @@ TEST_P(EntityTest, DecalSpecializationAppliedToMorphologyFilter) {
             expected_constants);
 }
 
+TEST_P(EntityTest, SharedContentContextsSharePipelinesButNotTransients) {
+  auto content_context = GetContentContext();
+  std::unique_ptr<ContentContext> shared =
+      content_context->CreateShared(GetContext());
+  ASSERT_TRUE(shared->IsValid());
+
+  ContentContextOptions options = {
+      .color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt,
+      .has_depth_stencil_attachments = false,
+  };
+  // Variants created through either content context are visible to both.
+  auto variant = shared->GetSolidFillPipeline(options);
+  EXPECT_EQ(content_context->GetSolidFillPipeline(options), variant);
+
+  EXPECT_EQ(content_context->GetLazyGlyphAtlas(), shared->GetLazyGlyphAtlas());
+  EXPECT_EQ(&content_context->GetTessellator(), &shared->GetTessellator());
+  EXPECT_EQ(content_context->GetEmptyTexture(), shared->GetEmptyTexture());
+
+  EXPECT_NE(&content_context->GetTransientsBuffer(),
+            &shared->GetTransientsBuffer());
+  EXPECT_NE(content_context->GetRenderTargetCache(),
+            shared->GetRenderTargetCache());
+}
+
+TEST_P(EntityTest, FirstFramePipelinesBecomeReady) {
+  fml::TimePoint start = fml::TimePoint::Now();
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+  // Frames poll for readiness without waiting for the pipelines.
+  content_context.AreFirstFramePipelinesReady();
+  EXPECT_TRUE(content_context.WaitForFirstFramePipelines());
+  fml::TimeDelta time_to_ready = fml::TimePoint::Now() - start;
+  EXPECT_TRUE(content_context.AreFirstFramePipelinesReady());
+  RecordProperty("time_to_ready_us",
+                 std::to_string(time_to_ready.ToMicroseconds()));
+
+  // The pipelines that were waited for are used without further waiting.
+  ContentContextOptions options = {
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+      .has_depth_stencil_attachments = true,
+  };
+  EXPECT_TRUE(content_context.GetSolidFillPipeline(options));
+  EXPECT_TRUE(content_context.GetTexturePipeline(options));
+}
+
+TEST_P(EntityTest, FirstUseOfEachAdvancedBlendDoesNotWaitForPipelines) {
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+  auto image = CreateTextureForFixture("boston.jpg");
+  RenderTarget target =
+      content_context.GetRenderTargetCache()->CreateOffscreenMSAA(
+          *GetContext(), {100, 100}, 1);
+  auto cmd_buffer = GetContext()->CreateCommandBuffer();
+  auto pass = cmd_buffer->CreateRenderPass(target);
+
+  auto render_blend = [&](BlendMode blend_mode) {
+    Entity entity;
+    entity.SetContents(ColorFilterContents::MakeBlend(
+        blend_mode, FilterInput::Make({image}), Color::Red()));
+    return entity.Render(content_context, *pass);
+  };
+
+  // The result of a blend is drawn into the pass like any other snapshot.
+  // Draw one first so that the variants of the pipelines that do that exist,
+  // since they are not specific to advanced blends. Blend modes with fixed
+  // function blending have no uber pipeline and are not covered here; see
+  // ContentContext::GetSynchronousVariantCount.
+  ASSERT_TRUE(Entity::FromSnapshot(Snapshot{.texture = image})
+                  .Render(content_context, *pass));
+  const size_t synchronous_variant_count =
+      content_context.GetSynchronousVariantCount();
+
+  for (int i = static_cast<int>(Entity::kLastPipelineBlendMode) + 1;
+       i <= static_cast<int>(Entity::kLastAdvancedBlendMode); i++) {
+    EXPECT_TRUE(render_blend(static_cast<BlendMode>(i)));
+    EXPECT_EQ(content_context.GetSynchronousVariantCount(),
+              synchronous_variant_count)
+        << BlendModeToString(static_cast<BlendMode>(i));
+  }
+}
+
+TEST_P(EntityTest, EntityBatcherMergesConsecutiveSolidRects) {
+  if (!GetContext()->GetCapabilities()->SupportsSSBO()) {
+    GTEST_SKIP() << "Instanced solid fills require SSBOs.";
+  }
+  auto content_context = GetContentContext();
+  RenderTarget target =
+      content_context->GetRenderTargetCache()->CreateOffscreenMSAA(
+          *GetContext(), {100, 100}, 1, "Batching Texture");
+  testing::MockRenderPass pass(GetContext(), target);
+  EntityBatcher batcher(content_context->GetTransientsBuffer(),
+                        [&content_context](ContentContextOptions options) {
+                          return content_context->GetInstancedSolidFillPipeline(
+                              options);
+                        });
+
+  RectGeometry rect(Rect::MakeXYWH(10, 10, 20, 20));
+  CircleGeometry circle(Point(50, 50), 10);
+  auto make_entity = [](const Geometry* geometry, BlendMode blend_mode) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(geometry);
+    contents->SetColor(Color::Red());
+    Entity entity;
+    entity.SetContents(contents);
+    entity.SetBlendMode(blend_mode);
+    return entity;
+  };
+
+  EXPECT_TRUE(batcher.Add(make_entity(&rect, BlendMode::kSourceOver), pass));
+  EXPECT_TRUE(batcher.Add(make_entity(&rect, BlendMode::kSourceOver), pass));
+  EXPECT_EQ(batcher.GetPendingCount(), 2u);
+  EXPECT_TRUE(pass.GetCommands().empty());
+
+  // A change of blend mode flushes the pending batch.
+  EXPECT_TRUE(batcher.Add(make_entity(&rect, BlendMode::kSource), pass));
+  EXPECT_EQ(batcher.GetPendingCount(), 1u);
+  ASSERT_EQ(pass.GetCommands().size(), 1u);
+  EXPECT_EQ(pass.GetCommands()[0].instance_count, 2u);
+
+  // Other geometries are not batched.
+  EXPECT_FALSE(batcher.Add(make_entity(&circle, BlendMode::kSource), pass));
+  EXPECT_EQ(batcher.GetPendingCount(), 1u);
+
+  EXPECT_TRUE(batcher.Flush());
+  EXPECT_EQ(batcher.GetPendingCount(), 0u);
+  ASSERT_EQ(pass.GetCommands().size(), 2u);
+  EXPECT_EQ(pass.GetCommands()[1].instance_count, 1u);
+  EXPECT_TRUE(pass.GetCommands()[1]
+                  .pipeline->GetDescriptor()
+                  .GetDepthStencilAttachmentDescriptor()
+                  ->depth_write_enabled);
+}
+
+TEST_P(EntityTest, EntityBatcherMergesTextureRectsOfOneTexture) {
+  auto content_context = GetContentContext();
+  RenderTarget target =
+      content_context->GetRenderTargetCache()->CreateOffscreenMSAA(
+          *GetContext(), {100, 100}, 1, "Batching Texture");
+  testing::MockRenderPass pass(GetContext(), target);
+  EntityBatcher batcher(
+      content_context->GetTransientsBuffer(), nullptr,
+      [&content_context](ContentContextOptions options) {
+        return content_context->GetTexturePipeline(options);
+      },
+      [this](const SamplerDescriptor& descriptor) {
+        return GetContext()->GetSamplerLibrary()->GetSampler(descriptor);
+      });
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {64, 64};
+  desc.usage = TextureUsage::kShaderRead;
+  auto atlas = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  auto other = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(atlas && other);
+
+  auto make_entity = [](const std::shared_ptr<Texture>& texture, Rect source,
+                        bool strict) {
+    auto contents =
+        TextureContents::MakeRect(Rect::MakeXYWH(source.GetX(), 10, 16, 16));
+    contents->SetTexture(texture);
+    contents->SetSourceRect(source);
+    contents->SetStrictSourceRect(strict);
+    Entity entity;
+    entity.SetContents(contents);
+    return entity;
+  };
+
+  // Different regions of one texture are merged.
+  EXPECT_TRUE(batcher.Add(
+      make_entity(atlas, Rect::MakeXYWH(0, 0, 16, 16), false), pass));
+  EXPECT_TRUE(batcher.Add(
+      make_entity(atlas, Rect::MakeXYWH(16, 0, 16, 16), false), pass));
+  EXPECT_TRUE(batcher.Add(
+      make_entity(atlas, Rect::MakeXYWH(32, 0, 16, 16), false), pass));
+  EXPECT_EQ(batcher.GetPendingCount(), 3u);
+  EXPECT_TRUE(pass.GetCommands().empty());
+
+  // Another texture flushes the pending batch.
+  EXPECT_TRUE(batcher.Add(
+      make_entity(other, Rect::MakeXYWH(0, 0, 16, 16), false), pass));
+  EXPECT_EQ(batcher.GetPendingCount(), 1u);
+  ASSERT_EQ(pass.GetCommands().size(), 1u);
+  EXPECT_EQ(pass.GetCommands()[0].element_count, 18u);
+
+  // Strict source rects are not batched.
+  EXPECT_FALSE(batcher.Add(
+      make_entity(other, Rect::MakeXYWH(0, 0, 16, 16), true), pass));
+
+  EXPECT_TRUE(batcher.Flush());
+  EXPECT_EQ(batcher.GetPendingCount(), 0u);
+  ASSERT_EQ(pass.GetCommands().size(), 2u);
+  EXPECT_EQ(pass.GetCommands()[1].element_count, 6u);
+}
+
+TEST_P(EntityTest, BackdropFilterCacheOnlyReusesMarkedBackdrops) {
+  if (!GetContext()->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    GTEST_SKIP() << "Cached backdrops are copied with blits.";
+  }
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 50};
+  desc.usage = TextureUsage::kRenderTarget | TextureUsage::kShaderRead;
+  auto texture = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(texture);
+
+  BackdropFilterCache cache;
+  BackdropFilterCache::Key key{.backdrop_id = -1,
+                               .coverage = Rect::MakeXYWH(0, 0, 100, 50)};
+  // Backdrops that were not marked unchanged are not kept.
+  Snapshot uncached =
+      cache.Set(*GetContext(), key, Snapshot{.texture = texture});
+  EXPECT_EQ(uncached.texture, texture);
+  EXPECT_EQ(cache.GetCachedCount(), 0u);
+
+  cache.MarkUnchanged(-1);
+  EXPECT_TRUE(cache.IsUnchanged(-1));
+  Snapshot copy = cache.Set(*GetContext(), key, Snapshot{.texture = texture});
+  EXPECT_NE(copy.texture, texture);
+  EXPECT_EQ(cache.GetCachedCount(), 1u);
+  cache.End();
+  EXPECT_FALSE(cache.IsUnchanged(-1));
+
+  // Results are only reused for backdrops marked unchanged.
+  EXPECT_FALSE(cache.Get(key).has_value());
+  cache.End();
+
+  cache.MarkUnchanged(-1);
+  BackdropFilterCache::Key moved = key;
+  moved.coverage = Rect::MakeXYWH(0, 10, 100, 50);
+  EXPECT_FALSE(cache.Get(moved).has_value());
+  std::optional<Snapshot> hit = cache.Get(key);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->texture, copy.texture);
+
+  // A new result for the same backdrop reuses the texture of the old one.
+  Snapshot moved_copy =
+      cache.Set(*GetContext(), moved, Snapshot{.texture = texture});
+  EXPECT_EQ(moved_copy.texture, copy.texture);
+  EXPECT_EQ(cache.GetCachedCount(), 1u);
+  cache.End();
+
+  // Results that are not used in a frame are discarded.
+  EXPECT_EQ(cache.GetCachedCount(), 1u);
+  cache.End();
+  EXPECT_EQ(cache.GetCachedCount(), 0u);
+}
+
 // This doesn't really tell you if the hashes will have frequent
 // collisions, but since this type is only used to hash a bounded
 // set of options, we can just compare benchmarks.
@@ -2447,6 +2707,53 @@ TEST_P(EntityTest, GiantStrokePathAllocation) {
   EXPECT_NEAR(point.y, expected[4].y, 0.1);
 }
 
+TEST_P(EntityTest, RoundRectClipComplementCoversOutsideOfRoundRect) {
+  ContentContext content_context(GetContext(), /*typographer_context=*/nullptr);
+  auto cmd_buffer = content_context.GetContext()->CreateCommandBuffer();
+  RenderTargetAllocator allocator(
+      content_context.GetContext()->GetResourceAllocator());
+  auto render_target = allocator.CreateOffscreen(
+      *content_context.GetContext(), /*size=*/{100, 100}, /*mip_count=*/1);
+  auto pass = cmd_buffer->CreateRenderPass(render_target);
+
+  RoundRectGeometry geometry(Rect::MakeLTRB(10, 10, 50, 40), Size(8, 8));
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({0.25, 0.5}));
+
+  std::optional<GeometryResult> result =
+      geometry.GetClipComplementBuffer(content_context, entity, *pass);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->type, PrimitiveType::kTriangle);
+  const VertexBuffer& vertex_buffer = result->vertex_buffer;
+  ASSERT_EQ(vertex_buffer.vertex_count % 3, 0u);
+
+  const Point* points = reinterpret_cast<const Point*>(
+      vertex_buffer.vertex_buffer.GetBuffer()->OnGetContents() +
+      vertex_buffer.vertex_buffer.GetRange().offset);
+  // The complement extends to the pixel boundaries around the device bounds.
+  Rect outer = Rect::MakeLTRB(9.75, 9.5, 50.75, 40.5);
+  Scalar area = 0;
+  for (size_t i = 0; i < vertex_buffer.vertex_count; i += 3) {
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_TRUE(outer.ContainsInclusive(points[i + j])) << points[i + j];
+    }
+    area += std::abs(
+        (points[i + 1] - points[i]).Cross(points[i + 2] - points[i]));
+  }
+  area /= 2;
+
+  // The frame between the rounded out and the actual bounds, and the four
+  // corners outside of the tessellated arcs.
+  size_t divisions = Tessellator::ComputeQuadrantDivisions(8);
+  Scalar corner_area = 64 - 32 * divisions * std::sin(kPiOver2 / divisions);
+  EXPECT_NEAR(area, 41 * 31 - 40 * 30 + 4 * corner_area, 1e-3);
+
+  // Other transforms are clipped with the stencil buffer.
+  entity.SetTransform(Matrix::MakeRotationZ(Degrees(10)));
+  EXPECT_FALSE(geometry.GetClipComplementBuffer(content_context, entity, *pass)
+                   .has_value());
+}
+
 TEST_P(EntityTest, GiantLineStripPathAllocation) {
   PathBuilder builder{};
   for (int i = 0; i < 10000; i++) {
@@ -4,8 +4,10 @@
 
 #include "impeller/entity/geometry/geometry.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/circle_geometry.h"
@@ -16,7 +18,10 @@
 #include "impeller/entity/geometry/rect_geometry.h"
 #include "impeller/entity/geometry/round_rect_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/geometry/constants.h"
 #include "impeller/geometry/rect.h"
+#include "impeller/geometry/trig.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -122,6 +127,90 @@ bool Geometry::CanApplyMaskFilter() const {
   return true;
 }
 
+std::optional<GeometryResult> Geometry::GetClipComplementBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return std::nullopt;
+}
+
+// static
+GeometryResult Geometry::ComputeClipComplementGeometry(HostBuffer& host_buffer,
+                                                       const Entity& entity,
+                                                       RenderPass& pass,
+                                                       const Rect& bounds,
+                                                       const Size& radii) {
+  using VT = SolidFillVertexShader::PerVertexData;
+
+  const Matrix& transform = entity.GetTransform();
+  FML_DCHECK(transform.IsTranslationScaleOnly());
+
+  // The rounded out device bounds, in the local space of the bounds. This is
+  // exact as the transform only translates and scales.
+  Rect outer = Rect::RoundOut(bounds.TransformBounds(transform))
+                   .TransformBounds(transform.Invert());
+
+  std::vector<VT> vertices;
+  auto add_triangle = [&vertices](Point a, Point b, Point c) {
+    vertices.push_back({.position = a});
+    vertices.push_back({.position = b});
+    vertices.push_back({.position = c});
+  };
+  auto add_rect = [&add_triangle](Scalar left, Scalar top, Scalar right,
+                                  Scalar bottom) {
+    if (left >= right || top >= bottom) {
+      return;
+    }
+    add_triangle({left, top}, {right, top}, {left, bottom});
+    add_triangle({right, top}, {right, bottom}, {left, bottom});
+  };
+
+  // The frame between the bounds and the rounded out bounds.
+  add_rect(outer.GetLeft(), outer.GetTop(), outer.GetRight(), bounds.GetTop());
+  add_rect(outer.GetLeft(), bounds.GetBottom(), outer.GetRight(),
+           outer.GetBottom());
+  add_rect(outer.GetLeft(), bounds.GetTop(), bounds.GetLeft(),
+           bounds.GetBottom());
+  add_rect(bounds.GetRight(), bounds.GetTop(), outer.GetRight(),
+           bounds.GetBottom());
+
+  // The corners outside of the elliptical arcs, as fans from the corners of
+  // the bounds, with the same divisions that the tessellator fills them with.
+  Size corner_radii(std::min(radii.width, bounds.GetWidth() / 2),
+                    std::min(radii.height, bounds.GetHeight() / 2));
+  if (!corner_radii.IsEmpty()) {
+    size_t divisions = Tessellator::ComputeQuadrantDivisions(
+        transform.GetMaxBasisLengthXY() * corner_radii.MaxDimension());
+    std::vector<Trig> trigs;
+    trigs.reserve(divisions + 1);
+    for (size_t i = 0; i <= divisions; i++) {
+      trigs.emplace_back(Radians(kPiOver2 * i / divisions));
+    }
+    for (Point corner : bounds.GetPoints()) {
+      Point direction(corner.x == bounds.GetLeft() ? -1 : 1,
+                      corner.y == bounds.GetTop() ? -1 : 1);
+      Point center = corner - direction * corner_radii;
+      for (size_t i = 0; i < divisions; i++) {
+        add_triangle(corner,
+                     center + direction * (trigs[i] * corner_radii),
+                     center + direction * (trigs[i + 1] * corner_radii));
+      }
+    }
+  }
+
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer =
+          {
+              .vertex_buffer = host_buffer.Emplace(
+                  vertices.data(), vertices.size() * sizeof(VT), alignof(VT)),
+              .vertex_count = vertices.size(),
+              .index_type = IndexType::kNone,
+          },
+      .transform = entity.GetShaderTransform(pass),
+  };
+}
+
 // static
 Scalar Geometry::ComputeStrokeAlphaCoverage(const Matrix& transform,
                                             Scalar stroke_width) {
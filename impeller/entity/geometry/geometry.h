@@ -116,6 +116,31 @@ class Geometry {
     return 1.0;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief  Compute the vertices that cover the pixels of the transformed
+  ///         coverage of this geometry, rounded out to whole pixels, that the
+  ///         geometry itself does not cover.
+  ///
+  ///         Within a scissor of the rounded out coverage, writing the depth
+  ///         of these vertices is an intersect clip of the geometry without
+  ///         the stencil preparation and the cover draw of general clips.
+  ///
+  /// @return The vertices, or std::nullopt if the geometry can not compute
+  ///         them for the transform of `entity`.
+  virtual std::optional<GeometryResult> GetClipComplementBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const;
+
+  /// @brief  Compute the clip complement vertices of `bounds` with elliptical
+  ///         corners of `radii`, under a transform of `entity` that only
+  ///         translates and scales. See `GetClipComplementBuffer`.
+  static GeometryResult ComputeClipComplementGeometry(HostBuffer& host_buffer,
+                                                      const Entity& entity,
+                                                      RenderPass& pass,
+                                                      const Rect& bounds,
+                                                      const Size& radii);
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const ContentContext& renderer,
@@ -43,4 +43,16 @@ bool RectGeometry::IsAxisAlignedRect() const {
   return true;
 }
 
+std::optional<GeometryResult> RectGeometry::GetClipComplementBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  const Matrix& transform = entity.GetTransform();
+  if (!transform.IsTranslationScaleOnly() || !transform.IsInvertible()) {
+    return std::nullopt;
+  }
+  return ComputeClipComplementGeometry(renderer.GetTransientsBuffer(), entity,
+                                       pass, rect_, Size());
+}
+
 }  // namespace impeller
@@ -21,6 +21,12 @@ class RectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<GeometryResult> GetClipComplementBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const override;
+
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
@@ -63,4 +63,16 @@ bool RoundRectGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<GeometryResult> RoundRectGeometry::GetClipComplementBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  const Matrix& transform = entity.GetTransform();
+  if (!transform.IsTranslationScaleOnly() || !transform.IsInvertible()) {
+    return std::nullopt;
+  }
+  return ComputeClipComplementGeometry(renderer.GetTransientsBuffer(), entity,
+                                       pass, bounds_, radii_);
+}
+
 }  // namespace impeller
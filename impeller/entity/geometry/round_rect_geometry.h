@@ -25,6 +25,12 @@ class RoundRectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<GeometryResult> GetClipComplementBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
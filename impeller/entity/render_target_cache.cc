@@ -3,17 +3,68 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/allocation.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
+namespace {
+
+int64_t GetPooledLength(int64_t length) {
+  if (length <= 0) {
+    return length;
+  }
+  const int64_t step = std::max<int64_t>(
+      RenderTargetCache::kMinPooledSizeStep,
+      static_cast<int64_t>(
+          Allocation::NextPowerOfTwoSize(static_cast<uint32_t>(length))) /
+          8);
+  return (length + step - 1) / step * step;
+}
+
+// The memory held by the textures of the render target. Transient attachments
+// are not backed by memory that outlives the render pass, so they are not
+// counted.
+size_t GetByteSize(const RenderTarget& render_target) {
+  size_t byte_size = 0u;
+  auto add_texture = [&byte_size](const std::shared_ptr<Texture>& texture) {
+    if (texture && texture->GetTextureDescriptor().storage_mode !=
+                       StorageMode::kDeviceTransient) {
+      byte_size += texture->GetTextureDescriptor().GetByteSizeOfAllMipLevels();
+    }
+  };
+  render_target.IterateAllAttachments(
+      [&add_texture](const Attachment& attachment) {
+        add_texture(attachment.texture);
+        add_texture(attachment.resolve_texture);
+        return true;
+      });
+  return byte_size;
+}
+
+}  // namespace
+
+double RenderTargetCache::Stats::GetReuseRate() const {
+  const size_t total = allocations + reuses;
+  return total == 0u ? 0.0 : static_cast<double>(reuses) / total;
+}
+
 RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
-                                     uint32_t keep_alive_frame_count)
+                                     uint32_t keep_alive_frame_count,
+                                     size_t max_pooled_bytes)
     : RenderTargetAllocator(std::move(allocator)),
-      keep_alive_frame_count_(keep_alive_frame_count) {}
+      keep_alive_frame_count_(keep_alive_frame_count),
+      max_pooled_bytes_(max_pooled_bytes) {}
 
 void RenderTargetCache::Start() {
+  frame_count_++;
+  stats_.allocations = 0u;
+  stats_.reuses = 0u;
   for (auto& td : render_target_data_) {
     td.used_this_frame = false;
   }
@@ -22,15 +73,50 @@ void RenderTargetCache::Start() {
 void RenderTargetCache::End() {
   std::vector<RenderTargetData> retain;
 
+  size_t pooled_bytes = 0u;
   for (RenderTargetData& td : render_target_data_) {
     if (td.used_this_frame) {
       retain.push_back(td);
+      pooled_bytes += td.byte_size;
     } else if (td.keep_alive_frame_count > 0) {
       td.keep_alive_frame_count--;
       retain.push_back(td);
+      pooled_bytes += td.byte_size;
+    }
+  }
+
+  // Discard the least recently used textures until the rest fit the budget.
+  // Targets handed out this frame keep their textures alive until they are
+  // done with them, the cache only stops reusing them.
+  stats_.evictions = 0u;
+  if (pooled_bytes > max_pooled_bytes_) {
+    std::stable_sort(retain.begin(), retain.end(),
+                     [](const RenderTargetData& a, const RenderTargetData& b) {
+                       return a.last_used_frame > b.last_used_frame;
+                     });
+    while (!retain.empty() && pooled_bytes > max_pooled_bytes_) {
+      pooled_bytes -= retain.back().byte_size;
+      retain.pop_back();
+      stats_.evictions++;
     }
   }
   render_target_data_.swap(retain);
+  stats_.pooled_bytes = pooled_bytes;
+
+  FML_TRACE_COUNTER("flutter", "RenderTargetCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Allocations", stats_.allocations,  //
+                    "PooledBytes", stats_.pooled_bytes,  //
+                    "ReusePercent",
+                    static_cast<int64_t>(stats_.GetReuseRate() * 100));
+}
+
+ISize RenderTargetCache::GetPooledSize(ISize size) const {
+  return ISize(GetPooledLength(size.width), GetPooledLength(size.height));
+}
+
+const RenderTargetCache::Stats& RenderTargetCache::GetStats() const {
+  return stats_;
 }
 
 RenderTarget RenderTargetCache::CreateOffscreen(
@@ -59,6 +145,8 @@ RenderTarget RenderTargetCache::CreateOffscreen(
     if (!render_target_data.used_this_frame && other_config == config) {
       render_target_data.used_this_frame = true;
       render_target_data.keep_alive_frame_count = keep_alive_frame_count_;
+      render_target_data.last_used_frame = frame_count_;
+      stats_.reuses++;
       ColorAttachment color0 =
           render_target_data.render_target.GetColorAttachment(0);
       std::optional<DepthAttachment> depth =
@@ -79,8 +167,11 @@ RenderTarget RenderTargetCache::CreateOffscreen(
       .used_this_frame = true,                            //
       .keep_alive_frame_count = keep_alive_frame_count_,  //
       .config = config,                                   //
-      .render_target = created_target                     //
+      .render_target = created_target,                    //
+      .byte_size = GetByteSize(created_target),           //
+      .last_used_frame = frame_count_                     //
   });
+  stats_.allocations++;
   return created_target;
 }
 
@@ -112,6 +203,8 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
     if (!render_target_data.used_this_frame && other_config == config) {
       render_target_data.used_this_frame = true;
       render_target_data.keep_alive_frame_count = keep_alive_frame_count_;
+      render_target_data.last_used_frame = frame_count_;
+      stats_.reuses++;
       ColorAttachment color0 =
           render_target_data.render_target.GetColorAttachment(0);
       std::optional<DepthAttachment> depth =
@@ -133,8 +226,11 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
       .used_this_frame = true,                            //
       .keep_alive_frame_count = keep_alive_frame_count_,  //
       .config = config,                                   //
-      .render_target = created_target                     //
+      .render_target = created_target,                    //
+      .byte_size = GetByteSize(created_target),           //
+      .last_used_frame = frame_count_                     //
   });
+  stats_.allocations++;
   return created_target;
 }
 
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 #define FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 
+#include <cstdint>
 #include <string_view>
 #include "impeller/renderer/render_target.h"
 
@@ -13,11 +14,43 @@ namespace impeller {
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
 ///        allocated texture data for one frame.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures unused after a frame are kept alive for
+///        `keep_alive_frame_count` more frames. If the cached textures exceed
+///        `max_pooled_bytes` at the end of a frame, the least recently used
+///        ones are discarded first until they fit.
+///
+///        Sizes returned by `GetPooledSize` are rounded up to coarse buckets,
+///        so that layers whose bounds change slightly from frame to frame
+///        keep reusing the same textures.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
+  /// The default budget for the textures kept between frames.
+  static constexpr size_t kDefaultMaxPooledBytes = 64u * 1024u * 1024u;
+
+  /// The smallest step between the pooled sizes of a dimension.
+  static constexpr int64_t kMinPooledSizeStep = 32;
+
+  struct Stats {
+    /// The number of render targets created with new textures since the
+    /// start of the frame.
+    size_t allocations = 0u;
+    /// The number of render targets created with cached textures since the
+    /// start of the frame.
+    size_t reuses = 0u;
+    /// The number of cached render targets discarded to fit the budget at the
+    /// end of the last frame.
+    size_t evictions = 0u;
+    /// The size of the cached textures, in bytes.
+    size_t pooled_bytes = 0u;
+
+    /// The fraction of the render targets created since the start of the
+    /// frame that reused cached textures.
+    double GetReuseRate() const;
+  };
+
   explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
-                             uint32_t keep_alive_frame_count = 4);
+                             uint32_t keep_alive_frame_count = 4,
+                             size_t max_pooled_bytes = kDefaultMaxPooledBytes);
 
   ~RenderTargetCache() = default;
 
@@ -54,19 +87,35 @@ class RenderTargetCache : public RenderTargetAllocator {
       const std::shared_ptr<Texture>& existing_depth_stencil_texture =
           nullptr) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief  Round each dimension up to a multiple of an eighth of its next
+  ///         power of two, and at least of `kMinPooledSizeStep`. Pooled
+  ///         textures are at most a quarter larger than requested in each
+  ///         dimension, except for the smallest ones.
+  ///
+  // |RenderTargetAllocator|
+  ISize GetPooledSize(ISize size) const override;
+
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  const Stats& GetStats() const;
+
  private:
   struct RenderTargetData {
     bool used_this_frame;
     uint32_t keep_alive_frame_count;
     RenderTargetConfig config;
     RenderTarget render_target;
+    size_t byte_size = 0u;
+    uint64_t last_used_frame = 0u;
   };
 
   std::vector<RenderTargetData> render_target_data_;
   uint32_t keep_alive_frame_count_;
+  size_t max_pooled_bytes_;
+  uint64_t frame_count_ = 0u;
+  Stats stats_;
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
@@ -162,5 +162,83 @@ TEST_P(RenderTargetCacheTest, CreateWithEmptySize) {
   }
 }
 
+TEST_P(RenderTargetCacheTest, PooledSizeRoundsUpToBuckets) {
+  auto render_target_cache = RenderTargetCache(
+      GetContext()->GetResourceAllocator(), /*keep_alive_frame_count=*/0);
+
+  EXPECT_EQ(render_target_cache.GetPooledSize({1, 32}), ISize(32, 32));
+  EXPECT_EQ(render_target_cache.GetPooledSize({100, 129}), ISize(128, 160));
+  EXPECT_EQ(render_target_cache.GetPooledSize({1000, 1030}),
+            ISize(1024, 1280));
+  EXPECT_EQ(render_target_cache.GetPooledSize({0, 100}), ISize(0, 128));
+}
+
+TEST_P(RenderTargetCacheTest, PooledSizesReuseTexturesAcrossResizes) {
+  auto render_target_cache = RenderTargetCache(
+      GetContext()->GetResourceAllocator(), /*keep_alive_frame_count=*/0);
+
+  render_target_cache.Start();
+  RenderTarget target1 = render_target_cache.CreateOffscreen(
+      *GetContext(), render_target_cache.GetPooledSize({300, 200}), 1);
+  render_target_cache.End();
+
+  // A slightly larger layer on the next frame lands in the same bucket.
+  render_target_cache.Start();
+  RenderTarget target2 = render_target_cache.CreateOffscreen(
+      *GetContext(), render_target_cache.GetPooledSize({310, 212}), 1);
+  render_target_cache.End();
+
+  EXPECT_EQ(target1.GetRenderTargetTexture(), target2.GetRenderTargetTexture());
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
+TEST_P(RenderTargetCacheTest, EvictsLeastRecentlyUsedTexturesOverBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  // Enough for two of the 4 byte per pixel color textures below. The depth
+  // stencil textures are transient and not counted.
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/4,
+                        /*max_pooled_bytes=*/100 * 1024);
+
+  std::vector<RenderTarget> targets;
+  for (int64_t width : {100, 101, 102}) {
+    render_target_cache.Start();
+    targets.push_back(
+        render_target_cache.CreateOffscreen(*GetContext(), {width, 100}, 1));
+    render_target_cache.End();
+  }
+
+  // The first texture was the least recently used one.
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(render_target_cache.GetStats().evictions, 1u);
+  EXPECT_LE(render_target_cache.GetStats().pooled_bytes, 100u * 1024u);
+  for (auto it = render_target_cache.GetRenderTargetDataBegin();
+       it != render_target_cache.GetRenderTargetDataEnd(); it++) {
+    EXPECT_NE(it->render_target.GetRenderTargetTexture(),
+              targets[0].GetRenderTargetTexture());
+  }
+}
+
+TEST_P(RenderTargetCacheTest, TracksAllocationsAndReuses) {
+  auto render_target_cache = RenderTargetCache(
+      GetContext()->GetResourceAllocator(), /*keep_alive_frame_count=*/0);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  EXPECT_EQ(render_target_cache.GetStats().allocations, 2u);
+  EXPECT_EQ(render_target_cache.GetStats().reuses, 0u);
+  render_target_cache.End();
+  EXPECT_GT(render_target_cache.GetStats().pooled_bytes, 0u);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.CreateOffscreen(*GetContext(), {200, 100}, 1);
+  EXPECT_EQ(render_target_cache.GetStats().allocations, 1u);
+  EXPECT_EQ(render_target_cache.GetStats().reuses, 1u);
+  EXPECT_DOUBLE_EQ(render_target_cache.GetStats().GetReuseRate(), 0.5);
+  render_target_cache.End();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -8,6 +8,8 @@
 #include <impeller/types.glsl>
 #include "blend_select.glsl"
 
+// A negative blend type reads the blend type from the uniforms instead, so
+// that one pipeline can draw every advanced blend.
 layout(constant_id = 0) const float blend_type = 0.0;
 layout(constant_id = 1) const float supports_decal = 1.0;
 
@@ -17,6 +19,7 @@ uniform BlendInfo {
   float16_t color_factor;
   f16vec4 color;  // This color input is expected to be unpremultiplied.
   float supports_decal_sampler_address_mode;
+  float16_t uber_blend_type;
 }
 blend_info;
 
@@ -51,7 +54,9 @@ void main() {
     src.a *= blend_info.src_input_alpha;
   }
 
-  f16vec3 blend_result = AdvancedBlend(dst.rgb, src.rgb, int(blend_type));
+  int type = blend_type < 0.0 ? int(blend_info.uber_blend_type)
+                              : int(blend_type);
+  f16vec3 blend_result = AdvancedBlend(dst.rgb, src.rgb, type);
 
   frag_color = IPApplyBlendedColor(dst, src, blend_result);
 }
@@ -13,6 +13,9 @@
 // Warning: if any of the constant values or layouts are changed in this
 // file, then the hard-coded constant value in
 // impeller/renderer/backend/vulkan/binding_helpers_vk.cc
+
+// A negative blend type reads the blend type from the uniforms instead, so
+// that one pipeline can draw every advanced blend.
 layout(constant_id = 0) const float blend_type = 0;
 layout(constant_id = 1) const float supports_decal = 1;
 
@@ -29,6 +32,7 @@ uniform sampler2D texture_sampler_src;
 uniform FragInfo {
   float16_t src_input_alpha;
   float16_t dst_input_alpha;
+  float16_t uber_blend_type;
 }
 frag_info;
 
@@ -52,7 +56,9 @@ void main() {
                      )));
   src.a *= frag_info.src_input_alpha;
 
-  f16vec3 blend_result = AdvancedBlend(dst.rgb, src.rgb, int(blend_type));
+  int type = blend_type < 0.0 ? int(frag_info.uber_blend_type)
+                              : int(blend_type);
+  f16vec3 blend_result = AdvancedBlend(dst.rgb, src.rgb, type);
 
   frag_color = IPApplyBlendedColor(dst, src, blend_result);
 }
@@ -0,0 +1,27 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+struct RectInstance {
+  mat4 mvp;
+  vec4 color;
+};
+
+layout(std140) readonly buffer InstanceInfo {
+  RectInstance instances[];
+}
+instance_info;
+
+// A corner of the unit square, which the instance transform maps onto the
+// rectangle.
+in vec2 position;
+
+out mediump vec4 v_color;
+
+void main() {
+  RectInstance instance = instance_info.instances[gl_InstanceIndex];
+  gl_Position = instance.mvp * vec4(position, 0.0, 1.0);
+  v_color = instance.color;
+}
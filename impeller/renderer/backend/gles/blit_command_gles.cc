@@ -10,6 +10,7 @@
 #include "impeller/geometry/point.h"
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -101,9 +102,10 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  ShadowStateGLES& state = reactor.GetShadowState();
+  state.Disable(GL_SCISSOR_TEST);
+  state.Disable(GL_DEPTH_TEST);
+  state.Disable(GL_STENCIL_TEST);
 
   gl.BlitFramebuffer(source_region.GetX(),       // srcX0
                      source_region.GetY(),       // srcY0
@@ -397,9 +399,10 @@ bool BlitResizeTextureCommandGLES::Encode(const ReactorGLES& reactor) const {
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  ShadowStateGLES& state = reactor.GetShadowState();
+  state.Disable(GL_SCISSOR_TEST);
+  state.Disable(GL_DEPTH_TEST);
+  state.Disable(GL_STENCIL_TEST);
 
   const IRect source_region = IRect::MakeSize(source->GetSize());
   const IRect destination_region = IRect::MakeSize(destination->GetSize());
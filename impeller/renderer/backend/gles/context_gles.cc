@@ -13,6 +13,7 @@
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/render_pass_gles.h"
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 #include "impeller/renderer/command_queue.h"
 
@@ -83,6 +84,13 @@ Context::BackendType ContextGLES::GetBackendType() const {
   return Context::BackendType::kOpenGLES;
 }
 
+std::optional<fml::TimeDelta> ContextGLES::TakeGPUFrameTime() const {
+  if (!gpu_tracer_) {
+    return std::nullopt;
+  }
+  return gpu_tracer_->TakeLastFrameTime();
+}
+
 const std::shared_ptr<ReactorGLES>& ContextGLES::GetReactor() const {
   return reactor_;
 }
@@ -157,7 +165,9 @@ void ContextGLES::ResetThreadLocalState() const {
   }
   [[maybe_unused]] auto result =
       reactor_->AddOperation([](const ReactorGLES& reactor) {
-        RenderPassGLES::ResetGLState(reactor.GetProcTable());
+        ShadowStateGLES& state = reactor.GetShadowState();
+        state.Invalidate();
+        RenderPassGLES::ResetGLState(state);
       });
 }
 
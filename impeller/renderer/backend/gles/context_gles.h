@@ -44,6 +44,9 @@ class ContextGLES final : public Context,
 
   std::shared_ptr<GPUTracerGLES> GetGPUTracer() const { return gpu_tracer_; }
 
+  // |Context|
+  std::optional<fml::TimeDelta> TakeGPUFrameTime() const override;
+
  private:
   std::shared_ptr<ReactorGLES> reactor_;
   std::shared_ptr<ShaderLibraryGLES> shader_library_;
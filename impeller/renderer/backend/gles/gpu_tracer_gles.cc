@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include <thread>
+#include <utility>
 #include "fml/trace_event.h"
 
 namespace impeller {
@@ -67,6 +68,7 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
                       "FrameTimeMS", gpu_ms);
+    last_frame_time_ = fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(duration));
     gl.DeleteQueriesEXT(1, &query);
     pending_traces_.pop_front();
   }
@@ -85,4 +87,8 @@ void GPUTracerGLES::MarkFrameEnd(const ProcTableGLES& gl) {
   active_frame_ = std::nullopt;
 }
 
+std::optional<fml::TimeDelta> GPUTracerGLES::TakeLastFrameTime() {
+  return std::exchange(last_frame_time_, std::nullopt);
+}
+
 }  // namespace impeller
@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <deque>
+#include <optional>
 #include <thread>
 
+#include "fml/time/time_delta.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -40,11 +42,16 @@ class GPUTracerGLES {
   /// @brief Record the end of a frame workload.
   void MarkFrameEnd(const ProcTableGLES& gl);
 
+  /// @brief Take the GPU time of the last frame workload whose query was
+  ///        processed since the previous call, if any.
+  std::optional<fml::TimeDelta> TakeLastFrameTime();
+
  private:
   void ProcessQueries(const ProcTableGLES& gl);
 
   std::deque<uint32_t> pending_traces_;
   std::optional<uint32_t> active_frame_ = std::nullopt;
+  std::optional<fml::TimeDelta> last_frame_time_ = std::nullopt;
   std::thread::id raster_thread_;
 
   bool enabled_ = false;
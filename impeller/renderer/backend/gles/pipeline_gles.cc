@@ -65,13 +65,13 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   if (!handle.has_value()) {
     return false;
   }
-  reactor_->GetProcTable().UseProgram(handle.value());
+  reactor_->GetShadowState().UseProgram(handle.value());
   return true;
 }
 
 [[nodiscard]] bool PipelineGLES::UnbindProgram() const {
   if (reactor_) {
-    reactor_->GetProcTable().UseProgram(0u);
+    reactor_->GetShadowState().UseProgram(0u);
   }
   return true;
 }
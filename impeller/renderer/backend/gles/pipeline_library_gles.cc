@@ -183,6 +183,8 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
     const PipelineDescriptor& desc,
     const std::shared_ptr<const ShaderFunction>& vert_function,
     const std::shared_ptr<const ShaderFunction>& frag_function) {
+  TRACE_EVENT1("impeller", "PipelineLibraryGLES::CreatePipeline", "Name",
+               desc.GetLabel().data());
   auto strong_library = weak_library.lock();
 
   if (!strong_library) {
@@ -93,6 +93,7 @@ ProcTableGLES::ProcTableGLES(  // NOLINT(google-readability-function-size)
     proc_ivar.function =                                        \
         reinterpret_cast<decltype(proc_ivar.function)>(fn_ptr); \
     proc_ivar.error_fn = error_fn;                              \
+    proc_ivar.call_count = call_count_.get();                   \
   } else {                                                      \
     VALIDATION_LOG << "Could not resolve " << proc_ivar.name;   \
     return;                                                     \
@@ -119,6 +120,7 @@ ProcTableGLES::ProcTableGLES(  // NOLINT(google-readability-function-size)
     proc_ivar.function =                                        \
         reinterpret_cast<decltype(proc_ivar.function)>(fn_ptr); \
     proc_ivar.error_fn = error_fn;                              \
+    proc_ivar.call_count = call_count_.get();                   \
   }
 
   if (description_->GetGlVersion().IsAtLeast(Version(3))) {
@@ -152,6 +154,10 @@ bool ProcTableGLES::IsValid() const {
   return is_valid_;
 }
 
+uint64_t ProcTableGLES::GetCallCount() const {
+  return call_count_->load(std::memory_order_relaxed);
+}
+
 void ProcTableGLES::ShaderSourceMapping(
     GLuint shader,
     const fml::Mapping& mapping,
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROC_TABLE_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROC_TABLE_GLES_H_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 
 #include "flutter/fml/logging.h"
@@ -99,6 +102,11 @@ struct GLProc {
   ///
   bool log_calls = false;
 
+  //----------------------------------------------------------------------------
+  /// The count of calls made through the proc table this function belongs to.
+  ///
+  std::atomic<uint64_t>* call_count = nullptr;
+
   //----------------------------------------------------------------------------
   /// @brief      Call the GL function with the appropriate parameters. Lookup
   ///             the documentation for the GL function being called to
@@ -119,6 +127,9 @@ struct GLProc {
                          << BuildGLArguments(std::forward<Args>(args)...);
     }
 #endif  // defined(IMPELLER_DEBUG) && !defined(NDEBUG)
+    if (call_count) {
+      call_count->fetch_add(1u, std::memory_order_relaxed);
+    }
     return function(std::forward<Args>(args)...);
   }
 
@@ -324,6 +335,12 @@ class ProcTableGLES {
 
   void PopDebugGroup() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls made through this proc table on any
+  ///             thread since it was created.
+  ///
+  uint64_t GetCallCount() const;
+
   // Visible For testing.
   std::optional<std::string> ComputeShaderWithDefines(
       const fml::Mapping& mapping,
@@ -334,6 +351,9 @@ class ProcTableGLES {
   std::unique_ptr<DescriptionGLES> description_;
   std::shared_ptr<const CapabilitiesGLES> capabilities_;
   GLint debug_label_max_length_ = 0;
+  // Heap allocated so that the procs may point to it after a move.
+  std::unique_ptr<std::atomic<uint64_t>> call_count_ =
+      std::make_unique<std::atomic<uint64_t>>(0u);
 
   ProcTableGLES(const ProcTableGLES&) = delete;
 
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 
 #include <algorithm>
+#include <map>
 
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
@@ -70,6 +71,77 @@ bool ReactorGLES::CollectGLHandle(const ProcTableGLES& gl,
   return false;
 }
 
+// static
+bool ReactorGLES::CreateGLHandles(const ProcTableGLES& gl,
+                                  HandleType type,
+                                  const std::vector<LiveHandle*>& handles) {
+  const auto count = static_cast<GLsizei>(handles.size());
+  std::vector<GLuint> names(count, GL_NONE);
+  switch (type) {
+    case HandleType::kUnknown:
+      return false;
+    case HandleType::kTexture:
+      gl.GenTextures(count, names.data());
+      break;
+    case HandleType::kBuffer:
+      gl.GenBuffers(count, names.data());
+      break;
+    case HandleType::kRenderBuffer:
+      gl.GenRenderbuffers(count, names.data());
+      break;
+    case HandleType::kFrameBuffer:
+      gl.GenFramebuffers(count, names.data());
+      break;
+    case HandleType::kProgram:
+    case HandleType::kFence:
+      for (LiveHandle* handle : handles) {
+        handle->name = CreateGLHandle(gl, type);
+        if (!handle->name.has_value()) {
+          return false;
+        }
+      }
+      return true;
+  }
+  for (size_t i = 0; i < handles.size(); i++) {
+    handles[i]->name = GLStorage{.handle = names[i]};
+  }
+  return true;
+}
+
+// static
+void ReactorGLES::CollectGLHandles(const ProcTableGLES& gl,
+                                   HandleType type,
+                                   const std::vector<GLStorage>& handles) {
+  const auto count = static_cast<GLsizei>(handles.size());
+  std::vector<GLuint> names;
+  names.reserve(count);
+  for (const GLStorage& handle : handles) {
+    names.push_back(handle.handle);
+  }
+  switch (type) {
+    case HandleType::kUnknown:
+      return;
+    case HandleType::kTexture:
+      gl.DeleteTextures(count, names.data());
+      return;
+    case HandleType::kBuffer:
+      gl.DeleteBuffers(count, names.data());
+      return;
+    case HandleType::kRenderBuffer:
+      gl.DeleteRenderbuffers(count, names.data());
+      return;
+    case HandleType::kFrameBuffer:
+      gl.DeleteFramebuffers(count, names.data());
+      return;
+    case HandleType::kProgram:
+    case HandleType::kFence:
+      for (const GLStorage& handle : handles) {
+        CollectGLHandle(gl, type, handle);
+      }
+      return;
+  }
+}
+
 ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
     : proc_table_(std::move(gl)) {
   if (!proc_table_ || !proc_table_->IsValid()) {
@@ -82,12 +154,16 @@ ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
 
 ReactorGLES::~ReactorGLES() {
   if (CanReactOnCurrentThread()) {
+    std::map<HandleType, std::vector<GLStorage>> handles_to_delete;
     for (auto& handle : handles_) {
       if (handle.second.name.has_value()) {
-        CollectGLHandle(*proc_table_, handle.first.GetType(),
-                        handle.second.name.value());
+        handles_to_delete[handle.first.GetType()].push_back(
+            handle.second.name.value());
       }
     }
+    for (const auto& [type, handles] : handles_to_delete) {
+      CollectGLHandles(*proc_table_, type, handles);
+    }
     proc_table_->Flush();
   }
 }
@@ -124,6 +200,47 @@ const ProcTableGLES& ReactorGLES::GetProcTable() const {
   return *proc_table_;
 }
 
+ShadowStateGLES& ReactorGLES::GetShadowState() const {
+  FML_DCHECK(IsValid());
+  Lock lock(shadow_states_mutex_);
+  return shadow_states_.try_emplace(std::this_thread::get_id(), *proc_table_)
+      .first->second;
+}
+
+uint64_t ReactorGLES::GetSkippedStateChangeCount() const {
+  uint64_t count = 0u;
+  Lock lock(shadow_states_mutex_);
+  for (const auto& [thread_id, shadow_state] : shadow_states_) {
+    count += shadow_state.GetSkippedCallCount();
+  }
+  return count;
+}
+
+void ReactorGLES::MarkFrameEnd() const {
+  const FrameCallCounts counts = {
+      .gl_calls = proc_table_->GetCallCount(),
+      .skipped_state_changes = GetSkippedStateChangeCount(),
+  };
+  Lock lock(frame_counts_mutex_);
+  last_frame_counts_ = {
+      .gl_calls = counts.gl_calls - frame_end_counts_.gl_calls,
+      .skipped_state_changes = counts.skipped_state_changes -
+                               frame_end_counts_.skipped_state_changes,
+  };
+  frame_end_counts_ = counts;
+
+  FML_TRACE_COUNTER("impeller", "ReactorGLES",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "GLCalls", last_frame_counts_.gl_calls,
+                    "SkippedStateChanges",
+                    last_frame_counts_.skipped_state_changes);
+}
+
+ReactorGLES::FrameCallCounts ReactorGLES::GetLastFrameCallCounts() const {
+  Lock lock(frame_counts_mutex_);
+  return last_frame_counts_;
+}
+
 std::optional<ReactorGLES::GLStorage> ReactorGLES::GetHandle(
     const HandleGLES& handle) const {
   if (handle.untracked_id_.has_value()) {
@@ -301,6 +418,9 @@ bool ReactorGLES::ConsolidateHandles() {
     WriterLock handles_lock(handles_mutex_);
     handles_to_delete.reserve(handles_to_collect_count_);
     handles_to_collect_count_ = 0;
+    // Handles of the same type are created together.
+    std::map<HandleType, std::vector<LiveHandle*>> handles_to_create;
+    std::vector<std::pair<HandleType, LiveHandle*>> handles_to_label;
     for (auto& handle : handles_) {
       // Collect dead handles.
       if (handle.second.pending_collection) {
@@ -310,23 +430,26 @@ bool ReactorGLES::ConsolidateHandles() {
       }
       // Create live handles.
       if (!handle.second.name.has_value()) {
-        auto gl_handle = CreateGLHandle(gl, handle.first.GetType());
-        if (!gl_handle) {
-          VALIDATION_LOG << "Could not create GL handle.";
-          return false;
-        }
-        handle.second.name = gl_handle;
+        handles_to_create[handle.first.GetType()].push_back(&handle.second);
       }
       // Set pending debug labels.
       if (handle.second.pending_debug_label.has_value() &&
           handle.first.GetType() != HandleType::kFence) {
-        handles_to_name.emplace_back(std::make_tuple(
-            ToDebugResourceType(handle.first.GetType()),
-            handle.second.name.value().handle,
-            std::move(handle.second.pending_debug_label.value())));
-        handle.second.pending_debug_label = std::nullopt;
+        handles_to_label.emplace_back(handle.first.GetType(), &handle.second);
+      }
+    }
+    for (const auto& [type, handles] : handles_to_create) {
+      if (!CreateGLHandles(gl, type, handles)) {
+        VALIDATION_LOG << "Could not create GL handle.";
+        return false;
       }
     }
+    for (const auto& [type, handle] : handles_to_label) {
+      handles_to_name.emplace_back(
+          std::make_tuple(ToDebugResourceType(type), handle->name->handle,
+                          std::move(handle->pending_debug_label.value())));
+      handle->pending_debug_label = std::nullopt;
+    }
     for (const auto& handle_to_delete : handles_to_delete) {
       handles_.erase(std::get<0>(handle_to_delete));
     }
@@ -336,14 +459,19 @@ bool ReactorGLES::ConsolidateHandles() {
     gl.SetDebugLabel(std::get<0>(handle), std::get<1>(handle),
                      std::get<2>(handle));
   }
+  // Handles of the same type are deleted together.
+  std::map<HandleType, std::vector<GLStorage>> names_to_delete;
   for (const auto& handle : handles_to_delete) {
     const std::optional<GLStorage>& storage = std::get<1>(handle);
     // This could be false if the handle was created and collected without
     // use. We still need to get rid of map entry.
     if (storage.has_value()) {
-      CollectGLHandle(gl, std::get<0>(handle).GetType(), storage.value());
+      names_to_delete[std::get<0>(handle).GetType()].push_back(storage.value());
     }
   }
+  for (const auto& [type, names] : names_to_delete) {
+    CollectGLHandles(gl, type, names);
+  }
 
   return true;
 }
@@ -365,6 +493,8 @@ bool ReactorGLES::FlushOps() {
     Lock ops_lock(ops_mutex_);
     std::swap(ops_[thread_id], ops);
   }
+  // The state may have been changed by the embedder since the last reaction.
+  GetShadowState().Invalidate();
   for (const auto& op : ops) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
     op(*this);
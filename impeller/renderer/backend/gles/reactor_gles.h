@@ -5,8 +5,11 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "flutter/third_party/abseil-cpp/absl/container/flat_hash_map.h"
@@ -14,6 +17,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
 
 namespace impeller {
 
@@ -138,6 +142,40 @@ class ReactorGLES {
   ///
   const ProcTableGLES& GetProcTable() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the cache of the state of the OpenGL context that is
+  ///             current on the calling thread. Redundant state changes made
+  ///             through the cache are skipped.
+  ///
+  ///             The cache is invalidated before each reaction, so this is
+  ///             only useful within a `ReactorGLES::Operation`.
+  ///
+  /// @return     The shadow state of the calling thread.
+  ///
+  ShadowStateGLES& GetShadowState() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The counts of the OpenGL calls made for a frame.
+  ///
+  struct FrameCallCounts {
+    /// The calls made through the proc table on any thread.
+    uint64_t gl_calls = 0u;
+    /// The state changes that were skipped because they were redundant.
+    uint64_t skipped_state_changes = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of the work of a frame. The counts of the calls
+  ///             made since the previous mark are recorded in a trace counter
+  ///             and returned by `GetLastFrameCallCounts`.
+  ///
+  void MarkFrameEnd() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The counts of the calls made between the last two frame ends.
+  ///
+  FrameCallCounts GetLastFrameCallCounts() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns the OpenGL handle for a reactor handle if one is
   ///             available. This is typically only safe to call within a
@@ -295,6 +333,16 @@ class ReactorGLES {
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
   int32_t handles_to_collect_count_ IPLR_GUARDED_BY(handles_mutex_) = 0;
 
+  mutable Mutex shadow_states_mutex_;
+  mutable std::map<std::thread::id, ShadowStateGLES> shadow_states_
+      IPLR_GUARDED_BY(shadow_states_mutex_);
+
+  mutable Mutex frame_counts_mutex_;
+  mutable FrameCallCounts frame_end_counts_ IPLR_GUARDED_BY(
+      frame_counts_mutex_);
+  mutable FrameCallCounts last_frame_counts_ IPLR_GUARDED_BY(
+      frame_counts_mutex_);
+
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_ IPLR_GUARDED_BY(
       workers_mutex_);
@@ -323,6 +371,24 @@ class ReactorGLES {
                               HandleType type,
                               GLStorage handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Name all the handles of one type, with a single call where
+  ///             OpenGL allows it.
+  ///
+  static bool CreateGLHandles(const ProcTableGLES& gl,
+                              HandleType type,
+                              const std::vector<LiveHandle*>& handles);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Delete all the handles of one type, with a single call where
+  ///             OpenGL allows it.
+  ///
+  static void CollectGLHandles(const ProcTableGLES& gl,
+                               HandleType type,
+                               const std::vector<GLStorage>& handles);
+
+  uint64_t GetSkippedStateChangeCount() const;
+
   ReactorGLES(const ReactorGLES&) = delete;
 
   ReactorGLES& operator=(const ReactorGLES&) = delete;
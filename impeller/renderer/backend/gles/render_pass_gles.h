@@ -19,7 +19,7 @@ class RenderPassGLES final
   // |RenderPass|
   ~RenderPassGLES() override;
 
-  static void ResetGLState(const ProcTableGLES& gl);
+  static void ResetGLState(ShadowStateGLES& state);
 
  private:
   friend class CommandBufferGLES;
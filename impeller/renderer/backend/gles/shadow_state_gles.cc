@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
+
+namespace impeller {
+
+ShadowStateGLES::ShadowStateGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+ShadowStateGLES::~ShadowStateGLES() = default;
+
+void ShadowStateGLES::Invalidate() {
+  state_ = {};
+}
+
+std::optional<bool>* ShadowStateGLES::GetCapability(GLenum cap) {
+  switch (cap) {
+    case GL_BLEND:
+      return &state_.blend;
+    case GL_CULL_FACE:
+      return &state_.cull_face;
+    case GL_DEPTH_TEST:
+      return &state_.depth_test;
+    case GL_DITHER:
+      return &state_.dither;
+    case GL_SCISSOR_TEST:
+      return &state_.scissor_test;
+    case GL_STENCIL_TEST:
+      return &state_.stencil_test;
+  }
+  return nullptr;
+}
+
+void ShadowStateGLES::SetCapability(GLenum cap, bool enabled) {
+  std::optional<bool>* current = GetCapability(cap);
+  if (current && !Update(*current, enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(cap);
+  } else {
+    gl_.Disable(cap);
+  }
+}
+
+void ShadowStateGLES::Enable(GLenum cap) {
+  SetCapability(cap, true);
+}
+
+void ShadowStateGLES::Disable(GLenum cap) {
+  SetCapability(cap, false);
+}
+
+void ShadowStateGLES::BlendFuncSeparate(GLenum src_rgb,
+                                        GLenum dst_rgb,
+                                        GLenum src_alpha,
+                                        GLenum dst_alpha) {
+  if (Update(state_.blend_func,
+             std::make_tuple(src_rgb, dst_rgb, src_alpha, dst_alpha))) {
+    gl_.BlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+  }
+}
+
+void ShadowStateGLES::BlendEquationSeparate(GLenum mode_rgb,
+                                            GLenum mode_alpha) {
+  if (Update(state_.blend_equation, std::make_tuple(mode_rgb, mode_alpha))) {
+    gl_.BlendEquationSeparate(mode_rgb, mode_alpha);
+  }
+}
+
+void ShadowStateGLES::ColorMask(GLboolean red,
+                                GLboolean green,
+                                GLboolean blue,
+                                GLboolean alpha) {
+  if (Update(state_.color_mask, std::make_tuple(red, green, blue, alpha))) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void ShadowStateGLES::DepthFunc(GLenum func) {
+  if (Update(state_.depth_func, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void ShadowStateGLES::DepthMask(GLboolean flag) {
+  if (Update(state_.depth_mask, flag)) {
+    gl_.DepthMask(flag);
+  }
+}
+
+template <class T>
+bool ShadowStateGLES::UpdateStencil(GLenum face,
+                                    std::optional<T> StencilFace::*member,
+                                    const T& value) {
+  // A call for both faces is only skipped if neither face would change.
+  const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+  const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+  if ((!front || state_.stencil_front.*member == value) &&
+      (!back || state_.stencil_back.*member == value)) {
+    skipped_call_count_.fetch_add(1u, std::memory_order_relaxed);
+    return false;
+  }
+  if (front) {
+    state_.stencil_front.*member = value;
+  }
+  if (back) {
+    state_.stencil_back.*member = value;
+  }
+  return true;
+}
+
+void ShadowStateGLES::StencilOpSeparate(GLenum face,
+                                        GLenum stencil_fail,
+                                        GLenum depth_fail,
+                                        GLenum depth_pass) {
+  if (UpdateStencil(face, &StencilFace::op,
+                    std::make_tuple(stencil_fail, depth_fail, depth_pass))) {
+    gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_pass);
+  }
+}
+
+void ShadowStateGLES::StencilFuncSeparate(GLenum face,
+                                          GLenum func,
+                                          GLint ref,
+                                          GLuint mask) {
+  if (UpdateStencil(face, &StencilFace::func,
+                    std::make_tuple(func, ref, mask))) {
+    gl_.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void ShadowStateGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  if (UpdateStencil(face, &StencilFace::mask, mask)) {
+    gl_.StencilMaskSeparate(face, mask);
+  }
+}
+
+void ShadowStateGLES::Viewport(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  if (Update(state_.viewport, Rect{x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void ShadowStateGLES::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if (Update(state_.scissor, Rect{x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void ShadowStateGLES::CullFace(GLenum mode) {
+  if (Update(state_.cull_face_mode, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void ShadowStateGLES::FrontFace(GLenum mode) {
+  if (Update(state_.front_face, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void ShadowStateGLES::UseProgram(GLuint program) {
+  if (Update(state_.program, program)) {
+    gl_.UseProgram(program);
+  }
+}
+
+uint64_t ShadowStateGLES::GetSkippedCallCount() const {
+  return skipped_call_count_.load(std::memory_order_relaxed);
+}
+
+}  // namespace impeller
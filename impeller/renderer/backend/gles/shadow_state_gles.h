@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_SHADOW_STATE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_SHADOW_STATE_GLES_H_
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the fixed function state of the OpenGL context that
+///             is current on a thread.
+///
+///             Calls that would set the state to the value it already has are
+///             skipped. State that has not been set through the cache since
+///             the last call to `Invalidate` is unknown, and is always set.
+///
+///             Only the state that is set by the render and blit passes is
+///             tracked. All other calls must be made on the proc table.
+///
+class ShadowStateGLES {
+ public:
+  explicit ShadowStateGLES(const ProcTableGLES& gl);
+
+  ~ShadowStateGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget all state. This must be called whenever the state may
+  ///             have been changed without going through the cache, such as by
+  ///             the embedder between reactions.
+  ///
+  void Invalidate();
+
+  void Enable(GLenum cap);
+
+  void Disable(GLenum cap);
+
+  void BlendFuncSeparate(GLenum src_rgb,
+                         GLenum dst_rgb,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_rgb, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls that were skipped because they would not
+  ///             have changed the state. This may be read on any thread.
+  ///
+  uint64_t GetSkippedCallCount() const;
+
+ private:
+  using Rect = std::tuple<GLint, GLint, GLsizei, GLsizei>;
+
+  struct StencilFace {
+    std::optional<std::tuple<GLenum, GLenum, GLenum>> op;
+    std::optional<std::tuple<GLenum, GLint, GLuint>> func;
+    std::optional<GLuint> mask;
+  };
+
+  struct State {
+    std::optional<bool> blend;
+    std::optional<bool> cull_face;
+    std::optional<bool> depth_test;
+    std::optional<bool> dither;
+    std::optional<bool> scissor_test;
+    std::optional<bool> stencil_test;
+    std::optional<std::tuple<GLenum, GLenum, GLenum, GLenum>> blend_func;
+    std::optional<std::tuple<GLenum, GLenum>> blend_equation;
+    std::optional<std::tuple<GLboolean, GLboolean, GLboolean, GLboolean>>
+        color_mask;
+    std::optional<GLenum> depth_func;
+    std::optional<GLboolean> depth_mask;
+    StencilFace stencil_front;
+    StencilFace stencil_back;
+    std::optional<Rect> viewport;
+    std::optional<Rect> scissor;
+    std::optional<GLenum> cull_face_mode;
+    std::optional<GLenum> front_face;
+    std::optional<GLuint> program;
+  };
+
+  const ProcTableGLES& gl_;
+  State state_;
+  std::atomic<uint64_t> skipped_call_count_ = 0u;
+
+  std::optional<bool>* GetCapability(GLenum cap);
+
+  void SetCapability(GLenum cap, bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set `current` to `value`.
+  ///
+  /// @return     If the call that sets the state must be made. Otherwise, the
+  ///             call is counted as skipped.
+  ///
+  template <class T>
+  bool Update(std::optional<T>& current, const T& value) {
+    if (current.has_value() && current.value() == value) {
+      skipped_call_count_.fetch_add(1u, std::memory_order_relaxed);
+      return false;
+    }
+    current = value;
+    return true;
+  }
+
+  template <class T>
+  bool UpdateStencil(GLenum face,
+                     std::optional<T> StencilFace::*member,
+                     const T& value);
+
+  ShadowStateGLES(const ShadowStateGLES&) = delete;
+
+  ShadowStateGLES& operator=(const ShadowStateGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_SHADOW_STATE_GLES_H_
@@ -36,6 +36,8 @@ class IMockGLESImpl {
                                       GLuint64* result) {}
   virtual void DeleteQueriesEXT(GLsizei size, const GLuint* queries) {}
   virtual void GenBuffers(GLsizei n, GLuint* buffers) {}
+  virtual void Enable(GLenum cap) {}
+  virtual void Disable(GLenum cap) {}
 };
 
 class MockGLESImpl : public IMockGLESImpl {
@@ -70,6 +72,8 @@ class MockGLESImpl : public IMockGLESImpl {
               (GLsizei size, const GLuint* queries),
               (override));
   MOCK_METHOD(void, GenBuffers, (GLsizei n, GLuint* buffers), (override));
+  MOCK_METHOD(void, Enable, (GLenum cap), (override));
+  MOCK_METHOD(void, Disable, (GLenum cap), (override));
 };
 
 /// @brief      Provides a mocked version of the |ProcTableGLES| class.
@@ -33,5 +33,15 @@ TEST(ProcTableGLES, ResolvesCorrectClearDepthProcOnDesktopGL) {
   FOR_EACH_IMPELLER_ES_ONLY_PROC(EXPECT_UNAVAILABLE);
 }
 
+TEST(ProcTableGLES, CountsCalls) {
+  auto mock_gles = MockGLES::Init();
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  uint64_t call_count = gl.GetCallCount();
+  gl.Flush();
+  gl.Flush();
+  EXPECT_EQ(gl.GetCallCount(), call_count + 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
+
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "gmock/gmock.h"
@@ -11,6 +13,7 @@
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
 #include "impeller/renderer/backend/gles/test/mock_gles.h"
 
 namespace impeller {
@@ -26,6 +29,16 @@ class TestWorker : public ReactorGLES::Worker {
   }
 };
 
+class ToggledWorker : public ReactorGLES::Worker {
+ public:
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return can_react;
+  }
+
+  bool can_react = false;
+};
+
 TEST(ReactorGLES, CanAttachCleanupCallbacksToHandles) {
   auto mock_gles = MockGLES::Init();
   ProcTableGLES::Resolver resolver = kMockResolverGLES;
@@ -177,5 +190,88 @@ TEST(ReactorGLES, CanDeferOperations) {
   EXPECT_TRUE(did_run);
 }
 
+TEST(ReactorGLES, CreatesAndDeletesHandlesOfTheSameTypeTogether) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+
+  EXPECT_CALL(*mock_gles_impl, GenTextures(3, _))
+      .WillOnce([](GLsizei size, GLuint* textures) {
+        for (GLsizei i = 0; i < size; i++) {
+          textures[i] = 100u + i;
+        }
+      });
+  EXPECT_CALL(*mock_gles_impl, DeleteTextures(3, _))
+      .WillOnce([](GLsizei size, const GLuint* textures) {
+        EXPECT_THAT(std::vector<GLuint>(textures, textures + size),
+                    ::testing::UnorderedElementsAre(100u, 101u, 102u));
+      });
+
+  std::shared_ptr<MockGLES> mock_gles =
+      MockGLES::Init(std::move(mock_gles_impl));
+  ProcTableGLES::Resolver resolver = kMockResolverGLES;
+  auto proc_table = std::make_unique<ProcTableGLES>(resolver);
+  auto worker = std::make_shared<ToggledWorker>();
+  auto reactor = std::make_shared<ReactorGLES>(std::move(proc_table));
+  reactor->AddWorker(worker);
+
+  // The handles are created off the GL thread, so they are named by the next
+  // reaction.
+  std::vector<HandleGLES> handles;
+  for (int i = 0; i < 3; i++) {
+    handles.push_back(reactor->CreateHandle(HandleType::kTexture));
+  }
+  worker->can_react = true;
+  EXPECT_TRUE(reactor->AddOperation([&](const ReactorGLES& reactor_gles) {
+    for (const HandleGLES& handle : handles) {
+      EXPECT_TRUE(reactor_gles.GetGLHandle(handle).has_value());
+    }
+  }));
+
+  for (const HandleGLES& handle : handles) {
+    reactor->CollectHandle(handle);
+  }
+  EXPECT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+}
+
+TEST(ReactorGLES, CountsCallsPerFrame) {
+  auto mock_gles = MockGLES::Init();
+  ProcTableGLES::Resolver resolver = kMockResolverGLES;
+  auto proc_table = std::make_unique<ProcTableGLES>(resolver);
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = std::make_shared<ReactorGLES>(std::move(proc_table));
+  reactor->AddWorker(worker);
+
+  reactor->MarkFrameEnd();
+  EXPECT_TRUE(reactor->AddOperation([](const ReactorGLES& reactor_gles) {
+    ShadowStateGLES& state = reactor_gles.GetShadowState();
+    state.Enable(GL_BLEND);
+    state.Enable(GL_BLEND);
+    state.Enable(GL_BLEND);
+    reactor_gles.MarkFrameEnd();
+  }));
+
+  ReactorGLES::FrameCallCounts counts = reactor->GetLastFrameCallCounts();
+  EXPECT_EQ(counts.skipped_state_changes, 2u);
+  EXPECT_GE(counts.gl_calls, 1u);
+}
+
+TEST(ReactorGLES, InvalidatesShadowStateBeforeEachReaction) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(2);
+
+  std::shared_ptr<MockGLES> mock_gles =
+      MockGLES::Init(std::move(mock_gles_impl));
+  ProcTableGLES::Resolver resolver = kMockResolverGLES;
+  auto proc_table = std::make_unique<ProcTableGLES>(resolver);
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = std::make_shared<ReactorGLES>(std::move(proc_table));
+  reactor->AddWorker(worker);
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_TRUE(reactor->AddOperation([](const ReactorGLES& reactor_gles) {
+      reactor_gles.GetShadowState().Enable(GL_BLEND);
+    }));
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
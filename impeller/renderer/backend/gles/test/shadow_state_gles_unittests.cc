@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/shadow_state_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(ShadowStateGLES, SkipsRedundantStateChanges) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, Disable(GL_BLEND)).Times(1);
+
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  ShadowStateGLES state(mock_gles->GetProcTable());
+
+  state.Enable(GL_BLEND);
+  state.Enable(GL_BLEND);
+  state.Disable(GL_BLEND);
+  state.Disable(GL_BLEND);
+  EXPECT_EQ(state.GetSkippedCallCount(), 2u);
+}
+
+TEST(ShadowStateGLES, SetsUnknownStateAfterInvalidation) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Disable(GL_SCISSOR_TEST)).Times(2);
+
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  ShadowStateGLES state(mock_gles->GetProcTable());
+
+  state.Disable(GL_SCISSOR_TEST);
+  state.Invalidate();
+  state.Disable(GL_SCISSOR_TEST);
+  EXPECT_EQ(state.GetSkippedCallCount(), 0u);
+}
+
+TEST(ShadowStateGLES, SkipsStencilStateOnlyIfBothFacesMatch) {
+  auto mock_gles = MockGLES::Init();
+  ShadowStateGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  EXPECT_EQ(state.GetSkippedCallCount(), 0u);
+
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  EXPECT_EQ(state.GetSkippedCallCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
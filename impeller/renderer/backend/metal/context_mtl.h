@@ -136,6 +136,9 @@ class ContextMTL final : public Context,
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<GPUTracerMTL> GetGPUTracer() const;
 
+  // |Context|
+  std::optional<fml::TimeDelta> TakeGPUFrameTime() const override;
+
   const std::shared_ptr<ImpellerMetalCaptureManager> GetCaptureManager() const;
 #endif  // IMPELLER_DEBUG
 
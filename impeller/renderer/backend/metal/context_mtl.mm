@@ -327,6 +327,10 @@ void ContextMTL::Shutdown() {}
 std::shared_ptr<GPUTracerMTL> ContextMTL::GetGPUTracer() const {
   return gpu_tracer_;
 }
+
+std::optional<fml::TimeDelta> ContextMTL::TakeGPUFrameTime() const {
+  return gpu_tracer_->TakeLastFrameTime();
+}
 #endif  // IMPELLER_DEBUG
 
 std::shared_ptr<const fml::SyncSwitch> ContextMTL::GetIsGpuDisabledSyncSwitch()
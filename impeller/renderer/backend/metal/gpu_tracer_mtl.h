@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <optional>
+#include "fml/time/time_delta.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/scalar.h"
@@ -34,6 +35,10 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   ///        aggregate frame workload metric.
   void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
 
+  /// @brief Take the GPU time of the last frame workload that completed since
+  ///        the previous call, if any.
+  std::optional<fml::TimeDelta> TakeLastFrameTime();
+
  private:
   struct GPUTraceState {
     Scalar smallest_timestamp = std::numeric_limits<float>::max();
@@ -44,6 +49,8 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[16] IPLR_GUARDED_BY(trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  std::optional<fml::TimeDelta> last_frame_time_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
 };
 
 }  // namespace impeller
@@ -8,6 +8,7 @@
 #include "impeller/renderer/backend/metal/formats_mtl.h"
 
 #include <memory>
+#include <utility>
 
 #include "impeller/renderer/backend/metal/gpu_tracer_mtl.h"
 
@@ -48,9 +49,15 @@ void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
         FML_TRACE_COUNTER("flutter", "GPUTracer",
                           reinterpret_cast<int64_t>(this),  // Trace Counter ID
                           "FrameTimeMS", gpu_ms);
+        self->last_frame_time_ = fml::TimeDelta::FromMillisecondsF(gpu_ms);
       }
     }];
   }
 }
 
+std::optional<fml::TimeDelta> GPUTracerMTL::TakeLastFrameTime() {
+  Lock lock(trace_state_mutex_);
+  return std::exchange(last_frame_time_, std::nullopt);
+}
+
 }  // namespace impeller
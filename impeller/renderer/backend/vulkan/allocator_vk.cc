@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "flutter/fml/memory/ref_ptr.h"
@@ -250,6 +251,23 @@ static constexpr VmaMemoryUsage ToVMAMemoryUsage() {
   return VMA_MEMORY_USAGE_AUTO;
 }
 
+static constexpr VmaMemoryUsage ToVMATextureMemoryUsage(
+    StorageMode mode,
+    bool supports_memoryless_textures) {
+  switch (mode) {
+    case StorageMode::kHostVisible:
+    case StorageMode::kDevicePrivate:
+      return VMA_MEMORY_USAGE_AUTO;
+    case StorageMode::kDeviceTransient:
+      // Requiring lazily allocated memory, instead of only preferring it,
+      // keeps VMA from picking a device local type that is always backed.
+      return supports_memoryless_textures
+                 ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED
+                 : VMA_MEMORY_USAGE_AUTO;
+  }
+  FML_UNREACHABLE();
+}
+
 static constexpr vk::Flags<vk::MemoryPropertyFlagBits>
 ToVKTextureMemoryPropertyFlags(StorageMode mode,
                                bool supports_memoryless_textures) {
@@ -335,7 +353,8 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
     VmaAllocationCreateInfo alloc_nfo = {};
 
-    alloc_nfo.usage = ToVMAMemoryUsage();
+    alloc_nfo.usage = ToVMATextureMemoryUsage(desc.storage_mode,
+                                              supports_memoryless_textures);
     alloc_nfo.preferredFlags =
         static_cast<VkMemoryPropertyFlags>(ToVKTextureMemoryPropertyFlags(
             desc.storage_mode, supports_memoryless_textures));
@@ -355,6 +374,18 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                                                 &allocation,          //
                                                 &allocation_info      //
                                                 )};
+      if (result == vk::Result::eErrorFeatureNotPresent &&
+          alloc_nfo.usage == VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED) {
+        // None of the lazily allocated memory types can hold this image.
+        alloc_nfo.usage = ToVMAMemoryUsage();
+        result = vk::Result{::vmaCreateImage(allocator,            //
+                                             &create_info_native,  //
+                                             &alloc_nfo,           //
+                                             &vk_image,            //
+                                             &allocation,          //
+                                             &allocation_info      //
+                                             )};
+      }
       if (result != vk::Result::eSuccess) {
         VALIDATION_LOG << "Unable to allocate Vulkan Image: "
                        << vk::to_string(result)
@@ -549,15 +580,37 @@ Bytes AllocatorVK::DebugGetHeapUsage() const {
     const VmaBudget& budget = budgets[i];
     total_usage += budget.usage;
   }
+  // Like memoryless textures on Metal, lazily allocated memory is not backed
+  // until a render pass needs to spill the attachment, which the store ops of
+  // transient attachments avoid.
+  size_t lazily_allocated = DebugGetLazilyAllocatedUsage().GetByteSize();
+  total_usage -= std::min(total_usage, lazily_allocated);
   return Bytes{static_cast<double>(total_usage)};
 }
 
+Bytes AllocatorVK::DebugGetLazilyAllocatedUsage() const {
+  VmaTotalStatistics statistics = {};
+  vmaCalculateStatistics(allocator_.get(), &statistics);
+  size_t usage = 0;
+  for (auto i = 0u; i < memory_properties_.memoryTypeCount; i++) {
+    if (memory_properties_.memoryTypes[i].propertyFlags &
+        vk::MemoryPropertyFlagBits::eLazilyAllocated) {
+      usage += statistics.memoryType[i].statistics.blockBytes;
+    }
+  }
+  return Bytes{static_cast<double>(usage)};
+}
+
 void AllocatorVK::DebugTraceMemoryStatistics() const {
 #ifdef IMPELLER_DEBUG
   FML_TRACE_COUNTER("flutter", "AllocatorVK",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
                     "MemoryBudgetUsageMB",
-                    DebugGetHeapUsage().ConvertTo<MebiBytes>().GetSize());
+                    DebugGetHeapUsage().ConvertTo<MebiBytes>().GetSize(),
+                    "LazilyAllocatedMB",
+                    DebugGetLazilyAllocatedUsage()
+                        .ConvertTo<MebiBytes>()
+                        .GetSize());
 #endif  // IMPELLER_DEBUG
 }
 
@@ -24,6 +24,12 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   Bytes DebugGetHeapUsage() const override;
 
+  /// @brief The size of the lazily allocated memory of transient attachments.
+  ///
+  ///        This memory is not included in `DebugGetHeapUsage`, as it is only
+  ///        backed when the contents of an attachment have to be kept.
+  Bytes DebugGetLazilyAllocatedUsage() const;
+
   /// @brief Select a matching memory type for the given
   ///        [memory_type_bits_requirement], or -1 if none is found.
   ///
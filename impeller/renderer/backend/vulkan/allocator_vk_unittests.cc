@@ -8,6 +8,7 @@
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/texture_descriptor.h"
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -35,6 +36,70 @@ TEST(AllocatorVKTest, ToVKImageUsageFlags) {
                 vk::ImageUsageFlagBits::eTransientAttachment);
 }
 
+TEST(AllocatorVKTest, ToVKImageUsageFlagsWithoutMemorylessTextures) {
+  // Devices without lazily allocated memory, like SwiftShader, back transient
+  // attachments with device local memory.
+  EXPECT_EQ(AllocatorVK::ToVKImageUsageFlags(
+                PixelFormat::kD24UnormS8Uint,
+                static_cast<TextureUsageMask>(TextureUsage::kRenderTarget),
+                StorageMode::kDeviceTransient,
+                /*supports_memoryless_textures=*/false),
+            vk::ImageUsageFlagBits::eDepthStencilAttachment);
+}
+
+TEST(AllocatorVKTest, TransientTexturesWithoutLazilyAllocatedMemory) {
+  auto const context = MockVulkanContextBuilder().Build();
+  ASSERT_FALSE(context->GetCapabilities()->SupportsDeviceTransientTextures());
+  auto allocator = context->GetResourceAllocator();
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDeviceTransient;
+  desc.type = TextureType::kTexture2DMultisample;
+  desc.sample_count = SampleCount::kCount4;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {1024, 1024};
+  desc.usage = TextureUsage::kRenderTarget;
+  EXPECT_TRUE(allocator->CreateTexture(desc));
+
+  EXPECT_EQ(reinterpret_cast<AllocatorVK*>(allocator.get())
+                ->DebugGetLazilyAllocatedUsage()
+                .GetByteSize(),
+            0u);
+}
+
+TEST(AllocatorVKTest, TransientTexturesFallBackFromUnfitLazyMemory) {
+  // The mock images can only be bound to the first memory type, so the lazily
+  // allocated type added here cannot hold them.
+  auto const context =
+      MockVulkanContextBuilder()
+          .SetPhysicalDeviceMemoryPropertiesCallback(
+              [](VkPhysicalDevice device,
+                 VkPhysicalDeviceMemoryProperties* memory_properties) {
+                uint32_t index = memory_properties->memoryTypeCount++;
+                memory_properties->memoryTypes[index].heapIndex = 1;
+                memory_properties->memoryTypes[index].propertyFlags =
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                    VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+              })
+          .Build();
+  ASSERT_TRUE(context->GetCapabilities()->SupportsDeviceTransientTextures());
+  auto allocator = context->GetResourceAllocator();
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDeviceTransient;
+  desc.type = TextureType::kTexture2DMultisample;
+  desc.sample_count = SampleCount::kCount4;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {1024, 1024};
+  desc.usage = TextureUsage::kRenderTarget;
+  EXPECT_TRUE(allocator->CreateTexture(desc));
+
+  EXPECT_EQ(reinterpret_cast<AllocatorVK*>(allocator.get())
+                ->DebugGetLazilyAllocatedUsage()
+                .GetByteSize(),
+            0u);
+}
+
 TEST(AllocatorVKTest, MemoryTypeSelectionSingleHeap) {
   vk::PhysicalDeviceMemoryProperties properties;
   properties.memoryTypeCount = 1;
@@ -630,6 +630,13 @@ std::shared_ptr<GPUTracerVK> ContextVK::GetGPUTracer() const {
   return gpu_tracer_;
 }
 
+std::optional<fml::TimeDelta> ContextVK::TakeGPUFrameTime() const {
+  if (!gpu_tracer_) {
+    return std::nullopt;
+  }
+  return gpu_tracer_->TakeLastFrameTime();
+}
+
 std::shared_ptr<DescriptorPoolRecyclerVK> ContextVK::GetDescriptorPoolRecycler()
     const {
   return descriptor_pool_recycler_;
@@ -676,7 +683,9 @@ void ContextVK::InitializeCommonlyUsedShadersIfNeeded() const {
             attachment.texture->GetTextureDescriptor().format,        //
             attachment.texture->GetTextureDescriptor().sample_count,  //
             attachment.load_action,                                   //
-            attachment.store_action                                   //
+            attachment.store_action,                                  //
+            vk::ImageLayout::eUndefined,                              //
+            attachment.texture->GetTextureDescriptor().storage_mode   //
         );
         return true;
       });
@@ -686,7 +695,8 @@ void ContextVK::InitializeCommonlyUsedShadersIfNeeded() const {
         depth->texture->GetTextureDescriptor().format,        //
         depth->texture->GetTextureDescriptor().sample_count,  //
         depth->load_action,                                   //
-        depth->store_action                                   //
+        depth->store_action,                                  //
+        depth->texture->GetTextureDescriptor().storage_mode   //
     );
   } else if (auto stencil = render_target.GetStencilAttachment();
              stencil.has_value()) {
@@ -694,7 +704,8 @@ void ContextVK::InitializeCommonlyUsedShadersIfNeeded() const {
         stencil->texture->GetTextureDescriptor().format,        //
         stencil->texture->GetTextureDescriptor().sample_count,  //
         stencil->load_action,                                   //
-        stencil->store_action                                   //
+        stencil->store_action,                                  //
+        stencil->texture->GetTextureDescriptor().storage_mode   //
     );
   }
 
@@ -211,6 +211,9 @@ class ContextVK final : public Context,
 
   std::shared_ptr<GPUTracerVK> GetGPUTracer() const;
 
+  // |Context|
+  std::optional<fml::TimeDelta> TakeGPUFrameTime() const override;
+
   void RecordFrameEndTime() const;
 
   // |Context|
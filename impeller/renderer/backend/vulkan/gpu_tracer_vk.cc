@@ -72,6 +72,11 @@ bool GPUTracerVK::IsEnabled() const {
   return enabled_;
 }
 
+std::optional<fml::TimeDelta> GPUTracerVK::TakeLastFrameTime() {
+  Lock lock(trace_state_mutex_);
+  return std::exchange(last_frame_time_, std::nullopt);
+}
+
 void GPUTracerVK::MarkFrameStart() {
   if (!enabled_) {
     return;
@@ -208,6 +213,8 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
       FML_TRACE_COUNTER("flutter", "GPUTracer",
                         reinterpret_cast<int64_t>(this),  // Trace Counter ID
                         "FrameTimeMS", gpu_ms);
+      Lock lock(trace_state_mutex_);
+      last_frame_time_ = fml::TimeDelta::FromMillisecondsF(gpu_ms);
     }
 
     // Record this query to be reset the next time a command is recorded.
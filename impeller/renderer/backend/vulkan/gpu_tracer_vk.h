@@ -6,8 +6,11 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_GPU_TRACER_VK_H_
 
 #include <memory>
+#include <optional>
 #include <thread>
 
+#include "fml/time/time_delta.h"
+
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
 #include "vulkan/vulkan_handles.hpp"
@@ -45,6 +48,10 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   // visible for testing.
   bool IsEnabled() const;
 
+  /// @brief Take the GPU time of the last frame workload that completed since
+  ///        the previous call, if any.
+  std::optional<fml::TimeDelta> TakeLastFrameTime();
+
   /// Initialize the set of query pools.
   void InitializeQueryPool(const ContextVK& context);
 
@@ -79,6 +86,8 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
       trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
   std::vector<size_t> IPLR_GUARDED_BY(trace_state_mutex_) states_to_reset_ = {};
+  std::optional<fml::TimeDelta> last_frame_time_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
 
   // The number of nanoseconds for each timestamp unit.
   float timestamp_period_ = 1;
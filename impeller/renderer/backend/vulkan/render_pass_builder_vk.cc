@@ -22,6 +22,17 @@ constexpr auto kSelfDependencyDstAccessMask =
 
 constexpr auto kSelfDependencyFlags = vk::DependencyFlagBits::eByRegion;
 
+// The store op of an attachment that is not resolved into. Transient
+// attachments are discarded even if their store action asks to keep them, as
+// storing them would back their lazily allocated memory.
+static vk::AttachmentStoreOp ToVKAttachmentStoreOp(StoreAction store_action,
+                                                   StorageMode storage_mode) {
+  if (storage_mode == StorageMode::kDeviceTransient) {
+    return vk::AttachmentStoreOp::eDontCare;
+  }
+  return ToVKAttachmentStoreOp(store_action, /*is_resolve_texture=*/false);
+}
+
 RenderPassBuilderVK::RenderPassBuilderVK() = default;
 
 RenderPassBuilderVK::~RenderPassBuilderVK() = default;
@@ -32,12 +43,13 @@ RenderPassBuilderVK& RenderPassBuilderVK::SetColorAttachment(
     SampleCount sample_count,
     LoadAction load_action,
     StoreAction store_action,
-    vk::ImageLayout current_layout) {
+    vk::ImageLayout current_layout,
+    StorageMode storage_mode) {
   vk::AttachmentDescription desc;
   desc.format = ToVKImageFormat(format);
   desc.samples = ToVKSampleCount(sample_count);
   desc.loadOp = ToVKAttachmentLoadOp(load_action);
-  desc.storeOp = ToVKAttachmentStoreOp(store_action, false);
+  desc.storeOp = ToVKAttachmentStoreOp(store_action, storage_mode);
   desc.stencilLoadOp = vk::AttachmentLoadOp::eDontCare;
   desc.stencilStoreOp = vk::AttachmentStoreOp::eDontCare;
   if (load_action == LoadAction::kLoad) {
@@ -75,12 +87,13 @@ RenderPassBuilderVK& RenderPassBuilderVK::SetDepthStencilAttachment(
     PixelFormat format,
     SampleCount sample_count,
     LoadAction load_action,
-    StoreAction store_action) {
+    StoreAction store_action,
+    StorageMode storage_mode) {
   vk::AttachmentDescription desc;
   desc.format = ToVKImageFormat(format);
   desc.samples = ToVKSampleCount(sample_count);
   desc.loadOp = ToVKAttachmentLoadOp(load_action);
-  desc.storeOp = ToVKAttachmentStoreOp(store_action, false);
+  desc.storeOp = ToVKAttachmentStoreOp(store_action, storage_mode);
   desc.stencilLoadOp = desc.loadOp;    // Not separable in Impeller.
   desc.stencilStoreOp = desc.storeOp;  // Not separable in Impeller.
   desc.initialLayout = vk::ImageLayout::eUndefined;
@@ -93,14 +106,15 @@ RenderPassBuilderVK& RenderPassBuilderVK::SetStencilAttachment(
     PixelFormat format,
     SampleCount sample_count,
     LoadAction load_action,
-    StoreAction store_action) {
+    StoreAction store_action,
+    StorageMode storage_mode) {
   vk::AttachmentDescription desc;
   desc.format = ToVKImageFormat(format);
   desc.samples = ToVKSampleCount(sample_count);
   desc.loadOp = vk::AttachmentLoadOp::eDontCare;
   desc.storeOp = vk::AttachmentStoreOp::eDontCare;
   desc.stencilLoadOp = ToVKAttachmentLoadOp(load_action);
-  desc.stencilStoreOp = ToVKAttachmentStoreOp(store_action, false);
+  desc.stencilStoreOp = ToVKAttachmentStoreOp(store_action, storage_mode);
   desc.initialLayout = vk::ImageLayout::eUndefined;
   desc.finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
   depth_stencil_ = desc;
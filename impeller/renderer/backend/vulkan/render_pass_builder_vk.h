@@ -28,23 +28,32 @@ class RenderPassBuilderVK {
 
   RenderPassBuilderVK& operator=(const RenderPassBuilderVK&) = delete;
 
+  /// The contents of attachments with a `storage_mode` of
+  /// `StorageMode::kDeviceTransient` are never stored, so that their lazily
+  /// allocated memory does not have to be backed. Only the resolve of a
+  /// transient multisample attachment is stored.
   RenderPassBuilderVK& SetColorAttachment(
       size_t index,
       PixelFormat format,
       SampleCount sample_count,
       LoadAction load_action,
       StoreAction store_action,
-      vk::ImageLayout current_layout = vk::ImageLayout::eUndefined);
+      vk::ImageLayout current_layout = vk::ImageLayout::eUndefined,
+      StorageMode storage_mode = StorageMode::kDevicePrivate);
 
-  RenderPassBuilderVK& SetDepthStencilAttachment(PixelFormat format,
-                                                 SampleCount sample_count,
-                                                 LoadAction load_action,
-                                                 StoreAction store_action);
+  RenderPassBuilderVK& SetDepthStencilAttachment(
+      PixelFormat format,
+      SampleCount sample_count,
+      LoadAction load_action,
+      StoreAction store_action,
+      StorageMode storage_mode = StorageMode::kDevicePrivate);
 
-  RenderPassBuilderVK& SetStencilAttachment(PixelFormat format,
-                                            SampleCount sample_count,
-                                            LoadAction load_action,
-                                            StoreAction store_action);
+  RenderPassBuilderVK& SetStencilAttachment(
+      PixelFormat format,
+      SampleCount sample_count,
+      LoadAction load_action,
+      StoreAction store_action,
+      StorageMode storage_mode = StorageMode::kDevicePrivate);
 
   vk::UniqueRenderPass Build(const vk::Device& device) const;
 
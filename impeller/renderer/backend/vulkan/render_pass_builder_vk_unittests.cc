@@ -170,5 +170,41 @@ TEST(RenderPassBuilder, CreatesMSAAResolveWithCorrectStore) {
   EXPECT_EQ(resolve.storeOp, vk::AttachmentStoreOp::eStore);
 }
 
+TEST(RenderPassBuilder, DiscardsTransientAttachments) {
+  RenderPassBuilderVK builder = RenderPassBuilderVK();
+  auto const context = MockVulkanContextBuilder().Build();
+
+  // A transient MSAA color attachment whose store action asks to keep it,
+  // with a transient depth stencil attachment.
+  builder.SetColorAttachment(0, PixelFormat::kR8G8B8A8UNormInt,
+                             SampleCount::kCount4, LoadAction::kClear,
+                             StoreAction::kStoreAndMultisampleResolve,
+                             vk::ImageLayout::eUndefined,
+                             StorageMode::kDeviceTransient);
+  builder.SetDepthStencilAttachment(
+      PixelFormat::kD24UnormS8Uint, SampleCount::kCount4, LoadAction::kClear,
+      StoreAction::kStore, StorageMode::kDeviceTransient);
+
+  auto render_pass = builder.Build(context->GetDevice());
+
+  EXPECT_TRUE(!!render_pass);
+
+  std::optional<vk::AttachmentDescription> color = builder.GetColor0();
+  ASSERT_TRUE(color.has_value());
+  EXPECT_EQ(color->storeOp, vk::AttachmentStoreOp::eDontCare);
+
+  // Only the resolve is stored.
+  std::optional<vk::AttachmentDescription> resolve =
+      builder.GetColor0Resolve();
+  ASSERT_TRUE(resolve.has_value());
+  EXPECT_EQ(resolve->storeOp, vk::AttachmentStoreOp::eStore);
+
+  std::optional<vk::AttachmentDescription> depth_stencil =
+      builder.GetDepthStencil();
+  ASSERT_TRUE(depth_stencil.has_value());
+  EXPECT_EQ(depth_stencil->storeOp, vk::AttachmentStoreOp::eDontCare);
+  EXPECT_EQ(depth_stencil->stencilStoreOp, vk::AttachmentStoreOp::eDontCare);
+}
+
 }  // namespace testing
 }  // namespace impeller
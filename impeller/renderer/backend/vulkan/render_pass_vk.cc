@@ -92,7 +92,8 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
             attachment.texture->GetTextureDescriptor().sample_count,  //
             attachment.load_action,                                   //
             attachment.store_action,                                  //
-            TextureVK::Cast(*attachment.texture).GetLayout()          //
+            TextureVK::Cast(*attachment.texture).GetLayout(),         //
+            attachment.texture->GetTextureDescriptor().storage_mode   //
         );
         TextureVK::Cast(*attachment.texture)
             .SetLayoutWithoutEncoding(vk::ImageLayout::eGeneral);
@@ -108,7 +109,8 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         depth->texture->GetTextureDescriptor().format,        //
         depth->texture->GetTextureDescriptor().sample_count,  //
         depth->load_action,                                   //
-        depth->store_action                                   //
+        depth->store_action,                                  //
+        depth->texture->GetTextureDescriptor().storage_mode   //
     );
   } else if (auto stencil = render_target_.GetStencilAttachment();
              stencil.has_value()) {
@@ -116,7 +118,8 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         stencil->texture->GetTextureDescriptor().format,        //
         stencil->texture->GetTextureDescriptor().sample_count,  //
         stencil->load_action,                                   //
-        stencil->store_action                                   //
+        stencil->store_action,                                  //
+        stencil->texture->GetTextureDescriptor().storage_mode   //
     );
   }
 
@@ -77,6 +77,10 @@ TEST(GPUTracerVK, CanTraceCmdBuffer) {
               called->end());
   ASSERT_TRUE(std::find(called->begin(), called->end(),
                         "vkGetQueryPoolResults") != called->end());
+
+  // The frame time is only taken once.
+  EXPECT_TRUE(context->TakeGPUFrameTime().has_value());
+  EXPECT_FALSE(context->TakeGPUFrameTime().has_value());
 }
 
 TEST(GPUTracerVK, DoesNotTraceOutsideOfFrameWorkload) {
@@ -110,6 +114,7 @@ TEST(GPUTracerVK, DoesNotTraceOutsideOfFrameWorkload) {
   ASSERT_NE(called, nullptr);
   ASSERT_TRUE(std::find(called->begin(), called->end(),
                         "vkGetQueryPoolResults") == called->end());
+  EXPECT_FALSE(context->TakeGPUFrameTime().has_value());
 }
 
 // This cmd buffer starts when there is a frame but finishes when there is none.
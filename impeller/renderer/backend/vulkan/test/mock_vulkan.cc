@@ -227,6 +227,11 @@ VkResult vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo,
   return VK_SUCCESS;
 }
 
+static thread_local std::function<void(
+    VkPhysicalDevice physicalDevice,
+    VkPhysicalDeviceMemoryProperties* pMemoryProperties)>
+    g_memory_properties_callback;
+
 void vkGetPhysicalDeviceMemoryProperties(
     VkPhysicalDevice physicalDevice,
     VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
@@ -244,6 +249,9 @@ void vkGetPhysicalDeviceMemoryProperties(
   pMemoryProperties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
   pMemoryProperties->memoryHeaps[1].size = 1024 * 1024 * 1024;
   pMemoryProperties->memoryHeaps[1].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+  if (g_memory_properties_callback) {
+    g_memory_properties_callback(physicalDevice, pMemoryProperties);
+  }
 }
 
 VkResult vkCreatePipelineCache(VkDevice device,
@@ -939,6 +947,7 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
   g_instance_layers = instance_layers_;
   g_format_properties_callback = format_properties_callback_;
   g_physical_device_properties_callback = physical_properties_callback_;
+  g_memory_properties_callback = memory_properties_callback_;
   settings.embedder_data = embedder_data_;
   std::shared_ptr<ContextVK> result = ContextVK::Create(std::move(settings));
   return result;
@@ -108,6 +108,16 @@ class MockVulkanContextBuilder {
     return *this;
   }
 
+  /// Modify the memory types and heaps reported by
+  /// vkGetPhysicalDeviceMemoryProperties after the defaults are set.
+  MockVulkanContextBuilder& SetPhysicalDeviceMemoryPropertiesCallback(
+      std::function<void(VkPhysicalDevice device,
+                         VkPhysicalDeviceMemoryProperties* memoryProperties)>
+          memory_properties_callback) {
+    memory_properties_callback_ = std::move(memory_properties_callback);
+    return *this;
+  }
+
   MockVulkanContextBuilder SetEmbedderData(
       const ContextVK::EmbedderData& embedder_data) {
     embedder_data_ = embedder_data;
@@ -126,6 +136,9 @@ class MockVulkanContextBuilder {
   std::function<void(VkPhysicalDevice device,
                      VkPhysicalDeviceProperties* physicalProperties)>
       physical_properties_callback_;
+  std::function<void(VkPhysicalDevice device,
+                     VkPhysicalDeviceMemoryProperties* memoryProperties)>
+      memory_properties_callback_;
 };
 
 /// @brief Override the image size returned by all swapchain images.
@@ -29,6 +29,10 @@ std::shared_ptr<const IdleWaiter> Context::GetIdleWaiter() const {
   return nullptr;
 }
 
+std::optional<fml::TimeDelta> Context::TakeGPUFrameTime() const {
+  return std::nullopt;
+}
+
 void Context::ResetThreadLocalState() const {
   // Nothing to do.
 }
@@ -6,9 +6,11 @@
 #define FLUTTER_IMPELLER_RENDERER_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "fml/closure.h"
+#include "fml/time/time_delta.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
@@ -226,6 +228,17 @@ class Context {
 
   virtual std::shared_ptr<const IdleWaiter> GetIdleWaiter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the GPU execution time of the last frame workload that
+  ///             completed since the previous call, as measured by the GPU
+  ///             tracer of the backend.
+  ///
+  /// @return     The GPU time of the frame, or std::nullopt if no frame
+  ///             completed since the previous call or if the backend has no
+  ///             enabled GPU tracer.
+  ///
+  virtual std::optional<fml::TimeDelta> TakeGPUFrameTime() const;
+
   //----------------------------------------------------------------------------
   /// Resets any thread local state that may interfere with embedders.
   ///
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_H_
 #define FLUTTER_IMPELLER_RENDERER_PIPELINE_H_
 
+#include <chrono>
 #include <future>
 
 #include "compute_pipeline_descriptor.h"
@@ -30,6 +31,13 @@ struct PipelineFuture {
   const std::shared_ptr<Pipeline<T>> Get() const { return future.get(); }
 
   bool IsValid() const { return future.valid(); }
+
+  /// Whether `Get` would return without waiting for the pipeline to be
+  /// created.
+  bool IsReady() const {
+    return future.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -137,6 +145,13 @@ class RenderPipelineHandle {
     return pipeline_;
   }
 
+  /// Whether `WaitAndGet` would return without waiting for the pipeline to be
+  /// created.
+  bool IsReady() const {
+    return did_wait_ || !pipeline_future_.IsValid() ||
+           pipeline_future_.IsReady();
+  }
+
   std::optional<PipelineDescriptor> GetDescriptor() const {
     return pipeline_future_.descriptor;
   }
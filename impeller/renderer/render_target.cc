@@ -315,6 +315,10 @@ RenderTargetAllocator::RenderTargetAllocator(
     std::shared_ptr<Allocator> allocator)
     : allocator_(std::move(allocator)) {}
 
+ISize RenderTargetAllocator::GetPooledSize(ISize size) const {
+  return size;
+}
+
 void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
@@ -177,6 +177,15 @@ class RenderTargetAllocator {
       const std::shared_ptr<Texture>& existing_color_resolve_texture = nullptr,
       const std::shared_ptr<Texture>& existing_depth_stencil_texture = nullptr);
 
+  /// @brief Get the size of the render target to allocate for contents of the
+  ///        given size.
+  ///
+  ///        Allocators that pool render targets may round the size up so that
+  ///        contents of similar sizes share render targets. Callers that use
+  ///        the larger size must only render into, and read back, the
+  ///        sub-rectangle of the requested size at the origin.
+  virtual ISize GetPooledSize(ISize size) const;
+
   /// @brief Mark the beginning of a frame workload.
   ///
   ///       This may be used to reset any tracking state on whether or not a
@@ -172,6 +172,10 @@ const std::shared_ptr<fml::Mapping>& RuntimeStage::GetCodeMapping() const {
   return code_mapping_;
 }
 
+const std::shared_ptr<fml::Mapping>& RuntimeStage::GetPayload() const {
+  return payload_;
+}
+
 const std::vector<RuntimeUniformDescription>& RuntimeStage::GetUniforms()
     const {
   return uniforms_;
@@ -44,6 +44,10 @@ class RuntimeStage {
 
   const std::shared_ptr<fml::Mapping>& GetCodeMapping() const;
 
+  /// The data that this stage was decoded from along with the stages of the
+  /// other backends, see |DecodeRuntimeStages|.
+  const std::shared_ptr<fml::Mapping>& GetPayload() const;
+
   bool IsDirty() const;
 
   void SetClean();
@@ -243,7 +243,7 @@ static int kPrecomputedDivisions[kPrecomputedDivisionCount] = {
     // clang-format on
 };
 
-static size_t ComputeQuadrantDivisions(Scalar pixel_radius) {
+size_t Tessellator::ComputeQuadrantDivisions(Scalar pixel_radius) {
   if (pixel_radius <= 0.0) {
     return 1;
   }
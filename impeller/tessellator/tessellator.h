@@ -237,6 +237,11 @@ class Tessellator {
   ///          true circle by more than this tolerance.
   static constexpr Scalar kCircleTolerance = 0.1f;
 
+  /// @brief   The number of divisions of a quarter circle with the given
+  ///          radius in pixels, so that its polygon stays within
+  ///          |kCircleTolerance| of the true circle.
+  static size_t ComputeQuadrantDivisions(Scalar pixel_radius);
+
   /// @brief   Create a |VertexGenerator| that can produce vertices for
   ///          a filled circle of the given radius around the given center
   ///          with enough polygon sub-divisions to provide reasonable
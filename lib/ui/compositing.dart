@@ -945,3 +945,278 @@ base class _NativeSceneBuilder extends NativeFieldWrapperClass1 implements Scene
   @override
   String toString() => 'SceneBuilder';
 }
+
+/// Builds [Scene]s from a compact description that is handed to the engine in
+/// a single call.
+///
+/// Each method of a [SceneBuilder] crosses from Dart into the engine, and each
+/// push also allocates an [EngineLayer] wrapper. For scenes with hundreds of
+/// layers, a [SceneCommandBuffer] records the same operations into a buffer
+/// instead, which [build] decodes into the layer tree in one call.
+///
+/// The push methods return integer layer ids instead of [EngineLayer]s. The
+/// ids of the layers of the last built scene can be passed as `oldLayer` to
+/// the push methods or to [addRetained] while describing the next scene. A
+/// retained layer keeps its id, and the ids of its descendants, for the scene
+/// after that. Like an [EngineLayer], each id may only be used once per scene.
+///
+/// A buffer is meant to be kept for the lifetime of the view it builds scenes
+/// for, and should be disposed afterwards to release the retained layers.
+///
+/// Only the layer types that make up the bulk of typical scenes are
+/// supported; scenes that need filters, shader masks, or path clips should be
+/// built with a [SceneBuilder].
+final class SceneCommandBuffer {
+  /// Creates a buffer with no retained layers.
+  SceneCommandBuffer() : _table = _SceneLayerTable();
+
+  // Op codes of the records, must be kept in sync with
+  // lib/ui/compositing/scene_layer_table.h.
+  static const int _kPushTransform = 0;
+  static const int _kPushOffset = 1;
+  static const int _kPushClipRect = 2;
+  static const int _kPushClipRRect = 3;
+  static const int _kPushOpacity = 4;
+  static const int _kPop = 5;
+  static const int _kAddRetained = 6;
+  static const int _kAddPicture = 7;
+  static const int _kAddTexture = 8;
+  static const int _kAddPlatformView = 9;
+
+  static const int _kInitialByteCount = 1024;
+
+  final _SceneLayerTable _table;
+
+  ByteData _data = ByteData(_kInitialByteCount);
+  int _byteCount = 0;
+  final List<_NativePicture> _pictures = <_NativePicture>[];
+
+  // Layer ids are 32-bit on the engine side, 0 meaning no layer.
+  int _nextLayerId = 1;
+
+  bool _disposed = false;
+
+  /// Whether this buffer has been disposed.
+  ///
+  /// This is only available when asserts are enabled, and will throw an
+  /// exception otherwise.
+  bool get debugDisposed {
+    bool? disposed;
+    assert(() {
+      disposed = _disposed;
+      return true;
+    }());
+    return disposed ?? (throw StateError('debugDisposed is only available when asserts are enabled.'));
+  }
+
+  /// Records a [SceneBuilder.pushTransform] and returns the id of the layer.
+  int pushTransform(Float64List matrix4, {int? oldLayer}) {
+    assert(_matrix4IsValid(matrix4));
+    final int id = _beginPush(_kPushTransform, 16, oldLayer);
+    for (int i = 0; i < 16; i++) {
+      _writeFloat(matrix4[i]);
+    }
+    return id;
+  }
+
+  /// Records a [SceneBuilder.pushOffset] and returns the id of the layer.
+  int pushOffset(double dx, double dy, {int? oldLayer}) {
+    final int id = _beginPush(_kPushOffset, 2, oldLayer);
+    _writeFloat(dx);
+    _writeFloat(dy);
+    return id;
+  }
+
+  /// Records a [SceneBuilder.pushClipRect] and returns the id of the layer.
+  int pushClipRect(Rect rect, {Clip clipBehavior = Clip.antiAlias, int? oldLayer}) {
+    assert(clipBehavior != Clip.none);
+    final int id = _beginPush(_kPushClipRect, 5, oldLayer);
+    _writeFloat(rect.left);
+    _writeFloat(rect.top);
+    _writeFloat(rect.right);
+    _writeFloat(rect.bottom);
+    _writeUint(clipBehavior.index);
+    return id;
+  }
+
+  /// Records a [SceneBuilder.pushClipRRect] and returns the id of the layer.
+  int pushClipRRect(RRect rrect, {Clip clipBehavior = Clip.antiAlias, int? oldLayer}) {
+    assert(clipBehavior != Clip.none);
+    final int id = _beginPush(_kPushClipRRect, 13, oldLayer);
+    _writeFloat(rrect.left);
+    _writeFloat(rrect.top);
+    _writeFloat(rrect.right);
+    _writeFloat(rrect.bottom);
+    _writeFloat(rrect.tlRadiusX);
+    _writeFloat(rrect.tlRadiusY);
+    _writeFloat(rrect.trRadiusX);
+    _writeFloat(rrect.trRadiusY);
+    _writeFloat(rrect.brRadiusX);
+    _writeFloat(rrect.brRadiusY);
+    _writeFloat(rrect.blRadiusX);
+    _writeFloat(rrect.blRadiusY);
+    _writeUint(clipBehavior.index);
+    return id;
+  }
+
+  /// Records a [SceneBuilder.pushOpacity] and returns the id of the layer.
+  int pushOpacity(int alpha, {Offset offset = Offset.zero, int? oldLayer}) {
+    final int id = _beginPush(_kPushOpacity, 3, oldLayer);
+    _writeUint(alpha & 0xFF);
+    _writeFloat(offset.dx);
+    _writeFloat(offset.dy);
+    return id;
+  }
+
+  /// Records a [SceneBuilder.pop].
+  void pop() {
+    _begin(_kPop, 0);
+  }
+
+  /// Adds the layer with the given id, which must have been part of the last
+  /// built scene, and its subtree to the scene.
+  ///
+  /// See [SceneBuilder.addRetained].
+  void addRetained(int layer) {
+    assert(layer > 0 && layer < _nextLayerId);
+    _begin(_kAddRetained, 1);
+    _writeUint(layer);
+  }
+
+  /// Records a [SceneBuilder.addPicture].
+  void addPicture(
+    Offset offset,
+    Picture picture, {
+    bool isComplexHint = false,
+    bool willChangeHint = false,
+  }) {
+    assert(!picture.debugDisposed);
+    _pictures.add(picture as _NativePicture);
+    _begin(_kAddPicture, 4);
+    _writeUint(_pictures.length - 1);
+    _writeFloat(offset.dx);
+    _writeFloat(offset.dy);
+    _writeUint((isComplexHint ? 1 : 0) | (willChangeHint ? 2 : 0));
+  }
+
+  /// Records a [SceneBuilder.addTexture].
+  void addTexture(
+    int textureId, {
+    Offset offset = Offset.zero,
+    double width = 0.0,
+    double height = 0.0,
+    bool freeze = false,
+    FilterQuality filterQuality = FilterQuality.low,
+  }) {
+    _begin(_kAddTexture, 8);
+    _writeFloat(offset.dx);
+    _writeFloat(offset.dy);
+    _writeFloat(width);
+    _writeFloat(height);
+    _writeInt64(textureId);
+    _writeUint(freeze ? 1 : 0);
+    _writeUint(filterQuality.index);
+  }
+
+  /// Records a [SceneBuilder.addPlatformView].
+  void addPlatformView(
+    int viewId, {
+    Offset offset = Offset.zero,
+    double width = 0.0,
+    double height = 0.0,
+  }) {
+    _begin(_kAddPlatformView, 6);
+    _writeFloat(offset.dx);
+    _writeFloat(offset.dy);
+    _writeFloat(width);
+    _writeFloat(height);
+    _writeInt64(viewId);
+  }
+
+  /// Builds a [Scene] from the recorded operations and clears the buffer for
+  /// the next scene.
+  ///
+  /// The layers of the new scene replace the retained layers of the previous
+  /// one, except for those added with [addRetained].
+  ///
+  /// Throws a [StateError] if the recording refers to layers that are not
+  /// available, or uses a layer more than once. In that case no scene is built, the buffer is still cleared,
+  /// and the layers of the previous scene remain available.
+  Scene build() {
+    assert(!_disposed);
+    final Scene scene = _NativeScene._();
+    final String? error = _table._build(scene, _pictures, _data, _byteCount);
+    _byteCount = 0;
+    _pictures.clear();
+    if (error != null) {
+      throw StateError(error);
+    }
+    return scene;
+  }
+
+  /// Releases the layers retained for the next scene.
+  ///
+  /// After calling this function, the buffer cannot be used further.
+  void dispose() {
+    assert(!_disposed);
+    assert(() {
+      _disposed = true;
+      return true;
+    }());
+    _table._dispose();
+  }
+
+  int _beginPush(int op, int argumentCount, int? oldLayer) {
+    final int id = _nextLayerId;
+    _nextLayerId = _nextLayerId == 0xFFFFFFFF ? 1 : _nextLayerId + 1;
+    _begin(op, argumentCount + 2);
+    _writeUint(id);
+    _writeUint(oldLayer ?? 0);
+    return id;
+  }
+
+  void _begin(int op, int argumentCount) {
+    assert(!_disposed);
+    final int requiredByteCount = _byteCount + (argumentCount + 1) * 4;
+    if (requiredByteCount > _data.lengthInBytes) {
+      int newByteCount = _data.lengthInBytes * 2;
+      while (newByteCount < requiredByteCount) {
+        newByteCount *= 2;
+      }
+      final ByteData newData = ByteData(newByteCount);
+      newData.buffer.asUint8List().setRange(0, _byteCount, _data.buffer.asUint8List());
+      _data = newData;
+    }
+    _writeUint(op);
+  }
+
+  void _writeUint(int value) {
+    _data.setUint32(_byteCount, value, _kFakeHostEndian);
+    _byteCount += 4;
+  }
+
+  void _writeInt64(int value) {
+    _writeUint(value & 0xFFFFFFFF);
+    _writeUint((value >> 32) & 0xFFFFFFFF);
+  }
+
+  void _writeFloat(double value) {
+    _data.setFloat32(_byteCount, value, _kFakeHostEndian);
+    _byteCount += 4;
+  }
+}
+
+base class _SceneLayerTable extends NativeFieldWrapperClass1 {
+  _SceneLayerTable() {
+    _constructor();
+  }
+
+  @Native<Void Function(Handle)>(symbol: 'SceneLayerTable::Create')
+  external void _constructor();
+
+  @Native<Handle Function(Pointer<Void>, Handle, Handle, Handle, Int32)>(symbol: 'SceneLayerTable::build')
+  external String? _build(Scene outScene, List<_NativePicture> pictures, ByteData commands, int byteCount);
+
+  @Native<Void Function(Pointer<Void>)>(symbol: 'SceneLayerTable::dispose')
+  external void _dispose();
+}
@@ -0,0 +1,371 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/compositing/scene_layer_table.h"
+
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/lib/ui/compositing/scene.h"
+#include "flutter/lib/ui/painting/image_filter.h"
+#include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
+
+namespace flutter {
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, SceneLayerTable);
+
+namespace {
+
+// The number of 32-bit arguments of each command, indexed by op code.
+constexpr size_t kArgumentCounts[] = {
+    18,  // kPushTransform
+    4,   // kPushOffset
+    7,   // kPushClipRect
+    15,  // kPushClipRRect
+    5,   // kPushOpacity
+    0,   // kPop
+    1,   // kAddRetained
+    4,   // kAddPicture
+    8,   // kAddTexture
+    6,   // kAddPlatformView
+};
+static_assert(std::size(kArgumentCounts) ==
+                  static_cast<size_t>(SceneCommand::kLastCommand) + 1,
+              "Every command must have an argument count.");
+
+// Reads the 32-bit words of the records. Callers check |Remaining| before
+// reading the arguments of a record.
+class SceneCommandReader {
+ public:
+  SceneCommandReader(const uint8_t* data, size_t size)
+      : data_(data), word_count_(size / sizeof(uint32_t)) {}
+
+  size_t Remaining() const { return word_count_ - position_; }
+
+  uint32_t ReadUint() {
+    FML_DCHECK(position_ < word_count_);
+    uint32_t value;
+    memcpy(&value, data_ + position_ * sizeof(uint32_t), sizeof(value));
+    position_++;
+    return value;
+  }
+
+  int64_t ReadInt64() {
+    uint64_t low = ReadUint();
+    uint64_t high = ReadUint();
+    return static_cast<int64_t>(low | (high << 32));
+  }
+
+  float ReadFloat() {
+    uint32_t bits = ReadUint();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  DlPoint ReadPoint() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    return DlPoint(x, y);
+  }
+
+  DlSize ReadSize() {
+    float width = ReadFloat();
+    float height = ReadFloat();
+    return DlSize(width, height);
+  }
+
+  DlRect ReadRect() {
+    float left = ReadFloat();
+    float top = ReadFloat();
+    float right = ReadFloat();
+    float bottom = ReadFloat();
+    return DlRect::MakeLTRB(left, top, right, bottom);
+  }
+
+ private:
+  const uint8_t* data_;
+  const size_t word_count_;
+  size_t position_ = 0;
+};
+
+bool IsValidClip(uint32_t clip_behavior) {
+  return clip_behavior > static_cast<uint32_t>(Clip::kNone) &&
+         clip_behavior <= static_cast<uint32_t>(Clip::kAntiAliasWithSaveLayer);
+}
+
+}  // namespace
+
+void SceneLayerTable::Create(Dart_Handle wrapper) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto res = fml::MakeRefCounted<SceneLayerTable>();
+  res->AssociateWithDartWrapper(wrapper);
+}
+
+SceneLayerTable::SceneLayerTable() = default;
+
+SceneLayerTable::~SceneLayerTable() = default;
+
+Dart_Handle SceneLayerTable::build(Dart_Handle scene_handle,
+                                   Dart_Handle pictures,
+                                   Dart_Handle commands,
+                                   int byte_count) {
+  // Unwrap the pictures before acquiring the command data, the VM cannot be
+  // re-entered while the typed data is acquired.
+  intptr_t picture_count = 0;
+  Dart_ListLength(pictures, &picture_count);
+  std::vector<sk_sp<DisplayList>> display_lists;
+  display_lists.reserve(picture_count);
+  for (intptr_t i = 0; i < picture_count; i++) {
+    Picture* picture =
+        tonic::DartConverter<Picture*>::FromDart(Dart_ListGetAt(pictures, i));
+    // A disposed picture is skipped, as SceneBuilder::addPicture does.
+    display_lists.push_back(picture ? picture->display_list() : nullptr);
+  }
+
+  auto root = std::make_shared<ContainerLayer>();
+  LayerMap next_layers;
+  const char* error;
+  {
+    tonic::DartByteData data(commands);
+    if (byte_count < 0 ||
+        static_cast<size_t>(byte_count) > data.length_in_bytes()) {
+      error = "SceneCommandBuffer.build called with an invalid byte count.";
+    } else {
+      error = Decode(static_cast<const uint8_t*>(data.data()), byte_count,
+                     display_lists, root, next_layers);
+    }
+  }
+  if (error) {
+    return tonic::ToDart(error);
+  }
+
+  layers_ = std::move(next_layers);
+  Scene::create(scene_handle, std::move(root));
+  return Dart_Null();
+}
+
+void SceneLayerTable::dispose() {
+  layers_.clear();
+  ClearDartWrapper();
+}
+
+const char* SceneLayerTable::Decode(
+    const uint8_t* data,
+    size_t size,
+    const std::vector<sk_sp<DisplayList>>& pictures,
+    const std::shared_ptr<ContainerLayer>& root,
+    LayerMap& next_layers) {
+  if (size % sizeof(uint32_t) != 0) {
+    return "The scene command buffer is not a multiple of 4 bytes.";
+  }
+
+  // The ids of the pushed layers, the root having id 0.
+  std::vector<std::pair<uint32_t, ContainerLayer*>> stack = {{0, root.get()}};
+  auto add_layer = [&stack, &next_layers](uint32_t id,
+                                          std::shared_ptr<Layer> layer) {
+    auto [parent_id, parent] = stack.back();
+    if (parent_id != 0 && id != 0) {
+      next_layers[parent_id].children.push_back(id);
+    }
+    parent->Add(std::move(layer));
+  };
+  // Returns false if the id is invalid or was already used in this scene.
+  auto push_layer = [this, &stack, &next_layers, &add_layer](
+                        uint32_t id, uint32_t old_id,
+                        const std::shared_ptr<ContainerLayer>& layer) {
+    if (id == 0 || next_layers.find(id) != next_layers.end()) {
+      return false;
+    }
+    auto old_layer = layers_.find(old_id);
+    if (old_layer != layers_.end()) {
+      layer->AssignOldLayer(old_layer->second.layer.get());
+    }
+    add_layer(id, layer);
+    next_layers[id].layer = layer;
+    stack.emplace_back(id, layer.get());
+    return true;
+  };
+
+  SceneCommandReader reader(data, size);
+  while (reader.Remaining() > 0) {
+    uint32_t op = reader.ReadUint();
+    if (op > static_cast<uint32_t>(SceneCommand::kLastCommand)) {
+      return "The scene command buffer contains an unknown command.";
+    }
+    if (reader.Remaining() < kArgumentCounts[op]) {
+      return "The scene command buffer ends in the middle of a command.";
+    }
+    switch (static_cast<SceneCommand>(op)) {
+      case SceneCommand::kPushTransform: {
+        uint32_t id = reader.ReadUint();
+        uint32_t old_id = reader.ReadUint();
+        float m[16];
+        for (float& value : m) {
+          value = reader.ReadFloat();
+        }
+        // clang-format off
+        DlMatrix matrix = DlMatrix::MakeColumn(
+            m[ 0], m[ 1], m[ 2], m[ 3],
+            m[ 4], m[ 5], m[ 6], m[ 7],
+            m[ 8], m[ 9], m[10], m[11],
+            m[12], m[13], m[14], m[15]);
+        // clang-format on
+        if (!push_layer(id, old_id, std::make_shared<TransformLayer>(matrix))) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kPushOffset: {
+        uint32_t id = reader.ReadUint();
+        uint32_t old_id = reader.ReadUint();
+        DlPoint offset = reader.ReadPoint();
+        auto layer = std::make_shared<TransformLayer>(
+            DlMatrix::MakeTranslation({offset.x, offset.y}));
+        if (!push_layer(id, old_id, layer)) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kPushClipRect: {
+        uint32_t id = reader.ReadUint();
+        uint32_t old_id = reader.ReadUint();
+        DlRect rect = reader.ReadRect();
+        uint32_t clip_behavior = reader.ReadUint();
+        if (!IsValidClip(clip_behavior)) {
+          return "The scene command buffer contains an invalid clip behavior.";
+        }
+        auto layer = std::make_shared<ClipRectLayer>(
+            rect, static_cast<Clip>(clip_behavior));
+        if (!push_layer(id, old_id, layer)) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kPushClipRRect: {
+        uint32_t id = reader.ReadUint();
+        uint32_t old_id = reader.ReadUint();
+        DlRect rect = reader.ReadRect();
+        float radii[8];
+        for (float& radius : radii) {
+          radius = reader.ReadFloat();
+        }
+        uint32_t clip_behavior = reader.ReadUint();
+        if (!IsValidClip(clip_behavior)) {
+          return "The scene command buffer contains an invalid clip behavior.";
+        }
+        // The Dart radii are in TL, TR, BR, BL (clockwise) order.
+        impeller::RoundingRadii rounding_radii = {
+            .top_left = DlSize(radii[0], radii[1]),
+            .top_right = DlSize(radii[2], radii[3]),
+            .bottom_left = DlSize(radii[6], radii[7]),
+            .bottom_right = DlSize(radii[4], radii[5]),
+        };
+        auto layer = std::make_shared<ClipRRectLayer>(
+            DlRoundRect::MakeRectRadii(rect.GetPositive(), rounding_radii),
+            static_cast<Clip>(clip_behavior));
+        if (!push_layer(id, old_id, layer)) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kPushOpacity: {
+        uint32_t id = reader.ReadUint();
+        uint32_t old_id = reader.ReadUint();
+        uint32_t alpha = reader.ReadUint();
+        DlPoint offset = reader.ReadPoint();
+        auto layer = std::make_shared<OpacityLayer>(alpha & 0xFF, offset);
+        if (!push_layer(id, old_id, layer)) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kPop:
+        // The root layer is never popped, as in SceneBuilder::PopLayer.
+        if (stack.size() > 1) {
+          stack.pop_back();
+        }
+        break;
+      case SceneCommand::kAddRetained: {
+        uint32_t id = reader.ReadUint();
+        auto retained = layers_.find(id);
+        if (retained == layers_.end()) {
+          return "The scene command buffer retains a layer that is not part "
+                 "of the previous scene.";
+        }
+        if (next_layers.find(id) != next_layers.end()) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        add_layer(id, retained->second.layer);
+        if (!RetainSubtree(id, next_layers)) {
+          return "The scene command buffer reuses a layer id.";
+        }
+        break;
+      }
+      case SceneCommand::kAddPicture: {
+        uint32_t index = reader.ReadUint();
+        DlPoint offset = reader.ReadPoint();
+        uint32_t hints = reader.ReadUint();
+        if (index >= pictures.size()) {
+          return "The scene command buffer refers to a missing picture.";
+        }
+        if (pictures[index]) {
+          add_layer(0, std::make_shared<DisplayListLayer>(
+                           offset, pictures[index], !!(hints & 1),
+                           !!(hints & 2)));
+        }
+        break;
+      }
+      case SceneCommand::kAddTexture: {
+        DlPoint offset = reader.ReadPoint();
+        DlSize size = reader.ReadSize();
+        int64_t texture_id = reader.ReadInt64();
+        bool freeze = reader.ReadUint() != 0;
+        uint32_t filter_quality = reader.ReadUint();
+        add_layer(0, std::make_shared<TextureLayer>(
+                         offset, size, texture_id, freeze,
+                         ImageFilter::SamplingFromIndex(filter_quality)));
+        break;
+      }
+      case SceneCommand::kAddPlatformView: {
+        DlPoint offset = reader.ReadPoint();
+        DlSize size = reader.ReadSize();
+        int64_t view_id = reader.ReadInt64();
+        add_layer(0,
+                  std::make_shared<PlatformViewLayer>(offset, size, view_id));
+        break;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool SceneLayerTable::RetainSubtree(uint32_t id, LayerMap& next_layers) {
+  auto entry = layers_.find(id);
+  if (entry == layers_.end()) {
+    return true;
+  }
+  if (!next_layers.emplace(id, entry->second).second) {
+    return false;
+  }
+  for (uint32_t child : entry->second.children) {
+    if (!RetainSubtree(child, next_layers)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter
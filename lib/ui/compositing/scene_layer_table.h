@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_COMPOSITING_SCENE_LAYER_TABLE_H_
+#define FLUTTER_LIB_UI_COMPOSITING_SCENE_LAYER_TABLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+
+namespace flutter {
+
+// The op codes of the records written by the Dart SceneCommandBuffer.
+//
+// Each record is a 32-bit op code followed by its 32-bit arguments, floats
+// unless noted otherwise. Layers are referred to by the uint32 ids assigned
+// by the Dart side, 0 meaning no layer. 64-bit ids are written as their low
+// word followed by their high word.
+//
+// Must be kept in sync with //lib/ui/compositing.dart.
+enum class SceneCommand : uint32_t {
+  kPushTransform,    // uint32 id, uint32 old id, 16 matrix values
+  kPushOffset,       // uint32 id, uint32 old id, dx, dy
+  kPushClipRect,     // uint32 id, uint32 old id, left, top, right, bottom,
+                     // uint32 clip behavior
+  kPushClipRRect,    // uint32 id, uint32 old id, left, top, right, bottom,
+                     // 8 radii in clockwise order, uint32 clip behavior
+  kPushOpacity,      // uint32 id, uint32 old id, uint32 alpha, dx, dy
+  kPop,              // no arguments
+  kAddRetained,      // uint32 id
+  kAddPicture,       // uint32 picture index, dx, dy, uint32 hints
+  kAddTexture,       // dx, dy, width, height, uint64 texture id,
+                     // uint32 freeze, uint32 filter quality
+  kAddPlatformView,  // dx, dy, width, height, uint64 view id
+
+  kLastCommand = kAddPlatformView,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The engine side of a Dart SceneCommandBuffer.
+///
+///             Builds Scenes from the records of the buffer in a single call
+///             and keeps the container layers of the last built scene, so
+///             that the next one can retain them or diff against them by id
+///             instead of through EngineLayer wrappers. A retained layer keeps
+///             its id, and the ids of its descendants, for the scene after.
+///
+class SceneLayerTable : public RefCountedDartWrappable<SceneLayerTable> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(SceneLayerTable);
+
+ public:
+  static void Create(Dart_Handle wrapper);
+
+  ~SceneLayerTable() override;
+
+  /// Decodes the first |byte_count| bytes of |commands| into a layer tree and
+  /// associates it with |scene_handle|.
+  ///
+  /// Returns null on success or an error string. On failure no scene is
+  /// created and the layers of the last built scene remain available.
+  Dart_Handle build(Dart_Handle scene_handle,
+                    Dart_Handle pictures,
+                    Dart_Handle commands,
+                    int byte_count);
+
+  void dispose();
+
+  size_t layer_count() const { return layers_.size(); }
+
+ private:
+  struct Entry {
+    std::shared_ptr<ContainerLayer> layer;
+    std::vector<uint32_t> children;
+  };
+  using LayerMap = std::unordered_map<uint32_t, Entry>;
+
+  SceneLayerTable();
+
+  const char* Decode(const uint8_t* data,
+                     size_t size,
+                     const std::vector<sk_sp<DisplayList>>& pictures,
+                     const std::shared_ptr<ContainerLayer>& root,
+                     LayerMap& next_layers);
+
+  // Copies the entry of |id| and those of its descendants from |layers_| into
+  // |next_layers|. Returns false if one of them is already in |next_layers|.
+  bool RetainSubtree(uint32_t id, LayerMap& next_layers);
+
+  LayerMap layers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SceneLayerTable);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_COMPOSITING_SCENE_LAYER_TABLE_H_
@@ -12,6 +12,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/compositing/scene_builder.h"
+#include "flutter/lib/ui/compositing/scene_layer_table.h"
 #include "flutter/lib/ui/dart_runtime_hooks.h"
 #include "flutter/lib/ui/isolate_name_server/isolate_name_server_natives.h"
 #include "flutter/lib/ui/painting/canvas.h"
@@ -79,6 +80,7 @@ typedef CanvasPath Path;
   V(Path::Create)                                                  \
   V(PictureRecorder::Create)                                       \
   V(SceneBuilder::Create)                                          \
+  V(SceneLayerTable::Create)                                       \
   V(SemanticsUpdateBuilder::Create)                                \
   /* Other */                                                      \
   V(FontCollection::LoadFontFromList)                              \
@@ -142,6 +144,7 @@ typedef CanvasPath Path;
   V(Canvas, drawAtlas)                           \
   V(Canvas, drawCircle)                          \
   V(Canvas, drawColor)                           \
+  V(Canvas, drawCommands)                        \
   V(Canvas, drawDRRect)                          \
   V(Canvas, drawImage)                           \
   V(Canvas, drawImageNine)                       \
@@ -296,6 +299,8 @@ typedef CanvasPath Path;
   V(SceneBuilder, pushOpacity)                   \
   V(SceneBuilder, pushShaderMask)                \
   V(SceneBuilder, pushTransformHandle)           \
+  V(SceneLayerTable, build)                      \
+  V(SceneLayerTable, dispose)                    \
   V(Scene, dispose)                              \
   V(Scene, toImage)                              \
   V(Scene, toImageSync)                          \
@@ -307,6 +307,85 @@ external void _finishCallResponse(bool didPass);
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+const int _kBenchmarkRectCount = 10000;
+
+Color _benchmarkRectColor(int i) => Color(0xFF000000 | (i * 2654435761) & 0xFFFFFF);
+
+Rect _benchmarkRect(int i) => Rect.fromLTWH((i % 100) * 10.0, (i ~/ 100) * 10.0, 8.0, 8.0);
+
+@pragma('vm:entry-point')
+void drawRectsIndividually() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint();
+  for (int i = 0; i < _kBenchmarkRectCount; i++) {
+    paint.color = _benchmarkRectColor(i);
+    canvas.drawRect(_benchmarkRect(i), paint);
+  }
+  recorder.endRecording().dispose();
+}
+
+final CanvasCommandBuffer _benchmarkCommandBuffer = CanvasCommandBuffer();
+
+@pragma('vm:entry-point')
+void drawRectsBatched() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final CanvasCommandBuffer buffer = _benchmarkCommandBuffer..clear();
+  for (int i = 0; i < _kBenchmarkRectCount; i++) {
+    buffer.color = _benchmarkRectColor(i);
+    buffer.drawRect(_benchmarkRect(i));
+  }
+
+// 125 groups of an offset, a clip, an opacity and a picture layer.
+const int _kBenchmarkLayerGroupCount = 125;
+
+Picture? _benchmarkScenePicture;
+
+Picture get _scenePicture {
+  if (_benchmarkScenePicture == null) {
+    final PictureRecorder recorder = PictureRecorder();
+    Canvas(recorder).drawRect(const Rect.fromLTWH(0, 0, 8, 8), Paint());
+    _benchmarkScenePicture = recorder.endRecording();
+  }
+  return _benchmarkScenePicture!;
+}
+
+@pragma('vm:entry-point')
+void buildSceneWithSceneBuilder() {
+  final SceneBuilder builder = SceneBuilder();
+  for (int i = 0; i < _kBenchmarkLayerGroupCount; i++) {
+    builder.pushOffset(1.0, 1.0);
+    builder.pushClipRect(const Rect.fromLTWH(0, 0, 1000, 1000));
+    builder.pushOpacity(0xF0);
+    builder.addPicture(Offset.zero, _scenePicture);
+  }
+  for (int i = 0; i < _kBenchmarkLayerGroupCount * 3; i++) {
+    builder.pop();
+  }
+  builder.build().dispose();
+}
+
+final SceneCommandBuffer _benchmarkSceneBuffer = SceneCommandBuffer();
+
+@pragma('vm:entry-point')
+void buildSceneWithCommandBuffer() {
+  final SceneCommandBuffer buffer = _benchmarkSceneBuffer;
+  for (int i = 0; i < _kBenchmarkLayerGroupCount; i++) {
+    buffer.pushOffset(1.0, 1.0);
+    buffer.pushClipRect(const Rect.fromLTWH(0, 0, 1000, 1000));
+    buffer.pushOpacity(0xF0);
+    buffer.addPicture(Offset.zero, _scenePicture);
+  }
+  for (int i = 0; i < _kBenchmarkLayerGroupCount * 3; i++) {
+    buffer.pop();
+  }
+  buffer.build().dispose();
+}
+  buffer.drawInto(canvas);
+  recorder.endRecording().dispose();
+}
+
 @pragma('vm:entry-point')
 @pragma('vm:external-name', 'ValidateConfiguration')
 external void validateConfiguration();
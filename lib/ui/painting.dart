@@ -6698,10 +6698,473 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Uint32, Double, Bool)>(symbol: 'Canvas::drawShadow')
   external void _drawShadow(_NativePath path, int color, double elevation, bool transparentOccluder);
 
+  @Native<Handle Function(Pointer<Void>, Handle, Handle, Handle, Int32)>(symbol: 'Canvas::drawCommands')
+  external String? _drawCommands(List<Path> paths, List<_Image> images, ByteData commands, int byteCount);
+
   @override
   String toString() => 'Canvas(recording: ${_recorder != null})';
 }
 
+/// A compact recording of drawing commands that can be drawn into a [Canvas]
+/// with a single call.
+///
+/// Each call on a [Canvas] crosses from Dart into the engine, which dominates
+/// the cost of painters that draw thousands of simple primitives per frame. A
+/// [CanvasCommandBuffer] packs the primitives and the changes of the paint
+/// state between them into a single buffer instead, which [drawInto] hands to
+/// the engine in one call.
+///
+/// The paint state of the buffer is set with its own properties, such as
+/// [color] and [style], which start out with the defaults of [Paint] and only
+/// take space in the buffer when they change. The paint state is independent
+/// of [save] and [restore].
+///
+/// A [restore] only restores the saves recorded before it in the buffer, and
+/// [drawInto] restores the ones that are still open at the end, so drawing a
+/// buffer leaves the save count of the canvas unchanged.
+///
+/// Paths and images are referenced rather than copied, so changes to a [Path]
+/// after it was recorded affect the next [drawInto].
+///
+/// ```dart
+/// final CanvasCommandBuffer buffer = CanvasCommandBuffer();
+/// for (final Particle particle in particles) {
+///   buffer.color = particle.color;
+///   buffer.drawRect(particle.bounds);
+/// }
+/// buffer.drawInto(canvas);
+/// ```
+final class CanvasCommandBuffer {
+  /// Creates an empty command buffer.
+  CanvasCommandBuffer();
+
+  // Op codes of the records, must be kept in sync with
+  // lib/ui/painting/canvas_commands.h.
+  static const int _kSave = 0;
+  static const int _kRestore = 1;
+  static const int _kTranslate = 2;
+  static const int _kScale = 3;
+  static const int _kRotate = 4;
+  static const int _kClipRect = 5;
+  static const int _kSetColor = 6;
+  static const int _kSetStyle = 7;
+  static const int _kSetStrokeWidth = 8;
+  static const int _kSetStrokeCap = 9;
+  static const int _kSetStrokeJoin = 10;
+  static const int _kSetBlendMode = 11;
+  static const int _kSetAntiAlias = 12;
+  static const int _kDrawRect = 13;
+  static const int _kDrawOval = 14;
+  static const int _kDrawCircle = 15;
+  static const int _kDrawLine = 16;
+  static const int _kDrawRRect = 17;
+  static const int _kDrawPath = 18;
+  static const int _kDrawImage = 19;
+
+  static const int _kInitialByteCount = 1024;
+
+  ByteData _data = ByteData(_kInitialByteCount);
+  int _byteCount = 0;
+
+  final List<Path> _paths = <Path>[];
+  final Map<Path, int> _pathIndices = <Path, int>{};
+  final List<Image> _images = <Image>[];
+  final List<_Image> _nativeImages = <_Image>[];
+  final Map<Image, int> _imageIndices = <Image, int>{};
+
+  /// Whether no commands have been recorded since the buffer was created or
+  /// last [clear]ed.
+  bool get isEmpty => _byteCount == 0;
+
+  /// The number of bytes used by the recorded commands.
+  int get lengthInBytes => _byteCount;
+
+  /// Removes all recorded commands and resets the paint state to the
+  /// defaults of [Paint].
+  ///
+  /// The memory of the buffer is kept so that it can be reused for the next
+  /// frame without growing it again.
+  void clear() {
+    _byteCount = 0;
+    _paths.clear();
+    _pathIndices.clear();
+    _images.clear();
+    _nativeImages.clear();
+    _imageIndices.clear();
+    _color = const Color(0xFF000000);
+    _style = PaintingStyle.fill;
+    _strokeWidth = 0.0;
+    _strokeCap = StrokeCap.butt;
+    _strokeJoin = StrokeJoin.miter;
+    _blendMode = BlendMode.srcOver;
+    _isAntiAlias = true;
+  }
+
+  /// The color used by the commands recorded after it is set.
+  ///
+  /// See [Paint.color].
+  Color get color => _color;
+  Color _color = const Color(0xFF000000);
+  set color(Color value) {
+    if (value == _color) {
+      return;
+    }
+    _color = value;
+    _begin(_kSetColor, 5);
+    _writeFloat(value.r);
+    _writeFloat(value.g);
+    _writeFloat(value.b);
+    _writeFloat(value.a);
+    _writeUint(_colorSpaceToIndex(value.colorSpace));
+  }
+
+  /// Whether the shapes recorded after it is set are filled or stroked.
+  ///
+  /// See [Paint.style].
+  PaintingStyle get style => _style;
+  PaintingStyle _style = PaintingStyle.fill;
+  set style(PaintingStyle value) {
+    if (value == _style) {
+      return;
+    }
+    _style = value;
+    _begin(_kSetStyle, 1);
+    _writeUint(value.index);
+  }
+
+  /// The stroke width used by the commands recorded after it is set.
+  ///
+  /// See [Paint.strokeWidth].
+  double get strokeWidth => _strokeWidth;
+  double _strokeWidth = 0.0;
+  set strokeWidth(double value) {
+    if (value == _strokeWidth) {
+      return;
+    }
+    _strokeWidth = value;
+    _begin(_kSetStrokeWidth, 1);
+    _writeFloat(value);
+  }
+
+  /// The stroke cap used by the commands recorded after it is set.
+  ///
+  /// See [Paint.strokeCap].
+  StrokeCap get strokeCap => _strokeCap;
+  StrokeCap _strokeCap = StrokeCap.butt;
+  set strokeCap(StrokeCap value) {
+    if (value == _strokeCap) {
+      return;
+    }
+    _strokeCap = value;
+    _begin(_kSetStrokeCap, 1);
+    _writeUint(value.index);
+  }
+
+  /// The stroke join used by the commands recorded after it is set.
+  ///
+  /// See [Paint.strokeJoin].
+  StrokeJoin get strokeJoin => _strokeJoin;
+  StrokeJoin _strokeJoin = StrokeJoin.miter;
+  set strokeJoin(StrokeJoin value) {
+    if (value == _strokeJoin) {
+      return;
+    }
+    _strokeJoin = value;
+    _begin(_kSetStrokeJoin, 1);
+    _writeUint(value.index);
+  }
+
+  /// The blend mode used by the commands recorded after it is set.
+  ///
+  /// See [Paint.blendMode].
+  BlendMode get blendMode => _blendMode;
+  BlendMode _blendMode = BlendMode.srcOver;
+  set blendMode(BlendMode value) {
+    if (value == _blendMode) {
+      return;
+    }
+    _blendMode = value;
+    _begin(_kSetBlendMode, 1);
+    _writeUint(value.index);
+  }
+
+  /// Whether the commands recorded after it is set are anti-aliased.
+  ///
+  /// See [Paint.isAntiAlias].
+  bool get isAntiAlias => _isAntiAlias;
+  bool _isAntiAlias = true;
+  set isAntiAlias(bool value) {
+    if (value == _isAntiAlias) {
+      return;
+    }
+    _isAntiAlias = value;
+    _begin(_kSetAntiAlias, 1);
+    _writeUint(value ? 1 : 0);
+  }
+
+  /// Records a [Canvas.save].
+  void save() {
+    _begin(_kSave, 0);
+  }
+
+  /// Records a [Canvas.restore].
+  void restore() {
+    _begin(_kRestore, 0);
+  }
+
+  /// Records a [Canvas.translate].
+  void translate(double dx, double dy) {
+    _begin(_kTranslate, 2);
+    _writeFloat(dx);
+    _writeFloat(dy);
+  }
+
+  /// Records a [Canvas.scale].
+  void scale(double sx, [double? sy]) {
+    _begin(_kScale, 2);
+    _writeFloat(sx);
+    _writeFloat(sy ?? sx);
+  }
+
+  /// Records a [Canvas.rotate].
+  void rotate(double radians) {
+    _begin(_kRotate, 1);
+    _writeFloat(radians);
+  }
+
+  /// Records a [Canvas.clipRect] with [ClipOp.intersect].
+  void clipRect(Rect rect, {bool doAntiAlias = true}) {
+    assert(_rectIsValid(rect));
+    _begin(_kClipRect, 5);
+    _writeRect(rect);
+    _writeUint(doAntiAlias ? 1 : 0);
+  }
+
+  /// Records a [Canvas.drawRect] with the current paint state.
+  void drawRect(Rect rect) {
+    assert(_rectIsValid(rect));
+    rect = _NativeCanvas._sorted(rect);
+    if (_style != PaintingStyle.fill || !rect.isEmpty) {
+      _begin(_kDrawRect, 4);
+      _writeRect(rect);
+    }
+  }
+
+  /// Records a [Canvas.drawOval] with the current paint state.
+  void drawOval(Rect rect) {
+    assert(_rectIsValid(rect));
+    rect = _NativeCanvas._sorted(rect);
+    if (_style != PaintingStyle.fill || !rect.isEmpty) {
+      _begin(_kDrawOval, 4);
+      _writeRect(rect);
+    }
+  }
+
+  /// Records a [Canvas.drawCircle] with the current paint state.
+  void drawCircle(Offset c, double radius) {
+    assert(_offsetIsValid(c));
+    _begin(_kDrawCircle, 3);
+    _writeFloat(c.dx);
+    _writeFloat(c.dy);
+    _writeFloat(radius);
+  }
+
+  /// Records a [Canvas.drawLine] with the current paint state.
+  void drawLine(Offset p1, Offset p2) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    _begin(_kDrawLine, 4);
+    _writeFloat(p1.dx);
+    _writeFloat(p1.dy);
+    _writeFloat(p2.dx);
+    _writeFloat(p2.dy);
+  }
+
+  /// Records a [Canvas.drawRRect] with the current paint state.
+  void drawRRect(RRect rrect) {
+    assert(_rrectIsValid(rrect));
+    _begin(_kDrawRRect, 12);
+    _writeFloat(rrect.left);
+    _writeFloat(rrect.top);
+    _writeFloat(rrect.right);
+    _writeFloat(rrect.bottom);
+    _writeFloat(rrect.tlRadiusX);
+    _writeFloat(rrect.tlRadiusY);
+    _writeFloat(rrect.trRadiusX);
+    _writeFloat(rrect.trRadiusY);
+    _writeFloat(rrect.brRadiusX);
+    _writeFloat(rrect.brRadiusY);
+    _writeFloat(rrect.blRadiusX);
+    _writeFloat(rrect.blRadiusY);
+  }
+
+  /// Records a [Canvas.drawPath] with the current paint state.
+  void drawPath(Path path) {
+    final int index = _pathIndices.putIfAbsent(path, () {
+      _paths.add(path);
+      return _paths.length - 1;
+    });
+    _begin(_kDrawPath, 1);
+    _writeUint(index);
+  }
+
+  /// Records a [Canvas.drawImage] with the current paint state.
+  void drawImage(Image image, Offset offset, {FilterQuality filterQuality = FilterQuality.none}) {
+    assert(!image.debugDisposed);
+    assert(_offsetIsValid(offset));
+    final int index = _imageIndices.putIfAbsent(image, () {
+      _images.add(image);
+      _nativeImages.add(image._image);
+      return _images.length - 1;
+    });
+    _begin(_kDrawImage, 4);
+    _writeUint(index);
+    _writeFloat(offset.dx);
+    _writeFloat(offset.dy);
+    _writeUint(filterQuality.index);
+  }
+
+  /// Draws the recorded commands into the canvas.
+  ///
+  /// The buffer is not modified and can be drawn again, for instance into
+  /// the canvas of the next frame.
+  void drawInto(Canvas canvas) {
+    if (_byteCount == 0) {
+      return;
+    }
+    if (canvas is _NativeCanvas) {
+      final String? error = canvas._drawCommands(_paths, _nativeImages, _data, _byteCount);
+      if (error != null) {
+        throw StateError(error);
+      }
+    } else {
+      _replay(canvas);
+    }
+  }
+
+  // Draws the commands with the individual methods of a canvas that is not
+  // implemented by the engine.
+  void _replay(Canvas canvas) {
+    final int saveCount = canvas.getSaveCount();
+    final Paint paint = Paint();
+    int offset = 0;
+    double readFloat() {
+      final double value = _data.getFloat32(offset, _kFakeHostEndian);
+      offset += 4;
+      return value;
+    }
+    int readUint() {
+      final int value = _data.getUint32(offset, _kFakeHostEndian);
+      offset += 4;
+      return value;
+    }
+    Rect readRect() => Rect.fromLTRB(readFloat(), readFloat(), readFloat(), readFloat());
+    Offset readOffset() => Offset(readFloat(), readFloat());
+
+    while (offset < _byteCount) {
+      switch (readUint()) {
+        case _kSave:
+          canvas.save();
+        case _kRestore:
+          if (canvas.getSaveCount() > saveCount) {
+            canvas.restore();
+          }
+        case _kTranslate:
+          canvas.translate(readFloat(), readFloat());
+        case _kScale:
+          canvas.scale(readFloat(), readFloat());
+        case _kRotate:
+          canvas.rotate(readFloat());
+        case _kClipRect:
+          canvas.clipRect(readRect(), doAntiAlias: readUint() != 0);
+        case _kSetColor:
+          paint.color = Color.from(
+            red: readFloat(),
+            green: readFloat(),
+            blue: readFloat(),
+            alpha: readFloat(),
+            colorSpace: ColorSpace.values[readUint()],
+          );
+        case _kSetStyle:
+          paint.style = PaintingStyle.values[readUint()];
+        case _kSetStrokeWidth:
+          paint.strokeWidth = readFloat();
+        case _kSetStrokeCap:
+          paint.strokeCap = StrokeCap.values[readUint()];
+        case _kSetStrokeJoin:
+          paint.strokeJoin = StrokeJoin.values[readUint()];
+        case _kSetBlendMode:
+          paint.blendMode = BlendMode.values[readUint()];
+        case _kSetAntiAlias:
+          paint.isAntiAlias = readUint() != 0;
+        case _kDrawRect:
+          canvas.drawRect(readRect(), paint);
+        case _kDrawOval:
+          canvas.drawOval(readRect(), paint);
+        case _kDrawCircle:
+          canvas.drawCircle(readOffset(), readFloat(), paint);
+        case _kDrawLine:
+          canvas.drawLine(readOffset(), readOffset(), paint);
+        case _kDrawRRect:
+          final Rect rect = readRect();
+          final Radius topLeft = Radius.elliptical(readFloat(), readFloat());
+          final Radius topRight = Radius.elliptical(readFloat(), readFloat());
+          final Radius bottomRight = Radius.elliptical(readFloat(), readFloat());
+          final Radius bottomLeft = Radius.elliptical(readFloat(), readFloat());
+          canvas.drawRRect(
+            RRect.fromRectAndCorners(
+              rect,
+              topLeft: topLeft,
+              topRight: topRight,
+              bottomRight: bottomRight,
+              bottomLeft: bottomLeft,
+            ),
+            paint,
+          );
+        case _kDrawPath:
+          canvas.drawPath(_paths[readUint()], paint);
+        case _kDrawImage:
+          final Image image = _images[readUint()];
+          final Offset imageOffset = readOffset();
+          paint.filterQuality = FilterQuality.values[readUint()];
+          canvas.drawImage(image, imageOffset, paint);
+      }
+    }
+    canvas.restoreToCount(saveCount);
+  }
+
+  void _begin(int op, int argumentCount) {
+    final int requiredByteCount = _byteCount + (argumentCount + 1) * 4;
+    if (requiredByteCount > _data.lengthInBytes) {
+      int newByteCount = _data.lengthInBytes * 2;
+      while (newByteCount < requiredByteCount) {
+        newByteCount *= 2;
+      }
+      final ByteData newData = ByteData(newByteCount);
+      newData.buffer.asUint8List().setRange(0, _byteCount, _data.buffer.asUint8List());
+      _data = newData;
+    }
+    _writeUint(op);
+  }
+
+  void _writeUint(int value) {
+    _data.setUint32(_byteCount, value, _kFakeHostEndian);
+    _byteCount += 4;
+  }
+
+  void _writeFloat(double value) {
+    _data.setFloat32(_byteCount, value, _kFakeHostEndian);
+    _byteCount += 4;
+  }
+
+  void _writeRect(Rect rect) {
+    _writeFloat(rect.left);
+    _writeFloat(rect.top);
+    _writeFloat(rect.right);
+    _writeFloat(rect.bottom);
+  }
+}
+
 /// Signature for [Picture] lifecycle events.
 typedef PictureEventCallback = void Function(Picture picture);
 
@@ -8,11 +8,13 @@
 
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/lib/ui/floating_point.h"
+#include "flutter/lib/ui/painting/canvas_commands.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/image_filter.h"
 #include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 using tonic::ToDart;
 
@@ -641,6 +643,67 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+Dart_Handle Canvas::drawCommands(Dart_Handle paths,
+                                 Dart_Handle images,
+                                 Dart_Handle commands,
+                                 int byte_count) {
+  if (!display_list_builder_) {
+    return Dart_Null();
+  }
+
+  // Unwrap the objects before acquiring the command data, the VM cannot be
+  // re-entered while the typed data is acquired.
+  intptr_t path_count = 0;
+  intptr_t image_count = 0;
+  Dart_ListLength(paths, &path_count);
+  Dart_ListLength(images, &image_count);
+  std::vector<DlPath> dl_paths;
+  dl_paths.reserve(path_count);
+  for (intptr_t i = 0; i < path_count; i++) {
+    CanvasPath* path =
+        tonic::DartConverter<CanvasPath*>::FromDart(Dart_ListGetAt(paths, i));
+    if (!path) {
+      return ToDart("Canvas.drawCommands called with non-genuine Path.");
+    }
+    dl_paths.push_back(path->path());
+  }
+  std::vector<sk_sp<DlImage>> dl_images;
+  dl_images.reserve(image_count);
+  for (intptr_t i = 0; i < image_count; i++) {
+    CanvasImage* image =
+        tonic::DartConverter<CanvasImage*>::FromDart(Dart_ListGetAt(images, i));
+    if (!image) {
+      return ToDart("Canvas.drawCommands called with non-genuine Image.");
+    }
+    auto dl_image = image->image();
+    if (!dl_image) {
+      return ToDart("Canvas.drawCommands called with a disposed Image.");
+    }
+    auto error = dl_image->get_error();
+    if (error) {
+      return ToDart(error.value());
+    }
+    dl_images.push_back(std::move(dl_image));
+  }
+
+  const char* error;
+  {
+    tonic::DartByteData data(commands);
+    if (byte_count < 0 ||
+        static_cast<size_t>(byte_count) > data.length_in_bytes()) {
+      error = "Canvas.drawCommands called with an invalid byte count.";
+    } else {
+      error = DrawCanvasCommands(*builder(),
+                                 static_cast<const uint8_t*>(data.data()),
+                                 byte_count, dl_paths, dl_images);
+    }
+  }
+  if (error) {
+    return ToDart(error);
+  }
+  return Dart_Null();
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
   if (dart_wrapper()) {
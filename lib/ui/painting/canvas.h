@@ -184,6 +184,14 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // Draws the |byte_count| bytes of records at the start of |commands|, see
+  // canvas_commands.h. |paths| and |images| are the lists of the paths and
+  // images that the records refer to.
+  Dart_Handle drawCommands(Dart_Handle paths,
+                           Dart_Handle images,
+                           Dart_Handle commands,
+                           int byte_count);
+
   void Invalidate();
 
   DisplayListBuilder* builder() { return display_list_builder_.get(); }
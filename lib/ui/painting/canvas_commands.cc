@@ -0,0 +1,274 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/canvas_commands.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/fml/logging.h"
+#include "flutter/lib/ui/painting/image_filter.h"
+
+namespace flutter {
+
+namespace {
+
+// The number of 32-bit arguments of each command, indexed by op code.
+constexpr size_t kArgumentCounts[] = {
+    0,   // kSave
+    0,   // kRestore
+    2,   // kTranslate
+    2,   // kScale
+    1,   // kRotate
+    5,   // kClipRect
+    5,   // kSetColor
+    1,   // kSetStyle
+    1,   // kSetStrokeWidth
+    1,   // kSetStrokeCap
+    1,   // kSetStrokeJoin
+    1,   // kSetBlendMode
+    1,   // kSetAntiAlias
+    4,   // kDrawRect
+    4,   // kDrawOval
+    3,   // kDrawCircle
+    4,   // kDrawLine
+    12,  // kDrawRRect
+    1,   // kDrawPath
+    4,   // kDrawImage
+};
+static_assert(std::size(kArgumentCounts) ==
+                  static_cast<size_t>(CanvasCommand::kLastCommand) + 1,
+              "Every command must have an argument count.");
+
+// Reads the 32-bit words of the records. Callers check |Remaining| before
+// reading the arguments of a record.
+class CommandReader {
+ public:
+  CommandReader(const uint8_t* data, size_t size)
+      : data_(data), word_count_(size / sizeof(uint32_t)) {}
+
+  size_t Remaining() const { return word_count_ - position_; }
+
+  uint32_t ReadUint() {
+    FML_DCHECK(position_ < word_count_);
+    uint32_t value;
+    memcpy(&value, data_ + position_ * sizeof(uint32_t), sizeof(value));
+    position_++;
+    return value;
+  }
+
+  float ReadFloat() {
+    uint32_t bits = ReadUint();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  DlRect ReadRect() {
+    float left = ReadFloat();
+    float top = ReadFloat();
+    float right = ReadFloat();
+    float bottom = ReadFloat();
+    return DlRect::MakeLTRB(left, top, right, bottom);
+  }
+
+  DlPoint ReadPoint() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    return DlPoint(x, y);
+  }
+
+ private:
+  const uint8_t* data_;
+  const size_t word_count_;
+  size_t position_ = 0;
+};
+
+// Matches the defaults of the Dart Paint.
+DlPaint DefaultPaint() {
+  return DlPaint().setAntiAlias(true);
+}
+
+// Draws the records onto |canvas|, which has |base_save_count| saves when the
+// records start. kRestore records never restore saves below that count.
+const char* DrawCommands(DlCanvas& canvas,
+                         int base_save_count,
+                         const uint8_t* data,
+                         size_t size,
+                         const std::vector<DlPath>& paths,
+                         const std::vector<sk_sp<DlImage>>& images) {
+  CommandReader reader(data, size);
+  DlPaint paint = DefaultPaint();
+  while (reader.Remaining() > 0) {
+    uint32_t op = reader.ReadUint();
+    if (op > static_cast<uint32_t>(CanvasCommand::kLastCommand)) {
+      return "The canvas command buffer contains an unknown command.";
+    }
+    if (reader.Remaining() < kArgumentCounts[op]) {
+      return "The canvas command buffer ends in the middle of a command.";
+    }
+    switch (static_cast<CanvasCommand>(op)) {
+      case CanvasCommand::kSave:
+        canvas.Save();
+        break;
+      case CanvasCommand::kRestore:
+        if (canvas.GetSaveCount() > base_save_count) {
+          canvas.Restore();
+        }
+        break;
+      case CanvasCommand::kTranslate: {
+        float dx = reader.ReadFloat();
+        float dy = reader.ReadFloat();
+        canvas.Translate(dx, dy);
+        break;
+      }
+      case CanvasCommand::kScale: {
+        float sx = reader.ReadFloat();
+        float sy = reader.ReadFloat();
+        canvas.Scale(sx, sy);
+        break;
+      }
+      case CanvasCommand::kRotate:
+        canvas.Rotate(reader.ReadFloat() * 180.0f / static_cast<float>(M_PI));
+        break;
+      case CanvasCommand::kClipRect: {
+        DlRect rect = reader.ReadRect();
+        bool is_aa = reader.ReadUint() != 0;
+        canvas.ClipRect(rect, DlCanvas::ClipOp::kIntersect, is_aa);
+        break;
+      }
+      case CanvasCommand::kSetColor: {
+        float red = reader.ReadFloat();
+        float green = reader.ReadFloat();
+        float blue = reader.ReadFloat();
+        float alpha = reader.ReadFloat();
+        uint32_t color_space = reader.ReadUint();
+        if (color_space > static_cast<uint32_t>(DlColorSpace::kDisplayP3)) {
+          return "The canvas command buffer contains an invalid color space.";
+        }
+        paint.setColor(DlColor(alpha, red, green, blue,
+                               static_cast<DlColorSpace>(color_space))
+                           .withColorSpace(DlColorSpace::kExtendedSRGB));
+        break;
+      }
+      case CanvasCommand::kSetStyle: {
+        uint32_t style = reader.ReadUint();
+        if (style > static_cast<uint32_t>(DlDrawStyle::kLastStyle)) {
+          return "The canvas command buffer contains an invalid style.";
+        }
+        paint.setDrawStyle(static_cast<DlDrawStyle>(style));
+        break;
+      }
+      case CanvasCommand::kSetStrokeWidth:
+        paint.setStrokeWidth(reader.ReadFloat());
+        break;
+      case CanvasCommand::kSetStrokeCap: {
+        uint32_t cap = reader.ReadUint();
+        if (cap > static_cast<uint32_t>(DlStrokeCap::kLastCap)) {
+          return "The canvas command buffer contains an invalid stroke cap.";
+        }
+        paint.setStrokeCap(static_cast<DlStrokeCap>(cap));
+        break;
+      }
+      case CanvasCommand::kSetStrokeJoin: {
+        uint32_t join = reader.ReadUint();
+        if (join > static_cast<uint32_t>(DlStrokeJoin::kLastJoin)) {
+          return "The canvas command buffer contains an invalid stroke join.";
+        }
+        paint.setStrokeJoin(static_cast<DlStrokeJoin>(join));
+        break;
+      }
+      case CanvasCommand::kSetBlendMode: {
+        uint32_t mode = reader.ReadUint();
+        if (mode > static_cast<uint32_t>(DlBlendMode::kLastMode)) {
+          return "The canvas command buffer contains an invalid blend mode.";
+        }
+        paint.setBlendMode(static_cast<DlBlendMode>(mode));
+        break;
+      }
+      case CanvasCommand::kSetAntiAlias:
+        paint.setAntiAlias(reader.ReadUint() != 0);
+        break;
+      case CanvasCommand::kDrawRect:
+        canvas.DrawRect(reader.ReadRect(), paint);
+        break;
+      case CanvasCommand::kDrawOval:
+        canvas.DrawOval(reader.ReadRect(), paint);
+        break;
+      case CanvasCommand::kDrawCircle: {
+        DlPoint center = reader.ReadPoint();
+        float radius = reader.ReadFloat();
+        canvas.DrawCircle(center, radius, paint);
+        break;
+      }
+      case CanvasCommand::kDrawLine: {
+        DlPoint p0 = reader.ReadPoint();
+        DlPoint p1 = reader.ReadPoint();
+        canvas.DrawLine(p0, p1, paint);
+        break;
+      }
+      case CanvasCommand::kDrawRRect: {
+        DlRect rect = reader.ReadRect();
+        float radii[8];
+        for (float& radius : radii) {
+          radius = reader.ReadFloat();
+        }
+        // The Dart radii are in TL, TR, BR, BL (clockwise) order.
+        impeller::RoundingRadii rounding_radii = {
+            .top_left = DlSize(radii[0], radii[1]),
+            .top_right = DlSize(radii[2], radii[3]),
+            .bottom_left = DlSize(radii[6], radii[7]),
+            .bottom_right = DlSize(radii[4], radii[5]),
+        };
+        canvas.DrawRoundRect(
+            DlRoundRect::MakeRectRadii(rect.GetPositive(), rounding_radii),
+            paint);
+        break;
+      }
+      case CanvasCommand::kDrawPath: {
+        uint32_t index = reader.ReadUint();
+        if (index >= paths.size()) {
+          return "The canvas command buffer refers to a missing path.";
+        }
+        canvas.DrawPath(paths[index], paint);
+        break;
+      }
+      case CanvasCommand::kDrawImage: {
+        uint32_t index = reader.ReadUint();
+        DlPoint point = reader.ReadPoint();
+        uint32_t filter_quality = reader.ReadUint();
+        if (index >= images.size()) {
+          return "The canvas command buffer refers to a missing image.";
+        }
+        canvas.DrawImage(images[index], point,
+                         ImageFilter::SamplingFromIndex(filter_quality),
+                         &paint);
+        break;
+      }
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+const char* DrawCanvasCommands(DlCanvas& canvas,
+                               const uint8_t* data,
+                               size_t size,
+                               const std::vector<DlPath>& paths,
+                               const std::vector<sk_sp<DlImage>>& images) {
+  if (size % sizeof(uint32_t) != 0) {
+    return "The canvas command buffer is not a multiple of 4 bytes.";
+  }
+
+  const int save_count = canvas.GetSaveCount();
+  const char* error =
+      DrawCommands(canvas, save_count, data, size, paths, images);
+  canvas.RestoreToCount(save_count);
+  return error;
+}
+
+}  // namespace flutter
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_CANVAS_COMMANDS_H_
+#define FLUTTER_LIB_UI_PAINTING_CANVAS_COMMANDS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/display_list/dl_canvas.h"
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/display_list/image/dl_image.h"
+
+namespace flutter {
+
+// The op codes of the records written by the Dart CanvasCommandBuffer.
+//
+// Each record is a 32-bit op code followed by its 32-bit arguments, floats
+// unless noted otherwise. Colors are written as red, green, blue and alpha
+// floats followed by a color space index.
+//
+// Must be kept in sync with //lib/ui/painting.dart.
+enum class CanvasCommand : uint32_t {
+  kSave,            // no arguments
+  kRestore,         // no arguments
+  kTranslate,       // dx, dy
+  kScale,           // sx, sy
+  kRotate,          // radians
+  kClipRect,        // left, top, right, bottom, uint32 anti-alias
+  kSetColor,        // red, green, blue, alpha, uint32 color space
+  kSetStyle,        // uint32 style
+  kSetStrokeWidth,  // width
+  kSetStrokeCap,    // uint32 cap
+  kSetStrokeJoin,   // uint32 join
+  kSetBlendMode,    // uint32 blend mode
+  kSetAntiAlias,    // uint32 anti-alias
+  kDrawRect,        // left, top, right, bottom
+  kDrawOval,        // left, top, right, bottom
+  kDrawCircle,      // x, y, radius
+  kDrawLine,        // x1, y1, x2, y2
+  kDrawRRect,       // left, top, right, bottom, 8 radii in clockwise order
+  kDrawPath,        // uint32 path index
+  kDrawImage,       // uint32 image index, x, y, uint32 filter quality
+
+  kLastCommand = kDrawImage,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Draws the records of a Dart CanvasCommandBuffer onto the
+///             canvas.
+///
+///             The paint state starts out as the default Dart Paint and is
+///             updated by the kSet* records. Paths and images are referred
+///             to by their index in the given vectors.
+///
+///             The records only restore the saves they made themselves. Any
+///             of them still open at the end are restored, so the canvas is
+///             left with the save count it had.
+///
+/// @param[in]  canvas  The canvas that receives the decoded operations.
+/// @param[in]  data    The records.
+/// @param[in]  size    The size of the records in bytes.
+/// @param[in]  paths   The paths referenced by kDrawPath records.
+/// @param[in]  images  The images referenced by kDrawImage records.
+///
+/// @return     Null on success, or a description of the first malformed
+///             record. The records before it have been drawn.
+///
+const char* DrawCanvasCommands(DlCanvas& canvas,
+                               const uint8_t* data,
+                               size_t size,
+                               const std::vector<DlPath>& paths,
+                               const std::vector<sk_sp<DlImage>>& images);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_CANVAS_COMMANDS_H_
@@ -11,6 +11,7 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/display_list/image_atlas.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "impeller/base/strings.h"
@@ -84,7 +85,8 @@ ImageDecoderImpeller::ImageDecoderImpeller(
     const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
       supports_wide_gamut_(supports_wide_gamut),
-      gpu_disabled_switch_(gpu_disabled_switch) {
+      gpu_disabled_switch_(gpu_disabled_switch),
+      image_atlas_(impeller::ImageAtlas::Create()) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
   runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
@@ -288,7 +290,8 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
     const SkImageInfo& image_info,
-    const std::optional<SkImageInfo>& resize_info) {
+    const std::optional<SkImageInfo>& resize_info,
+    const std::shared_ptr<impeller::ImageAtlas>& image_atlas) {
   const auto pixel_format =
       impeller::skia_conversions::ToPixelFormat(image_info.colorType());
   if (!pixel_format) {
@@ -391,11 +394,22 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
     command_buffer->WaitUntilCompleted();
   }
 
+  sk_sp<impeller::DlImageImpeller> image =
+      impeller::DlImageImpeller::Make(result_texture);
+
+  // Small images are also copied into the shared atlas, so that the draws of
+  // many of them can be merged. On GLES, the copies would be made from the IO
+  // context into pages that the raster context samples without any
+  // synchronization.
+  if (image_atlas &&
+      context->GetBackendType() != impeller::Context::BackendType::kOpenGLES &&
+      impeller::ImageAtlas::CanAdd(*context, *result_texture)) {
+    image->SetAtlasAllocation(image_atlas->Add(*context, result_texture));
+  }
+
   context->DisposeThreadLocalCachedResources();
 
-  return std::make_pair(
-      impeller::DlImageImpeller::Make(std::move(result_texture)),
-      std::string());
+  return std::make_pair(std::move(image), std::string());
 }
 
 void ImageDecoderImpeller::UploadTextureToPrivate(
@@ -405,7 +419,8 @@ void ImageDecoderImpeller::UploadTextureToPrivate(
     const SkImageInfo& image_info,
     const std::shared_ptr<SkBitmap>& bitmap,
     const std::optional<SkImageInfo>& resize_info,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    const std::shared_ptr<impeller::ImageAtlas>& image_atlas) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!context) {
     result(nullptr, "No Impeller context is available");
@@ -418,22 +433,25 @@ void ImageDecoderImpeller::UploadTextureToPrivate(
 
   gpu_disabled_switch->Execute(
       fml::SyncSwitch::Handlers()
-          .SetIfFalse([&result, context, buffer, image_info, resize_info] {
+          .SetIfFalse([&result, context, buffer, image_info, resize_info,
+                       image_atlas] {
             sk_sp<DlImage> image;
             std::string decode_error;
             std::tie(image, decode_error) = std::tie(image, decode_error) =
                 UnsafeUploadTextureToPrivate(context, buffer, image_info,
-                                             resize_info);
+                                             resize_info, image_atlas);
             result(image, decode_error);
           })
-          .SetIfTrue([&result, context, buffer, image_info, resize_info] {
+          .SetIfTrue([&result, context, buffer, image_info, resize_info,
+                      image_atlas] {
             auto result_ptr = std::make_shared<ImageResult>(std::move(result));
             context->StoreTaskForGPU(
-                [result_ptr, context, buffer, image_info, resize_info]() {
+                [result_ptr, context, buffer, image_info, resize_info,
+                 image_atlas]() {
                   sk_sp<DlImage> image;
                   std::string decode_error;
                   std::tie(image, decode_error) = UnsafeUploadTextureToPrivate(
-                      context, buffer, image_info, resize_info);
+                      context, buffer, image_info, resize_info, image_atlas);
                   (*result_ptr)(image, decode_error);
                 },
                 [result_ptr]() {
@@ -527,7 +545,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        io_runner = runners_.GetIOTaskRunner(),                    //
        result,
        supports_wide_gamut = supports_wide_gamut_,  //
-       gpu_disabled_switch = gpu_disabled_switch_]() {
+       gpu_disabled_switch = gpu_disabled_switch_,  //
+       image_atlas = image_atlas_]() {
 #if FML_OS_IOS_SIMULATOR
         // No-op backend.
         if (!context) {
@@ -553,13 +572,15 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         }
 
         auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
+                                                 gpu_disabled_switch,
+                                                 image_atlas]() {
           UploadTextureToPrivate(result, context,              //
                                  bitmap_result.device_buffer,  //
                                  bitmap_result.image_info,     //
                                  bitmap_result.sk_bitmap,      //
                                  bitmap_result.resize_info,    //
-                                 gpu_disabled_switch           //
+                                 gpu_disabled_switch,          //
+                                 image_atlas                   //
           );
         };
         // The I/O image uploads are not threadsafe on GLES.
@@ -19,6 +19,7 @@ namespace impeller {
 class Context;
 class Allocator;
 class DeviceBuffer;
+class ImageAtlas;
 }  // namespace impeller
 
 namespace flutter {
@@ -81,6 +82,7 @@ class ImageDecoderImpeller final : public ImageDecoder {
   /// @param image_info Format information about the particular image.
   /// @param bitmap      A bitmap containg the image to be uploaded.
   /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @param image_atlas An atlas to also pack small images into, if any.
   static void UploadTextureToPrivate(
       ImageResult result,
       const std::shared_ptr<impeller::Context>& context,
@@ -88,7 +90,8 @@ class ImageDecoderImpeller final : public ImageDecoder {
       const SkImageInfo& image_info,
       const std::shared_ptr<SkBitmap>& bitmap,
       const std::optional<SkImageInfo>& resize_info,
-      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      const std::shared_ptr<impeller::ImageAtlas>& image_atlas = nullptr);
 
   /// @brief Create a texture from the provided bitmap.
   /// @param context     The Impeller graphics context.
@@ -103,13 +106,15 @@ class ImageDecoderImpeller final : public ImageDecoder {
   FutureContext context_;
   const bool supports_wide_gamut_;
   std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
+  std::shared_ptr<impeller::ImageAtlas> image_atlas_;
 
   /// Only call this method if the GPU is available.
   static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
       const std::shared_ptr<impeller::Context>& context,
       const std::shared_ptr<impeller::DeviceBuffer>& buffer,
       const SkImageInfo& image_info,
-      const std::optional<SkImageInfo>& resize_info);
+      const std::optional<SkImageInfo>& resize_info,
+      const std::shared_ptr<impeller::ImageAtlas>& image_atlas);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpeller);
 };
@@ -4,11 +4,13 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 #include <future>
 
@@ -69,4 +71,152 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+// Simulates a platform message and its response of the given size crossing
+// the embedder/Dart boundary in both directions. The copying variant mirrors
+// `FlutterEngineSendPlatformMessage` and
+// `FlutterEngineSendPlatformMessageResponse`, the other one their `NoCopy`
+// counterparts.
+static void BM_PlatformMessageRoundTrip(benchmark::State& state,
+                                        bool copy_payload) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+                  ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  const size_t payload_size = state.range(0);
+  std::vector<uint8_t> payload(payload_size, 0);
+
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      // Platform to Dart.
+      Dart_Handle message_data;
+      if (copy_payload) {
+        auto data = fml::MallocMapping::Copy(payload.data(), payload.size());
+        message_data =
+            tonic::DartByteData::Create(data.GetMapping(), data.GetSize());
+      } else {
+        message_data = WrapPlatformMessageData(
+            std::make_unique<fml::NonOwnedMapping>(payload.data(),
+                                                   payload.size()));
+      }
+      benchmark::DoNotOptimize(message_data);
+
+      // Dart to platform and back as the response.
+      Dart_Handle library = Dart_RootLibrary();
+      Dart_Handle closure =
+          Dart_GetField(library, Dart_NewStringFromCString("messageCallback"));
+      auto response = fml::MakeRefCounted<PlatformMessageResponseDart>(
+          tonic::DartPersistentValue(isolate->get(), closure),
+          thread_host.ui_thread->GetTaskRunner(), "");
+      std::unique_ptr<fml::Mapping> response_data;
+      if (copy_payload) {
+        response_data = std::make_unique<fml::DataMapping>(payload);
+      } else {
+        response_data = std::make_unique<fml::NonOwnedMapping>(payload.data(),
+                                                               payload.size());
+      }
+      response->Complete(std::move(response_data));
+      return true;
+    });
+    FML_CHECK(successful);
+
+    std::promise<bool> completed;
+    task_runners.GetUITaskRunner()->PostTask(
+        [&completed] { completed.set_value(true); });
+    completed.get_future().wait();
+  }
+  state.SetBytesProcessed(state.iterations() * payload_size * 2);
+}
+
+BENCHMARK_CAPTURE(BM_PlatformMessageRoundTrip, Copy, true)
+    ->RangeMultiplier(4)
+    ->Range(64 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PlatformMessageRoundTrip, NoCopy, false)
+    ->RangeMultiplier(4)
+    ->Range(64 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// Records 10k rects of different colors into a Picture, either with one
+// Canvas call per paint change and rect or through a CanvasCommandBuffer. The
+// Dart side lives in the drawRectsIndividually and drawRectsBatched entry
+// points of the ui_test fixture.
+static void BM_CanvasDrawRects(benchmark::State& state,
+                               const char* entrypoint) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+                  ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle result =
+          Dart_Invoke(Dart_RootLibrary(),
+                      Dart_NewStringFromCString(entrypoint), 0, nullptr);
+      return !Dart_IsError(result);
+    });
+    FML_CHECK(successful);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_CanvasDrawRects, Individual, "drawRectsIndividually")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CanvasDrawRects, Batched, "drawRectsBatched")
+    ->Unit(benchmark::kMicrosecond);
+
+// Builds a Scene of 500 layers, either through the SceneBuilder methods or
+// through a SceneCommandBuffer. The Dart side lives in the
+// buildSceneWithSceneBuilder and buildSceneWithCommandBuffer entry points of
+// the ui_test fixture.
+static void BM_SceneBuild(benchmark::State& state, const char* entrypoint) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+                  ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle result =
+          Dart_Invoke(Dart_RootLibrary(),
+                      Dart_NewStringFromCString(entrypoint), 0, nullptr);
+      return !Dart_IsError(result);
+    });
+    FML_CHECK(successful);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_SceneBuild, SceneBuilder, "buildSceneWithSceneBuilder")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SceneBuild,
+                  CommandBuffer,
+                  "buildSceneWithCommandBuffer")
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
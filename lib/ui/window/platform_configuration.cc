@@ -304,8 +304,12 @@ void PlatformConfiguration::DispatchPlatformMessage(
     return;
   }
   tonic::DartState::Scope scope(dart_state);
-  Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+  Dart_Handle data_handle = Dart_Null();
+  if (message->hasExternalData()) {
+    data_handle = WrapPlatformMessageData(message->releaseExternalData());
+  } else if (message->hasData()) {
+    data_handle = ToByteData(message->data());
+  }
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -22,6 +22,16 @@ PlatformMessage::PlatformMessage(std::string channel,
       has_data_(false),
       response_(std::move(response)) {}
 
+PlatformMessage::PlatformMessage(
+    std::string channel,
+    std::unique_ptr<fml::Mapping> external_data,
+    fml::RefPtr<PlatformMessageResponse> response)
+    : channel_(std::move(channel)),
+      data_(),
+      external_data_(std::move(external_data)),
+      has_data_(true),
+      response_(std::move(response)) {}
+
 PlatformMessage::~PlatformMessage() = default;
 
 }  // namespace flutter
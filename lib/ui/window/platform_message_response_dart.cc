@@ -52,6 +52,33 @@ void PostCompletion(Callback&& callback,
 }
 }  // namespace
 
+Dart_Handle WrapPlatformMessageData(std::unique_ptr<fml::Mapping> data) {
+  Dart_Handle byte_buffer;
+  intptr_t size = data->GetSize();
+  if (data->GetSize() > tonic::DartByteData::kExternalSizeThreshold) {
+    const void* mapping = data->GetMapping();
+    byte_buffer = Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+        /*type=*/Dart_TypedData_kByteData,
+        /*data=*/mapping,
+        /*length=*/size,
+        /*peer=*/data.release(),
+        /*external_allocation_size=*/size,
+        /*callback=*/MappingFinalizer);
+  } else {
+    Dart_Handle mutable_byte_buffer =
+        tonic::DartByteData::Create(data->GetMapping(), data->GetSize());
+    Dart_Handle ui_lib = Dart_LookupLibrary(
+        tonic::DartConverter<std::string>().ToDart("dart:ui"));
+    FML_DCHECK(!(Dart_IsNull(ui_lib) || Dart_IsError(ui_lib)));
+    byte_buffer = Dart_Invoke(ui_lib,
+                              tonic::DartConverter<std::string>().ToDart(
+                                  "_wrapUnmodifiableByteData"),
+                              1, &mutable_byte_buffer);
+    FML_DCHECK(!(Dart_IsNull(byte_buffer) || Dart_IsError(byte_buffer)));
+  }
+  return byte_buffer;
+}
+
 PlatformMessageResponseDart::PlatformMessageResponseDart(
     tonic::DartPersistentValue callback,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
@@ -71,31 +98,7 @@ void PlatformMessageResponseDart::Complete(std::unique_ptr<fml::Mapping> data) {
   PostCompletion(
       std::move(callback_), ui_task_runner_, &is_complete_, channel_,
       [data = std::move(data)]() mutable {
-        Dart_Handle byte_buffer;
-        intptr_t size = data->GetSize();
-        if (data->GetSize() > tonic::DartByteData::kExternalSizeThreshold) {
-          const void* mapping = data->GetMapping();
-          byte_buffer = Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
-              /*type=*/Dart_TypedData_kByteData,
-              /*data=*/mapping,
-              /*length=*/size,
-              /*peer=*/data.release(),
-              /*external_allocation_size=*/size,
-              /*callback=*/MappingFinalizer);
-        } else {
-          Dart_Handle mutable_byte_buffer =
-              tonic::DartByteData::Create(data->GetMapping(), data->GetSize());
-          Dart_Handle ui_lib = Dart_LookupLibrary(
-              tonic::DartConverter<std::string>().ToDart("dart:ui"));
-          FML_DCHECK(!(Dart_IsNull(ui_lib) || Dart_IsError(ui_lib)));
-          byte_buffer = Dart_Invoke(ui_lib,
-                                    tonic::DartConverter<std::string>().ToDart(
-                                        "_wrapUnmodifiableByteData"),
-                                    1, &mutable_byte_buffer);
-          FML_DCHECK(!(Dart_IsNull(byte_buffer) || Dart_IsError(byte_buffer)));
-        }
-
-        return byte_buffer;
+        return WrapPlatformMessageData(std::move(data));
       });
 }
 
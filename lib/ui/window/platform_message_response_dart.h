@@ -11,6 +11,18 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Wraps a platform message payload in an unmodifiable Dart
+///             `ByteData`. Must be called on the UI thread with an isolate
+///             scope entered.
+///
+///             Payloads larger than
+///             `tonic::DartByteData::kExternalSizeThreshold` are not copied.
+///             The resulting external typed data takes ownership of the
+///             mapping and releases it when collected.
+///
+Dart_Handle WrapPlatformMessageData(std::unique_ptr<fml::Mapping> data);
+
 class PlatformMessageResponseDart : public PlatformMessageResponse {
   FML_FRIEND_MAKE_REF_COUNTED(PlatformMessageResponseDart);
 
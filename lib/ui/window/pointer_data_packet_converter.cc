@@ -26,6 +26,10 @@ std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     ConvertPointerData(pointer_data, converted_pointers);
   }
 
+  if (coalescing_interval_ > fml::TimeDelta::Zero()) {
+    CoalescePointerData(converted_pointers);
+  }
+
   // Writes converted_pointers into converted_packet.
   auto converted_packet =
       std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
@@ -395,6 +399,92 @@ void PointerDataPacketConverter::ConvertPointerData(
   }
 }
 
+void PointerDataPacketConverter::SetCoalescingInterval(
+    fml::TimeDelta interval) {
+  coalescing_interval_ = interval;
+}
+
+void PointerDataPacketConverter::CoalescePointerData(
+    std::vector<PointerData>& converted_pointers) {
+  struct CoalescingRun {
+    // The index of the event that the next event of the run replaces.
+    size_t index;
+    // The time stamp of the first event of the run.
+    int64_t start_time_stamp;
+    // The deltas of the events dropped from the run so far.
+    double physical_delta_x = 0;
+    double physical_delta_y = 0;
+    double pan_delta_x = 0;
+    double pan_delta_y = 0;
+  };
+  const int64_t interval = coalescing_interval_.ToMicroseconds();
+  std::map<int64_t, CoalescingRun> runs;
+  std::vector<bool> dropped(converted_pointers.size(), false);
+  bool has_dropped = false;
+
+  // Folds the deltas of the dropped events into the surviving event.
+  auto finish_run = [&converted_pointers](const CoalescingRun& run) {
+    PointerData& survivor = converted_pointers[run.index];
+    survivor.physical_delta_x += run.physical_delta_x;
+    survivor.physical_delta_y += run.physical_delta_y;
+    survivor.pan_delta_x += run.pan_delta_x;
+    survivor.pan_delta_y += run.pan_delta_y;
+  };
+
+  for (size_t i = 0; i < converted_pointers.size(); i++) {
+    const PointerData& pointer_data = converted_pointers[i];
+    auto iter = runs.find(pointer_data.device);
+    bool can_coalesce =
+        pointer_data.signal_kind == PointerData::SignalKind::kNone &&
+        (pointer_data.change == PointerData::Change::kMove ||
+         pointer_data.change == PointerData::Change::kHover);
+    if (!can_coalesce) {
+      // Any other event of the device ends its run.
+      if (iter != runs.end()) {
+        finish_run(iter->second);
+        runs.erase(iter);
+      }
+      continue;
+    }
+
+    if (iter != runs.end()) {
+      CoalescingRun& run = iter->second;
+      const PointerData& previous = converted_pointers[run.index];
+      if (previous.change == pointer_data.change &&
+          previous.kind == pointer_data.kind &&
+          previous.buttons == pointer_data.buttons &&
+          previous.view_id == pointer_data.view_id &&
+          previous.pointer_identifier == pointer_data.pointer_identifier &&
+          pointer_data.time_stamp - run.start_time_stamp <= interval) {
+        run.physical_delta_x += previous.physical_delta_x;
+        run.physical_delta_y += previous.physical_delta_y;
+        run.pan_delta_x += previous.pan_delta_x;
+        run.pan_delta_y += previous.pan_delta_y;
+        dropped[run.index] = true;
+        has_dropped = true;
+        run.index = i;
+        continue;
+      }
+      finish_run(run);
+    }
+    runs[pointer_data.device] = {i, pointer_data.time_stamp};
+  }
+  for (const auto& [device, run] : runs) {
+    finish_run(run);
+  }
+
+  if (!has_dropped) {
+    return;
+  }
+  size_t count = 0;
+  for (size_t i = 0; i < converted_pointers.size(); i++) {
+    if (!dropped[i]) {
+      converted_pointers[count++] = converted_pointers[i];
+    }
+  }
+  converted_pointers.resize(count);
+}
+
 PointerState PointerDataPacketConverter::EnsurePointerState(
     PointerData pointer_data) {
   PointerState state;
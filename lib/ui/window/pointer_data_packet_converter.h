@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 
 namespace flutter {
@@ -116,9 +117,33 @@ class PointerDataPacketConverter {
   ///
   std::unique_ptr<PointerDataPacket> Convert(const PointerDataPacket& packet);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Enables coalescing of consecutive move and hover events.
+  ///
+  ///             When enabled, a move or hover event of a device replaces the
+  ///             previous move or hover event of the same device in the
+  ///             converted packet, provided that no other event of that
+  ///             device happened in between and the events are no further
+  ///             apart than `interval` from the first event of the run. The
+  ///             surviving event carries the accumulated deltas, so the
+  ///             framework observes the same net motion with fewer events.
+  ///
+  ///             Coalescing only operates within a single call to `Convert`.
+  ///             If `Settings::coalesce_pointer_events` is set, the shell
+  ///             merges the packets that arrive while a dispatch is pending on
+  ///             the UI task runner into that dispatch, and sets the interval
+  ///             to the vsync interval of the main display.
+  ///
+  /// @param[in]  interval  The maximum time span of a coalesced run. A zero
+  ///                       interval (the default) disables coalescing.
+  ///
+  void SetCoalescingInterval(fml::TimeDelta interval);
+
  private:
   const Delegate& delegate_;
 
+  fml::TimeDelta coalescing_interval_;
+
   // A map from pointer device ID to the state of the pointer.
   std::map<int64_t, PointerState> states_;
 
@@ -138,6 +163,8 @@ class PointerDataPacketConverter {
   bool LocationNeedsUpdate(const PointerData pointer_data,
                            const PointerState state);
 
+  void CoalescePointerData(std::vector<PointerData>& converted_pointers);
+
   FML_DISALLOW_COPY_AND_ASSIGN(PointerDataPacketConverter);
 };
 
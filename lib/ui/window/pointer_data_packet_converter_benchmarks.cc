@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/lib/ui/window/pointer_data_packet_converter.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int64_t kImplicitViewId = 0;
+
+// The number of events a 1 kHz input device produces in a 60 Hz frame.
+constexpr size_t kEventsPerFrame = 16;
+
+class BenchmarkDelegate : public PointerDataPacketConverter::Delegate {
+ public:
+  // |PointerDataPacketConverter::Delegate|
+  bool ViewExists(int64_t view_id) const override {
+    return view_id == kImplicitViewId;
+  }
+};
+
+PointerData CreateMoveEvent(int64_t time_stamp, double x, double y) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = time_stamp;
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kStylus;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = 0;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.buttons = kPointerButtonStylusContact;
+  data.view_id = kImplicitViewId;
+  return data;
+}
+
+}  // namespace
+
+static void BM_PointerDataPacketConverter1kHzStream(benchmark::State& state,
+                                                    bool coalesce) {
+  BenchmarkDelegate delegate;
+  PointerDataPacketConverter converter(delegate);
+  if (coalesce) {
+    converter.SetCoalescingInterval(fml::TimeDelta::FromMicroseconds(16667));
+  }
+
+  // Put the stylus down so that the stream consists of moves only.
+  PointerDataPacket down_packet(1);
+  PointerData down = CreateMoveEvent(0, 0.0, 0.0);
+  down.change = PointerData::Change::kDown;
+  down_packet.SetPointerData(0, down);
+  converter.Convert(down_packet);
+
+  int64_t time_stamp = 0;
+  size_t dispatched_events = 0;
+  size_t frames = 0;
+  PointerDataPacket packet(kEventsPerFrame);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    for (size_t i = 0; i < kEventsPerFrame; i++) {
+      time_stamp += 1000;
+      double t = time_stamp / 1000.0;
+      packet.SetPointerData(i, CreateMoveEvent(time_stamp, t, t * 0.5));
+    }
+    state.ResumeTiming();
+
+    auto converted = converter.Convert(packet);
+    dispatched_events += converted->GetLength();
+    frames++;
+  }
+  state.counters["EventsPerFrame"] =
+      frames == 0 ? 0.0 : static_cast<double>(dispatched_events) / frames;
+}
+
+BENCHMARK_CAPTURE(BM_PointerDataPacketConverter1kHzStream, Uncoalesced, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PointerDataPacketConverter1kHzStream, Coalesced, true)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -881,5 +881,118 @@ TEST(PointerDataPacketConverterTest, CanConvertViewId) {
   ASSERT_EQ(result[1].view_id, 200);
 }
 
+TEST(PointerDataPacketConverterTest, CoalescingIsDisabledByDefault) {
+  TestDelegate delegate;
+  delegate.AddView(kImplicitViewId);
+  PointerDataPacketConverter converter(delegate);
+  auto packet = std::make_unique<PointerDataPacket>(5);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(1, data);
+  for (int i = 0; i < 3; i++) {
+    CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, i + 1.0,
+                               0.0, 1);
+    data.time_stamp = (i + 1) * 1000;
+    packet->SetPointerData(2 + i, data);
+  }
+  auto converted_packet = converter.Convert(*packet);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)5);
+}
+
+TEST(PointerDataPacketConverterTest, CanCoalesceMoveEvents) {
+  TestDelegate delegate;
+  delegate.AddView(kImplicitViewId);
+  PointerDataPacketConverter converter(delegate);
+  converter.SetCoalescingInterval(fml::TimeDelta::FromMilliseconds(16));
+  // A 1 kHz touch stream: add, down, 4 moves 1 ms apart, up.
+  auto packet = std::make_unique<PointerDataPacket>(7);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(1, data);
+  for (int i = 0; i < 4; i++) {
+    CreateSimulatedPointerData(data, PointerData::Change::kMove, 0,
+                               (i + 1) * 2.0, (i + 1) * 3.0, 1);
+    data.time_stamp = (i + 1) * 1000;
+    packet->SetPointerData(2 + i, data);
+  }
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 8.0, 12.0, 0);
+  data.time_stamp = 5000;
+  packet->SetPointerData(6, data);
+  auto converted_packet = converter.Convert(*packet);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)4);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[1].change, PointerData::Change::kDown);
+  ASSERT_EQ(result[2].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[2].time_stamp, 4000);
+  ASSERT_EQ(result[2].physical_x, 8.0);
+  ASSERT_EQ(result[2].physical_y, 12.0);
+  ASSERT_EQ(result[2].physical_delta_x, 8.0);
+  ASSERT_EQ(result[2].physical_delta_y, 12.0);
+  ASSERT_EQ(result[3].change, PointerData::Change::kUp);
+}
+
+TEST(PointerDataPacketConverterTest, CoalescingRespectsIntervalAndDevices) {
+  TestDelegate delegate;
+  delegate.AddView(kImplicitViewId);
+  PointerDataPacketConverter converter(delegate);
+  converter.SetCoalescingInterval(fml::TimeDelta::FromMilliseconds(2));
+  auto packet = std::make_unique<PointerDataPacket>(10);
+  PointerData data;
+  // Two devices hovering with interleaved events.
+  CreateSimulatedMousePointerData(data, PointerData::Change::kAdd,
+                                  PointerData::SignalKind::kNone, 0, 0.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedMousePointerData(data, PointerData::Change::kAdd,
+                                  PointerData::SignalKind::kNone, 1, 0.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  for (int i = 0; i < 4; i++) {
+    CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                    PointerData::SignalKind::kNone, 0,
+                                    i + 1.0, 0.0, 0.0, 0.0, 0);
+    data.time_stamp = (i + 1) * 1000;
+    packet->SetPointerData(2 + i * 2, data);
+    CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                    PointerData::SignalKind::kNone, 1, 0.0,
+                                    i + 1.0, 0.0, 0.0, 0);
+    data.time_stamp = (i + 1) * 1000;
+    packet->SetPointerData(3 + i * 2, data);
+  }
+  auto converted_packet = converter.Convert(*packet);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  // Each device has two runs: [1 ms, 3 ms] and [4 ms].
+  ASSERT_EQ(result.size(), (size_t)6);
+  ASSERT_EQ(result[2].device, 0);
+  ASSERT_EQ(result[2].time_stamp, 3000);
+  ASSERT_EQ(result[2].physical_x, 3.0);
+  ASSERT_EQ(result[2].physical_delta_x, 3.0);
+  ASSERT_EQ(result[3].device, 1);
+  ASSERT_EQ(result[3].time_stamp, 3000);
+  ASSERT_EQ(result[3].physical_y, 3.0);
+  ASSERT_EQ(result[3].physical_delta_y, 3.0);
+  ASSERT_EQ(result[4].device, 0);
+  ASSERT_EQ(result[4].time_stamp, 4000);
+  ASSERT_EQ(result[4].physical_delta_x, 1.0);
+  ASSERT_EQ(result[5].device, 1);
+  ASSERT_EQ(result[5].time_stamp, 4000);
+  ASSERT_EQ(result[5].physical_delta_y, 1.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -155,3 +155,156 @@ abstract class PictureRasterizationException implements Exception {
   String get message;
   StackTrace? stack;
 }
+
+// The web canvases are not backed by the engine's DisplayListBuilder, so the
+// commands are recorded as closures and replayed through the Canvas API.
+final class CanvasCommandBuffer {
+  CanvasCommandBuffer();
+
+  final List<void Function(Canvas canvas, Paint paint)> _commands =
+      <void Function(Canvas canvas, Paint paint)>[];
+  int _byteCount = 0;
+  // The save count of the canvas that [drawInto] started with, which the
+  // recorded restores don't go below.
+  int _drawSaveCount = 0;
+
+  bool get isEmpty => _commands.isEmpty;
+
+  int get lengthInBytes => _byteCount;
+
+  void clear() {
+    _commands.clear();
+    _byteCount = 0;
+    _color = const Color(0xFF000000);
+    _style = PaintingStyle.fill;
+    _strokeWidth = 0.0;
+    _strokeCap = StrokeCap.butt;
+    _strokeJoin = StrokeJoin.miter;
+    _blendMode = BlendMode.srcOver;
+    _isAntiAlias = true;
+  }
+
+  Color get color => _color;
+  Color _color = const Color(0xFF000000);
+  set color(Color value) {
+    if (value != _color) {
+      _color = value;
+      _record(5, (Canvas canvas, Paint paint) => paint.color = value);
+    }
+  }
+
+  PaintingStyle get style => _style;
+  PaintingStyle _style = PaintingStyle.fill;
+  set style(PaintingStyle value) {
+    if (value != _style) {
+      _style = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.style = value);
+    }
+  }
+
+  double get strokeWidth => _strokeWidth;
+  double _strokeWidth = 0.0;
+  set strokeWidth(double value) {
+    if (value != _strokeWidth) {
+      _strokeWidth = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.strokeWidth = value);
+    }
+  }
+
+  StrokeCap get strokeCap => _strokeCap;
+  StrokeCap _strokeCap = StrokeCap.butt;
+  set strokeCap(StrokeCap value) {
+    if (value != _strokeCap) {
+      _strokeCap = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.strokeCap = value);
+    }
+  }
+
+  StrokeJoin get strokeJoin => _strokeJoin;
+  StrokeJoin _strokeJoin = StrokeJoin.miter;
+  set strokeJoin(StrokeJoin value) {
+    if (value != _strokeJoin) {
+      _strokeJoin = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.strokeJoin = value);
+    }
+  }
+
+  BlendMode get blendMode => _blendMode;
+  BlendMode _blendMode = BlendMode.srcOver;
+  set blendMode(BlendMode value) {
+    if (value != _blendMode) {
+      _blendMode = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.blendMode = value);
+    }
+  }
+
+  bool get isAntiAlias => _isAntiAlias;
+  bool _isAntiAlias = true;
+  set isAntiAlias(bool value) {
+    if (value != _isAntiAlias) {
+      _isAntiAlias = value;
+      _record(1, (Canvas canvas, Paint paint) => paint.isAntiAlias = value);
+    }
+  }
+
+  void save() => _record(0, (Canvas canvas, Paint paint) => canvas.save());
+
+  void restore() => _record(0, (Canvas canvas, Paint paint) {
+        if (canvas.getSaveCount() > _drawSaveCount) {
+          canvas.restore();
+        }
+      });
+
+  void translate(double dx, double dy) =>
+      _record(2, (Canvas canvas, Paint paint) => canvas.translate(dx, dy));
+
+  void scale(double sx, [double? sy]) =>
+      _record(2, (Canvas canvas, Paint paint) => canvas.scale(sx, sy ?? sx));
+
+  void rotate(double radians) =>
+      _record(1, (Canvas canvas, Paint paint) => canvas.rotate(radians));
+
+  void clipRect(Rect rect, {bool doAntiAlias = true}) => _record(
+      5, (Canvas canvas, Paint paint) => canvas.clipRect(rect, doAntiAlias: doAntiAlias));
+
+  void drawRect(Rect rect) =>
+      _record(4, (Canvas canvas, Paint paint) => canvas.drawRect(rect, paint));
+
+  void drawOval(Rect rect) =>
+      _record(4, (Canvas canvas, Paint paint) => canvas.drawOval(rect, paint));
+
+  void drawCircle(Offset c, double radius) =>
+      _record(3, (Canvas canvas, Paint paint) => canvas.drawCircle(c, radius, paint));
+
+  void drawLine(Offset p1, Offset p2) =>
+      _record(4, (Canvas canvas, Paint paint) => canvas.drawLine(p1, p2, paint));
+
+  void drawRRect(RRect rrect) =>
+      _record(12, (Canvas canvas, Paint paint) => canvas.drawRRect(rrect, paint));
+
+  void drawPath(Path path) =>
+      _record(1, (Canvas canvas, Paint paint) => canvas.drawPath(path, paint));
+
+  void drawImage(Image image, Offset offset, {FilterQuality filterQuality = FilterQuality.none}) {
+    _record(4, (Canvas canvas, Paint paint) {
+      paint.filterQuality = filterQuality;
+      canvas.drawImage(image, offset, paint);
+    });
+  }
+
+  void drawInto(Canvas canvas) {
+    _drawSaveCount = canvas.getSaveCount();
+    final Paint paint = Paint();
+    for (final void Function(Canvas canvas, Paint paint) command in _commands) {
+      command(canvas, paint);
+    }
+    canvas.restoreToCount(_drawSaveCount);
+  }
+
+  // Counts the bytes the command takes in the engine's encoding, an op code
+  // followed by its 32-bit arguments.
+  void _record(int argumentCount, void Function(Canvas canvas, Paint paint) command) {
+    _commands.add(command);
+    _byteCount += (argumentCount + 1) * 4;
+  }
+}
@@ -123,3 +123,149 @@ abstract class SceneBuilder {
 class EngineLayer {
   void dispose() {}
 }
+
+// The web renderers build their layer trees in Dart, so the buffer forwards
+// the operations to a SceneBuilder and maps the layer ids to EngineLayers.
+final class SceneCommandBuffer {
+  SceneCommandBuffer();
+
+  SceneBuilder? _builder;
+  int _nextLayerId = 1;
+
+  // The layers of the last built scene and of the scene being described, with
+  // the ids of their children.
+  Map<int, (EngineLayer, List<int>)> _layers = <int, (EngineLayer, List<int>)>{};
+  Map<int, (EngineLayer, List<int>)> _nextLayers = <int, (EngineLayer, List<int>)>{};
+  final List<int> _stack = <int>[];
+
+  bool _disposed = false;
+
+  bool get debugDisposed {
+    bool? disposed;
+    assert(() {
+      disposed = _disposed;
+      return true;
+    }());
+    return disposed ?? (throw StateError('debugDisposed is only available when asserts are enabled.'));
+  }
+
+  SceneBuilder get _sceneBuilder => _builder ??= SceneBuilder();
+
+  T? _oldLayer<T extends EngineLayer>(int? id) {
+    final EngineLayer? layer = _layers[id]?.$1;
+    return layer is T ? layer : null;
+  }
+
+  int _push(EngineLayer layer) {
+    final int id = _nextLayerId++;
+    _addChild(id);
+    _nextLayers[id] = (layer, <int>[]);
+    _stack.add(id);
+    return id;
+  }
+
+  void _addChild(int id) {
+    if (_stack.isNotEmpty) {
+      _nextLayers[_stack.last]!.$2.add(id);
+    }
+  }
+
+  int pushTransform(Float64List matrix4, {int? oldLayer}) =>
+      _push(_sceneBuilder.pushTransform(matrix4, oldLayer: _oldLayer(oldLayer)));
+
+  int pushOffset(double dx, double dy, {int? oldLayer}) =>
+      _push(_sceneBuilder.pushOffset(dx, dy, oldLayer: _oldLayer(oldLayer)));
+
+  int pushClipRect(Rect rect, {Clip clipBehavior = Clip.antiAlias, int? oldLayer}) =>
+      _push(_sceneBuilder.pushClipRect(rect,
+          clipBehavior: clipBehavior, oldLayer: _oldLayer(oldLayer)));
+
+  int pushClipRRect(RRect rrect, {Clip clipBehavior = Clip.antiAlias, int? oldLayer}) =>
+      _push(_sceneBuilder.pushClipRRect(rrect,
+          clipBehavior: clipBehavior, oldLayer: _oldLayer(oldLayer)));
+
+  int pushOpacity(int alpha, {Offset offset = Offset.zero, int? oldLayer}) =>
+      _push(_sceneBuilder.pushOpacity(alpha, offset: offset, oldLayer: _oldLayer(oldLayer)));
+
+  void pop() {
+    if (_stack.isNotEmpty) {
+      _stack.removeLast();
+    }
+    _sceneBuilder.pop();
+  }
+
+  void addRetained(int layer) {
+    final (EngineLayer, List<int>)? entry = _layers[layer];
+    if (entry == null) {
+      throw StateError('The layer $layer is not part of the previous scene.');
+    }
+    _addChild(layer);
+    _sceneBuilder.addRetained(entry.$1);
+    void retain(int id) {
+      final (EngineLayer, List<int>)? retained = _layers[id];
+      if (retained != null) {
+        if (_nextLayers.containsKey(id)) {
+          throw StateError('The layer $id is used more than once.');
+        }
+        _nextLayers[id] = retained;
+        retained.$2.forEach(retain);
+      }
+    }
+    retain(layer);
+  }
+
+  void addPicture(
+    Offset offset,
+    Picture picture, {
+    bool isComplexHint = false,
+    bool willChangeHint = false,
+  }) {
+    _sceneBuilder.addPicture(offset, picture,
+        isComplexHint: isComplexHint, willChangeHint: willChangeHint);
+  }
+
+  void addTexture(
+    int textureId, {
+    Offset offset = Offset.zero,
+    double width = 0.0,
+    double height = 0.0,
+    bool freeze = false,
+    FilterQuality filterQuality = FilterQuality.low,
+  }) {
+    _sceneBuilder.addTexture(textureId,
+        offset: offset,
+        width: width,
+        height: height,
+        freeze: freeze,
+        filterQuality: filterQuality);
+  }
+
+  void addPlatformView(
+    int viewId, {
+    Offset offset = Offset.zero,
+    double width = 0.0,
+    double height = 0.0,
+  }) {
+    _sceneBuilder.addPlatformView(viewId, offset: offset, width: width, height: height);
+  }
+
+  Scene build() {
+    assert(!_disposed);
+    final Scene scene = _sceneBuilder.build();
+    _builder = null;
+    _stack.clear();
+    _layers = _nextLayers;
+    _nextLayers = <int, (EngineLayer, List<int>)>{};
+    return scene;
+  }
+
+  void dispose() {
+    assert(!_disposed);
+    assert(() {
+      _disposed = true;
+      return true;
+    }());
+    _layers.clear();
+    _nextLayers.clear();
+  }
+}
@@ -375,6 +375,10 @@ bool RuntimeController::DispatchPointerDataPacket(
   return false;
 }
 
+void RuntimeController::SetPointerCoalescingInterval(fml::TimeDelta interval) {
+  pointer_data_packet_converter_.SetCoalescingInterval(interval);
+}
+
 bool RuntimeController::DispatchSemanticsAction(int32_t node_id,
                                                 SemanticsAction action,
                                                 fml::MallocMapping args) {
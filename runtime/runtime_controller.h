@@ -475,6 +475,18 @@ class RuntimeController : public PlatformConfigurationClient,
   ///
   bool DispatchPointerDataPacket(const PointerDataPacket& packet);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the maximum time span of the runs of move and hover
+  ///             events that are coalesced when pointer data packets are
+  ///             dispatched.
+  ///
+  /// @param[in]  interval  The maximum time span of a coalesced run. A zero
+  ///                       interval disables coalescing.
+  ///
+  /// @see        `PointerDataPacketConverter::SetCoalescingInterval`
+  ///
+  void SetPointerCoalescingInterval(fml::TimeDelta interval);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the semantics action to the specified accessibility
   ///             node.
@@ -37,6 +37,12 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kSetLayerCostAttributionExtensionName =
+    "_flutter.setLayerCostAttribution";
+const std::string_view ServiceProtocol::kGetLayerCostsExtensionName =
+    "_flutter.getLayerCosts";
+const std::string_view ServiceProtocol::kGetTraceBufferExtensionName =
+    "_flutter.getTraceBuffer";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
 
@@ -58,6 +64,9 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kSetLayerCostAttributionExtensionName,
+          kGetLayerCostsExtensionName,
+          kGetTraceBufferExtensionName,
           kReloadAssetFonts,
       }) {}
 
@@ -28,6 +28,9 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kSetLayerCostAttributionExtensionName;
+  static const std::string_view kGetLayerCostsExtensionName;
+  static const std::string_view kGetTraceBufferExtensionName;
   static const std::string_view kReloadAssetFonts;
 
   class Handler {
@@ -6,6 +6,7 @@
 
 #include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -20,11 +21,17 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// Late latches shorter than this are not worth a round trip through the task
+// queue.
+constexpr fml::TimeDelta kMinLateLatchDelay =
+    fml::TimeDelta::FromMicroseconds(500);
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool enable_adaptive_frame_pacing)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
@@ -42,6 +49,10 @@ Animator::Animator(Delegate& delegate,
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  if (enable_adaptive_frame_pacing) {
+    frame_pacer_ =
+        std::make_unique<FramePacer>(layer_tree_pipeline_->GetDepthLimit());
+  }
 }
 
 Animator::~Animator() = default;
@@ -139,10 +150,15 @@ void Animator::EndFrame() {
       layer_tree_task_list.push_back(std::move(layer_tree_task));
     }
     layer_trees_tasks_.clear();
+    const uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
     PipelineProduceResult result = producer_continuation_.Complete(
         std::make_unique<FrameItem>(std::move(layer_tree_task_list),
                                     std::move(frame_timings_recorder_)));
 
+    if (result.success && frame_pacer_) {
+      frame_pacer_->OnFrameSubmitted(frame_number, fml::TimePoint::Now());
+    }
+
     if (!result.success) {
       FML_DLOG(INFO) << "Failed to commit to the pipeline";
     } else if (!result.is_first_item) {
@@ -278,8 +294,7 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTrees()) {
             self->DrawLastLayerTrees(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-            self->EndFrame();
+            self->BeginAndEndFrame(std::move(frame_timings_recorder));
           }
         }
       });
@@ -288,6 +303,54 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::BeginAndEndFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (!frame_pacer_) {
+    BeginFrame(std::move(frame_timings_recorder));
+    EndFrame();
+    return;
+  }
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const FramePacer::Decision decision = frame_pacer_->OnVsync(
+      frame_timings_recorder->GetVsyncStartTime(),
+      frame_timings_recorder->GetVsyncTargetTime(), now);
+  layer_tree_pipeline_->SetDepthLimit(decision.pipeline_depth);
+  FML_TRACE_COUNTER("flutter", "FramePacer", reinterpret_cast<int64_t>(this),
+                    "pipeline depth", decision.pipeline_depth);
+
+  if (decision.build_start - now < kMinLateLatchDelay) {
+    BeginFrame(std::move(frame_timings_recorder));
+    EndFrame();
+    return;
+  }
+
+  // The vsync stays pending until the delayed BeginFrame, so that
+  // RequestFrame calls in between don't wait for another vsync.
+  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Animator::LateLatch",
+                           frame_request_number_);
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      fml::MakeCopyable(
+          [self = weak_factory_.GetWeakPtr(),
+           frame_timings_recorder = std::move(frame_timings_recorder),
+           trace_id = frame_request_number_]() mutable {
+            TRACE_EVENT_ASYNC_END0("flutter", "Animator::LateLatch",
+                                   trace_id);
+            if (!self) {
+              return;
+            }
+            self->BeginFrame(std::move(frame_timings_recorder));
+            self->EndFrame();
+          }),
+      decision.build_start);
+}
+
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  if (frame_pacer_) {
+    frame_pacer_->OnFrameRasterized(timing);
+  }
+}
+
 void Animator::OnAllViewsRendered() {
   if (!layer_trees_tasks_.empty()) {
     EndFrame();
@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_pacer.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -45,9 +46,16 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //--------------------------------------------------------------------------
+  /// @param[in]  enable_adaptive_frame_pacing  Whether the depth of the frame
+  ///             pipeline and the start of the UI work of each frame are
+  ///             chosen by a |FramePacer| from the timings of recent frames,
+  ///             which must then be reported with |OnFrameRasterized|.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool enable_adaptive_frame_pacing = false);
 
   ~Animator();
 
@@ -107,6 +115,12 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Reports the timings of a rasterized frame to the frame pacer,
+  ///           if adaptive frame pacing is enabled.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -121,6 +135,11 @@ class Animator final {
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
   void EndFrame();
 
+  // Runs BeginFrame and EndFrame for a vsync, either right away or, when
+  // the frame pacer late latches the frame, in a delayed task.
+  void BeginAndEndFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   bool CanReuseLastLayerTrees();
 
   void DrawLastLayerTrees(
@@ -147,6 +166,7 @@ class Animator final {
   bool frame_scheduled_ = false;
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  std::unique_ptr<FramePacer> frame_pacer_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
@@ -6,9 +6,11 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -261,6 +263,328 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+namespace {
+
+// Fires each vsync right away, for a display with a 60Hz refresh rate.
+class ImmediateVsyncWaiter : public VsyncWaiter {
+ public:
+  static constexpr fml::TimeDelta kInterval =
+      fml::TimeDelta::FromMicroseconds(16667);
+
+  explicit ImmediateVsyncWaiter(const TaskRunners& task_runners)
+      : VsyncWaiter(task_runners) {}
+
+ protected:
+  void AwaitVSync() override {
+    task_runners_.GetPlatformTaskRunner()->PostTask([this]() {
+      const fml::TimePoint now = fml::TimePoint::Now();
+      FireCallback(now, now + kInterval);
+    });
+  }
+};
+
+}  // namespace
+
+TEST_F(ShellTest, AnimatorDelaysBuildWhileRasterThreadIsBusy) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+  // Frames that take longer to rasterize than a vsync interval.
+  const fml::TimeDelta build = fml::TimeDelta::FromMilliseconds(1);
+  const fml::TimeDelta raster = fml::TimeDelta::FromMilliseconds(50);
+
+  std::shared_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    animator = std::make_unique<Animator>(
+        delegate, task_runners,
+        std::make_unique<ImmediateVsyncWaiter>(task_runners),
+        /*enable_adaptive_frame_pacing=*/true);
+    const fml::TimePoint start =
+        fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+    for (size_t i = 0; i < FramePacer::kMinHistorySize; i++) {
+      FrameTiming timing;
+      timing.SetFrameNumber(0);
+      timing.Set(FrameTiming::kBuildStart, start);
+      timing.Set(FrameTiming::kBuildFinish, start + build);
+      timing.Set(FrameTiming::kRasterStart, start + build);
+      timing.Set(FrameTiming::kRasterFinish, start + build + raster);
+      animator->OnFrameRasterized(timing);
+    }
+  });
+
+  EXPECT_CALL(delegate, OnAnimatorUpdateLatestFrameTargetTime).Times(2);
+  // The rasterizer doesn't consume the first frame, so it is only notified
+  // once.
+  EXPECT_CALL(delegate, OnAnimatorDraw).Times(1);
+
+  fml::AutoResetWaitableEvent begin_frame_latch;
+  fml::TimePoint begin_frame_time;
+  fml::TimePoint frame_target_time;
+  for (int i = 0; i < 2; i++) {
+    PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+      EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+          .WillOnce([&](fml::TimePoint target_time, uint64_t frame_number) {
+            begin_frame_time = fml::TimePoint::Now();
+            frame_target_time = target_time;
+            auto layer_tree =
+                std::make_unique<LayerTree>(nullptr, DlISize(600, 800));
+            animator->Render(kImplicitViewId, std::move(layer_tree), 1.0);
+            begin_frame_latch.Signal();
+          });
+      animator->RequestFrame();
+    });
+    begin_frame_latch.Wait();
+  }
+
+  // The first frame is predicted to still be rasterizing at the vsync of the
+  // second one, so the second build is delayed until it can only just
+  // complete before its target time.
+  EXPECT_GE(begin_frame_time, frame_target_time - build);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
+namespace {
+
+// A model of a 60Hz display and the frame pipeline. Each frame is built on
+// the UI thread from the time chosen by the pacer, and rasterized as soon as
+// it is built and the raster thread is free. The timings of a frame are
+// reported at the first vsync after its rasterization ends.
+class FramePacerSimulation {
+ public:
+  static constexpr fml::TimeDelta kInterval =
+      fml::TimeDelta::FromMicroseconds(16667);
+
+  struct Frame {
+    FramePacer::Decision decision;
+    fml::TimePoint vsync_start;
+    fml::TimePoint vsync_target;
+    // Whether the pipeline was full when the build should have started.
+    bool skipped = false;
+    fml::TimePoint raster_end;
+  };
+
+  explicit FramePacerSimulation(uint32_t max_pipeline_depth)
+      : pacer_(max_pipeline_depth) {}
+
+  FramePacer& pacer() { return pacer_; }
+
+  Frame RunFrame(fml::TimeDelta build, fml::TimeDelta raster) {
+    Frame frame;
+    frame.vsync_start = vsync_;
+    frame.vsync_target = vsync_ + kInterval;
+    vsync_ = frame.vsync_target;
+    ReportFramesRasterizedBefore(frame.vsync_start);
+
+    frame.decision = pacer_.OnVsync(frame.vsync_start, frame.vsync_target,
+                                    std::max(frame.vsync_start, ui_free_));
+    const fml::TimePoint build_start = frame.decision.build_start;
+    const size_t frames_in_flight = std::count_if(
+        in_flight_.begin(), in_flight_.end(), [&](const FrameTiming& timing) {
+          return timing.Get(FrameTiming::kRasterFinish) > build_start;
+        });
+    if (frames_in_flight >= frame.decision.pipeline_depth) {
+      frame.skipped = true;
+      return frame;
+    }
+
+    FrameTiming timing;
+    timing.SetFrameNumber(++frame_number_);
+    timing.Set(FrameTiming::kVsyncStart, frame.vsync_start);
+    timing.Set(FrameTiming::kBuildStart, build_start);
+    timing.Set(FrameTiming::kBuildFinish, build_start + build);
+    timing.Set(FrameTiming::kRasterStart,
+               std::max(build_start + build, raster_free_));
+    timing.Set(FrameTiming::kRasterFinish,
+               timing.Get(FrameTiming::kRasterStart) + raster);
+    ui_free_ = timing.Get(FrameTiming::kBuildFinish);
+    raster_free_ = timing.Get(FrameTiming::kRasterFinish);
+    pacer_.OnFrameSubmitted(frame_number_, ui_free_);
+    in_flight_.push_back(timing);
+
+    frame.raster_end = raster_free_;
+    return frame;
+  }
+
+ private:
+  void ReportFramesRasterizedBefore(fml::TimePoint time) {
+    while (!in_flight_.empty() &&
+           in_flight_.front().Get(FrameTiming::kRasterFinish) <= time) {
+      pacer_.OnFrameRasterized(in_flight_.front());
+      in_flight_.erase(in_flight_.begin());
+    }
+  }
+
+  FramePacer pacer_;
+  fml::TimePoint vsync_ = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromSeconds(1));
+  fml::TimePoint ui_free_;
+  fml::TimePoint raster_free_;
+  uint64_t frame_number_ = 0;
+  std::vector<FrameTiming> in_flight_;
+};
+
+// Enough frames for the pacer to settle on a mode.
+constexpr int kWarmUpFrames = 30;
+
+}  // namespace
+
+TEST(FramePacerTest, LateLatchesFramesThatFitInOneInterval) {
+  const fml::TimeDelta build = fml::TimeDelta::FromMilliseconds(3);
+  const fml::TimeDelta raster = fml::TimeDelta::FromMilliseconds(4);
+  FramePacerSimulation simulation(2);
+
+  for (int i = 0; i < kWarmUpFrames; i++) {
+    simulation.RunFrame(build, raster);
+  }
+  for (int i = 0; i < 60; i++) {
+    auto frame = simulation.RunFrame(build, raster);
+    ASSERT_EQ(frame.decision.mode, FramePacer::Mode::kLowLatency);
+    ASSERT_EQ(frame.decision.pipeline_depth, 1u);
+    ASSERT_FALSE(frame.skipped);
+    // The frame is presented at its target time, but its build starts as
+    // late as the predicted build and raster times allow.
+    ASSERT_LE(frame.raster_end, frame.vsync_target);
+    ASSERT_EQ(frame.vsync_target - frame.decision.build_start,
+              build + raster + FramePacer::kSafetyMargin);
+  }
+}
+
+TEST(FramePacerTest, PipelinesFramesThatDoNotFitInOneInterval) {
+  const fml::TimeDelta build = fml::TimeDelta::FromMilliseconds(10);
+  const fml::TimeDelta raster = fml::TimeDelta::FromMilliseconds(12);
+  FramePacerSimulation simulation(2);
+
+  for (int i = 0; i < kWarmUpFrames; i++) {
+    simulation.RunFrame(build, raster);
+  }
+  for (int i = 0; i < 60; i++) {
+    auto frame = simulation.RunFrame(build, raster);
+    ASSERT_EQ(frame.decision.mode, FramePacer::Mode::kThroughput);
+    ASSERT_EQ(frame.decision.pipeline_depth, 2u);
+    ASSERT_FALSE(frame.skipped);
+    // Every frame is presented one interval after its target time. The
+    // raster thread is free by the time a build completes, so builds are
+    // not delayed.
+    ASSERT_LE(frame.raster_end,
+              frame.vsync_target + FramePacerSimulation::kInterval);
+    ASSERT_EQ(frame.decision.build_start, frame.vsync_start);
+  }
+}
+
+TEST(FramePacerTest, FallsBackToThroughputModeImmediately) {
+  const fml::TimeDelta light = fml::TimeDelta::FromMilliseconds(3);
+  const fml::TimeDelta heavy = fml::TimeDelta::FromMilliseconds(11);
+  FramePacerSimulation simulation(2);
+
+  for (int i = 0; i < kWarmUpFrames; i++) {
+    simulation.RunFrame(light, light);
+  }
+  ASSERT_EQ(simulation.pacer().mode(), FramePacer::Mode::kLowLatency);
+
+  // A single slow frame is ignored as an outlier.
+  simulation.RunFrame(heavy, heavy);
+  simulation.RunFrame(light, light);
+  simulation.RunFrame(light, light);
+  ASSERT_EQ(simulation.pacer().mode(), FramePacer::Mode::kLowLatency);
+
+  // Slow frames switch to the throughput mode as soon as they are reported,
+  // and after that no more frames miss their deadline.
+  int frames_until_switch = 0;
+  while (simulation.pacer().mode() == FramePacer::Mode::kLowLatency) {
+    ASSERT_LT(++frames_until_switch, 5);
+    simulation.RunFrame(heavy, heavy);
+  }
+  for (int i = 0; i < 2; i++) {
+    simulation.RunFrame(heavy, heavy);
+  }
+  for (int i = 0; i < 60; i++) {
+    auto frame = simulation.RunFrame(heavy, heavy);
+    ASSERT_FALSE(frame.skipped);
+    ASSERT_LE(frame.raster_end,
+              frame.vsync_target + FramePacerSimulation::kInterval);
+  }
+}
+
+TEST(FramePacerTest, ReturnsToLowLatencyModeWithHysteresis) {
+  const fml::TimeDelta light = fml::TimeDelta::FromMilliseconds(3);
+  const fml::TimeDelta heavy = fml::TimeDelta::FromMilliseconds(11);
+  FramePacerSimulation simulation(2);
+
+  for (int i = 0; i < kWarmUpFrames; i++) {
+    simulation.RunFrame(heavy, heavy);
+  }
+  ASSERT_EQ(simulation.pacer().mode(), FramePacer::Mode::kThroughput);
+
+  // The slow frames have to leave the history, and then the light frames
+  // have to fit for a number of vsyncs before the mode switches back.
+  int frames_until_switch = 0;
+  while (simulation.pacer().mode() == FramePacer::Mode::kThroughput) {
+    ++frames_until_switch;
+    ASSERT_LT(frames_until_switch, kWarmUpFrames);
+    simulation.RunFrame(light, light);
+  }
+  EXPECT_GT(frames_until_switch,
+            static_cast<int>(FramePacer::kLowLatencyHysteresis));
+}
+
+TEST(FramePacerTest, DelaysBuildsOnlyWhileTheRasterThreadIsBusy) {
+  const fml::TimeDelta build = fml::TimeDelta::FromMilliseconds(10);
+  const fml::TimeDelta raster = fml::TimeDelta::FromMilliseconds(12);
+  const fml::TimeDelta interval = FramePacerSimulation::kInterval;
+  FramePacer pacer(2);
+  fml::TimePoint time =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1));
+  uint64_t frame_number = 0;
+  auto rasterize = [&](uint64_t number) {
+    FrameTiming timing;
+    timing.SetFrameNumber(number);
+    timing.Set(FrameTiming::kBuildStart, time);
+    timing.Set(FrameTiming::kBuildFinish, time + build);
+    timing.Set(FrameTiming::kRasterStart, time + build);
+    timing.Set(FrameTiming::kRasterFinish, time + build + raster);
+    pacer.OnFrameRasterized(timing);
+  };
+  for (size_t i = 0; i < FramePacer::kMinHistorySize; i++) {
+    pacer.OnFrameSubmitted(++frame_number, time + build);
+    rasterize(frame_number);
+    time = time + interval;
+  }
+
+  // With the raster thread idle, the build starts right away.
+  auto decision = pacer.OnVsync(time, time + interval, time);
+  EXPECT_EQ(decision.mode, FramePacer::Mode::kThroughput);
+  EXPECT_EQ(decision.build_start, time);
+
+  // While a frame is rasterizing, the build is delayed to complete when the
+  // raster thread is predicted to be free.
+  pacer.OnFrameSubmitted(++frame_number, time);
+  decision = pacer.OnVsync(time, time + interval, time);
+  EXPECT_EQ(decision.build_start, time + raster - build);
+
+  // A frame that the rasterizer discards is never reported, and stops
+  // delaying builds once a later frame is.
+  rasterize(frame_number + 1);
+  decision = pacer.OnVsync(time, time + interval, time);
+  EXPECT_EQ(decision.build_start, time);
+}
+
+TEST(FramePacerTest, DoesNotLateLatchWithoutHistory) {
+  FramePacer pacer(2);
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  auto decision =
+      pacer.OnVsync(vsync_start, vsync_start + FramePacerSimulation::kInterval,
+                    vsync_start);
+  EXPECT_EQ(decision.mode, FramePacer::Mode::kThroughput);
+  EXPECT_EQ(decision.pipeline_depth, 2u);
+  EXPECT_EQ(decision.build_start, vsync_start);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -22,20 +22,25 @@ namespace flutter {
 ///
 /// ```
 ///    DlOpSpy dl_op_spy;
-///    display_list.Dispatch(dl_op_spy);
+///    display_list.DispatchInlined(dl_op_spy);
 ///    bool did_draw = dl_op_spy.did_draw()
 /// ```
 ///
+/// The receiver methods are public so that the spy can be used with
+/// |DisplayList::DispatchInlined|.
+///
 class DlOpSpy final : public virtual DlOpReceiver,
-                      private IgnoreAttributeDispatchHelper,
-                      private IgnoreClipDispatchHelper,
-                      private IgnoreTransformDispatchHelper {
+                      public IgnoreAttributeDispatchHelper,
+                      public IgnoreClipDispatchHelper,
+                      public IgnoreTransformDispatchHelper {
  public:
   //----------------------------------------------------------------------------
   /// @brief      Returns true if any non transparent content has been drawn.
   bool did_draw();
 
- private:
+  using DlOpReceiver::save;
+  using DlOpReceiver::saveLayer;
+
   void setColor(DlColor color) override;
   void setColorSource(const DlColorSource* source) override;
   void save() override;
@@ -106,6 +111,7 @@ class DlOpSpy final : public virtual DlOpReceiver,
                   bool transparent_occluder,
                   DlScalar dpr) override;
 
+ private:
   // Most recently set color, used when color_source goes to null
   DlColor color_;
 
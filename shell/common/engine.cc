@@ -262,6 +262,7 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 }
 
 void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
+  pointer_data_dispatcher_->OnFrameBegin(frame_time);
   runtime_controller_->BeginFrame(frame_time, frame_number);
 }
 
@@ -269,6 +270,10 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
   runtime_controller_->NotifyIdle(deadline);
 }
@@ -445,6 +450,12 @@ void Engine::DispatchPointerDataPacket(
   pointer_data_dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
 }
 
+void Engine::SetPointerCoalescingInterval(fml::TimeDelta interval) {
+  if (runtime_controller_) {
+    runtime_controller_->SetPointerCoalescingInterval(interval);
+  }
+}
+
 void Engine::DispatchSemanticsAction(int node_id,
                                      SemanticsAction action,
                                      fml::MallocMapping args) {
@@ -628,6 +628,15 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the timings of a rasterized frame to the animator,
+  ///             which paces the following frames with them when adaptive
+  ///             frame pacing is enabled.
+  ///
+  /// @param[in]  timing  The timings of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -798,6 +807,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet,
                                  uint64_t trace_flow_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the maximum time span of the runs of move and hover
+  ///             events of a device that are coalesced into their last event
+  ///             when pointer data packets are dispatched. The shell sets it
+  ///             to the vsync interval of the main display if
+  ///             `Settings::coalesce_pointer_events` is set.
+  ///
+  /// @param[in]  interval  The maximum time span of a coalesced run. A zero
+  ///                       interval, the default, disables coalescing.
+  ///
+  void SetPointerCoalescingInterval(fml::TimeDelta interval);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder encountered an
   ///             accessibility related action on the specified node. This call
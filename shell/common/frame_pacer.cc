@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_pacer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+// Returns the 90th percentile of the durations, so that a single outlier
+// does not throw the pacer out of the low latency mode.
+fml::TimeDelta Percentile90(const std::deque<fml::TimeDelta>& durations) {
+  if (durations.empty()) {
+    return fml::TimeDelta::Zero();
+  }
+  std::vector<fml::TimeDelta> sorted(durations.begin(), durations.end());
+  size_t index = std::min(sorted.size() * 9 / 10, sorted.size() - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  return sorted[index];
+}
+
+void PushDuration(std::deque<fml::TimeDelta>& durations,
+                  fml::TimeDelta duration) {
+  durations.push_back(std::max(duration, fml::TimeDelta::Zero()));
+  if (durations.size() > FramePacer::kHistorySize) {
+    durations.pop_front();
+  }
+}
+
+}  // namespace
+
+FramePacer::FramePacer(uint32_t max_pipeline_depth)
+    : max_pipeline_depth_(std::max<uint32_t>(max_pipeline_depth, 1)) {}
+
+FramePacer::~FramePacer() = default;
+
+fml::TimeDelta FramePacer::PredictedBuildDuration() const {
+  return Percentile90(build_durations_);
+}
+
+fml::TimeDelta FramePacer::PredictedRasterDuration() const {
+  return Percentile90(raster_durations_);
+}
+
+FramePacer::Decision FramePacer::OnVsync(fml::TimePoint vsync_start,
+                                         fml::TimePoint vsync_target,
+                                         fml::TimePoint now) {
+  const fml::TimeDelta interval = vsync_target - vsync_start;
+  if (build_durations_.size() < kMinHistorySize ||
+      raster_durations_.size() < kMinHistorySize ||
+      interval <= fml::TimeDelta::Zero()) {
+    mode_ = Mode::kThroughput;
+    fitting_vsyncs_ = 0;
+    return {
+        .mode = mode_,
+        .pipeline_depth = max_pipeline_depth_,
+        .build_start = now,
+    };
+  }
+
+  const fml::TimeDelta build = PredictedBuildDuration();
+  const fml::TimeDelta raster = PredictedRasterDuration();
+  if (build + raster + kSafetyMargin > interval) {
+    mode_ = Mode::kThroughput;
+    fitting_vsyncs_ = 0;
+  } else if (mode_ == Mode::kThroughput &&
+             ++fitting_vsyncs_ >= kLowLatencyHysteresis) {
+    mode_ = Mode::kLowLatency;
+  }
+
+  fml::TimePoint build_start = now;
+  if (mode_ == Mode::kLowLatency) {
+    // The frame is rasterized within this interval, as late as the
+    // predictions allow.
+    build_start = vsync_target - kSafetyMargin - raster - build;
+  }
+  if (!pending_frames_.empty()) {
+    // Finishing the build before the raster thread is free only makes the
+    // frame wait in the pipeline.
+    build_start = std::max(build_start, raster_busy_until_ - build);
+  }
+  // The build must not run into the next vsync.
+  build_start = std::min(build_start, vsync_target - build);
+
+  return {
+      .mode = mode_,
+      .pipeline_depth =
+          mode_ == Mode::kLowLatency ? 1u : max_pipeline_depth_,
+      .build_start = std::max(now, build_start),
+  };
+}
+
+void FramePacer::OnFrameSubmitted(uint64_t frame_number,
+                                  fml::TimePoint now) {
+  const fml::TimePoint raster_start =
+      pending_frames_.empty() ? now : std::max(now, raster_busy_until_);
+  raster_busy_until_ = raster_start + PredictedRasterDuration();
+  pending_frames_.push_back(frame_number);
+}
+
+void FramePacer::OnFrameRasterized(const FrameTiming& timing) {
+  const fml::TimeDelta build_duration =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  // Frames that reuse the last layer trees are not built.
+  if (build_duration > fml::TimeDelta::Zero()) {
+    PushDuration(build_durations_, build_duration);
+  }
+  PushDuration(raster_durations_, timing.Get(FrameTiming::kRasterFinish) -
+                                      timing.Get(FrameTiming::kRasterStart));
+
+  // This also drops the frames that the rasterizer discarded, which are
+  // never reported.
+  while (!pending_frames_.empty() &&
+         pending_frames_.front() <= timing.GetFrameNumber()) {
+    pending_frames_.pop_front();
+  }
+  if (pending_frames_.empty()) {
+    raster_busy_until_ = timing.Get(FrameTiming::kRasterFinish);
+  }
+}
+
+}  // namespace flutter
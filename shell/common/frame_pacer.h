@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+
+#include <cstdint>
+#include <deque>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Decides, frame by frame, how deep the frame pipeline may be and when the
+/// UI thread should start building a frame, from the build and raster times
+/// of recent frames.
+///
+/// When a frame is predicted to build and rasterize within one vsync
+/// interval, the pacer selects a pipeline depth of 1 and delays the start of
+/// the build ("late latching") so that the frame is rasterized just before
+/// its target time. Input that arrives during the delay is then presented one
+/// frame earlier than it would otherwise be.
+///
+/// When the frames don't fit in one interval, the pacer selects the maximum
+/// depth so that building and rasterizing overlap. A build then starts right
+/// away, unless the raster thread is predicted to still be busy with earlier
+/// frames when it would complete. In that case it is delayed to complete
+/// when the raster thread is free.
+///
+/// All methods must be called on the same thread.
+class FramePacer {
+ public:
+  enum class Mode {
+    // NOLINTBEGIN(readability-identifier-naming)
+    kLowLatency,
+    kThroughput,
+    // NOLINTEND(readability-identifier-naming)
+  };
+
+  struct Decision {
+    Mode mode = Mode::kThroughput;
+    uint32_t pipeline_depth = 1;
+    /// When the UI thread should start building the frame. Never before the
+    /// time the decision was made.
+    fml::TimePoint build_start;
+  };
+
+  /// The number of recent frames the predictions are made from.
+  static constexpr size_t kHistorySize = 16;
+
+  /// The number of frames recorded before the pacer starts to late latch.
+  static constexpr size_t kMinHistorySize = 4;
+
+  /// The number of consecutive vsyncs at which the frames are predicted to
+  /// fit in one interval before switching back to the low latency mode.
+  static constexpr uint32_t kLowLatencyHysteresis = 8;
+
+  /// Slack kept between the predicted end of the rasterization and the
+  /// deadline, to absorb scheduling jitter.
+  static constexpr fml::TimeDelta kSafetyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  explicit FramePacer(uint32_t max_pipeline_depth);
+
+  ~FramePacer();
+
+  /// Makes the pacing decision for the frame of a vsync.
+  Decision OnVsync(fml::TimePoint vsync_start,
+                   fml::TimePoint vsync_target,
+                   fml::TimePoint now);
+
+  /// Records that the built frame |frame_number| was submitted to the
+  /// pipeline at |now|.
+  void OnFrameSubmitted(uint64_t frame_number, fml::TimePoint now);
+
+  /// Records the timings of a rasterized frame. Frames are rasterized in
+  /// order, so the frames submitted before it that were never reported are
+  /// known to have been discarded.
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  Mode mode() const { return mode_; }
+
+  /// The build time that frames are predicted not to exceed.
+  fml::TimeDelta PredictedBuildDuration() const;
+
+  /// The raster time that frames are predicted not to exceed.
+  fml::TimeDelta PredictedRasterDuration() const;
+
+ private:
+  const uint32_t max_pipeline_depth_;
+  Mode mode_ = Mode::kThroughput;
+  uint32_t fitting_vsyncs_ = 0;
+  std::deque<fml::TimeDelta> build_durations_;
+  std::deque<fml::TimeDelta> raster_durations_;
+  // The numbers of the frames that were submitted but have not been reported
+  // rasterized, in the order they were submitted.
+  std::deque<uint64_t> pending_frames_;
+  // When the raster thread is predicted to finish the submitted frames.
+  fml::TimePoint raster_busy_until_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePacer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_PACER_H_
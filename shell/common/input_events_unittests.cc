@@ -440,6 +440,74 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, CoalescesPointerPacketsSentWhileUIThreadIsBusy) {
+  // Sets up shell with test fixture.
+  auto settings = CreateSettingsForFixture();
+  settings.coalesce_pointer_events = true;
+  std::unique_ptr<Shell> shell = CreateShell({
+      .settings = settings,
+      .platform_view_create_callback = ShellTestPlatformViewBuilder({
+          .simulate_vsync = true,
+      }),
+  });
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onPointerDataPacketMain");
+  // Sets up native handler.
+  fml::AutoResetWaitableEvent reportLatch;
+  std::vector<int64_t> result_sequence;
+  auto nativeOnPointerDataPacket = [&reportLatch, &result_sequence](
+                                       Dart_NativeArguments args) {
+    Dart_Handle exception = nullptr;
+    result_sequence = tonic::DartConverter<std::vector<int64_t>>::FromArguments(
+        args, 0, exception);
+    reportLatch.Signal();
+  };
+  // Starts engine.
+  AddNativeCallback("NativeOnPointerDataPacket",
+                    CREATE_NATIVE_ENTRY(nativeOnPointerDataPacket));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+
+  // Keeps the UI thread busy while the packets are sent, one per event.
+  fml::AutoResetWaitableEvent unblockLatch;
+  shell->GetTaskRunners().GetUITaskRunner()->PostTask(
+      [&unblockLatch]() { unblockLatch.Wait(); });
+  std::vector<std::pair<PointerData::Change, double>> events = {
+      {PointerData::Change::kAdd, 0.0},    {PointerData::Change::kDown, 0.0},
+      {PointerData::Change::kMove, 1.0},   {PointerData::Change::kMove, 2.0},
+      {PointerData::Change::kMove, 3.0},   {PointerData::Change::kUp, 3.0},
+      {PointerData::Change::kRemove, 3.0},
+  };
+  for (const auto& [change, dy] : events) {
+    auto packet = std::make_unique<PointerDataPacket>(1);
+    PointerData data;
+    CreateSimulatedPointerData(data, change, 3.0, dy);
+    packet->SetPointerData(0, data);
+    ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+  }
+  unblockLatch.Signal();
+  ShellTest::VSyncFlush(shell.get());
+
+  // The packets are dispatched together, and the moves are coalesced.
+  reportLatch.Wait();
+  size_t expect_length = 5;
+  ASSERT_EQ(result_sequence.size(), expect_length);
+  ASSERT_EQ(PointerData::Change(result_sequence[0]), PointerData::Change::kAdd);
+  ASSERT_EQ(PointerData::Change(result_sequence[1]),
+            PointerData::Change::kDown);
+  ASSERT_EQ(PointerData::Change(result_sequence[2]),
+            PointerData::Change::kMove);
+  ASSERT_EQ(PointerData::Change(result_sequence[3]), PointerData::Change::kUp);
+  ASSERT_EQ(PointerData::Change(result_sequence[4]),
+            PointerData::Change::kRemove);
+
+  // Cleans up shell.
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
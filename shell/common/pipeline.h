@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -129,19 +130,35 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        depth_limit_(depth),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// Limits the number of resources in flight to fewer than the depth the
+  /// pipeline was created with, until the limit is changed again. The limit
+  /// is clamped to [1, depth]. Resources that are already in flight are not
+  /// affected, |Produce| fails until enough of them have been consumed.
+  ///
+  /// Must be called by the producer.
+  void SetDepthLimit(uint32_t limit) {
+    depth_limit_ = std::clamp<uint32_t>(limit, 1, depth_);
+  }
+
+  uint32_t GetDepthLimit() const { return depth_limit_; }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!HasRoomForProducer() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -162,7 +179,7 @@ class Pipeline {
   /// Prefer using |Produce|. ProducerContinuation returned by this method
   /// doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!HasRoomForProducer() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -213,12 +230,20 @@ class Pipeline {
   }
 
  private:
+  const uint32_t depth_;
+  uint32_t depth_limit_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  // Only the producer increments |inflight_|, so a resource consumed
+  // concurrently can at worst make this return false spuriously.
+  bool HasRoomForProducer() const {
+    return static_cast<uint32_t>(inflight_.load()) < depth_limit_;
+  }
+
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
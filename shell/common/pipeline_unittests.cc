@@ -144,5 +144,38 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DepthLimitRestrictsProduce) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetDepthLimit(1);
+  ASSERT_EQ(pipeline->GetDepthLimit(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(1));
+  ASSERT_EQ(result.success, true);
+
+  // The pipeline has room for another item, but not within the limit.
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_FALSE(continuation_2);
+  ASSERT_FALSE(pipeline->ProduceIfEmpty());
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+
+  // Raising the limit allows a second item in flight again, but never more
+  // than the depth of the pipeline.
+  pipeline->SetDepthLimit(5);
+  ASSERT_EQ(pipeline->GetDepthLimit(), 2u);
+  Continuation continuation_4 = pipeline->Produce();
+  ASSERT_TRUE(continuation_4);
+  ASSERT_FALSE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,17 +4,43 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+namespace {
+
+bool IsResampledKind(const PointerData& data) {
+  switch (data.kind) {
+    case PointerData::DeviceKind::kTouch:
+    case PointerData::DeviceKind::kStylus:
+    case PointerData::DeviceKind::kInvertedStylus:
+      return data.signal_kind == PointerData::SignalKind::kNone;
+    case PointerData::DeviceKind::kMouse:
+    case PointerData::DeviceKind::kTrackpad:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
+void PointerDataDispatcher::OnFrameBegin(fml::TimePoint frame_target_time) {}
+
 SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +98,197 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "ResamplingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  std::vector<PointerData> events;
+  bool has_new_moves = false;
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    PointerData data = packet->GetPointerData(i);
+    auto pending = std::find(pending_devices_.begin(), pending_devices_.end(),
+                             data.device);
+    if (IsResampledKind(data) && data.change == PointerData::Change::kMove) {
+      resampler_.AddSample(data);
+      if (pending == pending_devices_.end()) {
+        pending_devices_.push_back(data.device);
+      }
+      has_new_moves = true;
+      continue;
+    }
+
+    if (pending != pending_devices_.end()) {
+      events.push_back(resampler_.GetLatestSample(data.device));
+      pending_devices_.erase(pending);
+    }
+    events.push_back(data);
+
+    switch (data.change) {
+      case PointerData::Change::kDown:
+        // The history of a pointer starts over with each contact.
+        resampler_.RemoveDevice(data.device);
+        extrapolated_devices_.erase(data.device);
+        if (IsResampledKind(data)) {
+          resampler_.AddSample(data);
+        }
+        break;
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel:
+      case PointerData::Change::kRemove:
+        resampler_.RemoveDevice(data.device);
+        extrapolated_devices_.erase(data.device);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (has_new_moves) {
+    pending_trace_flow_ids_.push_back(trace_flow_id);
+  }
+  if (!events.empty()) {
+    DispatchEvents(events, trace_flow_id);
+  } else if (!has_new_moves) {
+    TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
+  }
+
+  if (pending_devices_.empty()) {
+    // The pending moves were all dispatched ahead of later events.
+    for (uint64_t pending_flow_id : pending_trace_flow_ids_) {
+      if (pending_flow_id != trace_flow_id) {
+        TRACE_FLOW_END("flutter", "PointerEvent", pending_flow_id);
+      }
+    }
+    pending_trace_flow_ids_.clear();
+  } else if (has_new_moves) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void ResamplingPointerDataDispatcher::OnFrameBegin(
+    fml::TimePoint frame_target_time) {
+  if (!pending_devices_.empty()) {
+    DispatchPendingMoves(frame_target_time.ToEpochDelta().ToMicroseconds());
+  }
+}
+
+void ResamplingPointerDataDispatcher::DispatchPendingMoves(
+    std::optional<int64_t> time_micros) {
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchPendingMoves");
+  std::vector<PointerData> events;
+  events.reserve(pending_devices_.size());
+  for (int64_t device : pending_devices_) {
+    const PointerData& latest = resampler_.GetLatestSample(device);
+    if (!time_micros.has_value()) {
+      events.push_back(latest);
+      extrapolated_devices_.erase(device);
+      continue;
+    }
+    PointerData event = resampler_.Resample(device, time_micros.value());
+    if (event.time_stamp > latest.time_stamp) {
+      extrapolated_devices_[device] = 0;
+    } else {
+      extrapolated_devices_.erase(device);
+    }
+    auto dispatched = dispatched_positions_.find(device);
+    if (dispatched != dispatched_positions_.end() &&
+        event.time_stamp < dispatched->second.time_stamp) {
+      event.time_stamp = dispatched->second.time_stamp;
+    }
+    events.push_back(event);
+  }
+  pending_devices_.clear();
+
+  // The moves of all the pending packets are dispatched together. Only the
+  // flow of the latest packet continues to the frame.
+  FML_DCHECK(!pending_trace_flow_ids_.empty());
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t superseded_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", superseded_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+
+  DispatchEvents(events, trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::DispatchEvents(
+    std::vector<PointerData>& events,
+    uint64_t trace_flow_id) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    PointerData& event = events[i];
+    const bool resampled = IsResampledKind(event) &&
+                           event.change == PointerData::Change::kMove;
+    auto dispatched = dispatched_positions_.find(event.device);
+    if (dispatched != dispatched_positions_.end() &&
+        (resampled || dispatched->second.resampled)) {
+      // The deltas were computed against events that were not dispatched.
+      event.physical_delta_x =
+          event.physical_x - dispatched->second.physical_x;
+      event.physical_delta_y =
+          event.physical_y - dispatched->second.physical_y;
+    }
+    if (event.change == PointerData::Change::kRemove) {
+      dispatched_positions_.erase(event.device);
+    } else if (IsResampledKind(event)) {
+      dispatched_positions_[event.device] = {
+          .physical_x = event.physical_x,
+          .physical_y = event.physical_y,
+          .time_stamp = event.time_stamp,
+          .resampled = resampled,
+      };
+    }
+    packet->SetPointerData(i, event);
+  }
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::OnSecondaryVsyncCallback() {
+  // The secondary callbacks run after the frame callback of the same vsync,
+  // so the moves are still pending here only if no frame began.
+  if (!pending_devices_.empty()) {
+    DispatchPendingMoves(std::nullopt);
+  }
+
+  std::vector<PointerData> settled;
+  for (auto it = extrapolated_devices_.begin();
+       it != extrapolated_devices_.end();) {
+    if (++it->second < kSettleVsyncs) {
+      ++it;
+      continue;
+    }
+    PointerData event = resampler_.GetLatestSample(it->first);
+    event.time_stamp =
+        std::max(event.time_stamp, dispatched_positions_[it->first].time_stamp);
+    settled.push_back(event);
+    it = extrapolated_devices_.erase(it);
+  }
+  if (!settled.empty()) {
+    const uint64_t trace_flow_id = fml::tracing::TraceNonce();
+    TRACE_FLOW_BEGIN("flutter", "PointerEvent", trace_flow_id);
+    DispatchEvents(settled, trace_flow_id);
+  }
+
+  if (!extrapolated_devices_.empty()) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->OnSecondaryVsyncCallback();
+        }
+      });
+}
+
 }  // namespace flutter
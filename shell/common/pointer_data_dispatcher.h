@@ -5,8 +5,13 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/pointer_data_resampler.h"
 
 namespace flutter {
 
@@ -74,6 +79,14 @@ class PointerDataDispatcher {
   virtual void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Signal that the engine is about to begin building a frame.
+  ///             Packets dispatched from here are handled before the frame
+  ///             is built.
+  ///
+  /// @param[in]  frame_target_time  The time the frame is presented at.
+  virtual void OnFrameBegin(fml::TimePoint frame_target_time);
+
   //----------------------------------------------------------------------------
   /// @brief      Default destructor.
   virtual ~PointerDataDispatcher();
@@ -163,6 +176,74 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds back the move events of touches and styluses, and
+/// dispatches a single move per pointer at the beginning of each frame, with
+/// the position the pointer is predicted to have when the frame is presented.
+///
+/// Without resampling, a frame shows the pointer where it was at the latest
+/// sample delivered before the frame was built, which is between one and two
+/// sampling intervals plus the whole frame latency behind. The resampled
+/// position is interpolated or extrapolated from the recent samples of the
+/// pointer by |PointerDataResampler| at the target time of the frame, which
+/// removes most of that lag for drags and scrolls.
+///
+/// All other events are dispatched right away. The pending move of a pointer
+/// is dispatched, unresampled, before any other event of the same pointer,
+/// so that the order of the events of each pointer is kept. The deltas of all
+/// dispatched events are relative to the previous dispatched event of their
+/// pointer.
+///
+/// If no frame begins by the vsync after a move was received, the moves are
+/// dispatched unresampled at that vsync, since the framework may only
+/// schedule a frame once it sees them. A pointer whose position was
+/// extrapolated and that has no new samples for |kSettleVsyncs| vsyncs is
+/// considered to have stopped, and is moved back to its latest sample.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  static constexpr int kSettleVsyncs = 3;
+
+  explicit ResamplingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  // |PointerDataDispatcer|
+  void OnFrameBegin(fml::TimePoint frame_target_time) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  struct DispatchedPosition {
+    double physical_x = 0;
+    double physical_y = 0;
+    int64_t time_stamp = 0;
+    bool resampled = false;
+  };
+
+  // Dispatches the pending moves, resampled at |time_micros| if set.
+  void DispatchPendingMoves(std::optional<int64_t> time_micros);
+  void DispatchEvents(std::vector<PointerData>& events,
+                      uint64_t trace_flow_id);
+  void OnSecondaryVsyncCallback();
+  void ScheduleSecondaryVsyncCallback();
+
+  PointerDataResampler resampler_;
+  // The pointers with moves that have not been dispatched yet.
+  std::vector<int64_t> pending_devices_;
+  // The flow ids of the packets whose moves have not been dispatched yet.
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::unordered_map<int64_t, DispatchedPosition> dispatched_positions_;
+  // The pointers whose latest dispatched position was extrapolated, with the
+  // number of vsyncs since.
+  std::unordered_map<int64_t, int> extrapolated_devices_;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_resampler.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+PointerDataResampler::PointerDataResampler() = default;
+
+PointerDataResampler::~PointerDataResampler() = default;
+
+void PointerDataResampler::AddSample(const PointerData& data) {
+  std::deque<PointerData>& samples = samples_[data.device];
+  if (!samples.empty() && data.time_stamp < samples.back().time_stamp) {
+    return;
+  }
+  samples.push_back(data);
+  if (samples.size() > kMaxSamples) {
+    samples.pop_front();
+  }
+}
+
+void PointerDataResampler::RemoveDevice(int64_t device) {
+  samples_.erase(device);
+}
+
+bool PointerDataResampler::HasDevice(int64_t device) const {
+  return samples_.find(device) != samples_.end();
+}
+
+const PointerData& PointerDataResampler::GetLatestSample(
+    int64_t device) const {
+  auto found = samples_.find(device);
+  FML_DCHECK(found != samples_.end() && !found->second.empty());
+  return found->second.back();
+}
+
+PointerData PointerDataResampler::Resample(int64_t device,
+                                           int64_t time_micros) const {
+  auto found = samples_.find(device);
+  FML_DCHECK(found != samples_.end() && !found->second.empty());
+  const std::deque<PointerData>& samples = found->second;
+  const PointerData& latest = samples.back();
+
+  PointerData result = latest;
+  result.time_stamp = time_micros;
+
+  if (time_micros < samples.front().time_stamp) {
+    // Moving the pointer back to a position it had long ago would be worse
+    // than not resampling it.
+    result.time_stamp = latest.time_stamp;
+    return result;
+  }
+
+  if (time_micros <= latest.time_stamp) {
+    auto next = std::lower_bound(samples.begin(), samples.end(), time_micros,
+                                 [](const PointerData& sample, int64_t time) {
+                                   return sample.time_stamp < time;
+                                 });
+    if (next == samples.begin()) {
+      result.physical_x = next->physical_x;
+      result.physical_y = next->physical_y;
+      return result;
+    }
+    auto previous = next - 1;
+    const double span = next->time_stamp - previous->time_stamp;
+    const double t =
+        span > 0 ? (time_micros - previous->time_stamp) / span : 1.0;
+    result.physical_x =
+        previous->physical_x + (next->physical_x - previous->physical_x) * t;
+    result.physical_y =
+        previous->physical_y + (next->physical_y - previous->physical_y) * t;
+    return result;
+  }
+
+  // Fit x(t) and y(t) to lines through the samples of the velocity window.
+  double sum_t = 0, sum_tt = 0, sum_x = 0, sum_tx = 0, sum_y = 0, sum_ty = 0;
+  size_t count = 0;
+  for (auto it = samples.rbegin(); it != samples.rend(); ++it) {
+    const double t = it->time_stamp - latest.time_stamp;
+    if (-t > kVelocityWindowMicros) {
+      break;
+    }
+    sum_t += t;
+    sum_tt += t * t;
+    sum_x += it->physical_x;
+    sum_tx += t * it->physical_x;
+    sum_y += it->physical_y;
+    sum_ty += t * it->physical_y;
+    count++;
+  }
+  const double denominator = count * sum_tt - sum_t * sum_t;
+  if (count < 2 || denominator <= 0) {
+    return result;
+  }
+  const double velocity_x = (count * sum_tx - sum_t * sum_x) / denominator;
+  const double velocity_y = (count * sum_ty - sum_t * sum_y) / denominator;
+  // Extrapolate from the fitted position at the latest sample rather than
+  // from the latest sample itself, whose jitter the fit averages out.
+  const double fitted_x = (sum_x - velocity_x * sum_t) / count;
+  const double fitted_y = (sum_y - velocity_y * sum_t) / count;
+  const double prediction =
+      std::min(time_micros - latest.time_stamp, kMaxPredictionMicros);
+  result.physical_x = fitted_x + velocity_x * prediction;
+  result.physical_y = fitted_y + velocity_y * prediction;
+  return result;
+}
+
+}  // namespace flutter
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
+#define FLUTTER_SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/pointer_data.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps a short history of the samples of each pointer device, and computes
+/// the position of a device at an arbitrary time from it.
+///
+/// Positions between two samples are interpolated linearly. Positions after
+/// the latest sample are extrapolated with the velocity fitted to the recent
+/// samples by least squares, which averages out the jitter of individual
+/// samples. The extrapolation is capped at |kMaxPredictionMicros|, so that a
+/// pointer that stops abruptly overshoots by a bounded amount.
+///
+/// The time stamps of the samples and the sampling times are in
+/// microseconds, and must be measured with the same clock.
+class PointerDataResampler {
+ public:
+  /// The maximum number of samples kept for each device.
+  static constexpr size_t kMaxSamples = 12;
+
+  /// How far back from the latest sample the velocity is fitted.
+  static constexpr int64_t kVelocityWindowMicros = 40000;
+
+  /// How far past the latest sample positions are extrapolated.
+  static constexpr int64_t kMaxPredictionMicros = 16000;
+
+  PointerDataResampler();
+
+  ~PointerDataResampler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a sample to the history of its device. Samples older
+  ///             than the latest one of the device are ignored.
+  ///
+  void AddSample(const PointerData& data);
+
+  void RemoveDevice(int64_t device);
+
+  bool HasDevice(int64_t device) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the latest sample of |device| with its position and
+  ///             time stamp resampled at |time_micros|. Sampling times before
+  ///             the first sample in the history, which can only be the
+  ///             result of clocks that don't match, return the latest sample
+  ///             unchanged.
+  ///
+  ///             The device must have a sample.
+  ///
+  PointerData Resample(int64_t device, int64_t time_micros) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the latest sample of |device|, which must have one.
+  ///
+  const PointerData& GetLatestSample(int64_t device) const;
+
+ private:
+  std::unordered_map<int64_t, std::deque<PointerData>> samples_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataResampler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
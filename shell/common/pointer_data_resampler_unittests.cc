@@ -0,0 +1,365 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/shell/common/pointer_data_resampler.h"
+
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr int64_t kFrameIntervalMicros = 16667;
+
+PointerData CreateTouch(PointerData::Change change,
+                        int64_t time_stamp,
+                        double x,
+                        double y = 0,
+                        int64_t device = 0) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.device = device;
+  data.time_stamp = time_stamp;
+  data.physical_x = x;
+  data.physical_y = y;
+  return data;
+}
+
+// The x position of a pointer at a time in microseconds.
+using Trajectory = std::function<double(int64_t)>;
+
+struct TraceSample {
+  int64_t delivery_time;
+  PointerData data;
+};
+
+// Records a touch that follows |trajectory| for |duration| microseconds like
+// a 120Hz touch screen does: the samples are taken at jittery times, their
+// positions are noisy, and they are delivered in batches after a jittery
+// latency.
+std::vector<TraceSample> RecordTrace(const Trajectory& trajectory,
+                                     int64_t duration,
+                                     uint32_t seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int64_t> time_jitter(-1000, 1000);
+  std::uniform_real_distribution<double> position_noise(-0.5, 0.5);
+  std::uniform_int_distribution<int64_t> delivery_latency(4000, 12000);
+
+  std::vector<TraceSample> trace;
+  int64_t delivery_time = 0;
+  for (int64_t time = 0; time < duration; time += 8333) {
+    const int64_t sample_time = time + time_jitter(random);
+    // Deliveries are never reordered.
+    delivery_time = std::max(delivery_time, time + delivery_latency(random));
+    trace.push_back({
+        .delivery_time = delivery_time,
+        .data = CreateTouch(
+            trace.empty() ? PointerData::Change::kDown
+                          : PointerData::Change::kMove,
+            sample_time, trajectory(sample_time) + position_noise(random)),
+    });
+  }
+  return trace;
+}
+
+struct TraceError {
+  // The mean distance between the position dispatched for a frame and the
+  // position of the pointer when the frame is presented.
+  double resampled = 0;
+  // The same for the latest sample delivered before the frame, which is
+  // what a frame shows without resampling.
+  double latest_sample = 0;
+};
+
+// Replays |trace| against 60Hz frames, and measures the error of the frames
+// that begin between |from| and |to|.
+TraceError MeasureTraceError(const std::vector<TraceSample>& trace,
+                             const Trajectory& trajectory,
+                             int64_t from,
+                             int64_t to) {
+  PointerDataResampler resampler;
+  TraceError error;
+  int frames = 0;
+  size_t next_sample = 0;
+  for (int64_t vsync = 0; vsync < to; vsync += kFrameIntervalMicros) {
+    while (next_sample < trace.size() &&
+           trace[next_sample].delivery_time <= vsync) {
+      resampler.AddSample(trace[next_sample++].data);
+    }
+    if (vsync < from || !resampler.HasDevice(0)) {
+      continue;
+    }
+    const int64_t target = vsync + kFrameIntervalMicros;
+    const double position = trajectory(target);
+    error.resampled +=
+        std::abs(resampler.Resample(0, target).physical_x - position);
+    error.latest_sample +=
+        std::abs(resampler.GetLatestSample(0).physical_x - position);
+    frames++;
+  }
+  error.resampled /= frames;
+  error.latest_sample /= frames;
+  return error;
+}
+
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      dispatched.push_back(packet->GetPointerData(i));
+    }
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    secondary_callback_ = callback;
+  }
+
+  // Simulates a vsync, which begins a frame if |frame_target_time| is set.
+  void FireVsync(PointerDataDispatcher& dispatcher,
+                 std::optional<int64_t> frame_target_time) {
+    if (frame_target_time.has_value()) {
+      dispatcher.OnFrameBegin(fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromMicroseconds(frame_target_time.value())));
+    }
+    fml::closure callback = std::move(secondary_callback_);
+    secondary_callback_ = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<PointerData> dispatched;
+
+ private:
+  fml::closure secondary_callback_;
+};
+
+void Dispatch(PointerDataDispatcher& dispatcher,
+              const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  dispatcher.DispatchPacket(std::move(packet), /*trace_flow_id=*/0);
+}
+
+}  // namespace
+
+TEST(PointerDataResamplerTest, InterpolatesBetweenSamples) {
+  PointerDataResampler resampler;
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 1000, 10, 20));
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 2000, 20, 40));
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 4000, 40, 40));
+
+  PointerData data = resampler.Resample(0, 1500);
+  EXPECT_EQ(data.time_stamp, 1500);
+  EXPECT_DOUBLE_EQ(data.physical_x, 15);
+  EXPECT_DOUBLE_EQ(data.physical_y, 30);
+
+  data = resampler.Resample(0, 3000);
+  EXPECT_DOUBLE_EQ(data.physical_x, 30);
+  EXPECT_DOUBLE_EQ(data.physical_y, 40);
+
+  data = resampler.Resample(0, 1000);
+  EXPECT_DOUBLE_EQ(data.physical_x, 10);
+  EXPECT_EQ(data.change, PointerData::Change::kMove);
+}
+
+TEST(PointerDataResamplerTest, ExtrapolatesUpToMaxPrediction) {
+  PointerDataResampler resampler;
+  for (int64_t time = 0; time <= 32000; time += 8000) {
+    // 1 pixel per millisecond.
+    resampler.AddSample(
+        CreateTouch(PointerData::Change::kMove, time, time / 1000.0));
+  }
+
+  EXPECT_NEAR(resampler.Resample(0, 36000).physical_x, 36, 1e-9);
+  const int64_t far_future =
+      32000 + PointerDataResampler::kMaxPredictionMicros * 10;
+  PointerData data = resampler.Resample(0, far_future);
+  EXPECT_EQ(data.time_stamp, far_future);
+  EXPECT_NEAR(data.physical_x,
+              32 + PointerDataResampler::kMaxPredictionMicros / 1000.0, 1e-9);
+}
+
+TEST(PointerDataResamplerTest, IgnoresSamplingTimesBeforeHistory) {
+  PointerDataResampler resampler;
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 50000, 10));
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 58000, 20));
+  // A sample older than the latest one is dropped.
+  resampler.AddSample(CreateTouch(PointerData::Change::kMove, 54000, 99));
+
+  PointerData data = resampler.Resample(0, 1000);
+  EXPECT_EQ(data.time_stamp, 58000);
+  EXPECT_DOUBLE_EQ(data.physical_x, 20);
+  EXPECT_DOUBLE_EQ(resampler.GetLatestSample(0).physical_x, 20);
+}
+
+TEST(PointerDataResamplerTest, ReducesErrorOfJitteryDrag) {
+  // 1000 pixels per second.
+  Trajectory drag = [](int64_t time) { return time / 1000.0; };
+  for (uint32_t seed = 0; seed < 4; seed++) {
+    auto trace = RecordTrace(drag, 1000000, seed);
+    TraceError error = MeasureTraceError(trace, drag, 100000, 1000000);
+    // Without resampling the frames lag behind by more than 16ms, the
+    // prediction covers about half of it.
+    EXPECT_GT(error.latest_sample, 16) << seed;
+    EXPECT_LT(error.resampled, error.latest_sample * 0.6) << seed;
+  }
+}
+
+TEST(PointerDataResamplerTest, ReducesErrorOfJitteryScroll) {
+  // A back and forth scroll with a period of one second and a peak speed of
+  // about 1250 pixels per second.
+  Trajectory scroll = [](int64_t time) {
+    return 200 * std::sin(time * 2 * M_PI / 1000000.0);
+  };
+  for (uint32_t seed = 0; seed < 4; seed++) {
+    auto trace = RecordTrace(scroll, 2000000, seed);
+    TraceError error = MeasureTraceError(trace, scroll, 100000, 2000000);
+    EXPECT_LT(error.resampled, error.latest_sample * 0.6) << seed;
+  }
+}
+
+TEST(PointerDataResamplerTest, BoundsOvershootOfStoppedDrag) {
+  // A drag that stops at 300ms, after which the finger rests on the screen.
+  Trajectory stop = [](int64_t time) {
+    return std::min<int64_t>(time, 300000) / 1000.0;
+  };
+  for (uint32_t seed = 0; seed < 4; seed++) {
+    auto trace = RecordTrace(stop, 1000000, seed);
+    // The overshoot never exceeds the maximum prediction...
+    TraceError stopping = MeasureTraceError(trace, stop, 300000, 400000);
+    EXPECT_LT(stopping.resampled,
+              PointerDataResampler::kMaxPredictionMicros / 1000.0)
+        << seed;
+    // ...and vanishes once the stop leaves the velocity window.
+    TraceError stopped = MeasureTraceError(trace, stop, 400000, 1000000);
+    EXPECT_LT(stopped.resampled, 1) << seed;
+  }
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesMovesAtFrameTargetTime) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kDown, 0, 0)});
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].change, PointerData::Change::kDown);
+
+  // Moves are held back until the next frame begins.
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kMove, 8000, 8)});
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kMove, 12000, 12),
+                        CreateTouch(PointerData::Change::kMove, 16000, 16)});
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+
+  delegate.FireVsync(dispatcher, 20000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  const PointerData& move = delegate.dispatched[1];
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, 20000);
+  EXPECT_NEAR(move.physical_x, 20, 1e-9);
+  EXPECT_NEAR(move.physical_delta_x, 20, 1e-9);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, KeepsOrderOfEventsOfAPointer) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kDown, 0, 0)});
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kMove, 8000, 8)});
+  delegate.FireVsync(dispatcher, 16000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  ASSERT_NEAR(delegate.dispatched[1].physical_x, 16, 1e-9);
+
+  PointerData move = CreateTouch(PointerData::Change::kMove, 18000, 18);
+  move.physical_delta_x = 10;
+  PointerData up = CreateTouch(PointerData::Change::kUp, 19000, 19);
+  up.physical_delta_x = 1;
+  Dispatch(dispatcher, {move});
+  Dispatch(dispatcher, {up});
+
+  // The pending move is dispatched as is before the up event, with the
+  // deltas relative to the dispatched positions.
+  ASSERT_EQ(delegate.dispatched.size(), 4u);
+  EXPECT_EQ(delegate.dispatched[2].change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[2].physical_x, 18);
+  EXPECT_NEAR(delegate.dispatched[2].physical_delta_x, 2, 1e-9);
+  EXPECT_EQ(delegate.dispatched[3].change, PointerData::Change::kUp);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[3].physical_delta_x, 1);
+
+  // Nothing is left to dispatch.
+  delegate.FireVsync(dispatcher, 32000);
+  EXPECT_EQ(delegate.dispatched.size(), 4u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesMovesAtVsyncWithoutFrame) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kDown, 0, 0)});
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kMove, 8000, 8)});
+  delegate.FireVsync(dispatcher, std::nullopt);
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  EXPECT_EQ(delegate.dispatched[1].time_stamp, 8000);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, 8);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, SettlesStoppedPointer) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kDown, 0, 0)});
+  Dispatch(dispatcher, {CreateTouch(PointerData::Change::kMove, 8000, 8)});
+  delegate.FireVsync(dispatcher, 16000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  ASSERT_GT(delegate.dispatched[1].physical_x, 8);
+
+  for (int i = 1; i < ResamplingPointerDataDispatcher::kSettleVsyncs; i++) {
+    delegate.FireVsync(dispatcher, std::nullopt);
+  }
+  ASSERT_EQ(delegate.dispatched.size(), 3u);
+  const PointerData& settled = delegate.dispatched[2];
+  EXPECT_EQ(settled.change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(settled.physical_x, 8);
+  EXPECT_NEAR(settled.physical_delta_x, 8 - delegate.dispatched[1].physical_x,
+              1e-9);
+  EXPECT_EQ(settled.time_stamp, 16000);
+
+  delegate.FireVsync(dispatcher, std::nullopt);
+  EXPECT_EQ(delegate.dispatched.size(), 3u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesMouseMovesRightAway) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  PointerData hover = CreateTouch(PointerData::Change::kHover, 0, 5);
+  hover.kind = PointerData::DeviceKind::kMouse;
+  PointerData move = CreateTouch(PointerData::Change::kMove, 8000, 8);
+  move.kind = PointerData::DeviceKind::kMouse;
+  Dispatch(dispatcher, {hover, move});
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  EXPECT_EQ(delegate.dispatched[1].change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, 8);
+}
+
+}  // namespace testing
+}  // namespace flutter
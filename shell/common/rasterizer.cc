@@ -12,7 +12,9 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/utils/dl_serialization.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/base64.h"
@@ -41,6 +43,7 @@
 #include "impeller/core/formats.h"                // nogncheck
 #include "impeller/display_list/aiks_context.h"   // nogncheck
 #include "impeller/display_list/dl_dispatcher.h"  // nogncheck
+#include "impeller/typographer/backends/skia/typeface_skia.h"  // nogncheck
 #endif
 
 namespace flutter {
@@ -655,6 +658,11 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
+    // Subtrees that the framework rebuilt without changes take the place of
+    // the instances of the previous frame, which diffing, prerolling and the
+    // raster cache then treat as retained.
+    layer_tree->ReuseIdenticalSubtrees(GetLastLayerTree(view_id));
+
     DrawSurfaceStatus status = DrawToSurfaceUnsafe(
         view_id, *layer_tree, device_pixel_ratio, presentation_time);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
@@ -662,6 +670,7 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     auto& view_record = EnsureViewRecord(task->view_id);
     view_record.last_draw_status = status;
     if (status == DrawSurfaceStatus::kSuccess) {
+      CaptureFrameIfRequested(view_id, *layer_tree);
       view_record.last_successful_task = std::make_unique<LayerTreeTask>(
           view_id, std::move(layer_tree), device_pixel_ratio);
     } else if (status == DrawSurfaceStatus::kRetry) {
@@ -739,17 +748,27 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
   if (compositor_frame) {
     NOT_SLIMPELLER(compositor_context_->raster_cache().BeginFrame());
 
+    const bool submits_to_embedder =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+    const bool embedder_uses_frame_damage =
+        submits_to_embedder && external_view_embedder_->UsesFrameDamage();
+
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
-    if (frame->framebuffer_info().supports_partial_repaint) {
+    if (embedder_uses_frame_damage) {
+      // The external view embedder repaints the damaged regions of its render
+      // targets itself, so the frame is diffed but painted entirely.
+      damage = std::make_unique<FrameDamage>();
+      damage->DisablePartialRepaint();
+      damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
+    } else if (frame->framebuffer_info().supports_partial_repaint) {
       // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
       // involved - ExternalViewEmbedder unconditionally clears the entire
       // surface and also partial repaint with platform view present is
       // something that still need to be figured out.
-      bool force_full_repaint =
-          external_view_embedder_ &&
-          (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+      bool force_full_repaint = submits_to_embedder;
 
       damage = std::make_unique<FrameDamage>();
       auto existing_damage = frame->framebuffer_info().existing_damage;
@@ -760,6 +779,13 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
       }
+    } else if (surface_->GetAiksContext()) {
+      // Impeller reuses the filtered backdrops of backdrop filters whose
+      // content did not change, which is only known from diffing against
+      // the previous layer tree. Diff without clipping the frame.
+      damage = std::make_unique<FrameDamage>();
+      damage->DisablePartialRepaint();
+      damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
     }
 
     bool ignore_raster_cache = true;
@@ -778,15 +804,15 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
 
     SurfaceFrame::SubmitInfo submit_info;
     submit_info.presentation_time = presentation_time;
-    if (damage) {
+    if (damage && (frame->framebuffer_info().supports_partial_repaint ||
+                   embedder_uses_frame_damage)) {
       submit_info.frame_damage = ToOptSkIRect(damage->GetFrameDamage());
       submit_info.buffer_damage = ToOptSkIRect(damage->GetBufferDamage());
     }
 
     frame->set_submit_info(submit_info);
 
-    if (external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
+    if (submits_to_embedder) {
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFlutterView(
           view_id, surface_->GetContext(), surface_->GetAiksContext(),
@@ -1107,6 +1133,64 @@ void Rasterizer::FireNextFrameCallbackIfPresent() {
   callback();
 }
 
+void Rasterizer::CaptureFrameIfRequested(int64_t view_id,
+                                         LayerTree& layer_tree) {
+#if !FLUTTER_RELEASE
+  const Settings& settings = delegate_.GetSettings();
+  if (settings.frame_capture_path.empty() ||
+      captured_frame_count_ >= settings.frame_capture_count) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::CaptureFrame");
+
+  GrDirectContext* gr_context = surface_ ? surface_->GetContext() : nullptr;
+  auto display_list = layer_tree.Flatten(
+      DlRect::MakeSize(layer_tree.frame_size()),
+      compositor_context_->texture_registry(), gr_context);
+
+  // Images are read back here as their textures may not outlive the frame.
+  DlSerializationOptions options;
+  options.gr_context = gr_context;
+#if IMPELLER_SUPPORTS_RENDERING
+  // Impeller text frames are recorded as text blobs of their Skia typefaces.
+  options.skia_typeface_resolver = [](const impeller::Typeface& typeface) {
+    return impeller::TypefaceSkia::Cast(typeface).GetSkiaTypeface();
+  };
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  DlSerializationStats stats;
+  std::shared_ptr<fml::Mapping> data =
+      SerializeDisplayList(display_list, options, &stats);
+  if (!data) {
+    return;
+  }
+
+  const size_t frame_number = captured_frame_count_++;
+  std::string file_name = "frame_" + std::to_string(frame_number) + "_view_" +
+                          std::to_string(view_id) + ".dl";
+  FML_LOG(INFO) << "Capturing " << file_name << " with " << stats.op_count
+                << " ops, " << stats.embedded_image_count
+                << " embedded and " << stats.referenced_image_count
+                << " referenced images and " << stats.typeface_count
+                << " typefaces.";
+  if (stats.unsupported_count > 0) {
+    FML_LOG(ERROR) << "The frame capture " << file_name
+                   << " is incomplete: " << stats.unsupported_count
+                   << " operations could not be serialized and were dropped.";
+  }
+
+  delegate_.GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [directory = settings.frame_capture_path, file_name, data]() {
+        fml::UniqueFD directory_fd = fml::OpenDirectory(
+            directory.c_str(), true, fml::FilePermission::kReadWrite);
+        if (!directory_fd.is_valid() ||
+            !fml::WriteAtomically(directory_fd, file_name.c_str(), *data)) {
+          FML_LOG(ERROR) << "Could not write the frame capture " << file_name
+                         << " to " << directory;
+        }
+      });
+#endif  // !FLUTTER_RELEASE
+}
+
 void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
 #if !SLIMPELLER
   user_override_resource_cache_bytes_ |= from_user;
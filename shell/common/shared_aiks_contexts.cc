@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shared_aiks_contexts.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/pipeline_library.h"
+
+namespace flutter {
+
+namespace {
+
+// The AiksContexts of a share group are only ever created and used on the
+// thread of the group, so the mutex only guards the map.
+using ShareKey = std::pair<const impeller::PipelineLibrary*, size_t>;
+using ShareGroups =
+    std::map<ShareKey, std::vector<std::weak_ptr<impeller::AiksContext>>>;
+
+std::mutex share_groups_mutex;
+
+ShareGroups& GetShareGroups() {
+  static ShareGroups share_groups;
+  return share_groups;
+}
+
+// Returns a live AiksContext of the group of |key|, forgetting the collected
+// ones of all groups on the way.
+std::shared_ptr<impeller::AiksContext> FindLiveContext(const ShareKey& key) {
+  std::scoped_lock lock(share_groups_mutex);
+  ShareGroups& share_groups = GetShareGroups();
+  for (auto group = share_groups.begin(); group != share_groups.end();) {
+    auto& contexts = group->second;
+    contexts.erase(
+        std::remove_if(contexts.begin(), contexts.end(),
+                       [](const auto& context) { return context.expired(); }),
+        contexts.end());
+    if (contexts.empty()) {
+      group = share_groups.erase(group);
+    } else {
+      ++group;
+    }
+  }
+  auto found = share_groups.find(key);
+  if (found == share_groups.end()) {
+    return nullptr;
+  }
+  return found->second.front().lock();
+}
+
+void AddContext(const ShareKey& key,
+                const std::shared_ptr<impeller::AiksContext>& aiks_context) {
+  std::scoped_lock lock(share_groups_mutex);
+  GetShareGroups()[key].push_back(aiks_context);
+}
+
+}  // namespace
+
+std::shared_ptr<impeller::AiksContext> SharedAiksContexts::Create(
+    const std::shared_ptr<impeller::Context>& context,
+    std::shared_ptr<impeller::TypographerContext> typographer_context) {
+  if (!context || !fml::MessageLoop::IsInitializedForCurrentThread()) {
+    // The thread the AiksContext is used from is unknown, so it can't be
+    // shared.
+    return std::make_shared<impeller::AiksContext>(
+        context, std::move(typographer_context));
+  }
+
+  const ShareKey key = {context->GetPipelineLibrary().get(),
+                        fml::MessageLoop::GetCurrentTaskQueueId()};
+  std::shared_ptr<impeller::AiksContext> aiks_context;
+  if (auto shared = FindLiveContext(key)) {
+    TRACE_EVENT0("flutter", "SharedAiksContexts::CreateShared");
+    aiks_context = shared->CreateShared(context);
+  }
+  if (!aiks_context) {
+    aiks_context = std::make_shared<impeller::AiksContext>(
+        context, std::move(typographer_context));
+  }
+  if (aiks_context->IsValid()) {
+    AddContext(key, aiks_context);
+  }
+  return aiks_context;
+}
+
+}  // namespace flutter
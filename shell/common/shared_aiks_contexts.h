@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHARED_AIKS_CONTEXTS_H_
+#define FLUTTER_SHELL_COMMON_SHARED_AIKS_CONTEXTS_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/display_list/aiks_context.h"
+#include "impeller/renderer/context.h"
+#include "impeller/typographer/typographer_context.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Creates the AiksContexts of the Impeller rendering surfaces.
+///
+/// The surfaces that render on the same raster thread with Impeller contexts
+/// using the same pipeline library get AiksContexts that share their pipelines
+/// and glyph atlas, so that every surface but the first starts hot. This is the
+/// case for the surfaces of the shells spawned from one another with
+/// |Shell::Spawn|, such as the windows of a multi-window application. Each
+/// surface still gets its own transients buffer and render target cache.
+///
+/// The Metal surfaces don't go through here. On iOS, spawned shells share their
+/// IOSContext, and so already render with the one AiksContext it owns. The
+/// embedder creates an Impeller context, and so a pipeline library, per engine,
+/// so there is nothing its surfaces could share.
+///
+class SharedAiksContexts {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an AiksContext for a surface rendering with
+  ///             |context| on the current thread. It shares the pipelines and
+  ///             the glyph atlas of the live AiksContexts created for the same
+  ///             pipeline library and thread, if there are any, in which case
+  ///             |typographer_context| is unused.
+  ///
+  static std::shared_ptr<impeller::AiksContext> Create(
+      const std::shared_ptr<impeller::Context>& context,
+      std::shared_ptr<impeller::TypographerContext> typographer_context);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(SharedAiksContexts);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHARED_AIKS_CONTEXTS_H_
@@ -22,6 +22,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/trace_buffer.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
@@ -122,6 +123,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_to_buffer) {
+      fml::tracing::TraceBufferEnable();
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -304,6 +309,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (shell->GetSettings().enable_pointer_resampling) {
+    // Resampling dispatches the moves at vsync too, so it replaces the
+    // smoothing dispatchers of the platforms.
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -327,8 +339,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().enable_adaptive_frame_pacing);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -499,6 +512,19 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kSetLayerCostAttributionExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolSetLayerCostAttribution, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetLayerCostsExtensionName] = {
+      task_runners_.GetRasterTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetLayerCosts, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetTraceBufferExtensionName] = {
+      task_runners_.GetIOTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetTraceBuffer, this,
+                std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kReloadAssetFonts] = {
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
@@ -1089,6 +1115,10 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (settings_.coalesce_pointer_events) {
+    DispatchCoalescedPointerData(std::move(packet));
+    return;
+  }
   fml::TaskRunner::RunNowAndFlushMessages(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
@@ -1100,6 +1130,51 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   next_pointer_flow_id_++;
 }
 
+void Shell::DispatchCoalescedPointerData(
+    std::unique_ptr<PointerDataPacket> packet) {
+  {
+    std::scoped_lock lock(pending_pointer_data_->mutex);
+    const std::vector<uint8_t>& data = packet->data();
+    pending_pointer_data_->data.insert(pending_pointer_data_->data.end(),
+                                       data.begin(), data.end());
+    if (pending_pointer_data_->dispatch_pending) {
+      // The pending dispatch also takes the events of this packet.
+      TRACE_FLOW_END("flutter", "PointerEvent", next_pointer_flow_id_);
+      next_pointer_flow_id_++;
+      return;
+    }
+    pending_pointer_data_->dispatch_pending = true;
+  }
+
+  // The runs of moves that are coalesced span at most one frame.
+  const double refresh_rate = GetMainDisplayRefreshRate();
+  const fml::Milliseconds frame_budget =
+      refresh_rate > kUnknownDisplayRefreshRate
+          ? fml::RefreshRateToFrameBudget(refresh_rate)
+          : fml::kDefaultFrameBudget;
+  const fml::TimeDelta interval =
+      fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+
+  fml::TaskRunner::RunNowAndFlushMessages(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, pending = pending_pointer_data_, interval,
+       flow_id = next_pointer_flow_id_]() {
+        std::unique_ptr<PointerDataPacket> packet;
+        {
+          std::scoped_lock lock(pending->mutex);
+          packet = std::make_unique<PointerDataPacket>(pending->data.data(),
+                                                       pending->data.size());
+          pending->data.clear();
+          pending->dispatch_pending = false;
+        }
+        if (engine) {
+          engine->SetPointerCoalescingInterval(interval);
+          engine->DispatchPointerDataPacket(std::move(packet), flow_id);
+        }
+      });
+  next_pointer_flow_id_++;
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchSemanticsAction(int32_t node_id,
                                                   SemanticsAction action,
@@ -1574,6 +1649,15 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.enable_adaptive_frame_pacing) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1946,6 +2030,93 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolSetLayerCostAttribution(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (params.count("enabled") == 0) {
+    ServiceProtocolParameterError(response, "'enabled' parameter is missing.");
+    return false;
+  }
+
+  LayerCostRecorder& recorder =
+      rasterizer_->compositor_context()->layer_cost_recorder();
+  recorder.set_enabled(params.at("enabled") == "true");
+  if (params.count("heatMap") != 0) {
+    recorder.set_heat_map_enabled(params.at("heatMap") == "true");
+  }
+
+  response->SetObject();
+  response->AddMember("type", "Success", response->GetAllocator());
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetLayerCosts(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  const LayerCostRecorder& recorder =
+      rasterizer_->compositor_context()->layer_cost_recorder();
+  auto& allocator = response->GetAllocator();
+
+  rapidjson::Value layers(rapidjson::kArrayType);
+  for (const auto& cost : recorder.GetCosts()) {
+    rapidjson::Value layer(rapidjson::kObjectType);
+    layer.AddMember<uint64_t>("layerId", cost.layer_id, allocator);
+    layer.AddMember("isDisplayList", cost.is_display_list, allocator);
+    layer.AddMember<uint64_t>("frameCount", cost.frame_count, allocator);
+    layer.AddMember("totalMicros", cost.total_time.ToMicrosecondsF(),
+                    allocator);
+    layer.AddMember("selfMicros", cost.self_time.ToMicrosecondsF(),
+                    allocator);
+    layer.AddMember("maxSelfMicros", cost.max_self_time.ToMicrosecondsF(),
+                    allocator);
+    layer.AddMember("renderMicros", cost.render_time.ToMicrosecondsF(),
+                    allocator);
+    layer.AddMember("gpuMicros", cost.gpu_time.ToMicrosecondsF(), allocator);
+    layer.AddMember<uint64_t>("opCount", cost.op_count, allocator);
+    layer.AddMember<uint64_t>("complexityScore", cost.complexity_score,
+                              allocator);
+    rapidjson::Value bounds(rapidjson::kArrayType);
+    bounds.PushBack(cost.device_bounds.GetLeft(), allocator);
+    bounds.PushBack(cost.device_bounds.GetTop(), allocator);
+    bounds.PushBack(cost.device_bounds.GetRight(), allocator);
+    bounds.PushBack(cost.device_bounds.GetBottom(), allocator);
+    layer.AddMember("bounds", bounds, allocator);
+    layers.PushBack(layer, allocator);
+  }
+
+  response->SetObject();
+  response->AddMember("type", "LayerCosts", allocator);
+  response->AddMember("enabled", recorder.enabled(), allocator);
+  response->AddMember<uint64_t>("frameCount", recorder.GetFrameCount(),
+                                allocator);
+  response->AddMember("layers", layers, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetTraceBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (!fml::tracing::TraceBufferIsEnabled()) {
+    ServiceProtocolFailureError(
+        response, "Trace buffer is not enabled. Pass --trace-to-buffer.");
+    return false;
+  }
+
+  std::string trace = fml::tracing::TraceBufferDumpJSON();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceBuffer", allocator);
+  response->AddMember("trace", rapidjson::Value(trace.c_str(), allocator),
+                      allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
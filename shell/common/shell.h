@@ -9,6 +9,7 @@
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
@@ -479,6 +480,18 @@ class Shell final : public PlatformView::Delegate,
   bool is_added_to_service_protocol_ = false;
   uint64_t next_pointer_flow_id_ = 0;
 
+  // The events of the pointer data packets that the platform sent while the
+  // dispatch of earlier events was pending on the UI task runner. They are
+  // dispatched along with those events, so that their moves are coalesced.
+  // Only used if |Settings::coalesce_pointer_events| is set.
+  struct PendingPointerData {
+    std::mutex mutex;
+    bool dispatch_pending = false;
+    std::vector<uint8_t> data;
+  };
+  const std::shared_ptr<PendingPointerData> pending_pointer_data_ =
+      std::make_shared<PendingPointerData>();
+
   bool first_frame_rasterized_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
@@ -594,6 +607,10 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
 
+  // Dispatches the packet along with the packets that are already pending on
+  // the UI task runner, if any. See |Settings::coalesce_pointer_events|.
+  void DispatchCoalescedPointerData(std::unique_ptr<PointerDataPacket> packet);
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(int32_t node_id,
                                              SemanticsAction action,
@@ -765,6 +782,31 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Enables or disables the attribution of raster costs to layers with the
+  // 'enabled' parameter, and the heat map overlay that shows them with the
+  // optional 'heatMap' parameter.
+  bool OnServiceProtocolSetLayerCostAttribution(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the raster costs attributed to each layer over the last window
+  // of frames, most expensive first.
+  bool OnServiceProtocolGetLayerCosts(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the events recorded in the trace ring buffers as a Chrome trace
+  // event JSON string.
+  bool OnServiceProtocolGetTraceBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Forces the FontCollection to reload the font manifest. Used to support
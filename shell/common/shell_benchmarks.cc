@@ -4,15 +4,50 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/common/constants.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/shell_test_external_view_embedder.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <unistd.h>
+#endif
+
 namespace flutter {
 
+static Settings CreateBenchmarkSettings(const fml::UniqueFD& assets_dir,
+                                        testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,24 +59,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
 
     thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
         "io.flutter.bench.",
@@ -120,4 +138,139 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Returns the resident memory of the process, or zero where it is unknown.
+static size_t GetResidentMemoryBytes() {
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+// Creates a platform view that counts |first_frames| down when its shell has
+// rasterized its first frame.
+static Shell::CreateCallback<PlatformView> CreatePlatformView(
+    fml::CountDownLatch& first_frames) {
+  return [&first_frames](Shell& shell) {
+    auto first_frame = std::make_shared<std::once_flag>();
+    auto end_frame = [&first_frames, first_frame](
+                         bool, fml::RefPtr<fml::RasterThreadMerger>) {
+      std::call_once(*first_frame,
+                     [&first_frames] { first_frames.CountDown(); });
+    };
+    testing::ShellTestPlatformViewBuilder builder({
+        .shell_test_external_view_embedder =
+            std::make_shared<ShellTestExternalViewEmbedder>(
+                end_frame, PostPrerollResult::kSuccess,
+                /*support_thread_merging=*/false),
+    });
+    return builder(shell);
+  };
+}
+
+// Shows the view of |shell| so that its frames get rasterized.
+static void ShowView(Shell& shell) {
+  ViewportMetrics metrics;
+  metrics.physical_width = 800;
+  metrics.physical_height = 600;
+  shell.GetPlatformView()->SetViewportMetrics(kFlutterImplicitViewId, metrics);
+  shell.GetPlatformView()->NotifyCreated();
+}
+
+// Measures the time from starting a shell and spawning |state.range(0)| - 1
+// more from it until all of them have rasterized their first frame, as well as
+// the memory that the shells take. Spawned shells share the VM and the IO
+// manager of the first one and, as they render with Impeller on the same raster
+// thread, the pipelines and glyph atlas of its AiksContext (with the GL test
+// platform view, which shares one Impeller context between them). So the more
+// of them there are, the lower the cost of each should be.
+static void BM_SpawnToFirstFrame(benchmark::State& state) {
+  const int64_t engine_count = state.range(0);
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+  settings.enable_impeller = true;
+  size_t total_memory = 0;
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<ThreadHost> thread_host;
+    std::vector<std::unique_ptr<Shell>> shells;
+    fml::CountDownLatch first_frames(engine_count);
+    size_t memory_before = 0;
+    {
+      benchmarking::ScopedPauseTiming pause(state, true);
+      thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+          "io.flutter.bench.",
+          ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+              ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+      memory_before = GetResidentMemoryBytes();
+    }
+
+    TaskRunners task_runners("test",
+                             thread_host->platform_thread->GetTaskRunner(),
+                             thread_host->raster_thread->GetTaskRunner(),
+                             thread_host->ui_thread->GetTaskRunner(),
+                             thread_host->io_thread->GetTaskRunner());
+    auto create_rasterizer = [](Shell& shell) {
+      return std::make_unique<Rasterizer>(shell);
+    };
+    auto create_configuration = [&settings]() {
+      auto configuration = RunConfiguration::InferFromSettings(settings);
+      configuration.SetEntrypoint("drawFrame");
+      return configuration;
+    };
+
+    // Shells must be started and spawned on the platform thread.
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetPlatformTaskRunner(), [&]() {
+          shells.push_back(Shell::Create(flutter::PlatformData(), task_runners,
+                                         settings,
+                                         CreatePlatformView(first_frames),
+                                         create_rasterizer));
+          Shell& spawner = *shells.front();
+          ShowView(spawner);
+          spawner.RunEngine(create_configuration());
+          for (int64_t i = 1; i < engine_count; i++) {
+            shells.push_back(spawner.Spawn(create_configuration(), "/",
+                                           CreatePlatformView(first_frames),
+                                           create_rasterizer));
+            ShowView(*shells.back());
+          }
+        });
+    first_frames.Wait();
+
+    {
+      benchmarking::ScopedPauseTiming pause(state, true);
+      total_memory +=
+          std::max(GetResidentMemoryBytes(), memory_before) - memory_before;
+      // Shutdown must occur synchronously on the platform thread, spawned
+      // shells first.
+      fml::AutoResetWaitableEvent latch;
+      fml::TaskRunner::RunNowOrPostTask(
+          task_runners.GetPlatformTaskRunner(), [&shells, &latch]() {
+            while (!shells.empty()) {
+              shells.pop_back();
+            }
+            latch.Signal();
+          });
+      latch.Wait();
+      thread_host.reset();
+    }
+  }
+
+  state.counters["TotalMemoryBytes"] = benchmark::Counter(
+      static_cast<double>(total_memory), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_SpawnToFirstFrame)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 }  // namespace flutter
@@ -4,10 +4,13 @@
 
 #include "flutter/shell/common/shell_test_platform_view_gl.h"
 
+#include <map>
+#include <mutex>
 #include <utility>
 
 #include <EGL/egl.h>
 
+#include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
 #include "flutter/shell/gpu/gpu_surface_gl_skia.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 
@@ -22,6 +25,29 @@ static std::vector<std::shared_ptr<fml::Mapping>> ShaderLibraryMappings() {
   };
 }
 
+namespace {
+
+// Lets the reactor react on the threads that the views have made their EGL
+// context current on.
+class ReactorWorker final : public impeller::ReactorGLES::Worker {
+ public:
+  explicit ReactorWorker(std::shared_ptr<TestEGLContext> egl_context)
+      : egl_context_(std::move(egl_context)) {}
+
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const impeller::ReactorGLES& reactor) const override {
+    return ::eglGetCurrentContext() == egl_context_->onscreen_context;
+  }
+
+ private:
+  std::shared_ptr<TestEGLContext> egl_context_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ReactorWorker);
+};
+
+}  // namespace
+
 std::unique_ptr<ShellTestPlatformView> ShellTestPlatformView::CreateGL(
     PlatformView::Delegate& delegate,
     const TaskRunners& task_runners,
@@ -35,6 +61,22 @@ std::unique_ptr<ShellTestPlatformView> ShellTestPlatformView::CreateGL(
       shell_test_external_view_embedder);
 }
 
+std::shared_ptr<ShellTestPlatformViewGL::SharedContexts>
+ShellTestPlatformViewGL::GetSharedContexts(const TaskRunners& task_runners) {
+  static std::mutex mutex;
+  static std::map<size_t, std::weak_ptr<SharedContexts>> shared_contexts;
+  std::scoped_lock lock(mutex);
+  auto& weak_contexts =
+      shared_contexts[task_runners.GetRasterTaskRunner()->GetTaskQueueId()];
+  auto contexts = weak_contexts.lock();
+  if (!contexts) {
+    contexts = std::make_shared<SharedContexts>();
+    contexts->egl_context = std::make_shared<TestEGLContext>();
+    weak_contexts = contexts;
+  }
+  return contexts;
+}
+
 ShellTestPlatformViewGL::ShellTestPlatformViewGL(
     PlatformView::Delegate& delegate,
     const TaskRunners& task_runners,
@@ -43,12 +85,19 @@ ShellTestPlatformViewGL::ShellTestPlatformViewGL(
     std::shared_ptr<ShellTestExternalViewEmbedder>
         shell_test_external_view_embedder)
     : ShellTestPlatformView(delegate, task_runners),
-      gl_surface_(SkISize::Make(800, 600)),
+      shared_contexts_(GetSettings().enable_impeller
+                           ? GetSharedContexts(task_runners)
+                           : nullptr),
+      gl_surface_(shared_contexts_ ? shared_contexts_->egl_context
+                                   : std::make_shared<TestEGLContext>(),
+                  SkISize::Make(800, 600)),
       create_vsync_waiter_(std::move(create_vsync_waiter)),
       vsync_clock_(std::move(vsync_clock)),
       shell_test_external_view_embedder_(
           std::move(shell_test_external_view_embedder)) {
-  if (GetSettings().enable_impeller) {
+  if (shared_contexts_ && shared_contexts_->impeller_context) {
+    impeller_context_ = shared_contexts_->impeller_context;
+  } else if (shared_contexts_) {
     auto resolver = [](const char* name) -> void* {
       return reinterpret_cast<void*>(::eglGetProcAddress(name));
     };
@@ -62,6 +111,14 @@ ShellTestPlatformViewGL::ShellTestPlatformViewGL(
     }
     impeller_context_ = impeller::ContextGLES::Create(
         std::move(gl), ShaderLibraryMappings(), true);
+    gl_surface_.ClearCurrent();
+    if (!impeller_context_) {
+      return;
+    }
+    shared_contexts_->reactor_worker =
+        std::make_shared<ReactorWorker>(shared_contexts_->egl_context);
+    impeller_context_->AddReactorWorker(shared_contexts_->reactor_worker);
+    shared_contexts_->impeller_context = impeller_context_;
   }
 }
 
@@ -78,6 +135,10 @@ void ShellTestPlatformViewGL::SimulateVSync() {
 
 // |PlatformView|
 std::unique_ptr<Surface> ShellTestPlatformViewGL::CreateRenderingSurface() {
+  if (impeller_context_) {
+    return std::make_unique<GPUSurfaceGLImpeller>(this, impeller_context_,
+                                                  true);
+  }
   return std::make_unique<GPUSurfaceGLSkia>(this, true);
 }
 
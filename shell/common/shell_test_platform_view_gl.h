@@ -8,6 +8,7 @@
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
+#include "flutter/testing/test_gl_context.h"
 #include "flutter/testing/test_gl_surface.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
 
@@ -36,6 +37,21 @@ class ShellTestPlatformViewGL : public ShellTestPlatformView,
   }
 
  private:
+  // The EGL context and the Impeller context of the views that render with
+  // Impeller on the same raster thread, such as the ones of the shells spawned
+  // from one another. Sharing them lets the views share their pipeline library
+  // and so their AiksContexts, like the surfaces of a device do.
+  struct SharedContexts {
+    std::shared_ptr<TestEGLContext> egl_context;
+    std::shared_ptr<impeller::ContextGLES> impeller_context;
+    std::shared_ptr<impeller::ReactorGLES::Worker> reactor_worker;
+  };
+
+  static std::shared_ptr<SharedContexts> GetSharedContexts(
+      const TaskRunners& task_runners);
+
+  std::shared_ptr<SharedContexts> shared_contexts_;
+
   std::shared_ptr<impeller::ContextGLES> impeller_context_;
 
   TestGLSurface gl_surface_;
@@ -348,6 +348,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
                               &trace_allowlist);
   settings.trace_allowlist = ParseCommaDelimited(trace_allowlist);
 
+  settings.trace_to_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceToBuffer));
+
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
@@ -357,6 +360,15 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
+  settings.enable_adaptive_frame_pacing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAdaptiveFramePacing));
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+
+  settings.coalesce_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::CoalescePointerEvents));
+
   settings.verbose_logging =
       command_line.HasOption(FlagForSwitch(Switch::VerboseLogging));
 
@@ -523,6 +535,29 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::SoftwareRasterWorkerCount))) {
+    std::string software_raster_worker_count;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::SoftwareRasterWorkerCount),
+        &software_raster_worker_count);
+    settings.software_raster_worker_count =
+        std::max(std::stoi(software_raster_worker_count), 0);
+  }
+
+#if !FLUTTER_RELEASE
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::FrameCapturePath),
+                                  &settings.frame_capture_path)) {
+    settings.frame_capture_count = 1;
+    std::string frame_capture_count;
+    if (command_line.GetOptionValue(FlagForSwitch(Switch::FrameCaptureCount),
+                                    &frame_capture_count)) {
+      settings.frame_capture_count =
+          std::max(std::stoi(frame_capture_count), 0);
+    }
+  }
+#endif  // !FLUTTER_RELEASE
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
@@ -176,6 +176,12 @@ DEF_SWITCH(
     "trace-allowlist",
     "Filters out all trace events except those that are specified in this "
     "comma separated list of allowed prefixes.")
+DEF_SWITCH(TraceToBuffer,
+           "trace-to-buffer",
+           "Record trace events into per-thread in-memory ring buffers, "
+           "including those emitted before the Dart VM starts. The events "
+           "can be fetched with the _flutter.getTraceBuffer service "
+           "extension.")
 DEF_SWITCH(DumpSkpOnShaderCompilation,
            "dump-skp-on-shader-compilation",
            "Automatically dump the skp that triggers new shader compilations. "
@@ -262,6 +268,35 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(SoftwareRasterWorkerCount,
+           "software-raster-worker-count",
+           "The number of threads that rasterize frames of software surfaces "
+           "in tiles. Frames are rasterized on the raster thread only by "
+           "default.")
+DEF_SWITCH(FrameCapturePath,
+           "frame-capture-path",
+           "The directory into which the DisplayLists of the frames drawn by "
+           "the rasterizer are written, to be replayed offline by the "
+           "dl_replay tool. Ignored in release builds.")
+DEF_SWITCH(FrameCaptureCount,
+           "frame-capture-count",
+           "The number of frames written to the frame capture path. "
+           "Defaults to 1.")
+DEF_SWITCH(EnableAdaptiveFramePacing,
+           "enable-adaptive-frame-pacing",
+           "Adapt the depth of the frame pipeline to the timings of recent "
+           "frames, and delay the start of building frames that are predicted "
+           "to fit in one vsync interval to lower their latency.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Dispatch the move events of touches and styluses once per frame, "
+           "resampled at the time the frame is presented, to reduce the "
+           "perceived latency of drags and scrolls.")
+DEF_SWITCH(CoalescePointerEvents,
+           "coalesce-pointer-events",
+           "Merge the consecutive move and hover events of a pointer that "
+           "arrive within a vsync interval while the UI thread is busy, so "
+           "that high frequency input devices post fewer UI thread tasks.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -69,6 +69,59 @@ TEST(SwitchesTest, RouteParsedFlag) {
   EXPECT_TRUE(settings.route.empty());
 }
 
+TEST(SwitchesTest, SoftwareRasterWorkerCount) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.software_raster_worker_count, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--software-raster-worker-count=4"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.software_raster_worker_count, 4u);
+}
+
+TEST(SwitchesTest, CoalescePointerEvents) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.coalesce_pointer_events);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--coalesce-pointer-events"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.coalesce_pointer_events);
+}
+
+TEST(SwitchesTest, FrameCapture) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-capture-count=3"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.frame_capture_path.empty());
+  EXPECT_EQ(settings.frame_capture_count, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-capture-path=/tmp/frames"});
+  settings = SettingsFromCommandLine(command_line);
+#if !FLUTTER_RELEASE
+  EXPECT_EQ(settings.frame_capture_path, "/tmp/frames");
+  EXPECT_EQ(settings.frame_capture_count, 1u);
+#else
+  EXPECT_TRUE(settings.frame_capture_path.empty());
+  EXPECT_EQ(settings.frame_capture_count, 0u);
+#endif
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-capture-path=/tmp/frames",
+       "--frame-capture-count=3"});
+  settings = SettingsFromCommandLine(command_line);
+#if !FLUTTER_RELEASE
+  EXPECT_EQ(settings.frame_capture_count, 3u);
+#else
+  EXPECT_EQ(settings.frame_capture_count, 0u);
+#endif
+}
+
 TEST(SwitchesTest, EnableEmbedderAPI) {
   {
     // enable
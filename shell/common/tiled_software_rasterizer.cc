@@ -0,0 +1,193 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/tiled_software_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+namespace {
+
+// The state shared by all threads rasterizing the tiles of one display list.
+// Workers that start after all tiles have been claimed only touch this state,
+// which they keep alive.
+struct TileRasterState {
+  sk_sp<DisplayList> display_list;
+  SkPixmap pixmap;
+  std::vector<SkIRect> tiles;
+  std::atomic<size_t> next_tile = 0;
+  std::atomic<size_t> finished_tiles = 0;
+  std::atomic<bool> failed = false;
+  fml::AutoResetWaitableEvent all_tiles_finished;
+};
+
+// Finds the save layers with a backdrop filter, including those of nested
+// display lists. A backdrop filter reads the pixels around its layer, which
+// may belong to tiles that are being drawn by other threads.
+class BackdropFilterFinder final : public IgnoreAttributeDispatchHelper,
+                                   public IgnoreClipDispatchHelper,
+                                   public IgnoreTransformDispatchHelper,
+                                   public IgnoreDrawDispatchHelper {
+ public:
+  using DlOpReceiver::saveLayer;
+
+  bool found() const { return found_; }
+
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    found_ = found_ || backdrop != nullptr;
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    if (!found_) {
+      display_list->Dispatch(*this);
+    }
+  }
+
+ private:
+  bool found_ = false;
+};
+
+bool HasBackdropFilter(const DisplayList& display_list) {
+  if (display_list.root_has_backdrop_filter()) {
+    return true;
+  }
+  BackdropFilterFinder finder;
+  display_list.Dispatch(finder);
+  return finder.found();
+}
+
+void RasterizeTiles(TileRasterState& state) {
+  std::unique_ptr<SkCanvas> canvas;
+  for (size_t index = state.next_tile++; index < state.tiles.size();
+       index = state.next_tile++) {
+    if (!canvas) {
+      canvas = SkCanvas::MakeRasterDirect(state.pixmap.info(),
+                                          state.pixmap.writable_addr(),
+                                          state.pixmap.rowBytes());
+    }
+    if (canvas) {
+      TRACE_EVENT0("flutter", "TiledSoftwareRasterizer::RasterizeTile");
+      DlSkCanvasAdapter adapter(canvas.get());
+      canvas->save();
+      canvas->clipIRect(state.tiles[index]);
+      adapter.DrawDisplayList(state.display_list);
+      canvas->restore();
+    } else {
+      state.failed = true;
+    }
+    if (++state.finished_tiles == state.tiles.size()) {
+      state.all_tiles_finished.Signal();
+    }
+  }
+}
+
+}  // namespace
+
+TiledSoftwareRasterizer::TiledSoftwareRasterizer(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    size_t worker_count,
+    int tile_size)
+    : worker_task_runner_(std::move(worker_task_runner)),
+      worker_count_(std::max<size_t>(worker_count, 1)),
+      tile_size_(std::max(tile_size, 1)) {}
+
+TiledSoftwareRasterizer::~TiledSoftwareRasterizer() = default;
+
+std::vector<SkIRect> TiledSoftwareRasterizer::ComputeTiles(
+    const DisplayList& display_list,
+    const SkIRect& pixel_bounds,
+    const SkIRect& dirty_rect) const {
+  std::vector<SkIRect> tiles;
+  SkIRect area = pixel_bounds;
+  if (!area.intersect(dirty_rect)) {
+    return tiles;
+  }
+
+  // Tiles are aligned to the pixel bounds so that the same pixels end up in
+  // the same tile regardless of the dirty rect.
+  const int first_column = (area.left() - pixel_bounds.left()) / tile_size_;
+  const int first_row = (area.top() - pixel_bounds.top()) / tile_size_;
+  std::vector<int> results;
+  for (int top = pixel_bounds.top() + first_row * tile_size_;
+       top < area.bottom(); top += tile_size_) {
+    for (int left = pixel_bounds.left() + first_column * tile_size_;
+         left < area.right(); left += tile_size_) {
+      SkIRect tile = SkIRect::MakeXYWH(left, top, tile_size_, tile_size_);
+      if (!tile.intersect(area)) {
+        continue;
+      }
+      if (display_list.has_rtree()) {
+        results.clear();
+        display_list.rtree()->search(ToDlRect(tile), &results);
+        if (results.empty()) {
+          continue;
+        }
+      } else if (!display_list.GetBounds().IntersectsWithRect(
+                     ToDlRect(tile))) {
+        continue;
+      }
+      tiles.push_back(tile);
+    }
+  }
+  return tiles;
+}
+
+bool TiledSoftwareRasterizer::Rasterize(const sk_sp<DisplayList>& display_list,
+                                        const SkPixmap& pixmap,
+                                        const SkIRect& dirty_rect) const {
+  TRACE_EVENT0("flutter", "TiledSoftwareRasterizer::Rasterize");
+  if (!display_list || pixmap.addr() == nullptr) {
+    return false;
+  }
+
+  auto state = std::make_shared<TileRasterState>();
+  state->tiles = ComputeTiles(*display_list, pixmap.bounds(), dirty_rect);
+  if (state->tiles.empty()) {
+    return true;
+  }
+  state->display_list = display_list;
+  state->pixmap = pixmap;
+
+  // Backdrop filters must see everything drawn under them, so the whole dirty
+  // area is rasterized at once on the calling thread.
+  const bool single_threaded = HasBackdropFilter(*display_list);
+  if (single_threaded) {
+    SkIRect area = pixmap.bounds();
+    area.intersect(dirty_rect);
+    state->tiles = {area};
+  }
+
+  size_t helper_count = 0;
+  if (worker_task_runner_ && !single_threaded) {
+    helper_count = std::min(worker_count_, state->tiles.size()) - 1;
+  }
+  for (size_t i = 0; i < helper_count; i++) {
+    worker_task_runner_->PostTask([state]() { RasterizeTiles(*state); });
+  }
+  RasterizeTiles(*state);
+
+  // Workers may still be drawing the last tiles they claimed.
+  state->all_tiles_finished.Wait();
+
+  if (state->failed) {
+    FML_LOG(ERROR) << "Could not rasterize all tiles of the frame.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
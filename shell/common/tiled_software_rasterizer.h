@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_TILED_SOFTWARE_RASTERIZER_H_
+#define FLUTTER_SHELL_COMMON_TILED_SOFTWARE_RASTERIZER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Rasterizes display lists into CPU memory on multiple threads.
+///
+/// The target pixels are split into a grid of tiles. Tiles that no operation
+/// of the display list draws into are skipped, using the display list's
+/// |DlRTree| if it has one. The remaining tiles are handed out to the thread
+/// that calls |Rasterize| and up to `worker_count - 1` tasks posted to the
+/// worker task runner. Each thread draws into the tiles it claims with its own
+/// canvas clipped to the tile, so no synchronization is needed on the pixels.
+///
+/// The calling thread rasterizes tiles itself and never waits on workers that
+/// have not started yet, so a busy worker pool only costs parallelism.
+///
+/// Display lists with a backdrop filter are rasterized without tiles on the
+/// calling thread, as the filter reads the pixels of neighboring tiles.
+///
+class TiledSoftwareRasterizer {
+ public:
+  static constexpr int kDefaultTileSize = 256;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a tiled rasterizer.
+  ///
+  /// @param[in]  worker_task_runner  The task runner of the worker pool. If
+  ///                                 null, all tiles are rasterized on the
+  ///                                 calling thread.
+  /// @param[in]  worker_count        The maximum number of threads, including
+  ///                                 the calling thread, that rasterize the
+  ///                                 tiles of a single display list.
+  /// @param[in]  tile_size           The width and height of each tile.
+  ///
+  TiledSoftwareRasterizer(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      size_t worker_count,
+      int tile_size = kDefaultTileSize);
+
+  ~TiledSoftwareRasterizer();
+
+  size_t GetWorkerCount() const { return worker_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes the display list into the pixels. Blocks until all
+  ///             tiles have been rasterized.
+  ///
+  /// @param[in]  display_list  The display list to rasterize. Display lists
+  ///                           with an |DlRTree| only have the operations that
+  ///                           intersect each tile dispatched for it.
+  /// @param[in]  pixmap        The pixels to draw into. Must outlive the call.
+  /// @param[in]  dirty_rect    Only tiles that intersect this area of the
+  ///                           pixels are rasterized.
+  ///
+  /// @return     Whether all tiles were rasterized.
+  ///
+  bool Rasterize(const sk_sp<DisplayList>& display_list,
+                 const SkPixmap& pixmap,
+                 const SkIRect& dirty_rect) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The tiles of the `dirty_rect` area of the pixel bounds that
+  ///             the display list draws into.
+  ///
+  std::vector<SkIRect> ComputeTiles(const DisplayList& display_list,
+                                    const SkIRect& pixel_bounds,
+                                    const SkIRect& dirty_rect) const;
+
+ private:
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  const size_t worker_count_;
+  const int tile_size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TiledSoftwareRasterizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_TILED_SOFTWARE_RASTERIZER_H_
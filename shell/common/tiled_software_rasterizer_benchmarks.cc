@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/tiled_software_rasterizer.h"
+
+#include <random>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int kWidth = 3840;
+constexpr int kHeight = 2160;
+constexpr int kShapeCount = 20000;
+
+// A frame of |kShapeCount| overlapping anti-aliased shapes spread across a
+// 4K surface, recorded with an rtree like the frames of a tiled software
+// surface.
+sk_sp<DisplayList> MakeComplexDisplayList() {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> x(0, kWidth);
+  std::uniform_real_distribution<float> y(0, kHeight);
+  std::uniform_real_distribution<float> extent(8, 160);
+  std::uniform_int_distribution<uint32_t> color(0, 0xFFFFFF);
+
+  DisplayListBuilder builder(SkRect::MakeWH(kWidth, kHeight),
+                             /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  DlPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < kShapeCount; i++) {
+    paint.setColor(DlColor(0x80000000 | color(generator)));
+    SkRect bounds = SkRect::MakeXYWH(x(generator), y(generator),
+                                     extent(generator), extent(generator));
+    switch (i % 4) {
+      case 0:
+        builder.DrawRect(bounds, paint);
+        break;
+      case 1:
+        builder.DrawOval(bounds, paint);
+        break;
+      case 2:
+        builder.DrawRRect(SkRRect::MakeRectXY(bounds, 12, 12), paint);
+        break;
+      case 3: {
+        SkPath path;
+        path.moveTo(bounds.left(), bounds.bottom());
+        path.quadTo(bounds.centerX(), bounds.top() - bounds.height(),
+                    bounds.right(), bounds.bottom());
+        path.close();
+        builder.DrawPath(path, paint);
+        break;
+      }
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+static void BM_TiledSoftwareRasterizer4K(benchmark::State& state) {
+  const size_t worker_count = state.range(0);
+  auto loop = fml::ConcurrentMessageLoop::Create(worker_count);
+  TiledSoftwareRasterizer rasterizer(loop->GetTaskRunner(), worker_count);
+
+  auto display_list = MakeComplexDisplayList();
+  auto surface =
+      SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kWidth, kHeight));
+  SkPixmap pixmap;
+  FML_CHECK(surface && surface->peekPixels(&pixmap));
+
+  for (auto _ : state) {
+    FML_CHECK(rasterizer.Rasterize(display_list, pixmap,
+                                   SkIRect::MakeWH(kWidth, kHeight)));
+  }
+  state.counters["Tiles"] = rasterizer
+                                .ComputeTiles(*display_list, pixmap.bounds(),
+                                              SkIRect::MakeWH(kWidth, kHeight))
+                                .size();
+}
+
+BENCHMARK(BM_TiledSoftwareRasterizer4K)
+    ->ArgName("workers")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace flutter
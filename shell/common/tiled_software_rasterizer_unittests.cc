@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/tiled_software_rasterizer.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeDisplayList(const SkISize& size) {
+  DisplayListBuilder builder(SkRect::Make(size), /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  DlPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 20; i++) {
+    paint.setColor(DlColor(0x80000000 | (i * 0x0C1F37)));
+    builder.DrawOval(SkRect::MakeXYWH(i * 9.5f, i * 7.25f, 37, 23), paint);
+  }
+  return builder.Build();
+}
+
+SkBitmap MakeBitmap(const SkISize& size) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(size.width(), size.height());
+  bitmap.eraseColor(SK_ColorBLACK);
+  return bitmap;
+}
+
+}  // namespace
+
+TEST(TiledSoftwareRasterizerTest, MatchesUntiledRasterization) {
+  const SkISize size = SkISize::Make(200, 170);
+  auto display_list = MakeDisplayList(size);
+
+  SkBitmap expected = MakeBitmap(size);
+  SkCanvas canvas(expected);
+  DlSkCanvasAdapter(&canvas).DrawDisplayList(display_list);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TiledSoftwareRasterizer rasterizer(loop->GetTaskRunner(), 4,
+                                     /*tile_size=*/32);
+  SkBitmap actual = MakeBitmap(size);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, actual.pixmap(),
+                                   SkIRect::MakeSize(size)));
+
+  for (int y = 0; y < size.height(); y++) {
+    for (int x = 0; x < size.width(); x++) {
+      ASSERT_EQ(actual.getColor(x, y), expected.getColor(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(TiledSoftwareRasterizerTest,
+     MatchesUntiledRasterizationOfBackdropFilter) {
+  const SkISize size = SkISize::Make(200, 170);
+  DisplayListBuilder builder(SkRect::Make(size), /*prepare_rtree=*/true);
+  builder.DrawDisplayList(MakeDisplayList(size));
+  // The backdrop filter is nested in another layer, so it is not reported at
+  // the root of the display list.
+  builder.SaveLayer(nullptr, nullptr);
+  auto blur = DlImageFilter::MakeBlur(6, 6, DlTileMode::kClamp);
+  builder.SaveLayer(DlRect::MakeLTRB(20, 20, 180, 150), nullptr, blur.get());
+  builder.Restore();
+  builder.Restore();
+  auto display_list = builder.Build();
+  ASSERT_FALSE(display_list->root_has_backdrop_filter());
+
+  SkBitmap expected = MakeBitmap(size);
+  SkCanvas canvas(expected);
+  DlSkCanvasAdapter(&canvas).DrawDisplayList(display_list);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TiledSoftwareRasterizer rasterizer(loop->GetTaskRunner(), 4,
+                                     /*tile_size=*/32);
+  SkBitmap actual = MakeBitmap(size);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, actual.pixmap(),
+                                   SkIRect::MakeSize(size)));
+
+  for (int y = 0; y < size.height(); y++) {
+    for (int x = 0; x < size.width(); x++) {
+      ASSERT_EQ(actual.getColor(x, y), expected.getColor(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(TiledSoftwareRasterizerTest, OnlyRasterizesDirtyTiles) {
+  const SkISize size = SkISize::Make(128, 128);
+  DisplayListBuilder builder(SkRect::Make(size), /*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 128, 128),
+                   DlPaint(DlColor::kRed()));
+  auto display_list = builder.Build();
+
+  TiledSoftwareRasterizer rasterizer(nullptr, 1, /*tile_size=*/32);
+  SkBitmap bitmap = MakeBitmap(size);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, bitmap.pixmap(),
+                                   SkIRect::MakeLTRB(40, 40, 50, 50)));
+
+  // Only the tile containing the dirty rect is drawn.
+  EXPECT_EQ(bitmap.getColor(32, 32), SK_ColorRED);
+  EXPECT_EQ(bitmap.getColor(63, 63), SK_ColorRED);
+  EXPECT_EQ(bitmap.getColor(31, 31), SK_ColorBLACK);
+  EXPECT_EQ(bitmap.getColor(64, 64), SK_ColorBLACK);
+}
+
+TEST(TiledSoftwareRasterizerTest, SkipsTilesWithoutOperations) {
+  const SkISize size = SkISize::Make(128, 128);
+  DisplayListBuilder builder(SkRect::Make(size), /*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20),
+                   DlPaint(DlColor::kRed()));
+  builder.DrawRect(SkRect::MakeLTRB(100, 100, 110, 110),
+                   DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  TiledSoftwareRasterizer rasterizer(nullptr, 1, /*tile_size=*/32);
+  auto tiles = rasterizer.ComputeTiles(*display_list, SkIRect::MakeSize(size),
+                                       SkIRect::MakeSize(size));
+  ASSERT_EQ(tiles.size(), 2u);
+  EXPECT_EQ(tiles[0], SkIRect::MakeLTRB(0, 0, 32, 32));
+  EXPECT_EQ(tiles[1], SkIRect::MakeLTRB(96, 96, 128, 128));
+}
+
+}  // namespace testing
+}  // namespace flutter
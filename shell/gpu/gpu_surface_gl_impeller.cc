@@ -6,6 +6,7 @@
 
 #include "flow/surface_frame.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/shell/common/shared_aiks_contexts.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/gles/surface_gles.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
@@ -25,7 +26,7 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
+  auto aiks_context = SharedAiksContexts::Create(
       context, impeller::TypographerContextSkia::Make());
 
   if (!aiks_context->IsValid()) {
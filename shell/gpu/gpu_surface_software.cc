@@ -13,10 +13,18 @@
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+// Backing stores that were not presented in this many frames are no longer
+// tracked and are repainted entirely when they are presented again. This
+// covers pools of up to this many buffers that are presented in turn.
+static constexpr uint64_t kMaxBackingStoreDamageAge = 4;
+
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tiled_rasterizer_(std::move(tiled_rasterizer)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -59,6 +67,65 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  // Backing stores that retain their contents only need the regions repainted
+  // that changed since they were last presented.
+  const uint64_t backing_store_id =
+      delegate_->GetRetainedBackingStoreId(backing_store);
+  if (backing_store_id != 0) {
+    if (damage_size_ != size) {
+      // Backing stores of a different size are new allocations.
+      damage_.clear();
+      damage_size_ = size;
+    }
+    framebuffer_info.supports_partial_repaint = true;
+    auto existing_damage = damage_.find(backing_store_id);
+    if (existing_damage != damage_.end()) {
+      framebuffer_info.existing_damage = existing_damage->second.damage;
+    }
+  }
+
+  SurfaceFrame::SubmitCallback submit_callback =
+      [self = weak_factory_.GetWeakPtr(), backing_store,
+       backing_store_id](const SurfaceFrame& surface_frame) {
+        // If the surface itself went away, there is nothing more to do.
+        if (!self || !self->IsValid()) {
+          return false;
+        }
+        if (backing_store_id != 0) {
+          self->AccumulateDamage(backing_store_id,
+                                 surface_frame.submit_info().frame_damage);
+        }
+        return self->delegate_->PresentBackingStoreWithDamage(
+            backing_store, surface_frame.submit_info().frame_damage);
+      };
+
+  if (tiled_rasterizer_) {
+    // The frame is recorded with an rtree so that each tile only dispatches
+    // the operations that intersect it.
+    SurfaceFrame::EncodeCallback encode_callback =
+        [self = weak_factory_.GetWeakPtr(), backing_store](
+            SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+      SkPixmap pixmap;
+      if (!backing_store->peekPixels(&pixmap)) {
+        FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
+        return false;
+      }
+      // Tiles outside the buffer damage are up to date.
+      SkIRect dirty_rect = surface_frame.submit_info().buffer_damage.value_or(
+          SkIRect::MakeWH(pixmap.width(), pixmap.height()));
+      return self->tiled_rasterizer_->Rasterize(
+          surface_frame.BuildDisplayList(), pixmap, dirty_rect);
+    };
+    return std::make_unique<SurfaceFrame>(
+        nullptr, framebuffer_info, encode_callback, submit_callback,
+        logical_size, /*context_result=*/nullptr,
+        /*display_list_fallback=*/true, /*display_list_rtree=*/true);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -76,21 +143,29 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     canvas->Flush();
     return true;
   };
-  SurfaceFrame::SubmitCallback submit_callback =
-      [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame) {
-        // If the surface itself went away, there is nothing more to do.
-        if (!self || !self->IsValid()) {
-          return false;
-        }
-        return self->delegate_->PresentBackingStore(
-            surface_frame.SkiaSurface());
-      };
 
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
                                         encode_callback, submit_callback,
                                         logical_size);
 }
 
+void GPUSurfaceSoftware::AccumulateDamage(
+    uint64_t presented_id,
+    const std::optional<SkIRect>& frame_damage) {
+  present_count_++;
+  SkIRect damage = frame_damage.value_or(SkIRect::MakeSize(damage_size_));
+  for (auto it = damage_.begin(); it != damage_.end();) {
+    if (present_count_ - it->second.last_present > kMaxBackingStoreDamageAge) {
+      it = damage_.erase(it);
+      continue;
+    }
+    it->second.damage.join(damage);
+    ++it;
+  }
+  // The presented backing store is now up to date.
+  damage_[presented_id] = {SkIRect::MakeEmpty(), present_count_};
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
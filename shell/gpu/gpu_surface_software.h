@@ -5,17 +5,25 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <map>
+#include <optional>
+
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/tiled_software_rasterizer.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
 namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  // If a |tiled_rasterizer| is specified, frames are recorded into a display
+  // list and then rasterized into the backing store in tiles.
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +46,30 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer_;
+  struct BackingStoreDamage {
+    // The area of the backing store that lags behind the most recently
+    // presented frame.
+    SkIRect damage;
+    // The value of |present_count_| when the backing store was last
+    // presented.
+    uint64_t last_present = 0;
+  };
+  // Accumulated damage of the recently presented backing stores, keyed by
+  // |GPUSurfaceSoftwareDelegate::GetRetainedBackingStoreId|.
+  std::map<uint64_t, BackingStoreDamage> damage_;
+  // The size of the backing stores tracked in |damage_|.
+  SkISize damage_size_ = SkISize::MakeEmpty();
+  // The number of frames presented into tracked backing stores.
+  uint64_t present_count_ = 0;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  // Adds the frame damage to the accumulated damage of all backing stores
+  // other than the presented one, and stops tracking the backing stores that
+  // were not presented recently.
+  void AccumulateDamage(uint64_t presented_id,
+                        const std::optional<SkIRect>& frame_damage);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
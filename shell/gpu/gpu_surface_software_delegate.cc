@@ -4,8 +4,21 @@
 
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
+#include <utility>
+
 namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+uint64_t GPUSurfaceSoftwareDelegate::GetRetainedBackingStoreId(
+    const sk_sp<SkSurface>& backing_store) {
+  return 0;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<SkIRect>& frame_damage) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
 }  // namespace flutter
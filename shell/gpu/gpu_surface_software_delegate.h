@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <cstdint>
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -48,6 +51,44 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Identifies a backing store returned by `AcquireBackingStore`
+  ///             that retains its contents between frames. The same
+  ///             identifier must be returned every time the backing store is
+  ///             acquired, and must never be returned for any other pixels,
+  ///             even after the backing store was deallocated. Only the
+  ///             regions of such a backing store that changed since it was
+  ///             last presented are repainted.
+  ///
+  /// @param[in]  backing_store  The backing store that was just acquired.
+  ///
+  /// @return     The non-zero identifier of the backing store, or zero if it
+  ///             does not retain its contents. The default implementation
+  ///             returns zero.
+  ///
+  virtual uint64_t GetRetainedBackingStoreId(
+      const sk_sp<SkSurface>& backing_store);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called instead of `PresentBackingStore` when the region of
+  ///             the backing store that changed since the previous frame is
+  ///             known. Delegates that can take advantage of the damage, for
+  ///             instance to only copy the changed pixels to the screen,
+  ///             override this method. The default implementation ignores the
+  ///             damage.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  frame_damage   The region that changed since the previous
+  ///                            frame, or `std::nullopt` if the entire
+  ///                            backing store must be considered damaged.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen.
+  ///
+  virtual bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<SkIRect>& frame_damage);
 };
 
 }  // namespace flutter
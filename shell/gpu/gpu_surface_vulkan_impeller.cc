@@ -8,6 +8,7 @@
 
 #include "flow/surface_frame.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/shell/common/shared_aiks_contexts.h"
 #include "fml/trace_event.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
@@ -54,7 +55,7 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
+  auto aiks_context = SharedAiksContexts::Create(
       context, impeller::TypographerContextSkia::Make());
   if (!aiks_context->IsValid()) {
     return;
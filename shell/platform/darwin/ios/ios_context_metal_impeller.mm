@@ -18,6 +18,8 @@ IOSContextMetalImpeller::IOSContextMetalImpeller(
     : darwin_context_metal_impeller_(
           [[FlutterDarwinContextMetalImpeller alloc] init:is_gpu_disabled_sync_switch]) {
   if (darwin_context_metal_impeller_.context) {
+    // Engines spawned from one another share this IOSContext, and so render
+    // with this one AiksContext.
     aiks_context_ = std::make_shared<impeller::AiksContext>(
         darwin_context_metal_impeller_.context, impeller::TypographerContextSkia::Make());
   }
@@ -179,8 +179,20 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
+  bool acquire_buffer =
+      SAFE_ACCESS(software_config, acquire_buffer_callback, nullptr);
+  bool present_buffer =
+      SAFE_ACCESS(software_config, present_buffer_callback, nullptr);
+
+  if (acquire_buffer != present_buffer) {
+    FML_LOG(ERROR) << "The software renderer config must specify either both "
+                      "or none of the acquire and present buffer callbacks.";
+    return false;
+  }
+
   if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+          nullptr &&
+      !acquire_buffer) {
     return false;
   }
 
@@ -783,27 +795,96 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store;
+  if (auto ptr = SAFE_ACCESS(software_config, surface_present_callback,
+                             nullptr)) {
+    software_present_backing_store = [ptr, user_data](const void* allocation,
+                                                      size_t row_bytes,
+                                                      size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  using SoftwareBuffer = flutter::EmbedderSurfaceSoftware::SoftwareBuffer;
+  std::function<bool(const SkISize&, SoftwareBuffer*)> software_acquire_buffer;
+  std::function<bool(const SoftwareBuffer&, const SkIRect&)>
+      software_present_buffer;
+  auto acquire_buffer_callback =
+      SAFE_ACCESS(software_config, acquire_buffer_callback, nullptr);
+  auto present_buffer_callback =
+      SAFE_ACCESS(software_config, present_buffer_callback, nullptr);
+  if (acquire_buffer_callback && present_buffer_callback) {
+    software_acquire_buffer = [acquire_buffer_callback, user_data](
+                                  const SkISize& size,
+                                  SoftwareBuffer* buffer) -> bool {
+      FlutterFrameInfo frame_info = {};
+      frame_info.struct_size = sizeof(FlutterFrameInfo);
+      frame_info.size = {static_cast<uint32_t>(size.width()),
+                         static_cast<uint32_t>(size.height())};
+      FlutterSoftwareBuffer embedder_buffer = {};
+      embedder_buffer.struct_size = sizeof(FlutterSoftwareBuffer);
+      if (!acquire_buffer_callback(user_data, &frame_info, &embedder_buffer)) {
+        return false;
+      }
+      buffer->allocation = embedder_buffer.allocation;
+      buffer->row_bytes = embedder_buffer.row_bytes;
+      buffer->height = embedder_buffer.height;
+      buffer->user_data = embedder_buffer.user_data;
+      return true;
+    };
+    software_present_buffer = [present_buffer_callback, user_data](
+                                  const SoftwareBuffer& buffer,
+                                  const SkIRect& damage) -> bool {
+      FlutterSoftwareBuffer embedder_buffer = {};
+      embedder_buffer.struct_size = sizeof(FlutterSoftwareBuffer);
+      embedder_buffer.allocation = buffer.allocation;
+      embedder_buffer.row_bytes = buffer.row_bytes;
+      embedder_buffer.height = buffer.height;
+      embedder_buffer.user_data = buffer.user_data;
+
+      FlutterRect damage_rect = {
+          static_cast<double>(damage.left()),
+          static_cast<double>(damage.top()),
+          static_cast<double>(damage.right()),
+          static_cast<double>(damage.bottom()),
+      };
+      FlutterDamage frame_damage = {};
+      frame_damage.struct_size = sizeof(FlutterDamage);
+      frame_damage.num_rects = damage.isEmpty() ? 0 : 1;
+      frame_damage.damage = &damage_rect;
+      return present_buffer_callback(user_data, &embedder_buffer,
+                                     &frame_damage);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,  // optional
+          software_acquire_buffer,         // optional
+          software_present_buffer,         // optional
       };
 
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        std::shared_ptr<flutter::TiledSoftwareRasterizer> tiled_rasterizer;
+        const size_t raster_worker_count =
+            shell.GetSettings().software_raster_worker_count;
+        if (raster_worker_count > 1) {
+          tiled_rasterizer = std::make_shared<flutter::TiledSoftwareRasterizer>(
+              shell.GetConcurrentWorkerTaskRunner(), raster_worker_count);
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            std::move(tiled_rasterizer)         // tiled rasterizer
         );
       });
 }
@@ -3012,6 +3093,145 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+// Wraps an embedder owned buffer in a mapping that hands the buffer back to
+// the embedder when it is collected.
+static std::unique_ptr<fml::Mapping> MakeEmbedderOwnedMapping(
+    const uint8_t* data,
+    size_t size,
+    FlutterDataCallback release_callback,
+    void* user_data) {
+  return std::make_unique<fml::NonOwnedMapping>(
+      data, size,
+      [release_callback, user_data](const uint8_t* data, size_t size) {
+        release_callback(data, size, user_data);
+      });
+}
+
+// The channels whose messages the engine handles itself by reading
+// |PlatformMessage::data|, which is empty for messages with external data.
+static bool IsEngineHandledChannel(const char* channel) {
+  static constexpr const char* kEngineHandledChannels[] = {
+      "flutter/lifecycle",
+      "flutter/localization",
+      "flutter/navigation",
+      "flutter/settings",
+  };
+  for (const char* engine_channel : kEngineHandledChannels) {
+    if (strcmp(channel, engine_channel) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    FlutterDataCallback release_callback,
+    void* user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The release callback was invalid.");
+  }
+
+  // Created first so that the buffer is handed back on every return path.
+  auto mapping = MakeEmbedderOwnedMapping(
+      SAFE_ACCESS(flutter_message, message, nullptr),
+      SAFE_ACCESS(flutter_message, message_size, 0), release_callback,
+      user_data);
+
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (flutter_message == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
+  }
+
+  if (SAFE_ACCESS(flutter_message, channel, nullptr) == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments, "Message argument did not specify a valid channel.");
+  }
+
+  if (IsEngineHandledChannel(flutter_message->channel)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Messages on the channels handled by the engine must be sent with "
+        "FlutterEngineSendPlatformMessage.");
+  }
+
+  if (mapping->GetSize() != 0 && mapping->GetMapping() == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Message size was non-zero but the message data was nullptr.");
+  }
+
+  const FlutterPlatformMessageResponseHandle* response_handle =
+      SAFE_ACCESS(flutter_message, response_handle, nullptr);
+
+  fml::RefPtr<flutter::PlatformMessageResponse> response;
+  if (response_handle && response_handle->message) {
+    response = response_handle->message->response();
+  }
+
+  std::unique_ptr<flutter::PlatformMessage> message;
+  if (mapping->GetSize() == 0) {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel, response);
+  } else {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel, std::move(mapping), response);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->SendPlatformMessage(std::move(message))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send a message to the running "
+                                  "Flutter application.");
+}
+
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    FlutterDataCallback release_callback,
+    void* user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The release callback was invalid.");
+  }
+
+  auto mapping =
+      MakeEmbedderOwnedMapping(data, data_length, release_callback, user_data);
+
+  if (data_length != 0 && data == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Data size was non zero but the pointer to the data was null.");
+  }
+
+  if (handle == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid response handle.");
+  }
+
+  auto response = handle->message->response();
+
+  if (response) {
+    if (data_length == 0) {
+      response->CompleteEmpty();
+    } else {
+      response->Complete(std::move(mapping));
+    }
+  }
+
+  delete handle;
+
+  return kSuccess;
+}
+
 FlutterEngineResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
@@ -3637,6 +3857,9 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
+  SET_PROC(SendPlatformMessageNoCopy, FlutterEngineSendPlatformMessageNoCopy);
+  SET_PROC(SendPlatformMessageResponseNoCopy,
+           FlutterEngineSendPlatformMessageResponseNoCopy);
 #undef SET_PROC
 
   return kSuccess;
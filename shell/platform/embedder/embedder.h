@@ -609,6 +609,42 @@ typedef bool (*BoolPresentInfoCallback)(
     void* /* user data */,
     const FlutterPresentInfo* /* present info */);
 
+/// A pixel buffer owned by the embedder that the engine renders into directly
+/// when using the software renderer.
+///
+/// See: \ref FlutterSoftwareRendererConfig.acquire_buffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareBuffer).
+  size_t struct_size;
+  /// A pointer to the pixels of the buffer. The pixel format is the native
+  /// 32-bit RGBA format, premultiplied.
+  void* allocation;
+  /// The number of bytes in a single row of the allocation. Must be at least
+  /// four times the width of the frame.
+  size_t row_bytes;
+  /// The number of rows in the allocation. Must be the height of the frame.
+  size_t height;
+  /// A baton that is not interpreted by the engine in any way. It is given
+  /// back to the embedder when the buffer is presented and may be used to
+  /// identify the buffer within the pool of the embedder.
+  void* user_data;
+} FlutterSoftwareBuffer;
+
+/// Callback for when the software renderer needs a buffer to render the next
+/// frame into.
+typedef bool (*FlutterSoftwareBufferAcquireCallback)(
+    void* /* user data */,
+    const FlutterFrameInfo* /* frame info */,
+    FlutterSoftwareBuffer* /* buffer out */);
+
+/// Callback for when the software renderer has rendered a frame into a buffer
+/// supplied by the embedder. The damage describes the regions of the buffer
+/// that changed compared to the previously presented frame.
+typedef bool (*FlutterSoftwareBufferPresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwareBuffer* /* buffer */,
+    const FlutterDamage* /* frame damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterOpenGLRendererConfig).
   size_t struct_size;
@@ -919,7 +955,38 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Not required if `acquire_buffer_callback` and `present_buffer_callback`
+  /// are specified.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback invoked when the engine needs a buffer to render the next
+  /// frame into. This lets the embedder supply the pixel buffers, for example
+  /// from a pool of shared memory buffers, that the engine renders into
+  /// directly, avoiding the copy required by `surface_present_callback`.
+  ///
+  /// The engine holds on to at most one buffer at a time. A buffer that was
+  /// acquired but not presented, for instance because the frame was
+  /// discarded, is no longer accessed by the engine once this callback is
+  /// invoked again.
+  ///
+  /// Buffers are identified by their `allocation`. The engine only repaints
+  /// the regions of a buffer that changed since that buffer was last
+  /// presented, so the embedder must not modify the contents of its buffers.
+  /// Buffers of a different size, buffers whose `row_bytes` or `user_data`
+  /// changed and buffers that were not acquired in the last four frames are
+  /// always repainted entirely. An embedder that reallocates a buffer at the
+  /// address of a previous one must change its `user_data`.
+  ///
+  /// Must be specified together with `present_buffer_callback`. Not used if a
+  /// FlutterCompositor is supplied in FlutterProjectArgs.
+  FlutterSoftwareBufferAcquireCallback acquire_buffer_callback;
+  /// The callback invoked when a frame has been rendered into a buffer
+  /// obtained from `acquire_buffer_callback`. Ownership of the buffer returns
+  /// to the embedder. The frame damage lets the embedder only copy the changed
+  /// regions to the screen.
+  ///
+  /// Must be specified together with `acquire_buffer_callback`.
+  FlutterSoftwareBufferPresentCallback present_buffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1723,7 +1790,9 @@ typedef struct {
 
 typedef struct {
   /// A pointer to the raw bytes of the allocation described by this software
-  /// backing store.
+  /// backing store. The engine only repaints the regions of a backing store
+  /// that changed since it was last presented, so the embedder must not
+  /// modify the allocation until the backing store is collected.
   const void* allocation;
   /// The number of bytes in a single row of the allocation.
   size_t row_bytes;
@@ -1742,7 +1811,9 @@ typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareBackingStore2).
   size_t struct_size;
   /// A pointer to the raw bytes of the allocation described by this software
-  /// backing store.
+  /// backing store. The engine only repaints the regions of a backing store
+  /// that changed since it was last presented, so the embedder must not
+  /// modify the allocation until the backing store is collected.
   const void* allocation;
   /// The number of bytes in a single row of the allocation.
   size_t row_bytes;
@@ -2868,6 +2939,73 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+//------------------------------------------------------------------------------
+/// @brief      Send a platform message to the framework without copying its
+///             payload. The engine takes ownership of the buffer referenced by
+///             `message->message` and exposes it to Dart as an unmodifiable
+///             external `ByteData`. This avoids the copies made by
+///             `FlutterEngineSendPlatformMessage` for large payloads.
+///
+///             The buffer must stay valid and unmodified until
+///             `release_callback` is invoked. The callback is invoked exactly
+///             once, including when this call fails, and may be invoked on any
+///             thread (typically when the Dart garbage collector collects the
+///             `ByteData`).
+///
+///             Messages on the channels handled by the engine itself
+///             (`flutter/lifecycle`, `flutter/localization`,
+///             `flutter/navigation` and `flutter/settings`) must be sent via
+///             `FlutterEngineSendPlatformMessage`, and are rejected with
+///             `kInvalidArguments`.
+///
+/// @param[in]  engine            A running engine instance.
+/// @param[in]  message           The message to send.
+/// @param[in]  release_callback  The callback invoked with the buffer and its
+///                               size when the engine no longer references
+///                               it.
+/// @param[in]  user_data         The user data baton passed to
+///                               `release_callback`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    FlutterDataCallback release_callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Send a response to a platform message from the Dart Flutter
+///             application without copying its payload. Ownership of `data`
+///             is transferred to the engine in the same way as for
+///             `FlutterEngineSendPlatformMessageNoCopy`. Responses are only
+///             read by Dart, so unlike messages they are accepted for any
+///             channel.
+///
+/// @param[in]  engine            The running engine instance.
+/// @param[in]  handle            The platform message response handle.
+/// @param[in]  data              The data to associate with the platform
+///                               message response.
+/// @param[in]  data_length       The length of the platform message response
+///                               data.
+/// @param[in]  release_callback  The callback invoked with the buffer and its
+///                               size when the engine no longer references
+///                               it.
+/// @param[in]  user_data         The user data baton passed to
+///                               `release_callback`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    FlutterDataCallback release_callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      This API is only meant to be used by platforms that need to
 ///             flush tasks on a message loop not controlled by the Flutter
@@ -3357,6 +3495,19 @@ typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageResponseFnPtr)(
     const FlutterPlatformMessageResponseHandle* handle,
     const uint8_t* data,
     size_t data_length);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    FlutterDataCallback release_callback,
+    void* user_data);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageResponseNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    FlutterDataCallback release_callback,
+    void* user_data);
 typedef FlutterEngineResult (*FlutterEngineRegisterExternalTextureFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
@@ -3477,6 +3628,9 @@ typedef struct {
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
   FlutterEngineAddViewFnPtr AddView;
   FlutterEngineRemoveViewFnPtr RemoveView;
+  FlutterEngineSendPlatformMessageNoCopyFnPtr SendPlatformMessageNoCopy;
+  FlutterEngineSendPlatformMessageResponseNoCopyFnPtr
+      SendPlatformMessageResponseNoCopy;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_dispatch.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/dl_op_spy.h"
 #include "third_party/skia/include/gpu/ganesh/GrDirectContext.h"
@@ -111,7 +112,8 @@ static void InvalidateApiState(SkSurface& skia_surface) {
 #endif
 
 bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target,
-                                  bool clear_surface) {
+                                  bool clear_surface,
+                                  const std::optional<SkIRect>& clip_rect) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
   TryEndRecording();
   FML_DCHECK(HasEngineRenderedContents())
@@ -181,6 +183,11 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target,
   }
   DlSkCanvasAdapter dl_canvas(canvas);
   int restore_count = dl_canvas.GetSaveCount();
+  if (clip_rect.has_value()) {
+    dl_canvas.Save();
+    dl_canvas.TransformReset();
+    dl_canvas.ClipRect(DlRect::Make(ToDlIRect(clip_rect.value())));
+  }
   dl_canvas.SetTransform(surface_transformation_);
   if (clear_surface) {
     dl_canvas.Clear(DlColor::kTransparent());
@@ -102,8 +102,13 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
+  // Renders the slice into the render target. If a |clip_rect| in the
+  // coordinates of the render target is specified, only that region is
+  // cleared and repainted. Impeller render targets are always repainted
+  // entirely.
   bool Render(const EmbedderRenderTarget& render_target,
-              bool clear_surface = true);
+              bool clear_surface = true,
+              const std::optional<SkIRect>& clip_rect = std::nullopt);
 
   const DlRegion& GetDlRegion() const;
 
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 
 #include <cassert>
+#include <optional>
 #include <utility>
 
 #include "flutter/common/constants.h"
@@ -31,6 +32,7 @@ EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() = default;
 
 void EmbedderExternalViewEmbedder::CollectView(int64_t view_id) {
   render_target_caches_.erase(view_id);
+  diffed_views_.erase(view_id);
 }
 
 void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
@@ -105,6 +107,11 @@ DlCanvas* EmbedderExternalViewEmbedder::GetRootCanvas() {
   return found->second->GetCanvas();
 }
 
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::UsesFrameDamage() {
+  return retains_render_targets_ && !avoid_backing_store_cache_;
+}
+
 // |ExternalViewEmbedder|
 DlCanvas* EmbedderExternalViewEmbedder::CompositeEmbeddedView(int64_t view_id) {
   auto vid = EmbedderExternalView::ViewIdentifier(view_id);
@@ -247,17 +254,49 @@ class Layer {
     render_target_ = std::move(target);
   }
 
+  /// Describes the Flutter contents of this layer.
+  EmbedderRenderTarget::Contents GetContents(
+      const SkMatrix& transformation) const {
+    EmbedderRenderTarget::Contents contents;
+    for (auto c : flutter_contents_) {
+      contents.platform_view_ids.push_back(
+          c->GetViewIdentifier().platform_view_id);
+    }
+    contents.transformation = transformation;
+    return contents;
+  }
+
   /// Renders this layer Flutter contents to the render target previously
   /// assigned with SetRenderTarget.
-  void RenderFlutterContents() {
+  ///
+  /// A render target that retains the same contents from the previous frame
+  /// only has the |damage| repainted.
+  void RenderFlutterContents(const std::optional<SkIRect>& damage,
+                             const SkMatrix& transformation) {
     FML_DCHECK(has_flutter_contents());
-    if (render_target_) {
-      bool clear_surface = true;
-      for (auto c : flutter_contents_) {
-        c->Render(*render_target_, clear_surface);
-        clear_surface = false;
+    if (!render_target_) {
+      return;
+    }
+    std::optional<SkIRect> clip_rect;
+    std::optional<EmbedderRenderTarget::Contents> contents;
+    if (render_target_->RetainsContents()) {
+      contents = GetContents(transformation);
+      if (damage.has_value() &&
+          render_target_->GetRetainedContents() == contents) {
+        if (damage->isEmpty()) {
+          return;
+        }
+        clip_rect = damage;
       }
     }
+    bool clear_surface = true;
+    bool rendered = true;
+    for (auto c : flutter_contents_) {
+      rendered &= c->Render(*render_target_, clear_surface, clip_rect);
+      clear_surface = false;
+    }
+    render_target_->SetRetainedContents(rendered ? std::move(contents)
+                                                 : std::nullopt);
   }
 
   /// Returns platform views for this layer. In Z-order the platform views are
@@ -292,9 +331,12 @@ class LayerBuilder {
  public:
   using RenderTargetProvider =
       std::function<std::unique_ptr<EmbedderRenderTarget>(
-          const SkISize& frame_size)>;
+          const SkISize& frame_size,
+          const EmbedderRenderTarget::Contents& contents)>;
 
-  explicit LayerBuilder(SkISize frame_size) : frame_size_(frame_size) {
+  LayerBuilder(SkISize frame_size, const SkMatrix& surface_transformation)
+      : frame_size_(frame_size),
+        surface_transformation_(surface_transformation) {
     layers_.push_back(Layer());
   }
 
@@ -317,21 +359,39 @@ class LayerBuilder {
   void PrepareBackingStore(const RenderTargetProvider& target_provider) {
     for (auto& layer : layers_) {
       if (layer.has_flutter_contents()) {
-        layer.SetRenderTarget(target_provider(frame_size_));
+        layer.SetRenderTarget(target_provider(
+            frame_size_, layer.GetContents(surface_transformation_)));
       }
     }
   }
 
   /// Renders all layers with Flutter contents to their respective render
-  /// targets.
-  void Render() {
+  /// targets. |frame_damage| is the region of the frame that changed since
+  /// the previous frame, if known.
+  void Render(const std::optional<SkIRect>& frame_damage) {
+    std::optional<SkIRect> damage;
+    if (frame_damage.has_value()) {
+      damage = surface_transformation_.mapRect(SkRect::Make(*frame_damage))
+                   .roundOut();
+    }
     for (auto& layer : layers_) {
       if (layer.has_flutter_contents()) {
-        layer.RenderFlutterContents();
+        layer.RenderFlutterContents(damage, surface_transformation_);
       }
     }
   }
 
+  /// Whether any of the render targets retains its contents between frames.
+  bool RetainsRenderTargets() {
+    for (auto& layer : layers_) {
+      if (layer.render_target() != nullptr &&
+          layer.render_target()->RetainsContents()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   /// Populates EmbedderLayers from layer builder's layers.
   void PushLayers(EmbedderLayers& layers) {
     for (auto& layer : layers_) {
@@ -414,6 +474,7 @@ class LayerBuilder {
 
   std::vector<Layer> layers_;
   SkISize frame_size_;
+  SkMatrix surface_transformation_;
 };
 
 };  // namespace
@@ -431,18 +492,22 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
                                  pending_frame_size_.height());
   pending_surface_transformation_.mapRect(&_rect);
 
-  LayerBuilder builder(SkISize::Make(_rect.width(), _rect.height()));
+  LayerBuilder builder(SkISize::Make(_rect.width(), _rect.height()),
+                       pending_surface_transformation_);
 
   for (auto view_id : composition_order_) {
     auto& view = pending_views_[view_id];
     builder.AddExternalView(view.get());
   }
 
-  builder.PrepareBackingStore([&](const SkISize& frame_size) {
+  builder.PrepareBackingStore([&](const SkISize& frame_size,
+                                 const EmbedderRenderTarget::Contents&
+                                     contents) {
     if (!avoid_backing_store_cache_) {
       std::unique_ptr<EmbedderRenderTarget> target =
           render_target_cache.GetRenderTarget(
-              EmbedderExternalView::RenderTargetDescriptor(frame_size));
+              EmbedderExternalView::RenderTargetDescriptor(frame_size),
+              contents);
       if (target != nullptr) {
         return target;
       }
@@ -475,7 +540,21 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   }
 #endif  //  !SLIMPELLER
 
-  builder.Render();
+  // Render targets are only reused from the previous frame, so the ones that
+  // retain their contents lag behind by the damage of this frame. The damage
+  // is only accurate if the previous frame was diffed as well, as diffing
+  // records the paint regions of the layers.
+  const bool frame_diffed = UsesFrameDamage();
+  const bool damage_valid =
+      frame_diffed && diffed_views_.count(flutter_view_id) > 0;
+  builder.Render(damage_valid ? frame->submit_info().frame_damage
+                              : std::nullopt);
+  if (frame_diffed) {
+    diffed_views_.insert(flutter_view_id);
+  } else {
+    diffed_views_.erase(flutter_view_id);
+  }
+  retains_render_targets_ = builder.RetainsRenderTargets();
 
 #if !SLIMPELLER
   // We are going to be transferring control back over to the embedder there
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
@@ -111,6 +112,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool UsesFrameDamage() override;
+
  private:
   const bool avoid_backing_store_cache_;
   const CreateRenderTargetCallback create_render_target_callback_;
@@ -123,6 +127,11 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   // The render target caches for views. Each key is a view ID.
   std::unordered_map<int64_t, EmbedderRenderTargetCache> render_target_caches_;
+  // Whether the render targets of the most recent frame retain their
+  // contents, in which case the next frame only repaints its damage.
+  bool retains_render_targets_ = false;
+  // The views whose most recent frame was diffed against its previous frame.
+  std::unordered_set<int64_t> diffed_views_;
 
   void Reset();
 
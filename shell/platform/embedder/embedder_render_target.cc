@@ -27,4 +27,19 @@ const FlutterBackingStore* EmbedderRenderTarget::GetBackingStore() const {
   return &backing_store_;
 }
 
+bool EmbedderRenderTarget::RetainsContents() const {
+  return backing_store_.type == kFlutterBackingStoreTypeSoftware ||
+         backing_store_.type == kFlutterBackingStoreTypeSoftware2;
+}
+
+const std::optional<EmbedderRenderTarget::Contents>&
+EmbedderRenderTarget::GetRetainedContents() const {
+  return retained_contents_;
+}
+
+void EmbedderRenderTarget::SetRetainedContents(
+    std::optional<Contents> contents) {
+  retained_contents_ = std::move(contents);
+}
+
 }  // namespace flutter
@@ -6,9 +6,13 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -41,6 +45,22 @@ class EmbedderRenderTarget {
 
   using MakeOrClearCurrentCallback = std::function<SetCurrentResult()>;
 
+  /// Describes what a render target was rendered with, so that a render
+  /// target that retains its pixels only needs the regions that changed
+  /// repainted when it is rendered with the same contents again.
+  struct Contents {
+    /// The platform views that the slices rendered into the render target
+    /// follow, in order. The slice of the root view has no platform view.
+    std::vector<std::optional<int64_t>> platform_view_ids;
+    /// The transformation the slices were rendered with.
+    SkMatrix transformation;
+
+    bool operator==(const Contents& other) const {
+      return platform_view_ids == other.platform_view_ids &&
+             transformation == other.transformation;
+    }
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys this instance of the render target and invokes the
   ///             callback for the embedder to release its resource associated
@@ -91,6 +111,31 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the pixels of the backing store are retained between
+  ///             frames. This is the case for software backing stores, whose
+  ///             allocations the embedder must not modify.
+  ///
+  /// @return     Whether the pixels are retained.
+  ///
+  bool RetainsContents() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The contents the render target was last rendered with in
+  ///             their entirety, if it retains its contents.
+  ///
+  /// @return     The contents or `std::nullopt` if they are unknown.
+  ///
+  const std::optional<Contents>& GetRetainedContents() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the contents the render target was rendered with.
+  ///
+  /// @param[in]  contents  The contents, or `std::nullopt` if the render
+  ///                       target must be repainted entirely the next time.
+  ///
+  void SetRetainedContents(std::optional<Contents> contents);
+
   //----------------------------------------------------------------------------
   /// @brief      Make the render target current.
   ///
@@ -130,6 +175,8 @@ class EmbedderRenderTarget {
 
   fml::closure on_release_;
 
+  std::optional<Contents> retained_contents_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTarget);
 };
 
@@ -22,6 +22,21 @@ EmbedderRenderTargetCache::GetRenderTarget(
   return target;
 }
 
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::GetRenderTarget(
+    const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+    const EmbedderRenderTarget::Contents& contents) {
+  auto [begin, end] = cached_render_targets_.equal_range(descriptor);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second->GetRetainedContents() == contents) {
+      auto target = std::move(it->second);
+      cached_render_targets_.erase(it);
+      return target;
+    }
+  }
+  return GetRenderTarget(descriptor);
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
@@ -32,6 +32,12 @@ class EmbedderRenderTargetCache {
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
       const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
+  // Prefers a compatible render target that retains the specified contents,
+  // so that it only needs the regions that changed repainted.
+  std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
+      const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+      const EmbedderRenderTarget::Contents& contents);
+
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
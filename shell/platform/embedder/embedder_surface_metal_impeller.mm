@@ -64,6 +64,8 @@ std::unique_ptr<Surface> EmbedderSurfaceMetalImpeller::CreateGPUSurface()
     return nullptr;
   }
   if (!aiks_context_) {
+    // |context_| is owned by this engine alone, so unlike the surfaces of the
+    // other backends, this one has no AiksContext to share pipelines with.
     aiks_context_ =
         std::make_shared<impeller::AiksContext>(context_, impeller::TypographerContextSkia::Make());
   }
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_surface_software.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/trace_event.h"
@@ -15,12 +16,20 @@
 
 namespace flutter {
 
+// The number of embedder buffers that keep their identifiers after they were
+// last acquired. A buffer that is acquired again after more than this many
+// other buffers is considered new and repainted entirely.
+static constexpr size_t kMaxRecentBuffers = 4;
+
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer)
     : software_dispatch_table_(std::move(software_dispatch_table)),
-      external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+      external_view_embedder_(std::move(external_view_embedder)),
+      tiled_rasterizer_(std::move(tiled_rasterizer)) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !UsesEmbedderBuffers()) {
     return;
   }
   valid_ = true;
@@ -39,7 +48,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface,
+                                                      tiled_rasterizer_);
 
   if (!surface->IsValid()) {
     return nullptr;
@@ -63,6 +73,10 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (UsesEmbedderBuffers()) {
+    return AcquireEmbedderBuffer(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
@@ -77,18 +91,121 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     FML_LOG(ERROR) << "Could not create backing store for software rendering.";
     return nullptr;
   }
+  sk_surface_id_ = next_backing_store_id_++;
 
   return sk_surface_;
 }
 
+bool EmbedderSurfaceSoftware::UsesEmbedderBuffers() const {
+  return software_dispatch_table_.software_acquire_buffer &&
+         software_dispatch_table_.software_present_buffer;
+}
+
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireEmbedderBuffer(
+    const SkISize& size) {
+  // Any previously acquired buffer that was not presented is implicitly
+  // returned to the embedder.
+  sk_surface_ = nullptr;
+  sk_surface_id_ = 0;
+  acquired_buffer_ = {};
+
+  SoftwareBuffer buffer;
+  if (!software_dispatch_table_.software_acquire_buffer(size, &buffer)) {
+    FML_LOG(ERROR) << "The embedder could not supply a software buffer.";
+    return nullptr;
+  }
+
+  SkImageInfo info = SkImageInfo::MakeN32(
+      size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+  if (buffer.allocation == nullptr ||
+      buffer.height != static_cast<size_t>(size.fHeight) ||
+      buffer.row_bytes < info.minRowBytes()) {
+    FML_LOG(ERROR) << "The embedder supplied software buffer was invalid.";
+    return nullptr;
+  }
+
+  sk_surface_ =
+      SkSurfaces::WrapPixels(info, buffer.allocation, buffer.row_bytes);
+  if (sk_surface_ == nullptr) {
+    FML_LOG(ERROR) << "Could not wrap the embedder supplied software buffer.";
+    return nullptr;
+  }
+  acquired_buffer_ = buffer;
+  sk_surface_id_ = GetEmbedderBufferId(buffer);
+  return sk_surface_;
+}
+
+uint64_t EmbedderSurfaceSoftware::GetEmbedderBufferId(
+    const SoftwareBuffer& buffer) {
+  // Buffers are identified by their allocation. A buffer whose other
+  // properties changed was reallocated.
+  auto it = std::find_if(recent_buffers_.begin(), recent_buffers_.end(),
+                         [&buffer](const RecentBuffer& recent) {
+                           return recent.buffer.allocation ==
+                                  buffer.allocation;
+                         });
+  uint64_t id = 0;
+  if (it != recent_buffers_.end()) {
+    if (it->buffer.row_bytes == buffer.row_bytes &&
+        it->buffer.height == buffer.height &&
+        it->buffer.user_data == buffer.user_data) {
+      id = it->id;
+    }
+    recent_buffers_.erase(it);
+  }
+  if (id == 0) {
+    id = next_backing_store_id_++;
+  }
+  recent_buffers_.push_back({buffer, id});
+  if (recent_buffers_.size() > kMaxRecentBuffers) {
+    recent_buffers_.erase(recent_buffers_.begin());
+  }
+  return id;
+}
+
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  return PresentBackingStoreWithDamage(std::move(backing_store), std::nullopt);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+uint64_t EmbedderSurfaceSoftware::GetRetainedBackingStoreId(
+    const sk_sp<SkSurface>& backing_store) {
+  // Both the engine owned backing store and the buffers supplied by the
+  // embedder retain their contents between frames.
+  return backing_store == sk_surface_ ? sk_surface_id_ : 0;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<SkIRect>& frame_damage) {
+  TRACE_EVENT0("flutter", "EmbedderSurfaceSoftware::PresentBackingStore");
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
   }
 
+  if (UsesEmbedderBuffers()) {
+    if (backing_store != sk_surface_ ||
+        acquired_buffer_.allocation == nullptr) {
+      FML_LOG(ERROR) << "Tried to present a buffer that was not acquired.";
+      return false;
+    }
+    SkIRect bounds =
+        SkIRect::MakeWH(backing_store->width(), backing_store->height());
+    SkIRect damage = frame_damage.value_or(bounds);
+    if (!damage.intersect(bounds)) {
+      damage.setEmpty();
+    }
+    SoftwareBuffer buffer = acquired_buffer_;
+    acquired_buffer_ = {};
+    sk_surface_ = nullptr;
+    sk_surface_id_ = 0;
+    return software_dispatch_table_.software_present_buffer(buffer, damage);
+  }
+
   SkPixmap pixmap;
   if (!backing_store->peekPixels(&pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
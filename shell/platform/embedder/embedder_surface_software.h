@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -17,22 +19,62 @@ namespace flutter {
 class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
+  // A pixel buffer owned by the embedder.
+  struct SoftwareBuffer {
+    void* allocation = nullptr;
+    size_t row_bytes = 0;
+    size_t height = 0;
+    void* user_data = nullptr;
+  };
+
+  // Either |software_present_backing_store| or both of the buffer callbacks
+  // must be specified. If the buffer callbacks are specified, frames are
+  // rendered directly into the buffers of the embedder.
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;
+    std::function<bool(const SkISize& size, SoftwareBuffer* buffer)>
+        software_acquire_buffer;
+    std::function<bool(const SoftwareBuffer& buffer, const SkIRect& damage)>
+        software_present_buffer;
   };
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer = nullptr);
 
   ~EmbedderSurfaceSoftware() override;
 
  private:
+  // An embedder buffer that was recently acquired, along with the identifier
+  // of its contents.
+  struct RecentBuffer {
+    SoftwareBuffer buffer;
+    uint64_t id = 0;
+  };
+
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
+  // The identifier of the contents of |sk_surface_|, see
+  // |GetRetainedBackingStoreId|.
+  uint64_t sk_surface_id_ = 0;
+  uint64_t next_backing_store_id_ = 1;
+  // The embedder buffer |sk_surface_| wraps when rendering into embedder
+  // supplied buffers.
+  SoftwareBuffer acquired_buffer_;
+  // The most recently acquired embedder buffers, most recent last.
+  std::vector<RecentBuffer> recent_buffers_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer_;
+
+  bool UsesEmbedderBuffers() const;
+
+  sk_sp<SkSurface> AcquireEmbedderBuffer(const SkISize& size);
+
+  // Returns the identifier of the contents of an acquired embedder buffer.
+  uint64_t GetEmbedderBufferId(const SoftwareBuffer& buffer);
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -49,6 +91,15 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  uint64_t GetRetainedBackingStoreId(
+      const sk_sp<SkSurface>& backing_store) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<SkIRect>& frame_damage) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
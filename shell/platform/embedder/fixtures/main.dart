@@ -415,6 +415,17 @@ void platform_messages_no_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void platform_message_response_no_copy() {
+  PlatformDispatcher.instance.sendPlatformMessage('test_channel', null,
+      (ByteData? data) {
+    final Uint8List list =
+        data!.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+    signalNativeMessage(utf8.decode(list));
+  });
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void null_platform_messages() {
@@ -1439,6 +1450,30 @@ void draw_solid_blue() {
   drawSolidColor(const Color.fromARGB(255, 0, 0, 255));
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_moving_square() {
+  // Renders four frames of a 2x2 blue square that moves two pixels to the
+  // right every frame on top of a red background.
+  int frame = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    final Size size = PlatformDispatcher.instance.views.first.physicalSize;
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero,
+        createColoredBox(const Color.fromARGB(255, 255, 0, 0), size));
+    builder.addPicture(
+        Offset(frame * 2.0, 0.0),
+        createColoredBox(
+            const Color.fromARGB(255, 0, 0, 255), const Size(2.0, 2.0)));
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    frame++;
+    if (frame < 4) {
+      PlatformDispatcher.instance.scheduleFrame();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void pointer_data_packet() {
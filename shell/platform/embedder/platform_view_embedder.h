@@ -64,7 +64,8 @@ class PlatformViewEmbedder final : public PlatformView {
       const EmbedderSurfaceSoftware::SoftwareDispatchTable&
           software_dispatch_table,
       PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<TiledSoftwareRasterizer> tiled_rasterizer = nullptr);
 
 #ifdef SHELL_ENABLE_GL
   // Creates a platform view that sets up an OpenGL rasterizer.
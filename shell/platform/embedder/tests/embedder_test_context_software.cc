@@ -68,4 +68,24 @@ bool EmbedderTestContextSoftware::Present(const sk_sp<SkImage>& image) {
   return true;
 }
 
+void EmbedderTestContextSoftware::SetSoftwareBufferCallbacks(
+    AcquireBufferCallback acquire_callback,
+    PresentBufferCallback present_callback) {
+  acquire_buffer_callback_ = std::move(acquire_callback);
+  present_buffer_callback_ = std::move(present_callback);
+  renderer_config_.software.acquire_buffer_callback =
+      [](void* context, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) {
+        return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+            ->acquire_buffer_callback_(*frame_info, buffer);
+      };
+  renderer_config_.software.present_buffer_callback =
+      [](void* context, const FlutterSoftwareBuffer* buffer,
+         const FlutterDamage* frame_damage) {
+        auto self = reinterpret_cast<EmbedderTestContextSoftware*>(context);
+        self->software_surface_present_count_++;
+        return self->present_buffer_callback_(*buffer, *frame_damage);
+      };
+}
+
 }  // namespace flutter::testing
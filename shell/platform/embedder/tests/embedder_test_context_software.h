@@ -14,6 +14,13 @@ namespace testing {
 
 class EmbedderTestContextSoftware : public EmbedderTestContext {
  public:
+  using AcquireBufferCallback =
+      std::function<bool(const FlutterFrameInfo& frame_info,
+                         FlutterSoftwareBuffer* buffer)>;
+  using PresentBufferCallback =
+      std::function<bool(const FlutterSoftwareBuffer& buffer,
+                         const FlutterDamage& frame_damage)>;
+
   explicit EmbedderTestContextSoftware(std::string assets_path = "");
 
   ~EmbedderTestContextSoftware() override;
@@ -26,6 +33,14 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
 
   bool Present(const sk_sp<SkImage>& image);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the engine render into buffers supplied by the
+  ///             callbacks instead of presenting a copy of its own buffer.
+  ///             Must be called before the engine is launched.
+  ///
+  void SetSoftwareBufferCallbacks(AcquireBufferCallback acquire_callback,
+                                  PresentBufferCallback present_callback);
+
  private:
   // |EmbedderTestContext|
   void SetSurface(SkISize surface_size) override;
@@ -36,6 +51,8 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
   sk_sp<SkSurface> surface_;
   SkISize surface_size_;
   size_t software_surface_present_count_ = 0;
+  AcquireBufferCallback acquire_buffer_callback_;
+  PresentBufferCallback present_buffer_callback_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTestContextSoftware);
 };
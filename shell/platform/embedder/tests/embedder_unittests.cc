@@ -4,6 +4,9 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -535,6 +538,207 @@ TEST_F(EmbedderTest, InvalidPlatformMessages) {
   ASSERT_EQ(result, kInvalidArguments);
 }
 
+//------------------------------------------------------------------------------
+/// Tests that a platform message large enough to be exposed to Dart as external
+/// typed data arrives intact and its buffer is handed back to the embedder.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopy) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  const std::string message_data(64 * 1024, 'x');
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  auto buffer = std::make_unique<uint8_t[]>(message_data.size());
+  memcpy(buffer.get(), message_data.data(), message_data.size());
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = buffer.release();
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  std::atomic<int> release_count = 0;
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message,
+      [](const uint8_t* data, size_t size, void* user_data) {
+        delete[] data;
+        reinterpret_cast<std::atomic<int>*>(user_data)->fetch_add(1);
+      },
+      &release_count);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // Collecting the isolate runs the finalizer of the external typed data.
+  engine.reset();
+  ASSERT_EQ(release_count, 1);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that the buffer of a platform message that cannot be sent is handed
+/// back to the embedder.
+///
+TEST_F(EmbedderTest, InvalidPlatformMessagesWithoutCopyAreReleased) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = nullptr;
+  platform_message.message = nullptr;
+  platform_message.message_size = 0;
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  int release_count = 0;
+  auto release_callback = [](const uint8_t* data, size_t size,
+                             void* user_data) {
+    ++*reinterpret_cast<int*>(user_data);
+  };
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message, release_callback, &release_count);
+  ASSERT_EQ(result, kInvalidArguments);
+  ASSERT_EQ(release_count, 1);
+
+  result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message, nullptr, &release_count);
+  ASSERT_EQ(result, kInvalidArguments);
+  ASSERT_EQ(release_count, 1);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that messages on the channels the engine reads itself are rejected,
+/// as the engine does not read the payload of messages sent without copy.
+///
+TEST_F(EmbedderTest, EngineHandledPlatformMessagesCannotBeSentWithoutCopy) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  const std::string message_data = "{}";
+  for (const char* channel :
+       {"flutter/lifecycle", "flutter/localization", "flutter/navigation",
+        "flutter/settings"}) {
+    FlutterPlatformMessage platform_message = {};
+    platform_message.struct_size = sizeof(FlutterPlatformMessage);
+    platform_message.channel = channel;
+    platform_message.message =
+        reinterpret_cast<const uint8_t*>(message_data.data());
+    platform_message.message_size = message_data.size();
+    platform_message.response_handle = nullptr;  // No response needed.
+
+    int release_count = 0;
+    auto result = FlutterEngineSendPlatformMessageNoCopy(
+        engine.get(), &platform_message,
+        [](const uint8_t* data, size_t size, void* user_data) {
+          ++*reinterpret_cast<int*>(user_data);
+        },
+        &release_count);
+    EXPECT_EQ(result, kInvalidArguments) << channel;
+    EXPECT_EQ(release_count, 1) << channel;
+  }
+}
+
+//------------------------------------------------------------------------------
+/// Tests that a response sent without copy reaches Dart as the embedder owned
+/// buffer, which is handed back exactly once when Dart no longer references
+/// it.
+///
+TEST_F(EmbedderTest, PlatformMessageResponsesCanBeSentWithoutCopy) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  const std::string response_data(64 * 1024, 'x');
+  std::atomic<int> release_count = 0;
+  auto release_callback = [](const uint8_t* data, size_t size,
+                             void* user_data) {
+    delete[] data;
+    reinterpret_cast<std::atomic<int>*>(user_data)->fetch_add(1);
+  };
+
+  fml::AutoResetWaitableEvent response;
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        auto received_response = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        EXPECT_EQ(received_response, response_data);
+        // A copy would have released the buffer before Dart read it.
+        EXPECT_EQ(release_count, 0);
+        response.Signal();
+      })));
+
+  // The engine is run on its own thread, so that its platform message
+  // callback can respond while the test waits for Dart.
+  auto platform_task_runner = CreateNewThread("platform_thread");
+  UniqueEngine engine;
+  platform_task_runner->PostTask([&]() {
+    EmbedderConfigBuilder builder(context);
+    builder.SetSurface(SkISize::Make(1, 1));
+    builder.SetDartEntrypoint("platform_message_response_no_copy");
+    builder.SetPlatformMessageCallback(
+        [&](const FlutterPlatformMessage* message) {
+          if (strcmp(message->channel, "test_channel") != 0) {
+            return;
+          }
+          auto buffer = std::make_unique<uint8_t[]>(response_data.size());
+          memcpy(buffer.get(), response_data.data(), response_data.size());
+          auto result = FlutterEngineSendPlatformMessageResponseNoCopy(
+              engine.get(), message->response_handle, buffer.release(),
+              response_data.size(), release_callback, &release_count);
+          EXPECT_EQ(result, kSuccess);
+        });
+    engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+  });
+  response.Wait();
+
+  // The buffer of an invalid response is handed back as well.
+  std::atomic<int> invalid_release_count = 0;
+  auto result = FlutterEngineSendPlatformMessageResponseNoCopy(
+      engine.get(), nullptr, new uint8_t[1], 1, release_callback,
+      &invalid_release_count);
+  EXPECT_EQ(result, kInvalidArguments);
+  EXPECT_EQ(invalid_release_count, 1);
+
+  // Collecting the isolate runs the finalizer of the external typed data.
+  // Since the engine was started on its own thread, it must be killed there as
+  // well.
+  fml::AutoResetWaitableEvent kill_latch;
+  platform_task_runner->PostTask([&]() {
+    engine.reset();
+    kill_latch.Signal();
+  });
+  kill_latch.Wait();
+  EXPECT_EQ(release_count, 1);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that setting a custom log callback works as expected and defaults to
 /// using tag "flutter".
@@ -2758,6 +2962,297 @@ static void expectSoftwareRenderingOutputMatches(
   engine.reset();
 }
 
+namespace {
+
+// A pool of pixel buffers owned by the "embedder" that the software renderer
+// renders into directly.
+class FakeSoftwareBufferPool {
+ public:
+  FakeSoftwareBufferPool(size_t buffer_count, SkISize size)
+      : size_(size), in_use_(buffer_count, false) {
+    for (size_t i = 0; i < buffer_count; i++) {
+      buffers_.emplace_back(size.width() * size.height(), 0u);
+    }
+  }
+
+  bool Acquire(const FlutterFrameInfo& frame_info,
+               FlutterSoftwareBuffer* buffer) {
+    std::scoped_lock lock(mutex_);
+    EXPECT_EQ(frame_info.size.width, static_cast<uint32_t>(size_.width()));
+    EXPECT_EQ(frame_info.size.height, static_cast<uint32_t>(size_.height()));
+    // A buffer acquired but never presented is returned implicitly.
+    if (acquired_index_.has_value()) {
+      in_use_[acquired_index_.value()] = false;
+    }
+    for (size_t i = 0; i < buffers_.size(); i++) {
+      size_t index = (next_index_ + i) % buffers_.size();
+      if (!in_use_[index]) {
+        in_use_[index] = true;
+        acquired_index_ = index;
+        next_index_ = index + 1;
+        buffer->allocation = buffers_[index].data();
+        buffer->row_bytes = size_.width() * sizeof(uint32_t);
+        buffer->height = size_.height();
+        buffer->user_data = reinterpret_cast<void*>(index);
+        acquire_count_++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool Present(const FlutterSoftwareBuffer& buffer,
+               const FlutterDamage& frame_damage) {
+    std::scoped_lock lock(mutex_);
+    size_t index = reinterpret_cast<size_t>(buffer.user_data);
+    EXPECT_TRUE(acquired_index_.has_value());
+    EXPECT_EQ(index, acquired_index_.value_or(buffers_.size()));
+    EXPECT_EQ(buffer.allocation, buffers_[index].data());
+    acquired_index_.reset();
+    // The "display" takes the buffer over until the next one is presented.
+    if (displayed_index_.has_value()) {
+      in_use_[displayed_index_.value()] = false;
+    }
+    displayed_index_ = index;
+    if (frame_damage.num_rects > 0) {
+      last_damage_ = frame_damage.damage[0];
+    }
+    damage_rect_count_ = frame_damage.num_rects;
+    presented_damage_.push_back(last_damage_);
+    return true;
+  }
+
+  uint32_t DisplayedPixel(int x, int y) {
+    std::scoped_lock lock(mutex_);
+    FML_CHECK(displayed_index_.has_value());
+    return buffers_[displayed_index_.value()][y * size_.width() + x];
+  }
+
+  size_t acquire_count() {
+    std::scoped_lock lock(mutex_);
+    return acquire_count_;
+  }
+
+  size_t damage_rect_count() {
+    std::scoped_lock lock(mutex_);
+    return damage_rect_count_;
+  }
+
+  FlutterRect last_damage() {
+    std::scoped_lock lock(mutex_);
+    return last_damage_;
+  }
+
+  std::vector<FlutterRect> presented_damage() {
+    std::scoped_lock lock(mutex_);
+    return presented_damage_;
+  }
+
+ private:
+  const SkISize size_;
+  std::mutex mutex_;
+  std::vector<std::vector<uint32_t>> buffers_;
+  std::vector<bool> in_use_;
+  std::optional<size_t> acquired_index_;
+  std::optional<size_t> displayed_index_;
+  size_t next_index_ = 0;
+  size_t acquire_count_ = 0;
+  size_t damage_rect_count_ = 0;
+  FlutterRect last_damage_ = {};
+  std::vector<FlutterRect> presented_damage_;
+};
+
+}  // namespace
+
+TEST_F(EmbedderTest, CanRenderIntoEmbedderSuppliedSoftwareBuffers) {
+  const SkISize size = SkISize::Make(4, 4);
+  FakeSoftwareBufferPool pool(2, size);
+
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(size);
+  builder.SetDartEntrypoint("draw_solid_red");
+  fml::AutoResetWaitableEvent latch;
+  context.SetSoftwareBufferCallbacks(
+      [&pool](const FlutterFrameInfo& frame_info,
+              FlutterSoftwareBuffer* buffer) {
+        return pool.Acquire(frame_info, buffer);
+      },
+      [&pool, &latch](const FlutterSoftwareBuffer& buffer,
+                      const FlutterDamage& frame_damage) {
+        bool result = pool.Present(buffer, frame_damage);
+        latch.Signal();
+        return result;
+      });
+  // The buffer callbacks replace the present callback.
+  context.GetRendererConfig().software.surface_present_callback = nullptr;
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = size.width();
+  event.height = size.height();
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  engine.reset();
+
+  ASSERT_EQ(context.GetSurfacePresentCount(), 1u);
+  ASSERT_EQ(pool.acquire_count(), 1u);
+  ASSERT_EQ(pool.DisplayedPixel(0, 0), SK_ColorRED);
+  ASSERT_EQ(pool.DisplayedPixel(3, 3), SK_ColorRED);
+
+  // The first frame damages the entire buffer.
+  ASSERT_EQ(pool.damage_rect_count(), 1u);
+  ASSERT_EQ(pool.last_damage(), FlutterRectMakeLTRB(0, 0, 4, 4));
+}
+
+TEST_F(EmbedderTest, SoftwareBuffersOnlyRepaintDamagedRegions) {
+  const SkISize size = SkISize::Make(8, 8);
+  FakeSoftwareBufferPool pool(2, size);
+
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(size);
+  builder.SetDartEntrypoint("render_moving_square");
+  fml::CountDownLatch latch(4);
+  context.SetSoftwareBufferCallbacks(
+      [&pool](const FlutterFrameInfo& frame_info,
+              FlutterSoftwareBuffer* buffer) {
+        return pool.Acquire(frame_info, buffer);
+      },
+      [&pool, &latch](const FlutterSoftwareBuffer& buffer,
+                      const FlutterDamage& frame_damage) {
+        bool result = pool.Present(buffer, frame_damage);
+        latch.CountDown();
+        return result;
+      });
+  context.GetRendererConfig().software.surface_present_callback = nullptr;
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = size.width();
+  event.height = size.height();
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  engine.reset();
+
+  // The pool alternates between its two buffers. Both are painted entirely
+  // the first time they are used. After that, only the regions that changed
+  // since a buffer was last presented are repainted, and only the difference
+  // to the previous frame is reported as damage.
+  auto damage = pool.presented_damage();
+  ASSERT_EQ(damage.size(), 4u);
+  ASSERT_EQ(damage[0], FlutterRectMakeLTRB(0, 0, 8, 8));
+  ASSERT_EQ(damage[1], FlutterRectMakeLTRB(0, 0, 8, 8));
+  ASSERT_EQ(damage[2], FlutterRectMakeLTRB(2, 0, 6, 2));
+  ASSERT_EQ(damage[3], FlutterRectMakeLTRB(4, 0, 8, 2));
+
+  // The second buffer last showed the square at x = 2 and must have had that
+  // position repainted along with the new one.
+  ASSERT_EQ(pool.DisplayedPixel(0, 0), SK_ColorRED);
+  ASSERT_EQ(pool.DisplayedPixel(2, 0), SK_ColorRED);
+  ASSERT_EQ(pool.DisplayedPixel(3, 1), SK_ColorRED);
+  ASSERT_EQ(pool.DisplayedPixel(5, 0), SK_ColorRED);
+  ASSERT_EQ(pool.DisplayedPixel(6, 0), SK_ColorBLUE);
+  ASSERT_EQ(pool.DisplayedPixel(7, 1), SK_ColorBLUE);
+  ASSERT_EQ(pool.DisplayedPixel(7, 7), SK_ColorRED);
+}
+
+TEST_F(EmbedderTest, SoftwareBackingStoresOnlyRepaintDamagedRegions) {
+  const SkISize size = SkISize::Make(8, 8);
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(size);
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("render_moving_square");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  fml::CountDownLatch latch(4);
+  size_t frame = 0;
+  std::vector<const void*> allocations;
+  std::vector<SkColor> last_frame_pixels;
+  context.GetCompositor().SetPresentCallback(
+      [&](FlutterViewId view_id, const FlutterLayer** layers,
+          size_t layers_count) {
+        ASSERT_EQ(layers_count, 1u);
+        ASSERT_EQ(layers[0]->type, kFlutterLayerContentTypeBackingStore);
+        allocations.push_back(layers[0]->backing_store->software.allocation);
+        SkPixmap pixmap;
+        ASSERT_TRUE(context.GetCompositor()
+                        .GetSurface(layers[0]->backing_store)
+                        ->peekPixels(&pixmap));
+        if (frame == 1) {
+          // Neither the first frame nor the second, which is diffed against
+          // a frame that was not, are painted partially. Mark a pixel that
+          // no later frame damages.
+          *pixmap.writable_addr32(7, 7) = SK_ColorGREEN;
+        }
+        if (frame == 3) {
+          for (int x = 0; x < size.width(); x++) {
+            last_frame_pixels.push_back(pixmap.getColor(x, 0));
+          }
+          last_frame_pixels.push_back(pixmap.getColor(7, 7));
+        }
+        frame++;
+        latch.CountDown();
+      },
+      /*one_shot=*/false);
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = size.width();
+  event.height = size.height();
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  engine.reset();
+
+  // The backing store is reused for every frame.
+  ASSERT_EQ(allocations.size(), 4u);
+  for (const void* allocation : allocations) {
+    ASSERT_EQ(allocation, allocations[0]);
+  }
+
+  // The square moved from x = 4 to x = 6 in the last frame, and the previous
+  // positions of the square were repainted.
+  ASSERT_EQ(last_frame_pixels.size(), 9u);
+  for (int x = 0; x < 6; x++) {
+    ASSERT_EQ(last_frame_pixels[x], SK_ColorRED) << x;
+  }
+  ASSERT_EQ(last_frame_pixels[6], SK_ColorBLUE);
+  ASSERT_EQ(last_frame_pixels[7], SK_ColorBLUE);
+  // The marked pixel was not repainted.
+  ASSERT_EQ(last_frame_pixels[8], SK_ColorGREEN);
+}
+
+TEST_F(EmbedderTest, SoftwareBufferCallbacksMustBeSpecifiedTogether) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  context.GetRendererConfig().software.acquire_buffer_callback =
+      [](void* context, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) { return false; };
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
 template <typename T>
 static void expectSoftwareRenderingOutputMatches(
     EmbedderTest& test,
@@ -723,6 +723,96 @@ void main() async {
     await comparer.addGoldenImage(image, 'render_unordered_rects.png');
   });
 
+  test('CanvasCommandBuffer renders like the individual Canvas calls',
+      () async {
+    final Path path = Path()
+      ..moveTo(10, 60)
+      ..lineTo(40, 90)
+      ..lineTo(10, 90)
+      ..close();
+
+    final Image expected = await toImage((Canvas canvas) {
+      final Paint paint = Paint()..color = const Color(0xFF2196F3);
+      canvas.save();
+      canvas.translate(5, 5);
+      canvas.clipRect(const Rect.fromLTRB(0, 0, 90, 90));
+      canvas.drawRect(const Rect.fromLTRB(0, 0, 30, 30), paint);
+      paint.color = const Color(0x804CAF50);
+      canvas.drawOval(const Rect.fromLTRB(40, 0, 70, 30), paint);
+      paint
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = 4.0
+        ..strokeCap = StrokeCap.round;
+      canvas.drawLine(const Offset(50, 50), const Offset(80, 80), paint);
+      canvas.drawCircle(const Offset(70, 40), 8, paint);
+      paint.style = PaintingStyle.fill;
+      canvas.drawRRect(
+          RRect.fromLTRBR(20, 40, 45, 55, const Radius.circular(4)), paint);
+      canvas.drawPath(path, paint);
+      canvas.restore();
+    }, 100, 100);
+
+    final CanvasCommandBuffer buffer = CanvasCommandBuffer();
+    buffer.save();
+    buffer.translate(5, 5);
+    buffer.clipRect(const Rect.fromLTRB(0, 0, 90, 90));
+    buffer.color = const Color(0xFF2196F3);
+    buffer.drawRect(const Rect.fromLTRB(0, 0, 30, 30));
+    buffer.color = const Color(0x804CAF50);
+    buffer.drawOval(const Rect.fromLTRB(40, 0, 70, 30));
+    buffer
+      ..style = PaintingStyle.stroke
+      ..strokeWidth = 4.0
+      ..strokeCap = StrokeCap.round;
+    buffer.drawLine(const Offset(50, 50), const Offset(80, 80));
+    buffer.drawCircle(const Offset(70, 40), 8);
+    buffer.style = PaintingStyle.fill;
+    buffer.drawRRect(RRect.fromLTRBR(20, 40, 45, 55, const Radius.circular(4)));
+    buffer.drawPath(path);
+    buffer.restore();
+    expect(buffer.isEmpty, isFalse);
+
+    final Image actual = await toImage(buffer.drawInto, 100, 100);
+
+    final ByteData expectedData = (await expected.toByteData())!;
+    final ByteData actualData = (await actual.toByteData())!;
+    expect(actualData.buffer.asUint8List(),
+        equals(expectedData.buffer.asUint8List()));
+
+    // Unchanged paint state is not recorded again.
+    final int lengthInBytes = buffer.lengthInBytes;
+    buffer.color = const Color(0x804CAF50);
+    buffer.style = PaintingStyle.fill;
+    expect(buffer.lengthInBytes, lengthInBytes);
+
+    buffer.clear();
+    expect(buffer.isEmpty, isTrue);
+    expect(buffer.color, const Color(0xFF000000));
+  });
+
+  test('CanvasCommandBuffer only restores its own saves', () async {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.save();
+    canvas.translate(10, 10);
+
+    final CanvasCommandBuffer buffer = CanvasCommandBuffer();
+    buffer.save();
+    buffer.scale(2, 2);
+    buffer.restore();
+    buffer.restore();
+    buffer.restore();
+    buffer.save();
+    buffer.translate(5, 5);
+    buffer.drawInto(canvas);
+
+    expect(canvas.getSaveCount(), 2);
+    expect(canvas.getTransform(),
+        closeToTransform(Matrix4.translationValues(10, 10, 0).storage));
+    canvas.restore();
+    recorder.endRecording().dispose();
+  });
+
   test('Canvas.translate affects canvas.getTransform', () async {
     final PictureRecorder recorder = PictureRecorder();
     final Canvas canvas = Canvas(recorder);
@@ -412,6 +412,71 @@ void main() {
       );
     });
   });
+  test('SceneCommandBuffer builds the same scene as SceneBuilder', () async {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawPaint(Paint()..color = const Color(0xFF123456));
+    canvas.drawRect(const Rect.fromLTRB(0, 0, 4, 4), Paint()..color = const Color(0xFF00FF00));
+    final Picture picture = recorder.endRecording();
+
+    final SceneBuilder builder = SceneBuilder();
+    builder.pushOffset(2, 2);
+    builder.pushClipRect(const Rect.fromLTRB(0, 0, 10, 10));
+    builder.pushOpacity(0x80);
+    builder.addPicture(const Offset(1, 1), picture);
+    builder.pop();
+    builder.pop();
+    builder.pop();
+    final Scene expectedScene = builder.build();
+
+    final SceneCommandBuffer buffer = SceneCommandBuffer();
+    final int offsetLayer = buffer.pushOffset(2, 2);
+    buffer.pushClipRect(const Rect.fromLTRB(0, 0, 10, 10));
+    buffer.pushOpacity(0x80);
+    buffer.addPicture(const Offset(1, 1), picture);
+    buffer.pop();
+    buffer.pop();
+    buffer.pop();
+    final Scene actualScene = buffer.build();
+
+    // The retained subtree of the next scene renders the same.
+    buffer.addRetained(offsetLayer);
+    final Scene retainedScene = buffer.build();
+
+    final ByteData expected = (await expectedScene.toImageSync(16, 16).toByteData())!;
+    final ByteData actual = (await actualScene.toImageSync(16, 16).toByteData())!;
+    final ByteData retained = (await retainedScene.toImageSync(16, 16).toByteData())!;
+    expect(actual.buffer.asUint8List(), equals(expected.buffer.asUint8List()));
+    expect(retained.buffer.asUint8List(), equals(expected.buffer.asUint8List()));
+
+    expectedScene.dispose();
+    actualScene.dispose();
+    retainedScene.dispose();
+
+    // Only the layers of the last scene can be retained.
+    buffer.build().dispose();
+    buffer.addRetained(offsetLayer);
+    expect(buffer.build, throwsStateError);
+
+    buffer.dispose();
+    picture.dispose();
+  });
+
+  test('SceneCommandBuffer does not retain a layer twice', () {
+    final SceneCommandBuffer buffer = SceneCommandBuffer();
+    final int offsetLayer = buffer.pushOffset(2, 2);
+    final int clipLayer = buffer.pushClipRect(const Rect.fromLTRB(0, 0, 10, 10));
+    buffer.pop();
+    buffer.pop();
+    buffer.build().dispose();
+
+    // The clip layer is also retained as a descendant of the offset layer.
+    buffer.addRetained(clipLayer);
+    buffer.addRetained(offsetLayer);
+    expect(buffer.build, throwsStateError);
+
+    buffer.dispose();
+  });
 }
 
 typedef _TestNoSharingFunction = EngineLayer Function(SceneBuilder builder, EngineLayer? oldLayer);
@@ -0,0 +1,293 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays the frames captured with the --frame-capture-path engine switch and
+// reports the CPU time each rendering backend spends on them.
+//
+// Usage:
+//   dl_replay [--backend=all|skia|impeller] [--iterations=N]
+//             [--hardware-vulkan] frame_0_view_0.dl [frame_1_view_0.dl ...]
+//
+// The Skia backend renders into a raster surface. The Impeller backend renders
+// with Vulkan, on SwiftShader unless --hardware-vulkan is passed, and waits for
+// the device to go idle after every frame. Images are uploaded before the
+// measured iterations begin.
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_serialization.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "txt/platform.h"
+
+#if IMPELLER_ENABLE_VULKAN
+#include "flutter/impeller/core/device_buffer.h"
+#include "flutter/impeller/display_list/aiks_context.h"
+#include "flutter/impeller/display_list/dl_dispatcher.h"
+#include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/playground/backend/vulkan/swiftshader_utilities.h"
+#include "flutter/impeller/playground/playground_impl.h"
+#include "flutter/impeller/typographer/backends/skia/text_frame_skia.h"
+#include "flutter/impeller/typographer/backends/skia/typographer_context_skia.h"
+
+#define GLFW_INCLUDE_NONE
+#include "third_party/glfw/include/GLFW/glfw3.h"
+#endif  // IMPELLER_ENABLE_VULKAN
+
+namespace flutter {
+namespace {
+
+struct Timings {
+  double cpu_ms = 0;
+  double wall_ms = 0;
+};
+
+// A rendering backend that the captured frames are replayed with.
+class ReplayBackend {
+ public:
+  virtual ~ReplayBackend() = default;
+
+  virtual const char* GetName() const = 0;
+
+  // Creates the images of the deserialized DisplayLists for this backend.
+  virtual sk_sp<DlImage> MakeImage(const sk_sp<SkImage>& pixels) = 0;
+
+  // Selects the runtime effect shaders and the text representation of the
+  // deserialized DisplayLists for this backend.
+  virtual void SetUpDeserialization(DlDeserializationOptions& options) = 0;
+
+  // Renders the DisplayList and waits until the rendering has finished.
+  virtual bool Render(const sk_sp<DisplayList>& display_list,
+                      const SkISize& size) = 0;
+};
+
+class SkiaReplayBackend final : public ReplayBackend {
+ public:
+  const char* GetName() const override { return "skia"; }
+
+  sk_sp<DlImage> MakeImage(const sk_sp<SkImage>& pixels) override {
+    return DlImage::Make(pixels);
+  }
+
+  void SetUpDeserialization(DlDeserializationOptions& options) override {
+    options.runtime_stage_backend = impeller::RuntimeStageBackend::kSkSL;
+  }
+
+  bool Render(const sk_sp<DisplayList>& display_list,
+              const SkISize& size) override {
+    if (!surface_ || surface_->width() != size.width() ||
+        surface_->height() != size.height()) {
+      surface_ = SkSurfaces::Raster(
+          SkImageInfo::MakeN32Premul(size.width(), size.height()));
+      if (!surface_) {
+        return false;
+      }
+    }
+    SkCanvas* canvas = surface_->getCanvas();
+    canvas->clear(SK_ColorTRANSPARENT);
+    DlSkCanvasAdapter(canvas).DrawDisplayList(display_list);
+    return true;
+  }
+
+ private:
+  sk_sp<SkSurface> surface_;
+};
+
+#if IMPELLER_ENABLE_VULKAN
+class ImpellerReplayBackend final : public ReplayBackend {
+ public:
+  static std::unique_ptr<ImpellerReplayBackend> Create(bool use_swiftshader) {
+    impeller::SetupSwiftshaderOnce(use_swiftshader);
+    if (::glfwInit() != GLFW_TRUE) {
+      return nullptr;
+    }
+    impeller::PlaygroundSwitches switches;
+    switches.use_swiftshader = use_swiftshader;
+    auto playground = impeller::PlaygroundImpl::Create(
+        impeller::PlaygroundBackend::kVulkan, switches);
+    if (!playground || !playground->GetContext()) {
+      return nullptr;
+    }
+    return std::unique_ptr<ImpellerReplayBackend>(
+        new ImpellerReplayBackend(std::move(playground)));
+  }
+
+  ~ImpellerReplayBackend() override { context_->Shutdown(); }
+
+  const char* GetName() const override { return "impeller"; }
+
+  void SetUpDeserialization(DlDeserializationOptions& options) override {
+    options.runtime_stage_backend = impeller::RuntimeStageBackend::kVulkan;
+    options.text_frame_factory = impeller::MakeTextFrameFromTextBlobSkia;
+  }
+
+  sk_sp<DlImage> MakeImage(const sk_sp<SkImage>& pixels) override {
+    SkPixmap pixmap;
+    if (!pixels->peekPixels(&pixmap)) {
+      return nullptr;
+    }
+    impeller::TextureDescriptor descriptor;
+    descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+    descriptor.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+    descriptor.size = impeller::ISize(pixmap.width(), pixmap.height());
+    auto allocator = context_->GetResourceAllocator();
+    auto texture = allocator->CreateTexture(descriptor);
+    auto buffer = allocator->CreateBufferWithCopy(
+        static_cast<const uint8_t*>(pixmap.addr()), pixmap.computeByteSize());
+    auto command_buffer = context_->CreateCommandBuffer();
+    if (!texture || !buffer || !command_buffer) {
+      return nullptr;
+    }
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass->AddCopy(impeller::DeviceBuffer::AsBufferView(buffer),
+                            texture) ||
+        !blit_pass->EncodeCommands(allocator) ||
+        !context_->GetCommandQueue()->Submit({command_buffer}).ok()) {
+      return nullptr;
+    }
+    return impeller::DlImageImpeller::Make(texture);
+  }
+
+  bool Render(const sk_sp<DisplayList>& display_list,
+              const SkISize& size) override {
+    auto texture = impeller::DisplayListToTexture(
+        display_list, impeller::ISize(size.width(), size.height()),
+        aiks_context_);
+    if (auto idle_waiter = context_->GetIdleWaiter()) {
+      idle_waiter->WaitIdle();
+    }
+    return texture != nullptr;
+  }
+
+ private:
+  explicit ImpellerReplayBackend(
+      std::unique_ptr<impeller::PlaygroundImpl> playground)
+      : playground_(std::move(playground)),
+        context_(playground_->GetContext()),
+        aiks_context_(context_, impeller::TypographerContextSkia::Make()) {}
+
+  std::unique_ptr<impeller::PlaygroundImpl> playground_;
+  std::shared_ptr<impeller::Context> context_;
+  impeller::AiksContext aiks_context_;
+};
+#endif  // IMPELLER_ENABLE_VULKAN
+
+Timings Measure(const std::function<bool()>& render, int iterations) {
+  Timings timings;
+  for (int i = 0; i < iterations; i++) {
+    std::clock_t cpu_start = std::clock();
+    fml::TimePoint wall_start = fml::TimePoint::Now();
+    if (!render()) {
+      return {};
+    }
+    timings.wall_ms +=
+        (fml::TimePoint::Now() - wall_start).ToMillisecondsF() / iterations;
+    timings.cpu_ms += 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC /
+                      iterations;
+  }
+  return timings;
+}
+
+int ReplayFrames(const fml::CommandLine& command_line) {
+  if (command_line.positional_args().empty()) {
+    std::cerr << "Usage: dl_replay [--backend=all|skia|impeller] "
+                 "[--iterations=N] [--hardware-vulkan] <frame.dl>..."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string backend_name = command_line.GetOptionValueWithDefault(
+      "backend", "all");
+  int iterations = std::max(
+      std::atoi(
+          command_line.GetOptionValueWithDefault("iterations", "10").c_str()),
+      1);
+
+  std::vector<std::unique_ptr<ReplayBackend>> backends;
+  if (backend_name == "all" || backend_name == "skia") {
+    backends.push_back(std::make_unique<SkiaReplayBackend>());
+  }
+  if (backend_name == "all" || backend_name == "impeller") {
+#if IMPELLER_ENABLE_VULKAN
+    auto impeller = ImpellerReplayBackend::Create(
+        !command_line.HasOption("hardware-vulkan"));
+    if (!impeller) {
+      std::cerr << "Could not create an Impeller Vulkan context." << std::endl;
+      return EXIT_FAILURE;
+    }
+    backends.push_back(std::move(impeller));
+#else
+    std::cerr << "Impeller replay requires the Vulkan backend." << std::endl;
+    if (backend_name == "impeller") {
+      return EXIT_FAILURE;
+    }
+#endif  // IMPELLER_ENABLE_VULKAN
+  }
+  if (backends.empty()) {
+    std::cerr << "Unknown backend " << backend_name << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  for (const auto& path : command_line.positional_args()) {
+    auto mapping = fml::FileMapping::CreateReadOnly(path);
+    if (!mapping) {
+      std::cerr << "Could not open " << path << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << path;
+    for (const auto& backend : backends) {
+      DlDeserializationOptions options;
+      options.image_factory = [&backend](const sk_sp<SkImage>& pixels) {
+        return backend->MakeImage(pixels);
+      };
+      options.font_manager = txt::GetDefaultFontManager();
+      backend->SetUpDeserialization(options);
+      auto display_list = DeserializeDisplayList(
+          mapping->GetMapping(), mapping->GetSize(), options);
+      if (!display_list) {
+        std::cerr << std::endl << "Could not read " << path << std::endl;
+        return EXIT_FAILURE;
+      }
+      DlIRect bounds = DlIRect::RoundOut(display_list->GetBounds());
+      SkISize size = SkISize::Make(std::max<int32_t>(bounds.GetRight(), 1),
+                                   std::max<int32_t>(bounds.GetBottom(), 1));
+
+      // The first render warms up caches and pipelines and is not measured.
+      auto render = [&]() { return backend->Render(display_list, size); };
+      if (!render()) {
+        std::cerr << std::endl
+                  << "Could not render " << path << " with "
+                  << backend->GetName() << std::endl;
+        return EXIT_FAILURE;
+      }
+      Timings timings = Measure(render, iterations);
+      std::cout << "  " << backend->GetName() << ": cpu " << timings.cpu_ms
+                << " ms, wall " << timings.wall_ms << " ms";
+    }
+    std::cout << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char* argv[]) {
+  return flutter::ReplayFrames(
+      fml::CommandLineFromPlatformOrArgcArgv(argc, argv));
+}